@@ -4,3 +4,4 @@ option(MIR_DOUBLE_PRECISION "use double precision everywhere; will also enable M
 option(MIR_MEMBRANE_DOUBLE  "compute membrane forces in double precision" OFF)
 option(MIR_ROD_DOUBLE       "compute rod forces in double precision" OFF)
 option(MIR_USE_NVTX         "enable NVTX profiling" OFF)
+option(MIR_DETERMINISTIC_FORCES "accumulate forces in 64-bit fixed point for bitwise reproducible runs" OFF)
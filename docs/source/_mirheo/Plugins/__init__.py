@@ -269,6 +269,28 @@ def createDumpParticles():
     """
     pass
 
+def createDumpParticlesTrajectory():
+    r"""createDumpParticlesTrajectory(state: MirState, name: str, pv: ParticleVectors.ParticleVector, dump_every: int, channel_names: List[str], path: str, chunk_size: int = 4096, sort_by_id: bool = True) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
+
+
+        Same as :any:`createDumpParticles`, but all the dumps are appended to a single trajectory file <path>.traj.
+        The file contains an index of the frames, which allows to access any frame directly, see :any:`TrajectoryReader`.
+        The particles of each frame are stored in chunks; when they are sorted by id, a range of ids can be read without reading the whole frame.
+        The data is gathered and written by the first postprocess rank.
+
+        Args:
+            name: name of the plugin
+            pv: :any:`ParticleVector` that we'll work with
+            dump_every: write a frame every this many time-steps
+            channel_names: list of channel names to be dumped.
+            path: Path and filename prefix of the trajectory file. An existing file is overwritten, unless the plugin is loaded from a snapshot.
+            chunk_size: maximum number of particles in each chunk of a frame
+            sort_by_id: if True, the particles of each frame are sorted by global id
+    
+
+    """
+    pass
+
 def createDumpParticlesWithMesh():
     r"""createDumpParticlesWithMesh(state: MirState, name: str, ov: ParticleVectors.ObjectVector, dump_every: int, channel_names: List[str], path: str) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
 
@@ -437,6 +459,38 @@ def createMsd():
     """
     pass
 
+def createMultiTauCorrelator():
+    r"""createMultiTauCorrelator(state: MirState, name: str, pv: ParticleVectors.ParticleVector, channel_name: str, correlation: str, start_time: float, sample_every: int, dump_every: int, num_levels: int = 16, block_size: int = 16, path: str = 'correlations/') -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
+
+
+        This plugin computes time correlation functions of a per-particle vector channel with a multiple-tau correlator.
+        Every sample is used as a time origin and the lags are spaced quasi-logarithmically, up to
+        block_size * 2^(num_levels-1) samples, with num_levels * (block_size + 1) values stored per particle.
+        The history of each particle is stored in channels, so that it follows the particle across ranks.
+
+        With ``correlation="squared_difference"`` and the positions channel, the plugin computes the mean square displacement
+        (the positions are unwrapped across the periodic boundaries).
+        With ``correlation="dot"`` and the velocities channel, it computes the (non normalized) velocity autocorrelation function.
+
+        The correlation function is averaged over the particles and the time origins and rewritten to ``<path>/<pv name>_<channel_name>.csv``
+        every dump_every steps.
+
+        Args:
+            name: Name of the plugin.
+            pv: Concerned :class:`ParticleVector`.
+            channel_name: Name of the channel to correlate; must contain real3 or real4 (the first three components are used).
+            correlation: Either "squared_difference" or "dot".
+            start_time: Simulation time of the first sample.
+            sample_every: Sample the channel every this many time-steps.
+            dump_every: Report the correlation function every this many time-steps. Must be a multiple of sample_every.
+            num_levels: Number of blocks of the correlator.
+            block_size: Number of values per block; must be a multiple of 2.
+            path: The folder name in which the file will be dumped.
+    
+
+    """
+    pass
+
 def createParticleChannelAverager():
     r"""createParticleChannelAverager(state: MirState, name: str, pv: ParticleVectors.ParticleVector, channelName: str, averageName: str, updateEvery: float) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
 
@@ -1,3 +1,90 @@
+class TrajectoryReader:
+    r"""
+        Random access to the frames of a trajectory file, as written by :any:`createDumpParticlesTrajectory`.
+        Each frame is returned as a dictionary of numpy arrays: "positions" and one entry per channel.
+    
+    """
+    def __init__():
+        r"""__init__(filename: str) -> None
+
+
+            Args:
+                filename: name of the trajectory file
+        
+
+        """
+        pass
+
+    def find_frame():
+        r"""find_frame(time: float) -> int
+
+
+            Return the index of the last frame with a time not larger than the given one, or -1 if there is none.
+        
+
+        """
+        pass
+
+    def get_channel_names():
+        r"""get_channel_names() -> List[str]
+
+Return the names of the channels stored in each frame.
+
+        """
+        pass
+
+    def get_num_frames():
+        r"""get_num_frames() -> int
+
+Return the number of frames in the file.
+
+        """
+        pass
+
+    def get_step():
+        r"""get_step(frame: int) -> int
+
+Return the step of the given frame.
+
+        """
+        pass
+
+    def get_time():
+        r"""get_time(frame: int) -> float
+
+Return the simulation time of the given frame.
+
+        """
+        pass
+
+    def read_frame():
+        r"""read_frame(*args, **kwargs)
+Overloaded function.
+
+1. read_frame(frame: int) -> dict
+
+
+            Read all the particles of one frame.
+
+            Args:
+                frame: index of the frame
+        
+
+2. read_frame(frame: int, id_min: int, id_max: int) -> dict
+
+
+            Read the particles of one frame with an id between id_min and id_max (inclusive).
+            Only the chunks that may contain these ids are read; this is efficient when the frames are sorted by id.
+
+            Args:
+                frame: index of the frame
+                id_min: smallest id to read
+                id_max: largest id to read
+        
+
+        """
+        pass
+
 
 # Functions
 
@@ -430,6 +430,23 @@ Register Plugins
         """
         pass
 
+    def setSnapshotFormat():
+        r"""setSnapshotFormat(format: str) -> None
+
+
+            Set the format of the snapshot metadata file.
+            The binary format stores the config in ``config.bin``; it is much smaller and faster to save and load than JSON
+            for setups with many objects or large meshes, as arrays of numbers are stored as raw blobs.
+            ``config.json`` stays human-readable and is the default.
+            :py:meth:`_mirheo.Mirheo` detects the format automatically when loading a snapshot.
+
+            Args:
+                format: either "json" or "binary"
+        
+
+        """
+        pass
+
     def save_dependency_graph_graphml():
         r"""save_dependency_graph_graphml(fname: str, current: bool=True) -> None
 
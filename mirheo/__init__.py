@@ -192,7 +192,8 @@ def __init__():
     # Make the __init__ functions return None if we are not a compute task
     nonGPU_names  = [['Interactions', 'MembraneParameters'],
                      ['Interactions', 'KantorBendingParameters'],
-                     ['Interactions', 'JuelicherBendingParameters']]
+                     ['Interactions', 'JuelicherBendingParameters'],
+                     ['Utils', 'TrajectoryReader']]
     
     needing_state = ['Plugins', 'Integrators', 'ParticleVectors',
                      'Interactions', 'BelongingCheckers', 'Bouncers', 'Walls']
@@ -27,6 +27,43 @@ def compile_opt(args):
         print(mirheo.Utils.get_compile_option(args.name))
 
 
+def decode_log(args):
+    """The `mirheo decode_log` command.
+
+    Convert a binary log file (see `log_binary` in `Mirheo`) to the text format.
+
+    Usage:
+        decode_log file [file ...]
+    """
+    import struct
+    import sys
+    import time
+
+    magic = b'MIRLOGB1'
+    record_header = struct.Struct('=q4i')
+
+    for fname in args.files:
+        with open(fname, 'rb') as f:
+            data = f.read()
+
+        if data[:len(magic)] != magic:
+            sys.exit("'{}' is not a binary Mirheo log file.".format(fname))
+
+        rank, = struct.unpack_from('=i', data, len(magic))
+        pos = len(magic) + 4
+
+        while pos + record_header.size <= len(data):
+            time_ms, line, key_len, file_len, msg_len = record_header.unpack_from(data, pos)
+            pos += record_header.size
+            key      = data[pos:pos + key_len].decode(errors='replace'); pos += key_len
+            filename = data[pos:pos + file_len].decode(errors='replace'); pos += file_len
+            msg      = data[pos:pos + msg_len].decode(errors='replace'); pos += msg_len
+
+            sec, ms = divmod(time_ms, 1000)
+            stamp = time.strftime('%H:%M:%S', time.localtime(sec))
+            print("{}:{:03d}  Rank {:04d} {:>7} at {}:{} {}".format(stamp, ms, rank, key, filename, line, msg))
+
+
 def main(argv):
     parser = argparse.ArgumentParser()
     parser.add_argument('--version', action='store_true', default=False)
@@ -49,6 +86,10 @@ def main(argv):
     compile_opt_parser.add_argument('name', type=str,
                                     help="The option name. The special value 'all' will list all possible options and their current values.")
 
+    decode_log_parser = subparsers.add_parser('decode_log', help="Print binary log files in text format.")
+    decode_log_parser.add_argument('files', type=str, nargs='+', metavar="file",
+                                   help="The binary log files.")
+
     args = parser.parse_args()
 
     if args.version:
@@ -59,6 +100,8 @@ def main(argv):
         compile_opt(args)
     elif args.command == 'run':
         run(args)
+    elif args.command == 'decode_log':
+        decode_log(args)
     else:
         parser.print_help()
 
@@ -30,3 +30,24 @@ def eulerToQuaternion(pitch, roll, yaw):
          sy * cr * cp - cy * sr * sp]
 
     return q
+
+def vectorized(func):
+    """
+    Mark a position function as vectorized.
+    Mirheo then calls it with all the positions at once, as a numpy array of shape (n, 3),
+    instead of once per position.
+    The function must return an array of n values (or of shape (n, 3) for vector fields).
+
+    Example:
+        @vectorized
+        def sphere(r):
+            return np.linalg.norm(r - center, axis=1) - radius
+    """
+    import functools
+
+    @functools.wraps(func)
+    def wrapper(*args, **kwargs):
+        return func(*args, **kwargs)
+
+    wrapper.mirheo_vectorized = True
+    return wrapper
@@ -1,6 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "bindings.h"
 #include "class_wrapper.h"
+#include "position_function.h"
 
 #include <mirheo/core/initial_conditions/from_array.h>
 #include <mirheo/core/initial_conditions/interface.h>
@@ -183,11 +184,12 @@ void exportInitialConditions(py::module& m)
         The particles will be generated with the desired number density uniformly at random in all the domain and then filtered out by the given filter.
         These IC may be used with any Particle Vector, but only make sense for regular PV.
     )")
-        .def(py::init<real, std::function<bool(real3)>>(),
+        .def(py::init<real, PositionFilter>(),
              "number_density"_a, "filter"_a, R"(
             Args:
                 number_density: target number density
-                filter: given position, returns True if the particle should be kept
+                filter: given position, returns True if the particle should be kept.
+                        If decorated with :any:`mirheo.tools.vectorized`, it is called once with all the candidate positions.
         )");
 
     py::handlers_class<UniformSphereIC>(m, "UniformSphere", pyic, R"(
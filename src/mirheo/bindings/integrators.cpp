@@ -157,7 +157,7 @@ void exportIntegrators(py::module& m)
             The fast forces are updated after each sub step using the Shardlow method for viscous forces with multiple seeps.
         )")
         .def(py::init(&integrator_factory::createSubstepShardlowSweep),
-             "state"_a, "name"_a, "substeps"_a, "fastForces"_a, "gammaC"_a, "kBT"_a, "nsweeps"_a, R"(
+             "state"_a, "name"_a, "substeps"_a, "fastForces"_a, "gammaC"_a, "kBT"_a, "nsweeps"_a, "fused"_a=false, R"(
                 Args:
                     name: Name of the integrator.
                     substeps: Number of sub steps.
@@ -165,6 +165,9 @@ void exportIntegrators(py::module& m)
                     gammaC: Membrane viscous coefficient.
                     kBT: temperature, in energy units. Set to zero to disable membrane fluctuations.
                     nsweeps: Number of sweeps for the semi implicit step. Must be strictly more than 0.
+                    fused: If ``True``, each sub step (except the fast forces) runs in a single kernel with one block per membrane.
+                        Gives the same result as the default mode, with much fewer kernel launches.
+                        Meshes too large for the shared memory use the default mode.
 
                 .. warning::
                     The interaction will be set to the required object vector when setting this integrator to the object vector.
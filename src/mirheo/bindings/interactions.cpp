@@ -517,6 +517,15 @@ void exportInteractions(py::module& m)
                  * **kBT** temperature used in the acceptance-rejection algorithm
                  * **J** neighbouring spin 'dislike' energy
 
+             state update parameters, for **state_update** = 'transfer_matrix':
+
+                 * **kBT** temperature; the states are drawn from the exact Boltzmann distribution of the Ising model
+                   (same energy as 'spin'). If zero, the exact ground state is selected.
+                 * **J** neighbouring spin 'dislike' energy
+
+                 The states are computed with a parallel transfer matrix method in a single step per iteration,
+                 instead of Monte-Carlo steps that need many iterations to equilibrate.
+
              The interaction can support multiple polymorphic states if **kappa0**, **tau0** and **E0** are lists of equal size.
              In this case, the **E0** parameter is required.
              Only lists of 1, 2 and 11 states are supported.
@@ -110,9 +110,10 @@ void exportMirheo(py::module& m)
                            std::string log, int debuglvl,
                            std::string checkpointMechanismStr, int checkpointEvery,
                            std::string checkpointFolder, std::string checkpointModeStr,
-                           bool cudaMPI, bool noSplash, long commPtr, UnitConversion units)
+                           bool cudaMPI, bool noSplash, long commPtr, UnitConversion units,
+                           bool logAsync, bool logBinary)
             {
-                LogInfo logInfo(log, debuglvl, noSplash);
+                LogInfo logInfo(log, debuglvl, noSplash, logAsync, logBinary);
                 CheckpointInfo checkpointInfo(
                         checkpointEvery, checkpointFolder,
                         getCheckpointMode(checkpointModeStr),
@@ -132,7 +133,8 @@ void exportMirheo(py::module& m)
              "nranks"_a, "domain"_a, "log_filename"_a="log", "debug_level"_a=3,
              "checkpoint_mechanism"_a="Checkpoint", "checkpoint_every"_a=0,
              "checkpoint_folder"_a="restart/", "checkpoint_mode"_a="PingPong",
-             "cuda_aware_mpi"_a=false, "no_splash"_a=false, "comm_ptr"_a=0, "units"_a=UnitConversion{}, R"(
+             "cuda_aware_mpi"_a=false, "no_splash"_a=false, "comm_ptr"_a=0, "units"_a=UnitConversion{},
+             "log_async"_a=false, "log_binary"_a=false, R"(
 Create the Mirheo coordinator.
 
 .. warning::
@@ -173,11 +175,15 @@ Args:
     no_splash: don't display the splash screen when at the start-up.
     comm_ptr: pointer to communicator. By default MPI_COMM_WORLD will be used
     units: Mirheo to SI unit conversion factors. Automatically set if :any:`set_unit_registry` was used.
+    log_async: if True, log messages are queued in memory and written to the file by a background thread, at least every 50 ms.
+        This removes the cost of file output from the simulation loop. Ignored if debug_level is 8 or above.
+    log_binary: if True, write the log files in a compact binary format instead of text (not applicable to 'stdout' and 'stderr').
+        The files can be converted to text with ``python -m mirheo decode_log <file>``.
         )")
         .def(py::init( [] (int3 nranks, const std::string& snapshotPath, std::string log, int debuglvl,
-                           bool cudaMPI, bool noSplash, long commPtr)
+                           bool cudaMPI, bool noSplash, long commPtr, bool logAsync, bool logBinary)
             {
-                LogInfo logInfo(log, debuglvl, noSplash);
+                LogInfo logInfo(log, debuglvl, noSplash, logAsync, logBinary);
 
                 if (commPtr == 0) {
                     return std::make_unique<Mirheo> (      nranks, snapshotPath, logInfo, cudaMPI);
@@ -189,7 +195,8 @@ Args:
             } ),
              py::return_value_policy::take_ownership,
              "nranks"_a, "snapshot"_a, "log_filename"_a="log", "debug_level"_a=3,
-             "cuda_aware_mpi"_a=false, "no_splash"_a=false, "comm_ptr"_a=0, R"(
+             "cuda_aware_mpi"_a=false, "no_splash"_a=false, "comm_ptr"_a=0,
+             "log_async"_a=false, "log_binary"_a=false, R"(
 Create the Mirheo coordinator from a snapshot.
 
 Args:
@@ -200,6 +207,8 @@ Args:
     cuda_aware_mpi: enable CUDA Aware MPI. The MPI library must support that feature, otherwise it may fail.
     no_splash: don't display the splash screen when at the start-up.
     comm_ptr: pointer to communicator. By default MPI_COMM_WORLD will be used
+    log_async: write the log messages from a background thread, see above.
+    log_binary: write the log files in binary format, see above.
         )")
 
         .def("registerParticleVector", &Mirheo::registerParticleVector,
@@ -294,6 +303,108 @@ Args:
                     maximum_part_travel: maximum distance that one particle travels in one time step.
                         this should be as small as possible for performance reasons but large enough for correctness
          )")
+        .def("setIncrementalCellLists", &Mirheo::setIncrementalCellLists,
+             "pv"_a, "incremental"_a=true, R"(
+                Choose how the primary cell-list of a :any:`ParticleVector` is built.
+                With the incremental build, only the particles that changed cell since the previous time step
+                are sorted and merged into the existing order, which is cheaper when the particles move little
+                between two time steps.
+                The resulting order of the particles is deterministic.
+                The current implementation does not support :any:`ObjectVector`.
+
+                Args:
+                    pv: the :any:`ParticleVector`
+                    incremental: use the incremental build if ``True``, rebuild from scratch otherwise
+         )")
+        .def("setInPlaceObjectCellLists", &Mirheo::setInPlaceObjectCellLists,
+             "ov"_a, "inPlace"_a=true, R"(
+                Reorder the local objects of an :any:`ObjectVector` in place instead of copying them into its cell-list.
+                After each redistribution, the objects are sorted by the cell of their center of mass; the particles of an
+                object stay contiguous.
+                The pairwise interactions then read the particles directly from the :any:`ObjectVector` through a list of
+                particle indices sorted by cell, which avoids copying the particle data to the cell-list and the forces back.
+                Can not be used if the particles of the :any:`ObjectVector` are bounced (on walls or objects), split or
+                corrected by a belonging checker, nor with the :any:`createImposeProfile` and :any:`createRdf` plugins.
+
+                Args:
+                    ov: the :any:`ObjectVector`
+                    inPlace: reorder the objects in place if ``True``, use a copy otherwise
+         )")
+        .def("setHaloCompression", &Mirheo::setHaloCompression,
+             "pv"_a, "compressed"_a=true, R"(
+                Choose the format used to send the halo particles of a :any:`ParticleVector` to the neighbouring ranks.
+                With compression, positions are sent as 16-bit offsets inside their cell (error at most h/2^17,
+                where h is the cell size) and velocities in half precision (relative error at most 2^-11).
+                This reduces the size of the halo messages by a quarter.
+                The particle ids and the other channels are sent exactly.
+                The current implementation does not support :any:`ObjectVector`.
+
+                Args:
+                    pv: the :any:`ParticleVector`
+                    compressed: use the compressed format if ``True``
+         )")
+        .def("setFusedIntegration", &Mirheo::setFusedIntegration,
+             "pv"_a, "fused"_a=true, R"(
+                Fuse the integration of a :any:`ParticleVector` with the build of its cell-list.
+                The particles are counted into cells and their forces are cleared while they are integrated,
+                which saves full passes over the particles at every time step.
+                The cell-lists and the particles are the same as without fusion once the cell-lists are built,
+                but the forces are already cleared when the plugins run after the integration.
+
+                Requires an integrator that supports it (currently only ``VelocityVerlet`` and its variants)
+                and particles that are not modified after the integration: the :any:`ParticleVector` must not
+                bounce on walls or objects, nor be corrected by an object belonging checker,
+                nor be modified by a plugin before the cell-lists are built (e.g. outlets, inlets or imposed profiles).
+                The current implementation does not support :any:`ObjectVector` nor incremental cell-lists.
+
+                Args:
+                    pv: the :any:`ParticleVector`
+                    fused: fuse the integration with the cell-list build if ``True``
+         )")
+        .def("setMultipleTimeStepping", &Mirheo::setMultipleTimeStepping,
+             "substeps"_a, R"(
+                Define the time-scale levels used for multiple time stepping (RESPA).
+                Level 0 is the simulation time step; one time step of level k is split into ``substeps[k]``
+                time steps of level k+1.
+                See :any:`setInteractionLevel`.
+
+                Args:
+                    substeps: number of sub steps of each level relative to the previous one
+         )")
+        .def("setInteractionLevel", &Mirheo::setInteractionLevel,
+             "interaction"_a, "level"_a, R"(
+                Set the time-scale level of an :any:`Interaction` (0 by default).
+                The local part of an interaction of level k > 0 is evaluated at every time step of level k,
+                with the forces of the lower levels frozen, and the :any:`ParticleVector` it acts on are integrated
+                with that time step.
+                The other :any:`ParticleVector`, e.g. the solvent, are integrated with the simulation time step.
+                This allows a larger simulation time step when only a few stiff interactions limit it,
+                e.g. membrane, rod or binding forces.
+
+                The part of the interaction between particles of different ranks (halo) is evaluated at the
+                simulation time step.
+                Pairwise interactions can not have a level > 0, as they require cell-lists.
+
+                Args:
+                    interaction: the :any:`Interaction`, registered with :any:`setInteraction`
+                    level: the time-scale level, see :any:`setMultipleTimeStepping`
+         )")
+        .def("setOldPositionsStorage", &Mirheo::setOldPositionsStorage,
+             "pv"_a, "storage"_a, R"(
+                Choose how the positions of the previous time step of a :any:`ParticleVector` are stored.
+                They are needed by the bouncers and some plugins.
+
+                - ``full``: positions with the precision of the simulation (default)
+                - ``half_delta``: displacement since the previous step in half precision.
+                  This takes 8 bytes per particle instead of 16 (32 in double precision);
+                  the error is at most 2^-11 times the displacement of the particle.
+
+                The current implementation does not support :any:`ObjectVector`.
+
+                Args:
+                    pv: the :any:`ParticleVector`
+                    storage: ``full`` or ``half_delta``
+         )")
         .def("getState",       &Mirheo::getMirState,    "Return mirheo state")
 
         .def("dumpWalls2XDMF",    &Mirheo::dumpWalls2XDMF,
@@ -434,6 +545,17 @@ Args:
 
             Args:
                 path: Target folder.
+        )")
+        .def("setSnapshotFormat", &Mirheo::setSnapshotFormat,
+            "format"_a, R"(
+            Set the format of the snapshot metadata file.
+            The binary format stores the config in ``config.bin``; it is much smaller and faster to save and load than JSON
+            for setups with many objects or large meshes, as arrays of numbers are stored as raw blobs.
+            ``config.json`` stays human-readable and is the default.
+            :py:meth:`_mirheo.Mirheo` detects the format automatically when loading a snapshot.
+
+            Args:
+                format: either "json" or "binary"
         )");
 }
 
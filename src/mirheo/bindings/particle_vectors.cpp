@@ -10,6 +10,7 @@
 #include <mirheo/core/pvs/rigid_object_vector.h>
 #include <mirheo/core/pvs/rod_vector.h>
 #include <mirheo/core/pvs/factory.h>
+#include <mirheo/core/utils/cuda_common.h>
 
 #include <pybind11/stl.h>
 
@@ -19,6 +20,109 @@ namespace mirheo
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+namespace
+{
+
+/** Describes how one element of a channel is seen from python:
+    a fixed number of scalar components, possibly followed by padding.
+ */
+template <typename T> struct ChannelLayout;
+
+#define MIRHEO_CHANNEL_LAYOUT(Type, ScalarType, N)      \
+    template <> struct ChannelLayout<Type>              \
+    {                                                   \
+        using Scalar = ScalarType;                      \
+        static constexpr int numComponents = N;         \
+    }
+
+MIRHEO_CHANNEL_LAYOUT(int,          int,       1);
+MIRHEO_CHANNEL_LAYOUT(int64_t,      int64_t,   1);
+MIRHEO_CHANNEL_LAYOUT(float,        float,     1);
+MIRHEO_CHANNEL_LAYOUT(float2,       float,     2);
+MIRHEO_CHANNEL_LAYOUT(float3,       float,     3);
+MIRHEO_CHANNEL_LAYOUT(float4,       float,     3);  // the 4th lane holds the particle id or flags
+MIRHEO_CHANNEL_LAYOUT(double,       double,    1);
+MIRHEO_CHANNEL_LAYOUT(double2,      double,    2);
+MIRHEO_CHANNEL_LAYOUT(double3,      double,    3);
+MIRHEO_CHANNEL_LAYOUT(double4,      double,    3);  // the 4th lane holds the particle id or flags
+MIRHEO_CHANNEL_LAYOUT(Stress,       real,      6);
+MIRHEO_CHANNEL_LAYOUT(RigidMotion,  RigidReal, 19); // r, q, vel, omega, force, torque
+MIRHEO_CHANNEL_LAYOUT(COMandExtent, real,      9);  // com, low, high
+MIRHEO_CHANNEL_LAYOUT(Force,        real,      3);  // the integer part is not exposed
+
+#undef MIRHEO_CHANNEL_LAYOUT
+
+/** A view over the host memory of one channel of a DataManager.
+    Exposed to python through the buffer protocol, so that numpy arrays can be created
+    without copying the data.
+    The host and device copies are synchronized only through download() and upload().
+ */
+class ChannelView
+{
+public:
+    explicit ChannelView(const DataManager::ChannelDescription *desc) :
+        desc_(desc)
+    {}
+
+    void download()
+    {
+        mpark::visit([](auto pinnedBuffer)
+        {
+            pinnedBuffer->downloadFromDevice(defaultStream, ContainersSynch::Synch);
+        }, desc_->varDataPtr);
+    }
+
+    void upload()
+    {
+        mpark::visit([](auto pinnedBuffer)
+        {
+            pinnedBuffer->uploadToDevice(defaultStream);
+        }, desc_->varDataPtr);
+    }
+
+    size_t size() const
+    {
+        return desc_->container->size();
+    }
+
+    py::buffer_info getBufferInfo() const
+    {
+        return mpark::visit([](auto pinnedBuffer)
+        {
+            using T      = typename std::remove_pointer<decltype(pinnedBuffer)>::type::value_type;
+            using Scalar = typename ChannelLayout<T>::Scalar;
+            constexpr int numComponents = ChannelLayout<T>::numComponents;
+            static_assert(numComponents * sizeof(Scalar) <= sizeof(T), "wrong channel layout");
+
+            const auto n = static_cast<py::ssize_t>(pinnedBuffer->size());
+            constexpr auto elementStride = static_cast<py::ssize_t>(sizeof(T));
+            constexpr auto scalarStride  = static_cast<py::ssize_t>(sizeof(Scalar));
+
+            if (numComponents == 1)
+                return py::buffer_info(pinnedBuffer->hostPtr(), scalarStride,
+                                       py::format_descriptor<Scalar>::format(),
+                                       1, {n}, {elementStride});
+
+            return py::buffer_info(pinnedBuffer->hostPtr(), scalarStride,
+                                   py::format_descriptor<Scalar>::format(),
+                                   2, {n, static_cast<py::ssize_t>(numComponents)},
+                                   {elementStride, scalarStride});
+        }, desc_->varDataPtr);
+    }
+
+private:
+    const DataManager::ChannelDescription *desc_;
+};
+
+ChannelView getChannelView(DataManager& manager, const std::string& name)
+{
+    if (!manager.checkChannelExists(name))
+        throw std::invalid_argument("No channel named '" + name + "'");
+    return ChannelView(&manager.getChannelDescOrDie(name));
+}
+
+} // anonymous namespace
+
 void exportParticleVectors(py::module& m)
 {
     m.def("getReservedParticleChannels", []() {return channel_names::reservedParticleFields;},
@@ -30,6 +134,23 @@ void exportParticleVectors(py::module& m)
     m.def("getReservedBisegmentChannels", []() {return channel_names::reservedBisegmentFields;},
           "Return the list of reserved channel names per bisegment fields");
 
+    py::class_<ChannelView>(m, "ChannelView", py::buffer_protocol(), R"(
+        View over the host memory of a data channel (e.g. positions, velocities or any extra channel).
+        Supports the python buffer protocol: :code:`numpy.asarray(view)` gives a numpy array that shares the memory of the channel.
+        Vector types appear as 2D arrays with one row per element; padding and integer parts of the elements, such as the particle ids stored in the 4th lane of positions and velocities, are hidden through strides.
+
+        The host memory is not synchronized automatically with the device: call :code:`download` before reading
+        and :code:`upload` after modifying the data.
+
+        .. warning::
+            Particles are stored in local coordinates, and the channels are reordered and resized during a simulation step.
+            The numpy arrays obtained from a view are valid only until the next call to :code:`run`.
+    )")
+        .def_buffer(&ChannelView::getBufferInfo)
+        .def("download", &ChannelView::download, "Copy the device data to the host memory of the view.")
+        .def("upload",   &ChannelView::upload,   "Copy the host memory of the view to the device.")
+        .def("__len__",  &ChannelView::size);
+
     py::handlers_class<ParticleVector> pypv(m, "ParticleVector", R"(
         Basic particle vector, consists of identical disconnected particles.
     )");
@@ -69,6 +190,17 @@ void exportParticleVectors(py::module& m)
         .def("setForces",      &ParticleVector::setForces_vector, "forces"_a, R"(
             Args:
                 forces: A list of :math:`N \times 3` reals: 3 components of force for every of the N particles
+        )")
+        //
+        .def("getParticleChannel", [](ParticleVector *pv, const std::string& name)
+        {
+            return getChannelView(pv->local()->dataPerParticle, name);
+        }, "name"_a, py::keep_alive<0, 1>(), R"(
+            Args:
+                name: name of the channel, e.g. "positions" or "velocities"
+
+            Returns:
+                A :any:`ChannelView` over the local particle data of the given channel
         )");
 
     py::handlers_class<Mesh> pymesh(m, "Mesh", R"(
@@ -76,10 +208,11 @@ void exportParticleVectors(py::module& m)
     )");
 
     pymesh.def(py::init<const std::string&>(), "off_filename"_a, R"(
-        Create a mesh by reading the OFF file
+        Create a mesh by reading the OFF (ASCII or binary) or PLY file.
+        Meshes with the same connectivity share their topology data.
 
         Args:
-            off_filename: path of the OFF file
+            off_filename: path of the OFF or PLY file (the format is chosen from the extension)
     )")
         .def(py::init<const std::vector<real3>&, const std::vector<int3>&>(),
              "vertices"_a, "faces"_a, R"(
@@ -101,21 +234,22 @@ void exportParticleVectors(py::module& m)
         Internally used class for desctibing a triangular mesh that can be used with the Membrane Interactions.
         In contrast with the simple :any:`Mesh`, this class precomputes some required quantities on the mesh,
         including connectivity structures and stress-free quantities.
+        These are computed once and shared by all meshes with the same connectivity and stress-free shape.
     )")
         .def(py::init<const std::string&>(), "off_filename"_a, R"(
-            Create a mesh by reading the OFF file.
+            Create a mesh by reading the OFF (ASCII or binary) or PLY file.
             The stress free shape is the input initial mesh
 
             Args:
-                off_filename: path of the OFF file
+                off_filename: path of the OFF or PLY file
         )")
         .def(py::init<const std::string&, const std::string&>(),
              "off_initial_mesh"_a, "off_stress_free_mesh"_a, R"(
-            Create a mesh by reading the OFF file, with a different stress free shape.
+            Create a mesh by reading the OFF or PLY file, with a different stress free shape.
 
             Args:
-                off_initial_mesh: path of the OFF file : initial mesh
-                off_stress_free_mesh: path of the OFF file : stress-free mesh)
+                off_initial_mesh: path of the OFF or PLY file : initial mesh
+                off_stress_free_mesh: path of the OFF or PLY file : stress-free mesh)
         )")
         .def(py::init<const std::vector<real3>&, const std::vector<int3>&>(),
              "vertices"_a, "faces"_a, R"(
@@ -145,6 +279,17 @@ void exportParticleVectors(py::module& m)
 
     )");
 
+    pyov.def("getObjectChannel", [](ObjectVector *ov, const std::string& name)
+    {
+        return getChannelView(ov->local()->dataPerObject, name);
+    }, "name"_a, py::keep_alive<0, 1>(), R"(
+            Args:
+                name: name of the channel, e.g. "motions" or "com_extents"
+
+            Returns:
+                A :any:`ChannelView` over the local object data of the given channel
+        )");
+
     py::handlers_class<MembraneVector> (m, "MembraneVector", pyov, R"(
         Membrane is an Object Vector representing cell membranes.
         It must have a triangular mesh associated with it such that each particle is mapped directly onto single mesh vertex.
@@ -255,6 +400,16 @@ void exportParticleVectors(py::module& m)
     py::handlers_class<RodVector> (m, "RodVector", pyov, R"(
         Rod Vector is an :any:`ObjectVector` which reprents rod geometries.
     )")
+        .def("getBisegmentChannel", [](RodVector *rv, const std::string& name)
+        {
+            return getChannelView(rv->local()->dataPerBisegment, name);
+        }, "name"_a, py::keep_alive<0, 1>(), R"(
+            Args:
+                name: name of the channel
+
+            Returns:
+                A :any:`ChannelView` over the local bisegment data of the given channel
+        )")
         .def(py::init<const MirState*, std::string, real, int>(),
              "state"_a, "name"_a, "mass"_a, "num_segments"_a, R"(
 
@@ -7,6 +7,7 @@
 
 #include "bindings.h"
 #include "class_wrapper.h"
+#include "position_function.h"
 
 namespace mirheo
 {
@@ -24,6 +25,34 @@ void exportPlugins(py::module& m)
     )");
 
 
+    m.def("__createAdaptiveTimeStep", &plugin_factory::createAdaptiveTimeStepPlugin,
+          "compute_task"_a, "state"_a, "name"_a, "pvs"_a, "check_every"_a,
+          "dt_min"_a, "dt_max"_a, "max_displacement"_a, "hysteresis"_a=0.2, R"(
+        Adapt the time step of the simulation to the fastest particles.
+
+        Every ``check_every`` time steps, the largest velocity and acceleration norms :math:`v` and :math:`a` of the
+        particles of the given particle vectors are computed over all ranks.
+        The largest time step for which no particle travels further than :math:`d` is
+
+        .. math::
+
+            \Delta t_{lim} = \frac{2 d}{v + \sqrt{v^2 + 2 a d}}.
+
+        The time step is decreased to :math:`\Delta t_{lim}` immediately, but is only increased by a factor :math:`1 + h`
+        when :math:`\Delta t_{lim} > (1 + h)^2 \Delta t`, to avoid oscillations.
+        The result is clamped to :math:`[\Delta t_{min}, \Delta t_{max}]`.
+        The new time step is applied at the beginning of the next time step.
+
+        Args:
+            name: name of the plugin
+            pvs: list of :any:`ParticleVector` objects that limit the time step
+            check_every: update the time step every this amount of time steps
+            dt_min: smallest allowed time step :math:`\Delta t_{min}`
+            dt_max: largest allowed time step :math:`\Delta t_{max}`
+            max_displacement: largest distance :math:`d` travelled by a particle in one time step. It is reduced to the ``maximum_part_travel`` of the walls that bounce the particles, if smaller.
+            hysteresis: relative margin :math:`h > 0` before increasing the time step
+    )");
+
     m.def("__createAddForce", &plugin_factory::createAddForcePlugin,
           "compute_task"_a, "state"_a, "name"_a, "pv"_a, "force"_a, R"(
         This plugin will add constant force :math:`\mathbf{F}_{extra}` to each particle of a specific PV every time-step.
@@ -99,7 +128,8 @@ void exportPlugins(py::module& m)
             pvs: list of :any:`ParticleVector` that we'll work with
             target_density: target number density (used only at boundaries of level sets)
             region: a scalar field which describes how to subdivide the domain.
-                    It must be continuous and differentiable, as the forces are in the gradient direction of this field
+                    It must be continuous and differentiable, as the forces are in the gradient direction of this field.
+                    May be decorated with :any:`mirheo.tools.vectorized` to be evaluated on whole grid planes at once.
             resolution: grid resolution to represent the region field
             level_lo: lower level set to apply the controller on
             level_hi: highest level set to apply the controller on
@@ -119,7 +149,8 @@ void exportPlugins(py::module& m)
             name: name of the plugin
             pvs: list of :any:`ParticleVector` that we'll work with
             number_density: maximum number_density in the region
-            region: a function that is negative in the concerned region and positive outside
+            region: a function that is negative in the concerned region and positive outside.
+                    May be decorated with :any:`mirheo.tools.vectorized` to be evaluated on whole grid planes at once.
             resolution: grid resolution to represent the region field
 
     )");
@@ -143,7 +174,8 @@ void exportPlugins(py::module& m)
             name: name of the plugin
             pvs: list of :any:`ParticleVector` that we'll work with
             mass_rate: total outlet mass rate in the region
-            region: a function that is negative in the concerned region and positive outside
+            region: a function that is negative in the concerned region and positive outside.
+                    May be decorated with :any:`mirheo.tools.vectorized` to be evaluated on whole grid planes at once.
             resolution: grid resolution to represent the region field
 
     )");
@@ -257,6 +289,45 @@ void exportPlugins(py::module& m)
             path: Path and filename prefix for the dumps. For every dump two files will be created: <path>_NNNNN.xmf and <path>_NNNNN.h5
     )");
 
+    m.def("__createDumpParticlesAggregated", &plugin_factory::createDumpParticlesAggregatedPlugin,
+          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "dump_every"_a,
+          "channel_names"_a, "path"_a, "ranks_per_aggregator"_a, "subfiling"_a = false,
+          "io_hints"_a = std::map<std::string, std::string>(), R"(
+        Same as :any:`createDumpParticles`, but only a subset of the postprocess ranks, the aggregators, access the file system.
+        Each aggregator gathers the data of a group of consecutive postprocess ranks before writing it.
+        This reduces the number of ranks that take part in the collective MPI-IO operations, which helps with large numbers of ranks.
+
+        Args:
+            name: name of the plugin
+            pv: :any:`ParticleVector` that we'll work with
+            dump_every: write files every this many time-steps
+            channel_names: list of channel names to be dumped.
+            path: Path and filename prefix for the dumps. For every dump two files will be created: <path>_NNNNN.xmf and <path>_NNNNN.h5
+            ranks_per_aggregator: number of postprocess ranks in each group, including the aggregator
+            subfiling: if True, each aggregator writes its own <path>_NNNNN_subMMMMM.xmf and <path>_NNNNN_subMMMMM.h5 files,
+                and <path>_NNNNN.xmf references all of them. Otherwise, the aggregators write to a single shared file.
+            io_hints: MPI-IO hints passed to the hdf5 files, e.g. ``{"cb_nodes": "16", "striping_factor": "16"}``.
+                If empty, the default hints are used, unless the MPICH_MPIIO_HINTS environment variable is set.
+    )");
+
+    m.def("__createDumpParticlesTrajectory", &plugin_factory::createDumpParticlesTrajectoryPlugin,
+          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "dump_every"_a,
+          "channel_names"_a, "path"_a, "chunk_size"_a = 4096, "sort_by_id"_a = true, R"(
+        Same as :any:`createDumpParticles`, but all the dumps are appended to a single trajectory file <path>.traj.
+        The file contains an index of the frames, which allows to access any frame directly, see :any:`TrajectoryReader`.
+        The particles of each frame are stored in chunks; when they are sorted by id, a range of ids can be read without reading the whole frame.
+        The data is gathered and written by the first postprocess rank.
+
+        Args:
+            name: name of the plugin
+            pv: :any:`ParticleVector` that we'll work with
+            dump_every: write a frame every this many time-steps
+            channel_names: list of channel names to be dumped.
+            path: Path and filename prefix of the trajectory file. An existing file is overwritten, unless the plugin is loaded from a snapshot.
+            chunk_size: maximum number of particles in each chunk of a frame
+            sort_by_id: if True, the particles of each frame are sorted by global id
+    )");
+
     m.def("__createDumpParticlesWithMesh", &plugin_factory::createDumpParticlesWithMeshPlugin,
           "compute_task"_a, "state"_a, "name"_a, "ov"_a, "dump_every"_a,
           "channel_names"_a, "path"_a, R"(
@@ -298,6 +369,40 @@ void exportPlugins(py::module& m)
             plane: 4 coefficients for the plane equation ax + by + cz + d >= 0
     )");
 
+    m.def("__createFieldExtraction", &plugin_factory::createFieldExtractionPlugin,
+          "compute_task"_a, "state"_a, "name"_a, "pvs"_a, "sample_every"_a, "dump_every"_a,
+          "bin_size"_a = real3{1.0, 1.0, 1.0}, "channels"_a = std::vector<std::string>(),
+          "slices"_a = std::vector<std::pair<std::string, real>>(),
+          "probes"_a = std::vector<real3>(),
+          "isosurfaces"_a = std::vector<std::pair<std::string, real>>(),
+          "path"_a = "fields/", R"(
+        This plugin samples and time-averages particle quantities on a grid, as :any:`createDumpAverage`,
+        but only dumps data extracted from that grid instead of the full 3D fields:
+
+            * slices: the fields on planes normal to one of the axes, one csv file per dump;
+            * probes: the fields at given positions, all appended to a single csv file;
+            * isosurfaces: the surfaces on which a scalar field takes a given value, computed with marching cubes, one ply file per dump.
+
+        The fields are interpolated trilinearly between the bin centers.
+        The number density is always sampled and is named "number_densities"; it can be used for slices, probes and isosurfaces.
+        The isosurfaces are computed independently on each subdomain.
+
+        .. note::
+            This plugin is inactive if postprocess is disabled
+
+        Args:
+            name: name of the plugin
+            pvs: list of :any:`ParticleVector` that we'll work with
+            sample_every: sample quantities every this many time-steps
+            dump_every: extract and write the data every this many time-steps
+            bin_size: bin size for sampling. The resulting quantities will be *cell-centered*
+            channels: list of channel names. See :ref:`user-pv-reserved`.
+            slices: list of (axis, position) pairs, where axis is one of "x", "y" or "z" and position is the global coordinate of the plane along that axis
+            probes: list of positions, in global coordinates
+            isosurfaces: list of (channel, value) pairs; the channel must be "number_densities" or one of the scalar channels in **channels**
+            path: the files will look like this: <path>/probes.csv, <path>/slice<i>_NNNNN.csv and <path>/<channel>_<i>_NNNNN.ply
+    )");
+
     m.def("__createForceSaver", &plugin_factory::createForceSaverPlugin,
           "compute_task"_a, "state"_a, "name"_a, "pv"_a, R"(
         This plugin creates an extra channel per particle inside the given particle vector named 'forces'.
@@ -381,6 +486,34 @@ void exportPlugins(py::module& m)
             path: The folder name in which the file will be dumped.
     )");
 
+    m.def("__createMultiTauCorrelator", &plugin_factory::createMultiTauCorrelatorPlugin,
+          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "channel_name"_a, "correlation"_a, "start_time"_a,
+          "sample_every"_a, "dump_every"_a, "num_levels"_a=16, "block_size"_a=16, "path"_a="correlations/", R"(
+        This plugin computes time correlation functions of a per-particle vector channel with a multiple-tau correlator.
+        Every sample is used as a time origin and the lags are spaced quasi-logarithmically, up to
+        block_size * 2^(num_levels-1) samples, with num_levels * (block_size + 1) values stored per particle.
+        The history of each particle is stored in channels, so that it follows the particle across ranks.
+
+        With ``correlation="squared_difference"`` and the positions channel, the plugin computes the mean square displacement
+        (the positions are unwrapped across the periodic boundaries).
+        With ``correlation="dot"`` and the velocities channel, it computes the (non normalized) velocity autocorrelation function.
+
+        The correlation function is averaged over the particles and the time origins and rewritten to ``<path>/<pv name>_<channel_name>.csv``
+        every dump_every steps.
+
+        Args:
+            name: Name of the plugin.
+            pv: Concerned :class:`ParticleVector`.
+            channel_name: Name of the channel to correlate; must contain real3 or real4 (the first three components are used).
+            correlation: Either "squared_difference" or "dot".
+            start_time: Simulation time of the first sample.
+            sample_every: Sample the channel every this many time-steps.
+            dump_every: Report the correlation function every this many time-steps. Must be a multiple of sample_every.
+            num_levels: Number of blocks of the correlator.
+            block_size: Number of values per block; must be a multiple of 2.
+            path: The folder name in which the file will be dumped.
+    )");
+
     m.def("__createParticleChannelAverager", &plugin_factory::createParticleChannelAveragerPlugin,
           "compute_task"_a, "state"_a, "name"_a, "pv"_a, "channelName"_a, "averageName"_a, "updateEvery"_a, R"(
         This plugin averages a channel (per particle data) inside the given particle vector and saves it to a new channel.
@@ -575,6 +708,8 @@ void exportPlugins(py::module& m)
             resolution: grid size used to discretize the surface
             number_density: number density of the inserted solvent
             kBT: temperature of the inserted solvent
+
+        Both functions may be decorated with :any:`mirheo.tools.vectorized` to be evaluated on many positions at once.
     )");
 
     m.def("__createVirialPressurePlugin", &plugin_factory::createVirialPressurePlugin,
@@ -587,7 +722,8 @@ void exportPlugins(py::module& m)
         Args:
             name: name of the plugin
             pv: concerned :class:`ParticleVector`
-            regionFunc: predicate for the concerned region; positive inside the region and negative outside
+            regionFunc: predicate for the concerned region; positive inside the region and negative outside.
+                        May be decorated with :any:`mirheo.tools.vectorized` to be evaluated on whole grid planes at once.
             h: grid size for representing the predicate onto a grid
             dump_every: report total pressure every this many time-steps
             path: the folder name in which the file will be dumped
@@ -0,0 +1,122 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/utils/position_function.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+
+#include <cstring>
+#include <memory>
+
+// Provide cast from python callables to `mirheo::PositionFunction`.
+// Plain callables are wrapped as point-wise functions through the std::function caster.
+// Callables marked with `mirheo.tools.vectorized` receive all positions at once as a (n, 3) numpy array
+// and must return an array with one value (or one row of 3 values for real3 functions) per position.
+
+namespace pybind11 {
+namespace detail {
+
+template <typename T>
+struct position_function_value
+{
+    using Scalar = T;
+    static constexpr int size = 1;
+    static T unpack(const Scalar *src) { return src[0]; }
+};
+
+template <>
+struct position_function_value<mirheo::real3>
+{
+    using Scalar = mirheo::real;
+    static constexpr int size = 3;
+    static mirheo::real3 unpack(const Scalar *src) { return {src[0], src[1], src[2]}; }
+};
+
+template <typename T>
+struct type_caster<mirheo::PositionFunction<T>>
+{
+    using Type = mirheo::PositionFunction<T>;
+    using PointFunction = typename Type::PointFunction;
+    using BatchFunction = typename Type::BatchFunction;
+    using Value = position_function_value<T>;
+    using Scalar = typename Value::Scalar;
+
+    PYBIND11_TYPE_CASTER(Type, _("Callable[[real3], ") + make_caster<T>::name + _("]"));
+
+    bool load(handle src, bool convert)
+    {
+        if (src.is_none())
+        {
+            // allow None only during the conversion pass, as the std::function caster does
+            if (!convert)
+                return false;
+            value = Type();
+            return true;
+        }
+
+        if (!isinstance<function>(src) && !hasattr(src, "__call__"))
+            return false;
+
+        if (isVectorized(src))
+        {
+            value = makeBatchFunction(reinterpret_borrow<object>(src));
+            return true;
+        }
+
+        make_caster<PointFunction> pointCaster;
+        if (!pointCaster.load(src, convert))
+            return false;
+
+        value = Type(cast_op<PointFunction>(std::move(pointCaster)));
+        return true;
+    }
+
+    static handle cast(const Type& /*src*/, return_value_policy /*policy*/, handle /*parent*/)
+    {
+        return none().inc_ref();
+    }
+
+private:
+    static bool isVectorized(handle src)
+    {
+        if (!hasattr(src, "mirheo_vectorized"))
+            return false;
+        return src.attr("mirheo_vectorized").template cast<bool>();
+    }
+
+    static Type makeBatchFunction(object func)
+    {
+        // the python object must be released with the GIL held, wherever the last copy dies
+        std::shared_ptr<object> pyfunc(new object(std::move(func)), [](object *ptr)
+        {
+            gil_scoped_acquire acq;
+            delete ptr;
+        });
+
+        return Type(BatchFunction([pyfunc](const mirheo::real3 *positions, int n, T *values)
+        {
+            gil_scoped_acquire acq;
+
+            array_t<mirheo::real> pyPositions({static_cast<ssize_t>(n), static_cast<ssize_t>(3)});
+            std::memcpy(pyPositions.mutable_data(), positions, n * sizeof(mirheo::real3));
+
+            object result = (*pyfunc)(pyPositions);
+            auto arr = array_t<Scalar, array::c_style | array::forcecast>::ensure(result);
+
+            if (!arr)
+                throw type_error("vectorized position function must return an array");
+
+            if (arr.size() != static_cast<ssize_t>(n) * Value::size)
+                throw value_error("vectorized position function returned " + std::to_string(arr.size()) +
+                                  " values, expected " + std::to_string(n * Value::size));
+
+            const Scalar *src = arr.data();
+            for (int i = 0; i < n; ++i)
+                values[i] = Value::unpack(src + i * Value::size);
+        }));
+    }
+};
+
+}} // namespace pybind11::detail
@@ -1,11 +1,14 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "bindings.h"
 
+#include <mirheo/core/trajectory/reader.h>
 #include <mirheo/core/utils/compile_options.h>
 
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include <string>
+#include <vector>
 
 namespace mirheo
 {
@@ -37,6 +40,55 @@ static std::map<std::string, std::string> getAllCompileOptions()
     return dict;
 }
 
+static py::dtype getDtype(XDMF::Channel::NumberType numberType)
+{
+    switch (numberType)
+    {
+    case XDMF::Channel::NumberType::Float:  return py::dtype::of<float>();
+    case XDMF::Channel::NumberType::Double: return py::dtype::of<double>();
+    case XDMF::Channel::NumberType::Int:    return py::dtype::of<int>();
+    case XDMF::Channel::NumberType::Int64:  return py::dtype::of<int64_t>();
+    }
+    return py::dtype::of<float>();
+}
+
+/// Copy the data of a frame into a dictionary of numpy arrays, one per channel plus the positions.
+static py::dict frameToDict(const XDMF::VertexChannelsData& frame)
+{
+    py::dict dict;
+    const auto n = static_cast<py::ssize_t>(frame.positions.size());
+
+    py::array_t<real> positions({n, static_cast<py::ssize_t>(3)});
+    auto pos = positions.mutable_unchecked<2>();
+    for (py::ssize_t i = 0; i < n; ++i)
+    {
+        pos(i, 0) = frame.positions[i].x;
+        pos(i, 1) = frame.positions[i].y;
+        pos(i, 2) = frame.positions[i].z;
+    }
+    dict["positions"] = positions;
+
+    for (size_t c = 0; c < frame.descriptions.size(); ++c)
+    {
+        const auto& desc = frame.descriptions[c];
+        const auto nComponents = static_cast<py::ssize_t>(desc.nComponents());
+
+        std::vector<py::ssize_t> shape {n};
+        if (nComponents > 1)
+            shape.push_back(nComponents);
+
+        dict[desc.name.c_str()] = py::array(getDtype(desc.numberType), shape, frame.data[c].data());
+    }
+
+    return dict;
+}
+
+static void checkFrameId(const trajectory::Reader& reader, int frameId)
+{
+    if (frameId < 0 || frameId >= reader.getNumFrames())
+        throw py::index_error("Frame " + std::to_string(frameId) + " out of range");
+}
+
 void exportUtils(py::module& m)
 {
     m.def("get_compile_option", getCompileOption, "key"_a, R"(
@@ -50,6 +102,62 @@ void exportUtils(py::module& m)
     m.def("get_all_compile_options", getAllCompileOptions, R"(
     Return all compile time options used in the current installation in the form of a dictionary.
     )");
+
+    py::class_<trajectory::Reader>(m, "TrajectoryReader", R"(
+        Random access to the frames of a trajectory file, as written by :any:`createDumpParticlesTrajectory`.
+        Each frame is returned as a dictionary of numpy arrays: "positions" and one entry per channel.
+    )")
+        .def(py::init<const std::string&>(), "filename"_a, R"(
+            Args:
+                filename: name of the trajectory file
+        )")
+        .def("__len__", &trajectory::Reader::getNumFrames)
+        .def("get_num_frames", &trajectory::Reader::getNumFrames, "Return the number of frames in the file.")
+        .def("get_time", [](const trajectory::Reader& reader, int frameId)
+        {
+            checkFrameId(reader, frameId);
+            return reader.getTime(frameId);
+        }, "frame"_a, "Return the simulation time of the given frame.")
+        .def("get_step", [](const trajectory::Reader& reader, int frameId)
+        {
+            checkFrameId(reader, frameId);
+            return reader.getStep(frameId);
+        }, "frame"_a, "Return the step of the given frame.")
+        .def("find_frame", &trajectory::Reader::findFrame, "time"_a, R"(
+            Return the index of the last frame with a time not larger than the given one, or -1 if there is none.
+        )")
+        .def("get_channel_names", [](const trajectory::Reader& reader)
+        {
+            std::vector<std::string> names;
+            for (const auto& channel : reader.getChannels())
+                names.push_back(channel.name);
+            return names;
+        }, "Return the names of the channels stored in each frame.")
+        .def("read_frame", [](trajectory::Reader& reader, int frameId)
+        {
+            checkFrameId(reader, frameId);
+            return frameToDict(reader.readFrame(frameId));
+        }, "frame"_a, R"(
+            Read all the particles of one frame.
+
+            Args:
+                frame: index of the frame
+        )")
+        .def("read_frame", [](trajectory::Reader& reader, int frameId, int64_t idMin, int64_t idMax)
+        {
+            checkFrameId(reader, frameId);
+            if (reader.getIdChannelName().empty())
+                throw std::runtime_error("The trajectory has no id channel");
+            return frameToDict(reader.readFrame(frameId, idMin, idMax));
+        }, "frame"_a, "id_min"_a, "id_max"_a, R"(
+            Read the particles of one frame with an id between id_min and id_max (inclusive).
+            Only the chunks that may contain these ids are read; this is efficient when the frames are sorted by id.
+
+            Args:
+                frame: index of the frame
+                id_min: smallest id to read
+                id_max: largest id to read
+        )");
 }
 
 } // namespace mirheo
@@ -28,7 +28,7 @@ struct Triangle
 
 using TriangleTable = CollisionTable<int2>;
 
-__device__ static inline Triangle readTriangle(const real4 *vertices, int startId, int3 trid)
+__HD__ static inline Triangle readTriangle(const real4 *vertices, int startId, int3 trid)
 {
     auto addr = vertices + startId;
     return {
@@ -39,7 +39,7 @@ __device__ static inline Triangle readTriangle(const real4 *vertices, int startI
 
 
 
-__device__ static inline bool segmentTriangleQuickCheck(Triangle trNew, Triangle trOld, real3 xNew, real3 xOld)
+__HD__ static inline bool segmentTriangleQuickCheck(Triangle trNew, Triangle trOld, real3 xNew, real3 xOld)
 {
     const real3 v0 = trOld.v0;
     const real3 v1 = trOld.v1;
@@ -92,66 +92,149 @@ __device__ static inline bool segmentTriangleQuickCheck(Triangle trNew, Triangle
     return true;
 }
 
-__device__ static inline void findBouncesInCell(int pstart, int pend, int globTrid,
-                                                Triangle tr, Triangle trOld,
-                                                PVviewWithOldParticles pvView,
-                                                MeshView mesh, TriangleTable triangleTable)
+/// About maximum distance a particle can cover in one step
+static constexpr real sweptTolerance = 0.2_r;
+
+/**
+   \brief The range of cells (inclusive) overlapped by a triangle during one time step
+ */
+struct CellRange
 {
+    int3 lo; ///< lowest cell indices
+    int3 hi; ///< highest cell indices
+};
 
-#pragma unroll 2
-    for (int pid = pstart; pid < pend; pid++)
-    {
-        Particle p;
-        pvView.readPosition   (p,    pid);
-        const auto rOld = pvView.readOldPosition(pid);
+/** \brief Compute the cells covered by the bounding box of a triangle swept between its old and new positions.
+    \param [in] tr The triangle at the end of the time step
+    \param [in] trOld The triangle at the start of the time step
+    \param [in] cinfo The cell-lists of the particles
 
-        if (segmentTriangleQuickCheck(tr, trOld, p.r, rOld))
-            triangleTable.push_back({pid, globTrid});
-    }
+    The box is enlarged by sweptTolerance so that it contains all the particles that may cross the triangle.
+ */
+__HD__ static inline CellRange getSweptCellRange(Triangle tr, Triangle trOld, const CellListInfo& cinfo)
+{
+    const real3 lo = fmin_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
+    const real3 hi = fmax_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
+
+    return {cinfo.getCellIdAlongAxes(lo - sweptTolerance),
+            cinfo.getCellIdAlongAxes(hi + sweptTolerance)};
 }
 
-__global__ void findBouncesInMesh(OVviewWithNewOldVertices objView,
-                                  PVviewWithOldParticles pvView,
-                                  MeshView mesh, CellListInfo cinfo,
-                                  TriangleTable triangleTable)
+__device__ static inline CellRange getSweptCellRange(OVviewWithNewOldVertices objView, MeshView mesh,
+                                                     const CellListInfo& cinfo, int globTrid)
 {
-    // About maximum distance a particle can cover in one step
-    constexpr real tol = 0.2_r;
-
-    // One THREAD per triangle
-    const int gid = blockIdx.x * blockDim.x + threadIdx.x;
-    const int objId = gid / mesh.ntriangles;
-    const int trid  = gid % mesh.ntriangles;
-    if (objId >= objView.nObjects) return;
+    const int objId = globTrid / mesh.ntriangles;
+    const int trid  = globTrid % mesh.ntriangles;
 
     const int3 triangle = mesh.triangles[trid];
     const Triangle tr =    readTriangle(objView.vertices    , mesh.nvertices*objId, triangle);
     const Triangle trOld = readTriangle(objView.old_vertices, mesh.nvertices*objId, triangle);
 
-    const real3 lo = fmin_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
-    const real3 hi = fmax_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
+    return getSweptCellRange(tr, trOld, cinfo);
+}
 
-    const int3 cidLow  = cinfo.getCellIdAlongAxes(lo - tol);
-    const int3 cidHigh = cinfo.getCellIdAlongAxes(hi + tol);
+/** \brief Count the triangles overlapping each cell.
+
+    One thread per triangle. The cells which receive their first triangle are
+    registered in \p activeCells.
+ */
+__global__ void countTrianglesPerCell(OVviewWithNewOldVertices objView, MeshView mesh, CellListInfo cinfo,
+                                      int *triCellCounts, CollisionTable<int> activeCells)
+{
+    const int gid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (gid >= objView.nObjects * mesh.ntriangles) return;
+
+    const CellRange range = getSweptCellRange(objView, mesh, cinfo, gid);
 
     int3 cid3;
-#pragma unroll 2
-    for (cid3.z = cidLow.z; cid3.z <= cidHigh.z; cid3.z++)
-        for (cid3.y = cidLow.y; cid3.y <= cidHigh.y; cid3.y++)
+    for (cid3.z = range.lo.z; cid3.z <= range.hi.z; cid3.z++)
+        for (cid3.y = range.lo.y; cid3.y <= range.hi.y; cid3.y++)
+            for (cid3.x = range.lo.x; cid3.x <= range.hi.x; cid3.x++)
             {
-                cid3.x = cidLow.x;
-                const int cidLo = math::max(cinfo.encode(cid3), 0);
+                const int cid = cinfo.encode(cid3);
+                if (atomicAdd(triCellCounts + cid, 1) == 0)
+                    activeCells.push_back(cid);
+            }
+}
 
-                cid3.x = cidHigh.x;
-                const int cidHi = math::min(cinfo.encode(cid3)+1, cinfo.totcells);
+/** \brief Store the (global) triangle ids in the cells that they overlap.
 
-                const int pstart = cinfo.cellStarts[cidLo];
-                const int pend   = cinfo.cellStarts[cidHi];
+    One thread per triangle. \p triCellFill must be zero on entry.
+    Entries beyond \p capacity are dropped; the caller must check the total
+    number of entries (\p triCellStarts [totcells]) and retry with a larger buffer.
+ */
+__global__ void fillTrianglesPerCell(OVviewWithNewOldVertices objView, MeshView mesh, CellListInfo cinfo,
+                                     const int *triCellStarts, int *triCellFill, int capacity, int *triCellIds)
+{
+    const int gid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (gid >= objView.nObjects * mesh.ntriangles) return;
 
-                findBouncesInCell(pstart, pend, gid, tr, trOld, pvView, mesh, triangleTable);
+    const CellRange range = getSweptCellRange(objView, mesh, cinfo, gid);
+
+    int3 cid3;
+    for (cid3.z = range.lo.z; cid3.z <= range.hi.z; cid3.z++)
+        for (cid3.y = range.lo.y; cid3.y <= range.hi.y; cid3.y++)
+            for (cid3.x = range.lo.x; cid3.x <= range.hi.x; cid3.x++)
+            {
+                const int cid = cinfo.encode(cid3);
+                const int i = triCellStarts[cid] + atomicAdd(triCellFill + cid, 1);
+                if (i < capacity)
+                    triCellIds[i] = gid;
             }
 }
 
+/** \brief Pair the particles of each cell with the triangles binned in this cell.
+
+    One warp per active cell (grid-stride loop). Consecutive lanes work on consecutive
+    particles and the same triangle, which keeps the memory accesses coalesced and the
+    warps convergent.
+    Only the first \p capacity entries of \p triCellIds are read, see fillTrianglesPerCell();
+    the collisions are then incomplete and must be discarded by the caller.
+ */
+__global__ void findBouncesInCells(OVviewWithNewOldVertices objView,
+                                   PVviewWithOldParticles pvView,
+                                   MeshView mesh, CellListInfo cinfo,
+                                   const int *nActiveCells, const int *activeCells,
+                                   const int *triCellStarts, int capacity, const int *triCellIds,
+                                   TriangleTable triangleTable)
+{
+    const int warpId = (blockIdx.x * blockDim.x + threadIdx.x) / warpSize;
+    const int nwarps = (gridDim.x * blockDim.x) / warpSize;
+    const int lane = laneId();
+
+    const int nActive = *nActiveCells;
+
+    for (int i = warpId; i < nActive; i += nwarps)
+    {
+        const int cid = activeCells[i];
+
+        const int pstart = cinfo.cellStarts[cid];
+        const int np     = cinfo.cellStarts[cid+1] - pstart;
+        const int tstart = triCellStarts[cid];
+        const int nt     = max(min(triCellStarts[cid+1], capacity) - tstart, 0);
+
+        for (int k = lane; k < np * nt; k += warpSize)
+        {
+            const int pid      = pstart + k % np;
+            const int globTrid = triCellIds[tstart + k / np];
+
+            const int objId = globTrid / mesh.ntriangles;
+            const int trid  = globTrid % mesh.ntriangles;
+
+            const int3 triangle = mesh.triangles[trid];
+            const Triangle tr =    readTriangle(objView.vertices    , mesh.nvertices*objId, triangle);
+            const Triangle trOld = readTriangle(objView.old_vertices, mesh.nvertices*objId, triangle);
+
+            Particle p;
+            pvView.readPosition(p, pid);
+            const auto rOld = pvView.readOldPosition(pid);
+
+            if (segmentTriangleQuickCheck(tr, trOld, p.r, rOld))
+                triangleTable.push_back({pid, globTrid});
+        }
+    }
+}
+
 //=================================================================================================================
 // Filter the collisions better
 //=================================================================================================================
@@ -337,12 +420,12 @@ __global__
 void refineCollisions(OVviewWithNewOldVertices objView,
                       PVviewWithOldParticles pvView,
                       MeshView mesh,
-                      int nCoarseCollisions, int2 *coarseTable,
+                      const int *nCoarseCollisions, const int2 *coarseTable,
                       TriangleTable fineTable,
                       int *collisionTimes)
 {
     const int gid = blockIdx.x * blockDim.x + threadIdx.x;
-    if (gid >= nCoarseCollisions) return;
+    if (gid >= *nCoarseCollisions) return;
 
     const int2 pid_trid = coarseTable[gid];
     const int pid = pid_trid.x;
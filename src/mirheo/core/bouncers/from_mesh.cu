@@ -10,6 +10,12 @@
 #include <mirheo/core/rigid/operations.h>
 #include <mirheo/core/utils/kernel_launch.h>
 
+#include <cub/device/device_radix_sort.cuh>
+#include <cub/device/device_scan.cuh>
+#include <cub/device/device_select.cuh>
+
+#include <algorithm>
+
 namespace mirheo
 {
 
@@ -44,7 +50,7 @@ void BounceFromMesh::setup(ObjectVector *ov)
 void BounceFromMesh::setPrerequisites(ParticleVector *pv)
 {
     // do not set it to persistent because bounce happens after integration
-    pv->requireDataPerParticle<real4> (channel_names::oldPositions, DataManager::PersistenceMode::None, DataManager::ShiftMode::Active);
+    pv->requireOldPositions(DataManager::PersistenceMode::None, DataManager::ShiftMode::Active);
 }
 
 std::vector<std::string> BounceFromMesh::getChannelsToBeExchanged() const
@@ -81,13 +87,11 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
     // In case of crash, the estimate should be increased
     const int maxCoarseCollisions = static_cast<int>(coarseCollisionsPerTri_ * static_cast<real>(totalTriangles));
     coarseTable_.collisionTable.resize_anew(maxCoarseCollisions);
-    coarseTable_.nCollisions.clear(stream);
-    mesh_bounce_kernels::TriangleTable devCoarseTable { maxCoarseCollisions,
-                                                        coarseTable_.nCollisions.devPtr(),
-                                                        coarseTable_.collisionTable.devPtr() };
+    coarseTable_.sortedTable   .resize_anew(maxCoarseCollisions);
 
     const int maxFineCollisions = static_cast<int>(fineCollisionsPerTri_ * static_cast<real>(totalTriangles));
     fineTable_.collisionTable.resize_anew(maxFineCollisions);
+    fineTable_.sortedTable   .resize_anew(maxFineCollisions);
     fineTable_.nCollisions.clear(stream);
     mesh_bounce_kernels::TriangleTable devFineTable { maxFineCollisions,
                                                       fineTable_.nCollisions.devPtr(),
@@ -115,24 +119,22 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
     PVviewWithOldParticles pvView(pv, pv->local());
 
     // Step 1, find all the candidate collisions
-    SAFE_KERNEL_LAUNCH(
-            mesh_bounce_kernels::findBouncesInMesh,
-            getNblocks(totalTriangles, nthreads), nthreads, 0, stream,
-            vertexView, pvView, ov_->mesh.get(), cl->cellInfo(), devCoarseTable );
-
-    coarseTable_.nCollisions.downloadFromDevice(stream);
-    debug("Found %d triangle collision candidates", coarseTable_.nCollisions[0]);
+    _findCoarseCollisions(pv, cl, vertexView, stream);
+    const int nCoarseCollisions = coarseTable_.nCollisions[0];
+    debug("Found %d triangle collision candidates", nCoarseCollisions);
 
-    if (coarseTable_.nCollisions[0] > maxCoarseCollisions)
+    if (nCoarseCollisions > maxCoarseCollisions)
         die("Found too many triangle collision candidates (coarse) (%d, max %d) in bouncer '%s'.",
-            coarseTable_.nCollisions[0], maxCoarseCollisions, getCName());
+            nCoarseCollisions, maxCoarseCollisions, getCName());
+
+    _sortCollisions(coarseTable_, nCoarseCollisions, stream);
 
     // Step 2, filter the candidates
     SAFE_KERNEL_LAUNCH(
             mesh_bounce_kernels::refineCollisions,
-            getNblocks(coarseTable_.nCollisions[0], nthreads), nthreads, 0, stream,
+            getNblocks(nCoarseCollisions, nthreads), nthreads, 0, stream,
             vertexView, pvView, ov_->mesh.get(),
-            coarseTable_.nCollisions[0], devCoarseTable.indices,
+            coarseTable_.nCollisions.devPtr(), coarseTable_.collisionTable.devPtr(),
             devFineTable, collisionTimes_.devPtr() );
 
     fineTable_.nCollisions.downloadFromDevice(stream);
@@ -142,6 +144,9 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
         die("Found too many triangle collisions (precise) (%d, max %d) in bouncer '%s'.",
             fineTable_.nCollisions[0], maxFineCollisions, getCName());
 
+    // the fine table is a subset of the (unique) coarse table: sorting keeps its size
+    _sortCollisions(fineTable_, fineTable_.nCollisions[0], stream);
+
     // Step 3, resolve the collisions
     mpark::visit([&](auto& bounceKernel)
     {
@@ -169,4 +174,120 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
     }
 }
 
+void BounceFromMesh::_binTriangles(const OVviewWithNewOldVertices& vertexView, CellList *cl, cudaStream_t stream)
+{
+    const int nthreads = 128;
+    const int totalTriangles = ov_->mesh->getNtriangles() * vertexView.nObjects;
+    const int totcells = cl->totcells;
+
+    triCellCounts_.resize_anew(totcells + 1);
+    triCellStarts_.resize_anew(totcells + 1);
+    triCellCounts_.clear(stream);
+
+    activeCells_.collisionTable.resize_anew(totcells);
+    activeCells_.nCollisions.clear(stream);
+    CollisionTable<int> devActiveCells { totcells,
+                                         activeCells_.nCollisions.devPtr(),
+                                         activeCells_.collisionTable.devPtr() };
+
+    SAFE_KERNEL_LAUNCH(
+            mesh_bounce_kernels::countTrianglesPerCell,
+            getNblocks(totalTriangles, nthreads), nthreads, 0, stream,
+            vertexView, ov_->mesh.get(), cl->cellInfo(), triCellCounts_.devPtr(), devActiveCells );
+
+    size_t workSize = workBuffer_.size();
+    size_t requiredSize = 0;
+    cub::DeviceScan::ExclusiveSum(nullptr, requiredSize, triCellCounts_.devPtr(), triCellStarts_.devPtr(), totcells + 1, stream);
+    if (requiredSize > workSize)
+    {
+        workSize = requiredSize;
+        workBuffer_.resize_anew(workSize);
+    }
+    cub::DeviceScan::ExclusiveSum(workBuffer_.devPtr(), workSize, triCellCounts_.devPtr(), triCellStarts_.devPtr(), totcells + 1, stream);
+
+    CUDA_Check( cudaMemcpyAsync(nBinned_.hostPtr(), triCellStarts_.devPtr() + totcells, sizeof(int),
+                                cudaMemcpyDeviceToHost, stream) );
+
+    // counts are not needed anymore: reuse them as fill counters
+    triCellCounts_.clear(stream);
+
+    SAFE_KERNEL_LAUNCH(
+            mesh_bounce_kernels::fillTrianglesPerCell,
+            getNblocks(totalTriangles, nthreads), nthreads, 0, stream,
+            vertexView, ov_->mesh.get(), cl->cellInfo(),
+            triCellStarts_.devPtr(), triCellCounts_.devPtr(),
+            static_cast<int>(triCellIds_.size()), triCellIds_.devPtr() );
+}
+
+void BounceFromMesh::_findCoarseCollisions(ParticleVector *pv, CellList *cl, const OVviewWithNewOldVertices& vertexView, cudaStream_t stream)
+{
+    constexpr int nthreads = 128;
+    constexpr int warpSize = 32;
+    constexpr int maxBlocks = 1024;
+
+    const int totalTriangles = ov_->mesh->getNtriangles() * vertexView.nObjects;
+    PVviewWithOldParticles pvView(pv, pv->local());
+
+    mesh_bounce_kernels::TriangleTable devCoarseTable { static_cast<int>(coarseTable_.collisionTable.size()),
+                                                        coarseTable_.nCollisions.devPtr(),
+                                                        coarseTable_.collisionTable.devPtr() };
+
+    const int estimatedBinned = static_cast<int>(cellsPerTri_ * static_cast<real>(totalTriangles));
+    if (static_cast<int>(triCellIds_.size()) < estimatedBinned)
+        triCellIds_.resize_anew(estimatedBinned);
+
+    // one warp per cell overlapped by triangles; their number is only known on the device
+    const int nblocks = std::min(getNblocks(cl->totcells * warpSize, nthreads), maxBlocks);
+
+    while (true)
+    {
+        _binTriangles(vertexView, cl, stream);
+
+        coarseTable_.nCollisions.clear(stream);
+
+        SAFE_KERNEL_LAUNCH(
+                mesh_bounce_kernels::findBouncesInCells,
+                nblocks, nthreads, 0, stream,
+                vertexView, pvView, ov_->mesh.get(), cl->cellInfo(),
+                activeCells_.nCollisions.devPtr(), activeCells_.collisionTable.devPtr(),
+                triCellStarts_.devPtr(), static_cast<int>(triCellIds_.size()), triCellIds_.devPtr(),
+                devCoarseTable );
+
+        // also waits for nBinned_; the collisions found with an overflowing buffer are incomplete and discarded
+        coarseTable_.nCollisions.downloadFromDevice(stream);
+
+        if (nBinned_[0] <= static_cast<int>(triCellIds_.size()))
+            break;
+
+        debug("Binned %d triangle-cell pairs in bouncer '%s', growing the buffer (was %d)",
+              nBinned_[0], getCName(), static_cast<int>(triCellIds_.size()));
+        triCellIds_.resize_anew(nBinned_[0]);
+    }
+}
+
+void BounceFromMesh::_sortCollisions(CollisionTableWrapper<int2>& table, int n, cudaStream_t stream)
+{
+    if (n <= 0)
+        return;
+
+    // (particle id, triangle id) pairs are sorted as 64 bits keys
+    using Key = unsigned long long;
+    static_assert(sizeof(Key) == sizeof(int2), "int2 must have the size of a 64 bits integer");
+
+    auto keys       = reinterpret_cast<Key*>(table.collisionTable.devPtr());
+    auto sortedKeys = reinterpret_cast<Key*>(table.sortedTable   .devPtr());
+
+    size_t sortSize = 0, uniqueSize = 0;
+    cub::DeviceRadixSort::SortKeys(nullptr, sortSize, keys, sortedKeys, n, 0, 64, stream);
+    cub::DeviceSelect::Unique(nullptr, uniqueSize, sortedKeys, keys, table.nCollisions.devPtr(), n, stream);
+
+    size_t workSize = std::max(sortSize, uniqueSize);
+    if (workSize > workBuffer_.size())
+        workBuffer_.resize_anew(workSize);
+    workSize = workBuffer_.size();
+
+    cub::DeviceRadixSort::SortKeys(workBuffer_.devPtr(), workSize, keys, sortedKeys, n, 0, 64, stream);
+    cub::DeviceSelect::Unique(workBuffer_.devPtr(), workSize, sortedKeys, keys, table.nCollisions.devPtr(), n, stream);
+}
+
 } // namespace mirheo
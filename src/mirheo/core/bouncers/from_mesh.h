@@ -12,6 +12,7 @@ namespace mirheo
 {
 
 class RigidObjectVector;
+struct OVviewWithNewOldVertices;
 
 
 /** \brief Bounce particles against a triangle mesh.
@@ -57,14 +58,26 @@ private:
     {
         PinnedBuffer<int> nCollisions{1};
         DeviceBuffer<T> collisionTable;
+        DeviceBuffer<T> sortedTable; ///< work space for sorting the table
     };
 
     const real coarseCollisionsPerTri_ = 5.0_r; ///< maximum average possible number of collision per triangle in one step
     const real fineCollisionsPerTri_   = 1.0_r; ///< maximum average number of collision per triangle in one step
+    const real cellsPerTri_            = 8.0_r; ///< initial estimate of the average number of cells overlapped by one triangle
 
     CollisionTableWrapper<int2> coarseTable_; ///< collision table for the first step
     CollisionTableWrapper<int2> fineTable_;   ///< collision table for the second step
 
+    /** Triangles binned into the cells of the particle cell-lists.
+        The buffers are kept between time steps and only grow.
+    */
+    CollisionTableWrapper<int> activeCells_; ///< cells overlapped by at least one triangle
+    DeviceBuffer<int> triCellCounts_;        ///< number of triangles per cell; reused as fill counter
+    DeviceBuffer<int> triCellStarts_;        ///< exclusive scan of triCellCounts_
+    DeviceBuffer<int> triCellIds_;           ///< global triangle ids, grouped by cell
+    PinnedBuffer<int> nBinned_{1};           ///< total number of entries in triCellIds_
+    DeviceBuffer<char> workBuffer_;          ///< temporary storage for scans and sorts
+
     /** times stored as int so that we can use atomicMax
         note that times are always positive, thus guarantees ordering
     */
@@ -76,6 +89,10 @@ private:
     RigidObjectVector *rov_;
 
     void exec(ParticleVector *pv, CellList *cl, ParticleVectorLocality locality, cudaStream_t stream) override;
+
+    void _binTriangles(const OVviewWithNewOldVertices& vertexView, CellList *cl, cudaStream_t stream);
+    void _findCoarseCollisions(ParticleVector *pv, CellList *cl, const OVviewWithNewOldVertices& vertexView, cudaStream_t stream);
+    void _sortCollisions(CollisionTableWrapper<int2>& table, int n, cudaStream_t stream);
 };
 
 } // namespace mirheo
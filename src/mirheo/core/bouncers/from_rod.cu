@@ -36,7 +36,7 @@ void BounceFromRod::setup(ObjectVector *ov)
 void BounceFromRod::setPrerequisites(ParticleVector *pv)
 {
     // do not set it to persistent because bounce happens after integration
-    pv->requireDataPerParticle<real4> (channel_names::oldPositions, DataManager::PersistenceMode::None, DataManager::ShiftMode::Active);
+    pv->requireOldPositions(DataManager::PersistenceMode::None, DataManager::ShiftMode::Active);
 }
 
 std::vector<std::string> BounceFromRod::getChannelsToBeExchanged() const
@@ -38,7 +38,7 @@ template <class Shape>
 void BounceFromRigidShape<Shape>::setPrerequisites(ParticleVector *pv)
 {
     // do not set it to persistent because bounce happens after integration
-    pv->requireDataPerParticle<real4> (channel_names::oldPositions, DataManager::PersistenceMode::None, DataManager::ShiftMode::Active);
+    pv->requireOldPositions(DataManager::PersistenceMode::None, DataManager::ShiftMode::Active);
 }
 
 template <class Shape>
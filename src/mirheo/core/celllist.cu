@@ -1,9 +1,11 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "celllist.h"
+#include "celllist_incremental.h"
 
 #include <mirheo/core/logger.h>
 #include <mirheo/core/pvs/object_vector.h>
 #include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/rod_vector.h>
 #include <mirheo/core/pvs/views/pv.h>
 #include <mirheo/core/utils/cuda_common.h>
 #include <mirheo/core/utils/kernel_launch.h>
@@ -11,7 +13,10 @@
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
+#include <cub/device/device_radix_sort.cuh>
 #include <cub/device/device_scan.cuh>
+#include <cub/device/device_select.cuh>
+#include <cub/iterator/counting_input_iterator.cuh>
 #pragma GCC diagnostic pop
 
 #include <algorithm>
@@ -89,6 +94,170 @@ __global__ void accumulateKernel(int n, T *dst, CellListInfo cinfo, const T *src
     dst[pid] += src[srcId];
 }
 
+__global__ void classifyParticles(PVview view, CellListInfo cinfo, const int *prevCellStarts,
+                                  int *cellIds, int *stayFlags, char *moverFlags)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid > view.size) return;
+
+    // last entry of the scan
+    if (pid == view.size)
+    {
+        stayFlags[pid] = 0;
+        return;
+    }
+
+    const real4 pos = view.readPositionNoCache(pid);
+
+    //  XXX: relying here only on redistribution
+    const int cid = outgoingParticle(pos) ? INVALID : cinfo.getCellId<CellListsProjection::Clamp>(pos);
+    const bool stay = incremental_cell_list::isStayer(pid, cid, prevCellStarts, cinfo.totcells);
+
+    cellIds[pid] = cid;
+    stayFlags[pid] = stay ? 1 : 0;
+    moverFlags[pid] = (!stay && cid != INVALID) ? 1 : 0;
+}
+
+__global__ void gatherMoverCells(int nMovers, const int *moverIds, const int *cellIds, int *moverCells)
+{
+    const int k = blockIdx.x * blockDim.x + threadIdx.x;
+    if (k >= nMovers) return;
+
+    moverCells[k] = cellIds[moverIds[k]];
+}
+
+__global__ void computeCellSizesIncremental(CellListInfo cinfo, int n, const int *prevCellStarts, const int *stayScan,
+                                            int nMovers, const int *sortedMoverCells)
+{
+    const int cid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (cid > cinfo.totcells) return;
+
+    // last entry of the scan
+    if (cid == cinfo.totcells)
+    {
+        cinfo.cellSizes[cid] = 0;
+        return;
+    }
+
+    cinfo.cellSizes[cid] =
+        incremental_cell_list::numStayers(cid, prevCellStarts, stayScan, n) +
+        incremental_cell_list::numMovers(cid, sortedMoverCells, nMovers);
+}
+
+__global__ void reorderStayers(PVview view, CellListInfo cinfo, const int *prevCellStarts, const int *cellIds,
+                               const int *stayFlags, const int *stayScan, real4 *outPositions)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= view.size) return;
+
+    const int cid = cellIds[pid];
+
+    if (stayFlags[pid])
+    {
+        const int dstId = incremental_cell_list::stayerDestination(pid, cid, cinfo.cellStarts, prevCellStarts, stayScan);
+        writeNoCache(outPositions + dstId, view.readPositionNoCache(pid));
+        cinfo.order[pid] = dstId;
+    }
+    else if (cid == INVALID)
+    {
+        cinfo.order[pid] = INVALID;
+    }
+    // movers are handled in reorderMovers
+}
+
+__global__ void reorderMovers(PVview view, CellListInfo cinfo, const int *prevCellStarts, const int *stayScan,
+                              int nMovers, const int *sortedMoverIds, const int *sortedMoverCells, real4 *outPositions)
+{
+    const int k = blockIdx.x * blockDim.x + threadIdx.x;
+    if (k >= nMovers) return;
+
+    const int pid = sortedMoverIds[k];
+    const int cid = sortedMoverCells[k];
+    const int nstayers = incremental_cell_list::numStayers(cid, prevCellStarts, stayScan, view.size);
+
+    const int dstId = incremental_cell_list::moverDestination(k, cid, cinfo.cellStarts, nstayers,
+                                                              sortedMoverCells, nMovers);
+    writeNoCache(outPositions + dstId, view.readPositionNoCache(pid));
+    cinfo.order[pid] = dstId;
+}
+
+__global__ void addArrivedParticles(PVview view, CellListInfo cinfo, int start)
+{
+    const int pid = start + blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= view.size) return;
+
+    const real4 pos = view.readPositionNoCache(pid);
+
+    // the other particles had their forces cleared during the integration
+    writeNoCache(view.forces + pid, make_real4(0.0_r, 0.0_r, 0.0_r, 0.0_r));
+
+    if ( outgoingParticle(pos) ) return;
+
+    const int cid = cinfo.getCellId<CellListsProjection::Clamp>(pos);
+    atomicAdd(cinfo.cellSizes + cid, 1);
+}
+
+__global__ void removeExitedParticles(PVview view, CellListInfo cinfo, const int *nOutside, const int2 *outside)
+{
+    const int n = *nOutside;
+
+    for (int k = blockIdx.x * blockDim.x + threadIdx.x; k < n; k += blockDim.x * gridDim.x)
+    {
+        const int2 entry = outside[k];
+
+        // marked by the redistribution
+        if ( outgoingParticle(view.readPositionNoCache(entry.x)) )
+            atomicSub(cinfo.cellSizes + entry.y, 1);
+    }
+}
+
+__global__ void fillParticleIds(PVview view, CellListInfo cinfo)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= view.size) return;
+
+    const real4 pos = view.readPositionNoCache(pid);
+
+    //  XXX: relying here only on redistribution
+    if ( outgoingParticle(pos) ) return;
+
+    const int cid = cinfo.getCellId<CellListsProjection::Clamp>(pos);
+    const int dstId = cinfo.cellStarts[cid] + atomicAdd(cinfo.cellSizes + cid, 1);
+
+    cinfo.particleIds[dstId] = pid;
+}
+
+__global__ void computeObjectCells(int nObjects, const COMandExtent *comExtents, CellListInfo cinfo,
+                                   int *objCellIds, int *objIds)
+{
+    const int objId = blockIdx.x * blockDim.x + threadIdx.x;
+    if (objId >= nObjects) return;
+
+    objCellIds[objId] = cinfo.getCellId<CellListsProjection::Clamp>(comExtents[objId].com);
+    objIds[objId] = objId;
+}
+
+__global__ void countMisplacedObjects(int nObjects, const int *sortedObjIds, int *nMisplaced)
+{
+    const int objId = blockIdx.x * blockDim.x + threadIdx.x;
+    if (objId >= nObjects) return;
+
+    if (sortedObjIds[objId] != objId)
+        atomicAdd(nMisplaced, 1);
+}
+
+template <typename T>
+__global__ void reorderObjectEntities(int n, int entitiesPerObject, const int *srcObjIds, const T *inData, T *outData)
+{
+    const int dstId = blockIdx.x * blockDim.x + threadIdx.x;
+    if (dstId >= n) return;
+
+    const int dstObjId = dstId / entitiesPerObject;
+    const int srcId = srcObjIds[dstObjId] * entitiesPerObject + dstId % entitiesPerObject;
+
+    outData[dstId] = inData[srcId];
+}
+
 } // namespace cell_list_kernels
 
 //=================================================================================
@@ -415,10 +584,25 @@ PrimaryCellList::~PrimaryCellList() = default;
 
 void PrimaryCellList::build(cudaStream_t stream)
 {
+    forcesCleared_ = false;
+
     // Reqired here to avoid ptr swap if building didn't actually happen
-    if (!_checkNeedBuild()) return;
+    if (!_checkNeedBuild())
+    {
+        discardFusedBinning();
+        return;
+    }
 
-    CellList::build(stream);
+    if (incremental_)
+    {
+        _updateExtraDataChannels(stream);
+        debug("building %s incrementally", _makeName().c_str());
+        _buildIncremental(stream);
+    }
+    else
+    {
+        CellList::build(stream);
+    }
 
     if (pv_->local()->size() == 0)
     {
@@ -441,6 +625,184 @@ void PrimaryCellList::build(cudaStream_t stream)
     pv_->local()->resize(newSize, stream);
 }
 
+FusedBinningView PrimaryCellList::prepareFusedBinning(cudaStream_t stream)
+{
+    if (incremental_)
+        die("%s: the incremental build can not be fused with the integration", _makeName().c_str());
+
+    const int n = pv_->local()->size();
+
+    fusedCellSizes_.resize_anew(totcells + 1);
+    outside_.resize_anew(n);
+
+    fusedCellSizes_.clear(stream);
+    nOutside_.clear(stream);
+
+    fusedBinningPending_ = true;
+    fusedSize_ = n;
+
+    return {cellInfo(), fusedCellSizes_.devPtr(), nOutside_.devPtr(), outside_.devPtr()};
+}
+
+void PrimaryCellList::discardFusedBinning()
+{
+    fusedBinningPending_ = false;
+}
+
+void PrimaryCellList::_computeCellSizes(cudaStream_t stream)
+{
+    if (!fusedBinningPending_)
+    {
+        CellList::_computeCellSizes(stream);
+        return;
+    }
+
+    fusedBinningPending_ = false;
+
+    PVview view(pv_, pv_->local());
+
+    if (view.size < fusedSize_)
+        die("%s: %d particles were counted during the integration but only %d remain; "
+            "the particles must not be removed before the cell-list is built",
+            _makeName().c_str(), fusedSize_, view.size);
+
+    debug2("%s : Completing cell sizes counted during the integration with %d arrived particles",
+           _makeName().c_str(), view.size - fusedSize_);
+
+    std::swap(cellSizes, fusedCellSizes_);
+
+    const int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::addArrivedParticles,
+        getNblocks(view.size - fusedSize_, nthreads), nthreads, 0, stream,
+        view, cellInfo(), fusedSize_ );
+
+    // only the particles close to the subdomain boundaries can be outside
+    const int nblocksOutside = std::min(getNblocks(fusedSize_, nthreads), 64);
+
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::removeExitedParticles,
+        nblocksOutside, nthreads, 0, stream,
+        view, cellInfo(), nOutside_.devPtr(), outside_.devPtr() );
+
+    forcesCleared_ = true;
+}
+
+void PrimaryCellList::setIncrementalBuild(bool incremental)
+{
+    incremental_ = incremental;
+
+    // swapped with cellStarts at every incremental build
+    if (incremental_)
+        prevCellStarts_.resize_anew(totcells + 1);
+}
+
+void PrimaryCellList::_reorderPositionsAndCreateMapIncremental(cudaStream_t stream)
+{
+    PVview view(pv_, pv_->local());
+    const int n = view.size;
+
+    debug2("Reordering %d %s particles incrementally", n, pv_->getCName());
+
+    // the cell starts of the previous build describe the current layout of the particles
+    std::swap(prevCellStarts_, cellStarts);
+
+    order.resize_anew(n);
+    particlesDataContainer_->resize_anew(n);
+
+    cellIds_         .resize_anew(n);
+    stayFlags_       .resize_anew(n + 1);
+    stayScan_        .resize_anew(n + 1);
+    moverFlags_      .resize_anew(n);
+    moverIds_        .resize_anew(n);
+    moverCells_      .resize_anew(n);
+    sortedMoverIds_  .resize_anew(n);
+    sortedMoverCells_.resize_anew(n);
+
+    const int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::classifyParticles,
+        getNblocks(n + 1, nthreads), nthreads, 0, stream,
+        view, cellInfo(), prevCellStarts_.devPtr(),
+        cellIds_.devPtr(), stayFlags_.devPtr(), moverFlags_.devPtr() );
+
+    // cub work space is shared among the calls below
+    auto ensureWorkSize = [this](size_t size)
+    {
+        if (workBuffer_.size() < size)
+            workBuffer_.resize_anew(size);
+    };
+
+    size_t workSize = 0;
+    cub::DeviceScan::ExclusiveSum(nullptr, workSize, stayFlags_.devPtr(), stayScan_.devPtr(), n + 1, stream);
+    ensureWorkSize(workSize);
+    cub::DeviceScan::ExclusiveSum(workBuffer_.devPtr(), workSize,
+                                  stayFlags_.devPtr(), stayScan_.devPtr(), n + 1, stream);
+
+    const cub::CountingInputIterator<int> ids(0);
+    cub::DeviceSelect::Flagged(nullptr, workSize, ids, moverFlags_.devPtr(), moverIds_.devPtr(), nMovers_.devPtr(), n, stream);
+    ensureWorkSize(workSize);
+    cub::DeviceSelect::Flagged(workBuffer_.devPtr(), workSize,
+                               ids, moverFlags_.devPtr(), moverIds_.devPtr(), nMovers_.devPtr(), n, stream);
+
+    nMovers_.downloadFromDevice(stream, ContainersSynch::Synch);
+    const int nMovers = nMovers_[0];
+
+    debug2("%s : %d movers out of %d particles", _makeName().c_str(), nMovers, n);
+
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::gatherMoverCells,
+        getNblocks(nMovers, nthreads), nthreads, 0, stream,
+        nMovers, moverIds_.devPtr(), cellIds_.devPtr(), moverCells_.devPtr() );
+
+    // radix sort is stable: movers of the same cell stay sorted by index
+    int endBit = 1;
+    while ((1 << endBit) < totcells)
+        ++endBit;
+
+    cub::DeviceRadixSort::SortPairs(nullptr, workSize,
+                                    moverCells_.devPtr(), sortedMoverCells_.devPtr(),
+                                    moverIds_.devPtr(), sortedMoverIds_.devPtr(),
+                                    nMovers, 0, endBit, stream);
+    ensureWorkSize(workSize);
+    cub::DeviceRadixSort::SortPairs(workBuffer_.devPtr(), workSize,
+                                    moverCells_.devPtr(), sortedMoverCells_.devPtr(),
+                                    moverIds_.devPtr(), sortedMoverIds_.devPtr(),
+                                    nMovers, 0, endBit, stream);
+
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::computeCellSizesIncremental,
+        getNblocks(totcells + 1, nthreads), nthreads, 0, stream,
+        cellInfo(), n, prevCellStarts_.devPtr(), stayScan_.devPtr(),
+        nMovers, sortedMoverCells_.devPtr() );
+
+    _computeCellStarts(stream);
+
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::reorderStayers,
+        getNblocks(n, nthreads), nthreads, 0, stream,
+        view, cellInfo(), prevCellStarts_.devPtr(), cellIds_.devPtr(),
+        stayFlags_.devPtr(), stayScan_.devPtr(),
+        particlesDataContainer_->positions().devPtr() );
+
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::reorderMovers,
+        getNblocks(nMovers, nthreads), nthreads, 0, stream,
+        view, cellInfo(), prevCellStarts_.devPtr(), stayScan_.devPtr(),
+        nMovers, sortedMoverIds_.devPtr(), sortedMoverCells_.devPtr(),
+        particlesDataContainer_->positions().devPtr() );
+}
+
+void PrimaryCellList::_buildIncremental(cudaStream_t stream)
+{
+    _reorderPositionsAndCreateMapIncremental(stream);
+    _reorderPersistentData(stream);
+
+    changedStamp_ = pv_->cellListStamp;
+}
+
 void PrimaryCellList::accumulateChannels(__UNUSED const std::vector<std::string>& channelNames, __UNUSED cudaStream_t stream)
 {}
 
@@ -486,4 +848,152 @@ std::string PrimaryCellList::_makeName() const
     return "Primary " + CellList::_makeName();
 }
 
+
+//=================================================================================
+// Object primary cell-lists
+//=================================================================================
+
+ObjectPrimaryCellList::ObjectPrimaryCellList(ObjectVector *ov, real rc_, real3 localDomainSize_) :
+    CellList(ov, rc_, localDomainSize_),
+    ov_(ov)
+{
+    localPV_ = pv_->local();
+}
+
+ObjectPrimaryCellList::~ObjectPrimaryCellList() = default;
+
+void ObjectPrimaryCellList::build(cudaStream_t stream)
+{
+    if (!_checkNeedBuild()) return;
+
+    debug("building %s", _makeName().c_str());
+
+    PVview view(pv_, pv_->local());
+
+    particleIds_.resize_anew(view.size);
+    CellListInfo::particleIds = particleIds_.devPtr();
+
+    _computeCellSizes(stream);
+    _computeCellStarts(stream);
+    cellSizes.clear(stream);
+
+    const int nthreads = 128;
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::fillParticleIds,
+        getNblocks(view.size, nthreads), nthreads, 0, stream,
+        view, cellInfo() );
+
+    changedStamp_ = pv_->cellListStamp;
+}
+
+void ObjectPrimaryCellList::accumulateChannels(__UNUSED const std::vector<std::string>& channelNames, __UNUSED cudaStream_t stream)
+{}
+
+void ObjectPrimaryCellList::gatherChannels(const std::vector<std::string>& channelNames, __UNUSED cudaStream_t stream)
+{
+    // do not need to reorder data, but still invalidate halo
+    if (!channelNames.empty())
+        pv_->haloValid = false;
+}
+
+void ObjectPrimaryCellList::sortObjects(cudaStream_t stream)
+{
+    auto lov = ov_->local();
+    const int nObjects = lov->getNumObjects();
+
+    if (nObjects == 0) return;
+
+    ov_->findExtentAndCOM(stream, ParticleVectorLocality::Local);
+
+    objCellIds_      .resize_anew(nObjects);
+    objIds_          .resize_anew(nObjects);
+    sortedObjCellIds_.resize_anew(nObjects);
+    sortedObjIds_    .resize_anew(nObjects);
+
+    const int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::computeObjectCells,
+        getNblocks(nObjects, nthreads), nthreads, 0, stream,
+        nObjects, lov->dataPerObject.getData<COMandExtent>(channel_names::comExtents)->devPtr(),
+        cellInfo(), objCellIds_.devPtr(), objIds_.devPtr() );
+
+    // radix sort is stable: objects of the same cell keep their relative order
+    int endBit = 1;
+    while ((1 << endBit) < totcells)
+        ++endBit;
+
+    size_t workSize = 0;
+    cub::DeviceRadixSort::SortPairs(nullptr, workSize,
+                                    objCellIds_.devPtr(), sortedObjCellIds_.devPtr(),
+                                    objIds_.devPtr(), sortedObjIds_.devPtr(),
+                                    nObjects, 0, endBit, stream);
+    if (workBuffer_.size() < workSize)
+        workBuffer_.resize_anew(workSize);
+    cub::DeviceRadixSort::SortPairs(workBuffer_.devPtr(), workSize,
+                                    objCellIds_.devPtr(), sortedObjCellIds_.devPtr(),
+                                    objIds_.devPtr(), sortedObjIds_.devPtr(),
+                                    nObjects, 0, endBit, stream);
+
+    nMisplaced_.clear(stream);
+    SAFE_KERNEL_LAUNCH(
+        cell_list_kernels::countMisplacedObjects,
+        getNblocks(nObjects, nthreads), nthreads, 0, stream,
+        nObjects, sortedObjIds_.devPtr(), nMisplaced_.devPtr() );
+
+    nMisplaced_.downloadFromDevice(stream, ContainersSynch::Synch);
+
+    debug2("%s : %d out of %d objects change index", _makeName().c_str(), nMisplaced_[0], nObjects);
+
+    if (nMisplaced_[0] == 0) return;
+
+    _reorderObjectData(lov->dataPerParticle, particlesDataContainer_->dataPerParticle, ov_->getObjectSize(), stream);
+    _reorderObjectData(lov->dataPerObject, objectDataContainer_, 1, stream);
+
+    if (auto lrv = dynamic_cast<LocalRodVector*>(lov))
+        _reorderObjectData(lrv->dataPerBisegment, bisegmentDataContainer_, lrv->getNumSegmentsPerRod() - 1, stream);
+
+    ov_->cellListStamp++;
+}
+
+void ObjectPrimaryCellList::_reorderObjectData(DataManager& data, DataManager& container, int entitiesPerObject, cudaStream_t stream)
+{
+    const int n = ov_->local()->getNumObjects() * entitiesPerObject;
+
+    for (const auto& namedChannel : data.getSortedChannels())
+    {
+        const auto& name = namedChannel.first;
+        const auto& desc = namedChannel.second;
+        if (desc->persistence != DataManager::PersistenceMode::Active) continue;
+
+        debug2("%s: reordering object data '%s'", _makeName().c_str(), name.c_str());
+
+        mpark::visit([&](auto srcPinnedBuff)
+        {
+            using T = typename std::remove_pointer<decltype(srcPinnedBuff)>::type::value_type;
+
+            if (!container.checkChannelExists(name))
+                container.createData<T>(name, n);
+
+            auto dstPinnedBuff = container.getData<T>(name);
+            dstPinnedBuff->resize_anew(n);
+
+            constexpr int nthreads = 128;
+
+            SAFE_KERNEL_LAUNCH(
+                cell_list_kernels::reorderObjectEntities,
+                getNblocks(n, nthreads), nthreads, 0, stream,
+                n, entitiesPerObject, sortedObjIds_.devPtr(),
+                srcPinnedBuff->devPtr(), dstPinnedBuff->devPtr() );
+
+            std::swap(*srcPinnedBuff, *dstPinnedBuff);
+        }, desc->varDataPtr);
+    }
+}
+
+std::string ObjectPrimaryCellList::_makeName() const
+{
+    return "Object Primary " + CellList::_makeName();
+}
+
 } // namespace mirheo
@@ -10,6 +10,9 @@
 
 namespace mirheo
 {
+
+class ObjectVector;
+
 /// describes if the position should be projected inside the
 /// local subdomain or not
 enum class CellListsProjection
@@ -142,11 +145,53 @@ public:
     /// \c order[pid] is the destination index of the particle with index \c pid before reordering
     int *order {nullptr};
 
+    /// \c particleIds[k] is the index of the k-th particle of the cell-list inside the attached ParticleVector;
+    /// \c nullptr if the particles are stored in cell order (see ObjectPrimaryCellList)
+    int *particleIds {nullptr};
+
 private:
     real3 invh_; ///< 1 / h
 };
 
 
+/** \brief A device-compatible structure used to count particles into cells while they are integrated.
+
+    See PrimaryCellList::prepareFusedBinning().
+ */
+struct FusedBinningView
+{
+    CellListInfo cinfo; ///< Geometry of the cell-list
+    int *cellSizes;     ///< Number of particles per cell
+    int *nOutside;      ///< Number of particles outside of the subdomain
+    int2 *outside;      ///< (particle index, cell index) of the particles outside of the subdomain
+
+#ifdef __CUDACC__
+    /** \brief Count a particle into its cell.
+        \param [in] pid The index of the particle
+        \param [in] r The position of the particle in **local coordinates**
+
+        As in CellList::build(), particles outside of the subdomain are counted in the closest cell.
+        They are also recorded, so that they can be removed from the count if they are exchanged
+        during the redistribution.
+     */
+    __device__ inline void add(int pid, real3 r) const
+    {
+        const int3 cid3 = cinfo.getCellIdAlongAxes<CellListsProjection::NoClamp>(r);
+        const int cid = cinfo.encode(math::min(cinfo.ncells - 1, math::max(make_int3(0), cid3)));
+
+        atomicAdd(cellSizes + cid, 1);
+
+        if (cid3.x < 0 || cid3.x >= cinfo.ncells.x ||
+            cid3.y < 0 || cid3.y >= cinfo.ncells.y ||
+            cid3.z < 0 || cid3.z >= cinfo.ncells.z)
+        {
+            const int k = atomicAdd(nOutside, 1);
+            outside[k] = make_int2(pid, cid);
+        }
+    }
+#endif
+};
+
 /** \brief Contains the cell-list data for a given ParticleVector.
 
     As opposed to the PrimaryCellList class, it contains a **copy** of the
@@ -234,7 +279,7 @@ protected:
     /// the attached ParricleVector
     void _updateExtraDataChannels(cudaStream_t stream);
     /// Compute the number of particles per cell
-    void _computeCellSizes(cudaStream_t stream);
+    virtual void _computeCellSizes(cudaStream_t stream);
     /// Compute the cell starts; requires cell sizes
     void _computeCellStarts(cudaStream_t stream);
     /// reorder the positions and create \c order. requires cell starts
@@ -307,10 +352,133 @@ public:
     void accumulateChannels(const std::vector<std::string>& channelNames, cudaStream_t stream) override;
     void gatherChannels(const std::vector<std::string>& channelNames, cudaStream_t stream) override;
 
+    /** \brief Choose how the cell-list is built.
+        \param [in] incremental If \c true, use the incremental build; otherwise rebuild from scratch.
+
+        The incremental build exploits the fact that the particles are already sorted from the
+        previous build: only the particles that changed cell (or arrived in the subdomain) are sorted
+        and merged into the existing order.
+        The resulting order is deterministic (it does not rely on atomic operations).
+        See incremental_cell_list for details.
+     */
+    void setIncrementalBuild(bool incremental);
+
+    /** \brief Prepare the next build to be fused with the integration of the particles.
+        \param [in] stream Execution stream
+        \return The handler used to count the particles into cells during the integration.
+
+        The integrator counts the particles per cell while it advances them, and clears their forces
+        (see Integrator::executeAndBin()).
+        The next build then skips the pass over all particles that computes the cell sizes: it only
+        counts the particles received during the redistribution (clearing their forces as well) and
+        removes the ones that were sent away.
+        The particles must not be modified between the integration and the next build, other than by
+        the redistribution.
+     */
+    FusedBinningView prepareFusedBinning(cudaStream_t stream);
+
+    /// Discard the counts made since prepareFusedBinning(); the next build will count all particles.
+    void discardFusedBinning();
+
+    /// \return \c true if the forces of the particles were cleared during the integration preceding the last build.
+    bool hasClearedForces() const noexcept { return forcesCleared_; }
+
 protected:
     /// swap data between the internal container with the attached particle data
     void _swapPersistentExtraData();
     std::string _makeName() const override;
+
+    /// reorder the positions and create \c order from the previous order; fills cell sizes and starts
+    void _reorderPositionsAndCreateMapIncremental(cudaStream_t stream);
+
+    /// build cell lists incrementally (replaces _build())
+    void _buildIncremental(cudaStream_t stream);
+
+    /// compute the cell sizes from the counts of prepareFusedBinning() if any; otherwise count all particles
+    void _computeCellSizes(cudaStream_t stream) override;
+
+protected:
+    bool incremental_ {false}; ///< \c true if the incremental build is used
+
+    DeviceBuffer<int> prevCellStarts_;   ///< cell starts of the previous build
+    DeviceBuffer<int> cellIds_;          ///< cell index of each particle (-1 if leaving)
+    DeviceBuffer<int> stayFlags_;        ///< 1 for stayers, 0 otherwise
+    DeviceBuffer<int> stayScan_;         ///< exclusive prefix sum of stayFlags_
+    DeviceBuffer<char> moverFlags_;      ///< 1 for movers, 0 otherwise
+    DeviceBuffer<int> moverIds_;         ///< indices of the movers
+    DeviceBuffer<int> moverCells_;       ///< cell indices of the movers
+    DeviceBuffer<int> sortedMoverIds_;   ///< moverIds_ sorted by cell
+    DeviceBuffer<int> sortedMoverCells_; ///< moverCells_ sorted
+    PinnedBuffer<int> nMovers_ {1};      ///< number of movers
+    DeviceBuffer<char> workBuffer_;      ///< work space for cub
+
+    bool fusedBinningPending_ {false};   ///< \c true if the particles were counted during the integration
+    bool forcesCleared_ {false};         ///< \c true if the forces were cleared during the integration
+    int fusedSize_ {0};                  ///< number of particles counted during the integration
+    DeviceBuffer<int> fusedCellSizes_;   ///< cell sizes counted during the integration
+    DeviceBuffer<int> nOutside_ {1};     ///< number of particles outside of the subdomain after the integration
+    DeviceBuffer<int2> outside_;         ///< (index, cell) of the particles outside of the subdomain after the integration
+};
+
+/** \brief Contains the cell-list map for a given ObjectVector, without copy of the data.
+
+    The ObjectVector is reordered in place at the granularity of the objects: the objects are sorted by the
+    cell of their center of mass (see sortObjects()) and the particles of an object stay contiguous.
+    The particles are hence not stored in cell order; instead, the cell ranges index the array
+    CellListInfo::particleIds, which contains the indices of the particles in the ObjectVector.
+
+    The pairwise interaction kernels read the particles through this indirection, so that no data is gathered
+    into or accumulated from a copy.
+    The other users of the cell ranges (bouncers, belonging checkers, walls and some plugins) do not support
+    this cell-list.
+ */
+class ObjectPrimaryCellList : public CellList
+{
+public:
+    /** Construct a ObjectPrimaryCellList object
+        \param [in] ov The ObjectVector to attach.
+        \param [in] rc The maximum cut-off radius that can be used with that cell list.
+        \param [in] localDomainSize The size of the local subdomain
+     */
+    ObjectPrimaryCellList(ObjectVector *ov, real rc, real3 localDomainSize);
+
+    ~ObjectPrimaryCellList();
+
+    void build(cudaStream_t stream) override;
+
+    void accumulateChannels(const std::vector<std::string>& channelNames, cudaStream_t stream) override;
+    void gatherChannels(const std::vector<std::string>& channelNames, cudaStream_t stream) override;
+
+    /** \brief Reorder the local objects by the cell of their center of mass.
+        \param [in] stream Execution stream
+
+        All the persistent channels (per particle, per object and per bisegment for rods) are reordered.
+        This changes the indices of the objects; it must thus happen right after the redistribution of the objects,
+        before any map to the local objects is built (e.g. by the halo exchange).
+        Nothing is moved if the objects are already sorted.
+     */
+    void sortObjects(cudaStream_t stream);
+
+protected:
+    std::string _makeName() const override;
+
+private:
+    /// reorder the persistent channels of \p data, that has \p entitiesPerObject entries per object, using \p container as work space
+    void _reorderObjectData(DataManager& data, DataManager& container, int entitiesPerObject, cudaStream_t stream);
+
+private:
+    ObjectVector *ov_; ///< The attached ObjectVector
+
+    DeviceBuffer<int> particleIds_;      ///< particle indices in cell order
+    DeviceBuffer<int> objCellIds_;       ///< cell index of the center of mass of each object
+    DeviceBuffer<int> objIds_;           ///< indices of the objects
+    DeviceBuffer<int> sortedObjCellIds_; ///< objCellIds_ sorted
+    DeviceBuffer<int> sortedObjIds_;     ///< objIds_ sorted by cell: new index to old index
+    PinnedBuffer<int> nMisplaced_ {1};   ///< number of objects that change index
+    DeviceBuffer<char> workBuffer_;      ///< work space for cub
+
+    DataManager objectDataContainer_;    ///< work space to reorder the data per object
+    DataManager bisegmentDataContainer_; ///< work space to reorder the data per bisegment
 };
 
 } // namespace mirheo
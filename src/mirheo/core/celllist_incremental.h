@@ -0,0 +1,127 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+
+namespace mirheo
+{
+
+/** \brief Index arithmetic of the incremental cell-list build (see PrimaryCellList).
+
+    The particles of a PrimaryCellList are sorted by cell after each build.
+    At the next build, a particle is a *stayer* if it occupies a slot that belonged to
+    its current cell in the previous build; all other particles (new ones, or those that
+    changed cell) are *movers*.
+    Stayers form a subsequence that is already sorted by cell, so only the movers need to be sorted.
+    The new order places, in each cell, the stayers first (in their previous order), then the
+    movers sorted by their index.
+    The result does not depend on the scheduling of the threads.
+
+    All functions are used identically on the host (for testing) and on the device.
+ */
+namespace incremental_cell_list
+{
+
+/// \return the index of the first element of the sorted array \p a of size \p n that is not less than \p value
+__HD__ inline int lowerBound(const int *a, int n, int value)
+{
+    int lo = 0, hi = n;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (a[mid] < value) lo = mid + 1;
+        else                hi = mid;
+    }
+    return lo;
+}
+
+/// \return the index of the first element of the sorted array \p a of size \p n that is greater than \p value
+__HD__ inline int upperBound(const int *a, int n, int value)
+{
+    int lo = 0, hi = n;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (a[mid] <= value) lo = mid + 1;
+        else                 hi = mid;
+    }
+    return lo;
+}
+
+/** \brief Find the cell that owned a slot in the previous build.
+    \param [in] pid The slot index
+    \param [in] prevCellStarts The cell starts of the previous build (\p totcells + 1 entries)
+    \param [in] totcells The number of cells
+    \return the cell index, or -1 if the slot was not used in the previous build
+ */
+__HD__ inline int previousCellOfSlot(int pid, const int *prevCellStarts, int totcells)
+{
+    if (pid >= prevCellStarts[totcells])
+        return -1;
+    // last cell whose start is <= pid; empty cells share their start with the next one
+    return upperBound(prevCellStarts, totcells + 1, pid) - 1;
+}
+
+/** \param [in] pid The particle index
+    \param [in] cid The current cell of the particle, -1 if it is leaving the subdomain
+    \param [in] prevCellStarts The cell starts of the previous build
+    \param [in] totcells The number of cells
+    \return \c true if the particle keeps its place relative to the other stayers
+ */
+__HD__ inline bool isStayer(int pid, int cid, const int *prevCellStarts, int totcells)
+{
+    return cid >= 0 && previousCellOfSlot(pid, prevCellStarts, totcells) == cid;
+}
+
+/** \brief Number of stayers in a given cell.
+    \param [in] cid The cell index
+    \param [in] prevCellStarts The cell starts of the previous build
+    \param [in] stayScan Exclusive prefix sum of the stayer flags (\p n + 1 entries)
+    \param [in] n Current number of particles
+ */
+__HD__ inline int numStayers(int cid, const int *prevCellStarts, const int *stayScan, int n)
+{
+    const int begin = prevCellStarts[cid]   < n ? prevCellStarts[cid]   : n;
+    const int end   = prevCellStarts[cid+1] < n ? prevCellStarts[cid+1] : n;
+    return stayScan[end] - stayScan[begin];
+}
+
+/** \brief Number of movers that go to a given cell.
+    \param [in] cid The cell index
+    \param [in] sortedMoverCells Cell indices of the movers, sorted
+    \param [in] numMovers Number of movers
+ */
+__HD__ inline int numMovers(int cid, const int *sortedMoverCells, int numMovers)
+{
+    return upperBound(sortedMoverCells, numMovers, cid) - lowerBound(sortedMoverCells, numMovers, cid);
+}
+
+/** \return the new index of the stayer \p pid in cell \p cid.
+    \param [in] pid The particle index
+    \param [in] cid The cell of the particle
+    \param [in] cellStarts The new cell starts
+    \param [in] prevCellStarts The cell starts of the previous build
+    \param [in] stayScan Exclusive prefix sum of the stayer flags
+ */
+__HD__ inline int stayerDestination(int pid, int cid, const int *cellStarts, const int *prevCellStarts, const int *stayScan)
+{
+    return cellStarts[cid] + stayScan[pid] - stayScan[prevCellStarts[cid]];
+}
+
+/** \return the new index of the mover with rank \p k in the sorted list of movers.
+    \param [in] k The position of the mover in the sorted list
+    \param [in] cid The cell of the mover
+    \param [in] cellStarts The new cell starts
+    \param [in] nstayers Number of stayers in cell \p cid (see numStayers())
+    \param [in] sortedMoverCells Cell indices of the movers, sorted
+    \param [in] numMovers Number of movers
+ */
+__HD__ inline int moverDestination(int k, int cid, const int *cellStarts, int nstayers,
+                                   const int *sortedMoverCells, int numMovers)
+{
+    return cellStarts[cid] + nstayers + k - lowerBound(sortedMoverCells, numMovers, cid);
+}
+
+} // namespace incremental_cell_list
+
+} // namespace mirheo
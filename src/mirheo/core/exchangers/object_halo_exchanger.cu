@@ -10,6 +10,7 @@
 #include <mirheo/core/pvs/rod_vector.h>
 #include <mirheo/core/pvs/packers/objects.h>
 #include <mirheo/core/pvs/views/ov.h>
+#include <mirheo/core/pvs/views/pv.h>
 #include <mirheo/core/logger.h>
 #include <mirheo/core/utils/cuda_common.h>
 
@@ -123,6 +124,106 @@ __global__ void unpackObjects(BufferOffsetsSizesWrap dataWrap, PackerHandler pac
     packer.blockUnpack(numElements, buffer, srcObjId, dstObjId);
 }
 
+template <PackMode packMode>
+__global__ void getParticleHaloAndMap(DomainInfo domain, PVview view, MapEntry *map,
+                                      real rc, ParticlePackerHandler packer,
+                                      BufferOffsetsSizesWrap dataWrap)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    const int tid = threadIdx.x;
+
+    int nHalos = 0;
+    char validHalos[7];
+    int haloOffset[7];
+
+    // Use shared memory to decrease number of global atomics
+    __shared__ int blockSum[fragment_mapping::numFragments];
+    if (tid < fragment_mapping::numFragments) blockSum[tid] = 0;
+
+    __syncthreads();
+
+    if (pid < view.size)
+    {
+        // Find to which halos this particle should go
+        const real4 r = view.readPosition(pid);
+        int dx = 0, dy = 0, dz = 0;
+
+        if (r.x < -0.5_r * domain.localSize.x + rc) dx = -1;
+        if (r.y < -0.5_r * domain.localSize.y + rc) dy = -1;
+        if (r.z < -0.5_r * domain.localSize.z + rc) dz = -1;
+
+        if (r.x >  0.5_r * domain.localSize.x - rc) dx = 1;
+        if (r.y >  0.5_r * domain.localSize.y - rc) dy = 1;
+        if (r.z >  0.5_r * domain.localSize.z - rc) dz = 1;
+
+        for (int ix = math::min(dx, 0); ix <= math::max(dx, 0); ++ix)
+            for (int iy = math::min(dy, 0); iy <= math::max(dy, 0); ++iy)
+                for (int iz = math::min(dz, 0); iz <= math::max(dz, 0); ++iz)
+                {
+                    if (ix == 0 && iy == 0 && iz == 0) continue;
+                    const int bufId = fragment_mapping::getId(ix, iy, iz);
+                    validHalos[nHalos] = bufId;
+                    haloOffset[nHalos] = atomicAdd(blockSum + bufId, 1);
+                    nHalos++;
+                }
+    }
+
+    __syncthreads();
+
+    if (tid < fragment_mapping::numFragments && blockSum[tid] > 0)
+        blockSum[tid] = atomicAdd(dataWrap.sizes + tid, blockSum[tid]);
+
+    if (packMode == PackMode::Query)
+    {
+        return;
+    }
+    else
+    {
+        __syncthreads();
+
+        for (int i = 0; i < nHalos; ++i)
+        {
+            const int bufId = validHalos[i];
+            const int dstPid = blockSum[bufId] + haloOffset[i];
+
+            const int3 dir = fragment_mapping::getDir(bufId);
+            const auto shift = exchangers_common::getShift(domain.localSize, dir);
+
+            auto buffer = dataWrap.getBuffer(bufId);
+            const int numElements = dataWrap.offsets[bufId+1] - dataWrap.offsets[bufId];
+
+            packer.particles.packShift(pid, dstPid, buffer, numElements, shift);
+
+            map[dataWrap.offsets[bufId] + dstPid] = MapEntry(pid, bufId);
+        }
+    }
+}
+
+__global__ void unpackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerHandler packer)
+{
+    const int tid = threadIdx.x;
+    const int pid = tid + blockIdx.x * blockDim.x;
+
+    extern __shared__ int offsets[];
+
+    const int nBuffers = dataWrap.nBuffers;
+
+    for (int i = tid; i < nBuffers + 1; i += blockDim.x)
+        offsets[i] = dataWrap.offsets[i];
+    __syncthreads();
+
+    if (pid >= offsets[nBuffers]) return;
+
+    const int bufId = dispatchThreadsPerBuffer(nBuffers, offsets, pid);
+    auto buffer = dataWrap.getBuffer(bufId);
+    const int numElements = dataWrap.sizes[bufId];
+
+    const int srcPid = pid - offsets[bufId];
+    const int dstPid = pid;
+
+    packer.particles.unpack(srcPid, dstPid, buffer, numElements);
+}
+
 } // namespace object_halo_exchange_kernels
 
 
@@ -134,11 +235,13 @@ bool ObjectHaloExchanger::needExchange(size_t id)
 ObjectHaloExchanger::ObjectHaloExchanger() = default;
 ObjectHaloExchanger::~ObjectHaloExchanger() = default;
 
-void ObjectHaloExchanger::attach(ObjectVector *ov, real rc, const std::vector<std::string>& extraChannelNames)
+void ObjectHaloExchanger::attach(ObjectVector *ov, real rc, const std::vector<std::string>& extraChannelNames,
+                                 bool fullObjects)
 {
     const size_t id = objects_.size();
     objects_.push_back(ov);
     rcs_.push_back(rc);
+    fullObjects_.push_back(fullObjects);
 
     auto channels = extraChannelNames;
     channels.push_back(channel_names::positions);
@@ -149,9 +252,14 @@ void ObjectHaloExchanger::attach(ObjectVector *ov, real rc, const std::vector<st
         return std::find(channels.begin(), channels.end(), namedDesc.first) != channels.end();
     };
 
-    std::unique_ptr<ObjectPacker> packer, unpacker;
+    std::unique_ptr<ParticlePacker> packer, unpacker;
 
-    if (auto rv = dynamic_cast<RodVector*>(ov))
+    if (!fullObjects)
+    {
+        packer   = std::make_unique<ParticlePacker>(predicate);
+        unpacker = std::make_unique<ParticlePacker>(predicate);
+    }
+    else if (auto rv = dynamic_cast<RodVector*>(ov))
     {
         packer   = std::make_unique<RodPacker>(predicate);
         unpacker = std::make_unique<RodPacker>(predicate);
@@ -173,8 +281,13 @@ void ObjectHaloExchanger::attach(ObjectVector *ov, real rc, const std::vector<st
     for (const auto& name : channels)
         allChannelNames += "'" + name + "' ";
 
-    info("Object vector '%s' (rc %f) was attached to halo exchanger with channels %s",
-         ov->getCName(), rc, allChannelNames.c_str());
+    info("Object vector '%s' (rc %f) was attached to halo exchanger (%s) with channels %s",
+         ov->getCName(), rc, fullObjects ? "full objects" : "particles only", allChannelNames.c_str());
+}
+
+bool ObjectHaloExchanger::exchangesFullObjects(size_t id) const
+{
+    return fullObjects_[id];
 }
 
 void ObjectHaloExchanger::prepareSizes(size_t id, cudaStream_t stream)
@@ -185,13 +298,32 @@ void ObjectHaloExchanger::prepareSizes(size_t id, cudaStream_t stream)
     auto helper = getExchangeEntity(id);
     auto packer = packers_[id].get();
 
+    helper->send.sizes.clear(stream);
+    packer->update(lov, stream);
+
+    if (!fullObjects_[id])
+    {
+        debug2("Counting halo particles of '%s'", ov->getCName());
+
+        PVview view(ov, lov);
+        const int nthreads = 128;
+
+        if (view.size > 0)
+            SAFE_KERNEL_LAUNCH(
+                object_halo_exchange_kernels::getParticleHaloAndMap<PackMode::Query>,
+                getNblocks(view.size, nthreads), nthreads, 0, stream,
+                ov->getState()->domain, view, nullptr, rc,
+                packer->handler(), helper->wrapSendData() );
+
+        helper->computeSendOffsets_Dev2Dev(stream);
+        return;
+    }
+
     ov->findExtentAndCOM(stream, ParticleVectorLocality::Local);
 
     debug2("Counting halo objects of '%s'", ov->getCName());
 
     OVview ovView(ov, lov);
-    helper->send.sizes.clear(stream);
-    packer->update(lov, stream);
 
     if (ovView.nObjects > 0)
     {
@@ -204,7 +336,7 @@ void ObjectHaloExchanger::prepareSizes(size_t id, cudaStream_t stream)
                 ovView.nObjects, nthreads, 0, stream,
                 ov->getState()->domain, ovView, nullptr, rc,
                 packerHandler, helper->wrapSendData() );
-        }, exchangers_common::getHandler(packer));
+        }, exchangers_common::getObjectHandler(packer));
     }
 
     helper->computeSendOffsets_Dev2Dev(stream);
@@ -220,9 +352,28 @@ void ObjectHaloExchanger::prepareData(size_t id, cudaStream_t stream)
     auto& map = maps_[id];
 
     const int nhalo = helper->send.offsets[helper->nBuffers];
-    OVview ovView(ov, lov);
     map.resize_anew(nhalo);
 
+    if (!fullObjects_[id])
+    {
+        PVview view(ov, lov);
+        const int nthreads = 128;
+        debug2("Downloading %d halo particles of '%s'", nhalo, ov->getCName());
+
+        helper->resizeSendBuf();
+        helper->send.sizes.clearDevice(stream);
+
+        if (view.size > 0)
+            SAFE_KERNEL_LAUNCH(
+                object_halo_exchange_kernels::getParticleHaloAndMap<PackMode::Pack>,
+                getNblocks(view.size, nthreads), nthreads, 0, stream,
+                ov->getState()->domain, view, map.devPtr(), rc,
+                packer->handler(), helper->wrapSendData() );
+        return;
+    }
+
+    OVview ovView(ov, lov);
+
     if (ovView.nObjects > 0)
     {
         const int nthreads = 256;
@@ -238,7 +389,7 @@ void ObjectHaloExchanger::prepareData(size_t id, cudaStream_t stream)
                 ovView.nObjects, nthreads, 0, stream,
                 ov->getState()->domain, ovView, map.devPtr(), rc,
                 packerHandler, helper->wrapSendData());
-        }, exchangers_common::getHandler(packer));
+        }, exchangers_common::getObjectHandler(packer));
     }
 }
 
@@ -251,13 +402,27 @@ void ObjectHaloExchanger::combineAndUploadData(size_t id, cudaStream_t stream)
 
     const auto& offsets = helper->recv.offsets;
     const int totalRecvd = offsets[helper->nBuffers];
+    const size_t shMemSize = offsets.size() * sizeof(offsets[0]);
+
+    if (!fullObjects_[id])
+    {
+        hov->resizePartialObjects_anew(totalRecvd);
+        unpacker->update(hov, stream);
+
+        const int nthreads = 128;
+
+        SAFE_KERNEL_LAUNCH(
+            object_halo_exchange_kernels::unpackParticles,
+            getNblocks(totalRecvd, nthreads), nthreads, shMemSize, stream,
+            helper->wrapRecvData(), unpacker->handler() );
+        return;
+    }
 
     hov->resize_anew(totalRecvd * ov->getObjectSize());
     unpacker->update(hov, stream);
 
     const int nthreads = 256;
     const int nblocks = totalRecvd;
-    const size_t shMemSize = offsets.size() * sizeof(offsets[0]);
 
     mpark::visit([&](const auto& unpackerHandler)
     {
@@ -265,7 +430,7 @@ void ObjectHaloExchanger::combineAndUploadData(size_t id, cudaStream_t stream)
             object_halo_exchange_kernels::unpackObjects,
             nblocks, nthreads, shMemSize, stream,
             helper->wrapRecvData(), unpackerHandler );
-    }, exchangers_common::getHandler(unpacker));
+    }, exchangers_common::getObjectHandler(unpacker));
 }
 
 PinnedBuffer<int>& ObjectHaloExchanger::getSendOffsets(size_t id)
@@ -12,7 +12,7 @@ namespace mirheo
 {
 
 class ObjectVector;
-class ObjectPacker;
+class ParticlePacker;
 class MapEntry;
 
 /** \brief Pack and unpack data for halo object exchange.
@@ -23,6 +23,10 @@ class MapEntry;
     The result of this operation is stored in the halo LocalObjectVector.
 
     This is needed only when the full object is needed on the neighbour ranks (e.g. \c Bouncer or ObjectBelongingChecker).
+    Otherwise, the ObjectVector can be attached in "partial" mode: only the particles within one cut-off radius
+    of the subdomain boundaries are copied, without the object data.
+    The halo LocalObjectVector then contains no objects, which is enough for the pairwise interactions.
+    In that mode, the map and the send/recv offsets refer to particles instead of objects.
  */
 class ObjectHaloExchanger : public Exchanger
 {
@@ -35,20 +39,25 @@ public:
         \param ov The ObjectVector to attach
         \param rc The required cut-off radius
         \param extraChannelNames The list of channels to exchange (additionally to the default positions and velocities)
+        \param fullObjects If \c true, exchange the full objects; otherwise only the particles close to the boundaries.
 
         Multiple ObjectVector objects can be attached to the same halo exchanger.
      */
-    void attach(ObjectVector *ov, real rc, const std::vector<std::string>& extraChannelNames);
+    void attach(ObjectVector *ov, real rc, const std::vector<std::string>& extraChannelNames, bool fullObjects = true);
+
+    /// \return \c true if the given ov is exchanged as full objects, \c false if only particles are exchanged
+    bool exchangesFullObjects(size_t id) const;
 
     PinnedBuffer<int>& getSendOffsets(size_t id); ///< \return send offset within the send buffer (in number of elements) of the given ov
     PinnedBuffer<int>& getRecvOffsets(size_t id); ///< \return recv offset within the send buffer (in number of elements) of the given ov
-    DeviceBuffer<MapEntry>& getMap   (size_t id); ///< \return The map from LocalObjectVector to send buffer ids
+    DeviceBuffer<MapEntry>& getMap   (size_t id); ///< \return The map from LocalObjectVector (objects or particles) to send buffer ids
 
 private:
     std::vector<real> rcs_; ///< list of cut-off radius of all registered ovs
     std::vector<ObjectVector*> objects_; ///< list of registered ovs
-    std::vector<std::unique_ptr<ObjectPacker>> packers_; ///< helper classes to pack the registered ovs
-    std::vector<std::unique_ptr<ObjectPacker>> unpackers_; ///< helper classes to unpack the registered ovs
+    std::vector<bool> fullObjects_; ///< exchange mode of all registered ovs
+    std::vector<std::unique_ptr<ParticlePacker>> packers_; ///< helper classes to pack the registered ovs
+    std::vector<std::unique_ptr<ParticlePacker>> unpackers_; ///< helper classes to unpack the registered ovs
     std::vector<DeviceBuffer<MapEntry>> maps_; ///< maps from LocalObjectVector to send buffer ids
 
     void prepareSizes(size_t id, cudaStream_t stream) override;
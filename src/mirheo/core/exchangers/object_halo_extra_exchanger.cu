@@ -61,6 +61,52 @@ __global__ void unpack(BufferOffsetsSizesWrap dataWrap, PackerHandler packer)
 
     packer.blockUnpack(numElements, buffer, srcObjId, dstObjId);
 }
+
+__global__ void packParticles(DomainInfo domain, ParticlePackerHandler packer, const MapEntry *map,
+                              int numPackedParticles, BufferOffsetsSizesWrap dataWrap)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= numPackedParticles) return;
+
+    auto mapEntry = map[i];
+
+    const int bufId  = mapEntry.getBufId();
+    const int srcPid = mapEntry.getId();
+    const int dstPid = i - dataWrap.offsets[bufId];
+    const int numElements = dataWrap.sizes[bufId];
+
+    auto buffer = dataWrap.getBuffer(bufId);
+    auto dir   = fragment_mapping::getDir(bufId);
+    auto shift = exchangers_common::getShift(domain.localSize, dir);
+
+    packer.particles.packShift(srcPid, dstPid, buffer, numElements, shift);
+}
+
+__global__ void unpackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerHandler packer)
+{
+    const int tid = threadIdx.x;
+    const int pid = tid + blockIdx.x * blockDim.x;
+
+    extern __shared__ int offsets[];
+
+    const int nBuffers = dataWrap.nBuffers;
+
+    for (int i = tid; i < nBuffers + 1; i += blockDim.x)
+        offsets[i] = dataWrap.offsets[i];
+    __syncthreads();
+
+    if (pid >= offsets[nBuffers]) return;
+
+    const int bufId = dispatchThreadsPerBuffer(nBuffers, offsets, pid);
+    auto buffer = dataWrap.getBuffer(bufId);
+    const int numElements = dataWrap.sizes[bufId];
+
+    const int srcPid = pid - offsets[bufId];
+    const int dstPid = pid;
+
+    packer.particles.unpack(srcPid, dstPid, buffer, numElements);
+}
+
 } // namespace object_halo_extra_exchanger_kernels
 
 
@@ -90,9 +136,14 @@ void ObjectExtraExchanger::attach(ObjectVector *ov, const std::vector<std::strin
             != extraChannelNames.end();
     };
 
-    std::unique_ptr<ObjectPacker> packer, unpacker;
+    std::unique_ptr<ParticlePacker> packer, unpacker;
 
-    if (rv == nullptr)
+    if (!entangledHaloExchanger_->exchangesFullObjects(id))
+    {
+        packer   = std::make_unique<ParticlePacker>(predicate);
+        unpacker = std::make_unique<ParticlePacker>(predicate);
+    }
+    else if (rv == nullptr)
     {
         packer   = std::make_unique<ObjectPacker>(predicate);
         unpacker = std::make_unique<ObjectPacker>(predicate);
@@ -136,6 +187,20 @@ void ObjectExtraExchanger::prepareData(size_t id, cudaStream_t stream)
     helper->send.uploadInfosToDevice(stream);
     helper->resizeSendBuf();
 
+    if (!entangledHaloExchanger_->exchangesFullObjects(id))
+    {
+        const int nthreads = 128;
+        const int nparticles = static_cast<int>(map.size());
+
+        if (nparticles > 0)
+            SAFE_KERNEL_LAUNCH(
+                object_halo_extra_exchanger_kernels::packParticles,
+                getNblocks(nparticles, nthreads), nthreads, 0, stream,
+                ov->getState()->domain, packer->handler(), map.devPtr(),
+                nparticles, helper->wrapSendData() );
+        return;
+    }
+
     const int nthreads = 256;
     const int nblocks = static_cast<int>(map.size());
 
@@ -146,7 +211,7 @@ void ObjectExtraExchanger::prepareData(size_t id, cudaStream_t stream)
             nblocks, nthreads, 0, stream,
             ov->getState()->domain, packerHandler, map.devPtr(),
             helper->wrapSendData() );
-    }, exchangers_common::getHandler(packer));
+    }, exchangers_common::getObjectHandler(packer));
 }
 
 void ObjectExtraExchanger::combineAndUploadData(size_t id, cudaStream_t stream)
@@ -159,13 +224,27 @@ void ObjectExtraExchanger::combineAndUploadData(size_t id, cudaStream_t stream)
     const auto& offsets = helper->recv.offsets;
 
     const int totalRecvd = offsets[helper->nBuffers];
+    const size_t shMemSize = offsets.size() * sizeof(offsets[0]);
+
+    if (!entangledHaloExchanger_->exchangesFullObjects(id))
+    {
+        hov->resizePartialObjects_anew(totalRecvd);
+        unpacker->update(hov, stream);
+
+        const int nthreads = 128;
+
+        SAFE_KERNEL_LAUNCH(
+            object_halo_extra_exchanger_kernels::unpackParticles,
+            getNblocks(totalRecvd, nthreads), nthreads, shMemSize, stream,
+            helper->wrapRecvData(), unpacker->handler() );
+        return;
+    }
 
     hov->resize_anew(totalRecvd * ov->getObjectSize());
     unpacker->update(hov, stream);
 
     const int nthreads = 256;
     const int nblocks  = totalRecvd;
-    const size_t shMemSize = offsets.size() * sizeof(offsets[0]);
 
     mpark::visit([&](auto unpackerHandler)
     {
@@ -173,7 +252,7 @@ void ObjectExtraExchanger::combineAndUploadData(size_t id, cudaStream_t stream)
             object_halo_extra_exchanger_kernels::unpack,
             nblocks, nthreads, shMemSize, stream,
             helper->wrapRecvData(), unpackerHandler );
-    }, exchangers_common::getHandler(unpacker));
+    }, exchangers_common::getObjectHandler(unpacker));
 }
 
 } // namespace mirheo
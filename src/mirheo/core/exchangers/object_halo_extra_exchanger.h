@@ -13,7 +13,7 @@ namespace mirheo
 {
 
 class ObjectVector;
-class ObjectPacker;
+class ParticlePacker;
 class ObjectHaloExchanger;
 
 /** \brief Pack and unpack extra data for halo object exchange.
@@ -22,7 +22,8 @@ class ObjectHaloExchanger;
     This class only exchanges the additional data (not e.g. the default particle's positions and velocities).
     It uses the packing map from an external ObjectHaloExchanger.
     The attached ObjectVector objects must be the same as the ones in the external ObjectHaloExchanger
-    (and in the same order).
+    (and in the same order); the data is exchanged per object or per particle, following the mode of the
+    ObjectHaloExchanger.
  */
 class ObjectExtraExchanger : public Exchanger
 {
@@ -42,7 +43,7 @@ public:
 private:
     std::vector<ObjectVector*> objects_;
     ObjectHaloExchanger *entangledHaloExchanger_;
-    std::vector<std::unique_ptr<ObjectPacker>> packers_, unpackers_;
+    std::vector<std::unique_ptr<ParticlePacker>> packers_, unpackers_;
 
     void prepareSizes(size_t id, cudaStream_t stream) override;
     void prepareData (size_t id, cudaStream_t stream) override;
@@ -61,6 +61,49 @@ __global__ void reverseUnpackAndAdd(PackerHandler packer, const MapEntry *map,
     packer.blockUnpackAddNonZero(numElements, buffer, srcObjId, dstObjId, eps);
 }
 
+__global__ void reversePackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerHandler packer)
+{
+    const int tid = threadIdx.x;
+    const int pid = tid + blockIdx.x * blockDim.x;
+
+    extern __shared__ int offsets[];
+
+    const int nBuffers = dataWrap.nBuffers;
+
+    for (int i = tid; i < nBuffers + 1; i += blockDim.x)
+        offsets[i] = dataWrap.offsets[i];
+    __syncthreads();
+
+    if (pid >= offsets[nBuffers]) return;
+
+    const int bufId = dispatchThreadsPerBuffer(nBuffers, offsets, pid);
+    auto buffer = dataWrap.getBuffer(bufId);
+    const int numElements = dataWrap.sizes[bufId];
+
+    const int dstPid = pid - offsets[bufId];
+    const int srcPid = pid;
+
+    packer.particles.pack(srcPid, dstPid, buffer, numElements);
+}
+
+__global__ void reverseUnpackAndAddParticles(ParticlePackerHandler packer, const MapEntry *map,
+                                             int numParticles, BufferOffsetsSizesWrap dataWrap)
+{
+    constexpr real eps = 1e-6_r;
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= numParticles) return;
+
+    const MapEntry mapEntry = map[i];
+    const int bufId  = mapEntry.getBufId();
+    const int dstPid = mapEntry.getId();
+    const int srcPid = i - dataWrap.offsets[bufId];
+    const int numElements = dataWrap.sizes[bufId];
+
+    auto buffer = dataWrap.getBuffer(bufId);
+
+    packer.particles.unpackAtomicAddNonZero(srcPid, dstPid, buffer, numElements, eps);
+}
+
 } // namespace object_reverse_exchanger_kernels
 
 
@@ -85,9 +128,14 @@ void ObjectReverseExchanger::attach(ObjectVector *ov, std::vector<std::string> c
             != channelNames.end();
     };
 
-    std::unique_ptr<ObjectPacker> packer, unpacker;
+    std::unique_ptr<ParticlePacker> packer, unpacker;
 
-    if (rv == nullptr)
+    if (!entangledHaloExchanger_->exchangesFullObjects(id))
+    {
+        packer   = std::make_unique<ParticlePacker>(predicate);
+        unpacker = std::make_unique<ParticlePacker>(predicate);
+    }
+    else if (rv == nullptr)
     {
         packer   = std::make_unique<ObjectPacker>(predicate);
         unpacker = std::make_unique<ObjectPacker>(predicate);
@@ -143,19 +191,31 @@ void ObjectReverseExchanger::prepareData(size_t id, cudaStream_t stream)
 
     const auto& offsets = helper->send.offsets;
     const int nSendObj = offsets[helper->nBuffers];
+    const size_t shMemSize = offsets.size() * sizeof(offsets[0]);
+
+    if (!entangledHaloExchanger_->exchangesFullObjects(id))
+    {
+        const int nthreads = 128;
+
+        SAFE_KERNEL_LAUNCH(
+            object_reverse_exchanger_kernels::reversePackParticles,
+            getNblocks(nSendObj, nthreads), nthreads, shMemSize, stream,
+            helper->wrapSendData(), packer->handler() );
+
+        debug2("Will send back data for %d particles", nSendObj);
+        return;
+    }
 
     const int nthreads = 256;
     const int nblocks = nSendObj;
 
-    const size_t shMemSize = offsets.size() * sizeof(offsets[0]);
-
     mpark::visit([&](auto packerHandler)
     {
         SAFE_KERNEL_LAUNCH(
             object_reverse_exchanger_kernels::reversePack,
             nblocks, nthreads, shMemSize, stream,
             helper->wrapSendData(), packerHandler );
-    }, exchangers_common::getHandler(packer));
+    }, exchangers_common::getObjectHandler(packer));
 
     debug2("Will send back data for %d objects", nSendObj);
 }
@@ -172,6 +232,22 @@ void ObjectReverseExchanger::combineAndUploadData(size_t id, cudaStream_t stream
     const int totalRecvd = helper->recv.offsets[helper->nBuffers];
     auto& map = entangledHaloExchanger_->getMap(id);
 
+    if (!entangledHaloExchanger_->exchangesFullObjects(id))
+    {
+        debug("Updating data for %d '%s' particles", totalRecvd, ov->getCName());
+
+        const int nthreads = 128;
+        const int nparticles = static_cast<int>(map.size());
+
+        if (nparticles > 0)
+            SAFE_KERNEL_LAUNCH(
+                object_reverse_exchanger_kernels::reverseUnpackAndAddParticles,
+                getNblocks(nparticles, nthreads), nthreads, 0, stream,
+                unpacker->handler(), map.devPtr(), nparticles,
+                helper->wrapRecvData() );
+        return;
+    }
+
     debug("Updating data for %d '%s' objects", totalRecvd, ov->getCName());
 
     const int nthreads = 256;
@@ -183,7 +259,7 @@ void ObjectReverseExchanger::combineAndUploadData(size_t id, cudaStream_t stream
             static_cast<int>(map.size()), nthreads, 0, stream,
             unpackerHandler, map.devPtr(),
             helper->wrapRecvData());
-    }, exchangers_common::getHandler(unpacker));
+    }, exchangers_common::getObjectHandler(unpacker));
 }
 
 } // namespace mirheo
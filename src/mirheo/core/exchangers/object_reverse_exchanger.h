@@ -13,13 +13,14 @@ namespace mirheo
 
 class ObjectVector;
 class ObjectHaloExchanger;
-class ObjectPacker;
+class ParticlePacker;
 
 /** \brief Pack and unpack data from ghost particles back to the original bulk data.
 
     The ghost particles data must come from a ObjectHaloExchanger object.
     The attached ObjectVector objects must be the same as the ones in the external ObjectHaloExchanger
-    (and in the same order).
+    (and in the same order); the data is sent back per object or per particle, following the mode of the
+    ObjectHaloExchanger.
  */
 class ObjectReverseExchanger : public Exchanger
 {
@@ -39,7 +40,7 @@ public:
 private:
     std::vector<ObjectVector*> objects_;
     ObjectHaloExchanger *entangledHaloExchanger_;
-    std::vector<std::unique_ptr<ObjectPacker>> packers_, unpackers_;
+    std::vector<std::unique_ptr<ParticlePacker>> packers_, unpackers_;
 
     void prepareSizes(size_t id, cudaStream_t stream) override;
     void prepareData (size_t id, cudaStream_t stream) override;
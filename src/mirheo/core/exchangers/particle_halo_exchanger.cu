@@ -9,6 +9,7 @@
 
 #include <mirheo/core/celllist.h>
 #include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/packers/compressed_particles.h>
 #include <mirheo/core/pvs/packers/particles.h>
 #include <mirheo/core/pvs/particle_vector.h>
 #include <mirheo/core/utils/cuda_common.h>
@@ -28,9 +29,33 @@ enum class PackMode
 namespace particle_halo_exchangers_kernels
 {
 
-template <PackMode packMode>
+__device__ inline void packShift(const ParticlePackerHandler& packer, int srcId, int dstId,
+                                 char *buffer, int numElements, real3 shift)
+{
+    packer.particles.packShift(srcId, dstId, buffer, numElements, shift);
+}
+
+__device__ inline void packShift(const CompressedParticlePackerHandler& packer, int srcId, int dstId,
+                                 char *buffer, int numElements, real3 shift)
+{
+    packer.packShift(srcId, dstId, buffer, numElements, shift);
+}
+
+__device__ inline void unpack(const ParticlePackerHandler& packer, int srcId, int dstId,
+                              const char *buffer, int numElements)
+{
+    packer.particles.unpack(srcId, dstId, buffer, numElements);
+}
+
+__device__ inline void unpack(const CompressedParticlePackerHandler& packer, int srcId, int dstId,
+                              const char *buffer, int numElements)
+{
+    packer.unpack(srcId, dstId, buffer, numElements);
+}
+
+template <PackMode packMode, class PackerHandler>
 __global__ void getHalo(const CellListInfo cinfo, DomainInfo domain,
-                        ParticlePackerHandler packer, BufferOffsetsSizesWrap dataWrap)
+                        PackerHandler packer, BufferOffsetsSizesWrap dataWrap)
 {
     const int gid = blockIdx.x*blockDim.x + threadIdx.x;
     const int tid = threadIdx.x;
@@ -99,13 +124,14 @@ __global__ void getHalo(const CellListInfo cinfo, DomainInfo domain,
                 const int dstPid = myId   + i;
                 const int srcPid = pstart + i;
 
-                packer.particles.packShift(srcPid, dstPid, buffer, numElements, shift);
+                packShift(packer, srcPid, dstPid, buffer, numElements, shift);
             }
         }
     }
 }
 
-__global__ void unpackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerHandler packer)
+template <class PackerHandler>
+__global__ void unpackParticles(BufferOffsetsSizesWrap dataWrap, PackerHandler packer)
 {
     const int tid = threadIdx.x;
     const int pid = tid + blockIdx.x * blockDim.x;
@@ -128,7 +154,7 @@ __global__ void unpackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerH
     const int srcPid = pid - offsets[bufId];
     const int dstPid = pid;
 
-    packer.particles.unpack(srcPid, dstPid, buffer, numElements);
+    unpack(packer, srcPid, dstPid, buffer, numElements);
 }
 
 } //namespace particle_halo_exchangers_kernels
@@ -141,11 +167,23 @@ __global__ void unpackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerH
 ParticleHaloExchanger::ParticleHaloExchanger() = default;
 ParticleHaloExchanger::~ParticleHaloExchanger() = default;
 
-void ParticleHaloExchanger::attach(ParticleVector *pv, CellList *cl, const std::vector<std::string>& extraChannelNames)
+// call f with the device handler of the packer
+template <class F>
+static void visitHandler(ParticlePacker *packer, bool compressed, F&& f)
+{
+    if (compressed)
+        f(static_cast<CompressedParticlePacker*>(packer)->compressedHandler());
+    else
+        f(packer->handler());
+}
+
+void ParticleHaloExchanger::attach(ParticleVector *pv, CellList *cl, const std::vector<std::string>& extraChannelNames,
+                                   bool compressed)
 {
     const size_t id = particles_.size();
     particles_.push_back(pv);
     cellLists_.push_back(cl);
+    compressed_.push_back(compressed);
 
     auto channels = extraChannelNames;
     channels.push_back(channel_names::positions);
@@ -156,9 +194,20 @@ void ParticleHaloExchanger::attach(ParticleVector *pv, CellList *cl, const std::
         return std::find(channels.begin(), channels.end(), namedDesc.first) != channels.end();
     };
 
-    auto   packer = std::make_unique<ParticlePacker> (predicate);
-    auto unpacker = std::make_unique<ParticlePacker> (predicate);
-    auto   helper = std::make_unique<ExchangeEntity> (pv->getName(), id, packer.get());
+    std::unique_ptr<ParticlePacker> packer, unpacker;
+
+    if (compressed)
+    {
+        packer   = std::make_unique<CompressedParticlePacker> (predicate, cl->ncells, cl->localDomainSize);
+        unpacker = std::make_unique<CompressedParticlePacker> (predicate, cl->ncells, cl->localDomainSize);
+    }
+    else
+    {
+        packer   = std::make_unique<ParticlePacker> (predicate);
+        unpacker = std::make_unique<ParticlePacker> (predicate);
+    }
+
+    auto helper = std::make_unique<ExchangeEntity> (pv->getName(), id, packer.get());
 
     this->addExchangeEntity(std::move(  helper));
     packers_  .push_back(std::move(  packer));
@@ -167,8 +216,9 @@ void ParticleHaloExchanger::attach(ParticleVector *pv, CellList *cl, const std::
     std::string msg_channels = channels.empty() ? "no channels." : "with channels: ";
     for (const auto& ch : channels) msg_channels += "'" + ch + "' ";
 
-    info("Particle halo exchanger takes pv '%s' with celllist of rc = %g, %s",
-         pv->getCName(), cl->rc, msg_channels.c_str());
+    info("Particle halo exchanger takes pv '%s' with celllist of rc = %g, %s%s",
+         pv->getCName(), cl->rc, msg_channels.c_str(),
+         compressed ? " (compressed positions and velocities)" : "");
 }
 
 void ParticleHaloExchanger::prepareSizes(size_t id, cudaStream_t stream)
@@ -192,11 +242,15 @@ void ParticleHaloExchanger::prepareSizes(size_t id, cudaStream_t stream)
         const int nfaces   = 6;
         const dim3 nblocks = dim3(getNblocks(maxdim*maxdim, nthreads), nfaces, 1);
 
-        SAFE_KERNEL_LAUNCH(
-            particle_halo_exchangers_kernels::getHalo<PackMode::Query>,
-            nblocks, nthreads, 0, stream,
-            cl->cellInfo(), pv->getState()->domain,
-            packer->handler(), helper->wrapSendData() );
+        visitHandler(packer, compressed_[id], [&](auto handler)
+        {
+            using Handler = decltype(handler);
+            SAFE_KERNEL_LAUNCH(
+                particle_halo_exchangers_kernels::getHalo<PackMode::Query COMMA Handler>,
+                nblocks, nthreads, 0, stream,
+                cl->cellInfo(), pv->getState()->domain,
+                handler, helper->wrapSendData() );
+        });
     }
 
     helper->computeSendOffsets_Dev2Dev(stream);
@@ -225,11 +279,15 @@ void ParticleHaloExchanger::prepareData(size_t id, cudaStream_t stream)
         helper->resizeSendBuf();
         helper->send.sizes.clearDevice(stream);
 
-        SAFE_KERNEL_LAUNCH(
-            particle_halo_exchangers_kernels::getHalo<PackMode::Pack>,
-            nblocks, nthreads, 0, stream,
-            cl->cellInfo(), pv->getState()->domain,
-            packer->handler(), helper->wrapSendData() );
+        visitHandler(packer, compressed_[id], [&](auto handler)
+        {
+            using Handler = decltype(handler);
+            SAFE_KERNEL_LAUNCH(
+                particle_halo_exchangers_kernels::getHalo<PackMode::Pack COMMA Handler>,
+                nblocks, nthreads, 0, stream,
+                cl->cellInfo(), pv->getState()->domain,
+                handler, helper->wrapSendData() );
+        });
     }
 }
 
@@ -254,10 +312,13 @@ void ParticleHaloExchanger::combineAndUploadData(size_t id, cudaStream_t stream)
     const int nblocks  = getNblocks(totalRecvd, nthreads);
     const size_t shMemSize = offsets.size() * sizeof(offsets[0]);
 
-    SAFE_KERNEL_LAUNCH(
-        particle_halo_exchangers_kernels::unpackParticles,
-        nblocks, nthreads, shMemSize, stream,
-        helper->wrapRecvData(), unpacker->handler());
+    visitHandler(unpacker, compressed_[id], [&](auto handler)
+    {
+        SAFE_KERNEL_LAUNCH(
+            particle_halo_exchangers_kernels::unpackParticles,
+            nblocks, nthreads, shMemSize, stream,
+            helper->wrapRecvData(), handler);
+    });
 
     pv->haloValid = true;
 }
@@ -30,14 +30,17 @@ public:
         \param pv The ParticleVector to attach
         \param cl The associated cell-list of \p pv
         \param extraChannelNames The list of channels to exchange (additionally to the default positions and velocities)
+        \param compressed If \c true, positions and velocities are sent with reduced size (see halo_compression).
 
         Multiple ParticleVector objects can be attached to the same halo exchanger.
      */
-    void attach(ParticleVector *pv, CellList *cl, const std::vector<std::string>& extraChannelNames);
+    void attach(ParticleVector *pv, CellList *cl, const std::vector<std::string>& extraChannelNames,
+                bool compressed = false);
 
 private:
     std::vector<CellList*> cellLists_;
     std::vector<ParticleVector*> particles_;
+    std::vector<bool> compressed_;
     std::vector<std::unique_ptr<ParticlePacker>> packers_, unpackers_;
 
     void prepareSizes(size_t id, cudaStream_t stream) override;
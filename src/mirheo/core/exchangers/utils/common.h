@@ -42,6 +42,12 @@ inline VarPackHandler getHandler(ObjectPacker *packer)
     return packer->handler();
 }
 
+/// \return The handler of a packer that is known to be an ObjectPacker
+inline VarPackHandler getObjectHandler(ParticlePacker *packer)
+{
+    return getHandler(static_cast<ObjectPacker*>(packer));
+}
+
 } // namespace exchangers_common
 
 } // namespace mirheo
@@ -3,6 +3,8 @@
 
 #include <mirheo/core/utils/cuda_common.h>
 
+#include <vector>
+
 namespace mirheo
 {
 
@@ -40,9 +42,15 @@ void FieldFromFunction::setup(__UNUSED const MPI_Comm& comm)
 
     PinnedBuffer<float> fieldRawData (resolution_.x * resolution_.y * resolution_.z);
 
+    // evaluate the function one z plane at a time to limit the memory footprint
+    const int planeSize = resolution_.x * resolution_.y;
+    std::vector<real3> positions(planeSize);
+    std::vector<real> values(planeSize);
+
     int3 i;
     int id = 0;
     for (i.z = 0; i.z < resolution_.z; ++i.z) {
+        int planeId = 0;
         for (i.y = 0; i.y < resolution_.y; ++i.y) {
             for (i.x = 0; i.x < resolution_.x; ++i.x) {
                 real3 r {static_cast<real>(i.x) * h_.x,
@@ -52,9 +60,14 @@ void FieldFromFunction::setup(__UNUSED const MPI_Comm& comm)
                 r  = domain.local2global(r);
                 r  = make_periodic(r, domain.globalSize);
 
-                fieldRawData[id++] = static_cast<float>(func_(r));
+                positions[planeId++] = r;
             }
         }
+
+        func_(positions.data(), planeSize, values.data());
+
+        for (int j = 0; j < planeSize; ++j)
+            fieldRawData[id++] = static_cast<float>(values[j]);
     }
 
     fieldRawData.uploadToDevice(defaultStream);
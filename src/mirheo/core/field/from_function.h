@@ -1,13 +1,13 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "interface.h"
 
-#include <functional>
+#include <mirheo/core/utils/position_function.h>
 
 namespace mirheo
 {
 
-/// A function that describes a scala field
-using FieldFunction = std::function<real(real3)>;
+/// A function that describes a scalar field; can be evaluated in batches of positions
+using FieldFunction = PositionFunction<real>;
 
 /** \brief a \c Field that can be initialized from FieldFunction
  */
@@ -23,6 +23,7 @@ public:
         The scalar values will be discretized and stored on the grid.
         This can be useful as one can have a general scalar field configured
         on the host (e.g. from python) but usable on the device.
+        The function is evaluated once per plane of the grid, with all the positions of that plane.
     */
     FieldFromFunction(const MirState *state, std::string name, FieldFunction func, real3 h);
     ~FieldFromFunction();
@@ -1,9 +1,12 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include <functional>
+#include <memory>
 #include <random>
+#include <vector>
 
 #include <mirheo/core/logger.h>
 #include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/utils/old_positions.h>
 #include <mirheo/core/utils/common.h>
 
 #include "helpers.h"
@@ -11,8 +14,6 @@
 namespace mirheo
 {
 
-using PositionFilter = std::function<bool(real3)>;
-
 static long genSeed(const MPI_Comm& comm, const std::string& name)
 {
     int rank;
@@ -54,12 +55,11 @@ void setUniformParticles(real numberDensity, const MPI_Comm& comm, ParticleVecto
     std::mt19937 gen(seed);
     std::uniform_real_distribution<float> udistr(0, 1); // use float to get the same refs for tests
 
-    double3 avgMomentum {0,0,0};
-    int mycount {0};
-
     std::vector<real4> pos, vel;
+    std::vector<real3> globalPos;
     pos.reserve(ncells.x * ncells.y * ncells.z * static_cast<int>(math::ceil(numPartsPerCell)));
     vel.reserve(ncells.x * ncells.y * ncells.z * static_cast<int>(math::ceil(numPartsPerCell)));
+    globalPos.reserve(pos.capacity());
 
     for (int i = 0; i < ncells.x; ++i) {
         for (int j = 0; j < ncells.y; ++j) {
@@ -73,22 +73,40 @@ void setUniformParticles(real numberDensity, const MPI_Comm& comm, ParticleVecto
                 {
                     const Particle part = genParticle(h, i, j, k, domain, udistr, gen);
 
-                    if (! filterIn(domain.local2global(part.r)))
-                        continue;
-
                     pos.push_back(part.r2Real4());
                     vel.push_back(part.u2Real4());
-
-                    avgMomentum.x += part.u.x;
-                    avgMomentum.y += part.u.y;
-                    avgMomentum.z += part.u.z;
-
-                    mycount++;
+                    globalPos.push_back(domain.local2global(part.r));
                 }
             }
         }
     }
 
+    // evaluate the filter on all candidates at once
+    const int ncandidates = static_cast<int>(pos.size());
+    std::unique_ptr<bool[]> keep(new bool[ncandidates]);
+    filterIn(globalPos.data(), ncandidates, keep.get());
+
+    double3 avgMomentum {0,0,0};
+    int mycount {0};
+
+    for (int i = 0; i < ncandidates; ++i)
+    {
+        if (!keep[i])
+            continue;
+
+        pos[mycount] = pos[i];
+        vel[mycount] = vel[i];
+
+        avgMomentum.x += vel[i].x;
+        avgMomentum.y += vel[i].y;
+        avgMomentum.z += vel[i].z;
+
+        mycount++;
+    }
+
+    pos.resize(mycount);
+    vel.resize(mycount);
+
     pv->local()->resize(mycount, stream);
     std::copy(pos.begin(), pos.end(), pv->local()->positions ().begin());
     std::copy(vel.begin(), vel.end(), pv->local()->velocities().begin());
@@ -107,7 +125,7 @@ void setUniformParticles(real numberDensity, const MPI_Comm& comm, ParticleVecto
     pv->local()->positions() .uploadToDevice(stream);
     pv->local()->velocities().uploadToDevice(stream);
     pv->local()->computeGlobalIds(comm, stream);
-    pv->local()->dataPerParticle.getData<real4>(channel_names::oldPositions)->copy(pv->local()->positions(), stream);
+    storeOldPositions(pv, pv->local()->positions().devPtr(), stream);
 
     debug2("Generated %d %s particles", pv->local()->size(), pv->getCName());
 }
@@ -1,7 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include <mirheo/core/datatypes.h>
+#include <mirheo/core/utils/position_function.h>
 
-#include <functional>
 #include <mpi.h>
 #include <cuda_runtime.h>
 #include <vector_types.h>
@@ -9,8 +9,8 @@
 namespace mirheo
 {
 
-/// \brief Returns `true` if the position is in, `false` otherwise.
-using PositionFilter = std::function<bool(real3)>;
+/// \brief Returns `true` if the position is in, `false` otherwise. Can be evaluated in batches of positions.
+using PositionFilter = PositionFunction<bool>;
 
 class ParticleVector;
 
@@ -19,6 +19,7 @@ class ParticleVector;
     \param [in] comm MPI communicator with Cartesian topology.
     \param [in,out] pv ParticleVector that will store the new particles.
     \param [in] filterOut Indicator function that is true inside the considered domain.
+                          It is evaluated once with all the generated positions.
     \param [in] stream The stream used to upload data.
  */
 void setUniformParticles(real numberDensity, const MPI_Comm& comm, ParticleVector *pv, PositionFilter filterOut, cudaStream_t stream);
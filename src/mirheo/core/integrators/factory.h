@@ -76,9 +76,9 @@ createOscillating(const MirState *state, const std::string& name, real3 velocity
 
 inline std::shared_ptr<IntegratorSubStepShardlowSweep>
 createSubstepShardlowSweep(const MirState *state, const std::string& name, int substeps,
-                           BaseMembraneInteraction* fastForces, real gammaC, real kBT, int nsweeps)
+                           BaseMembraneInteraction* fastForces, real gammaC, real kBT, int nsweeps, bool fused)
 {
-    return std::make_shared<IntegratorSubStepShardlowSweep> (state, name, substeps, fastForces, gammaC, kBT, nsweeps);
+    return std::make_shared<IntegratorSubStepShardlowSweep> (state, name, substeps, fastForces, gammaC, kBT, nsweeps, fused);
 }
 
 inline std::shared_ptr<IntegratorVVRigid>
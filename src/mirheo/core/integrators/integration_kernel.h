@@ -1,10 +1,12 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include <mirheo/core/celllist.h>
 #include <mirheo/core/datatypes.h>
 #include <mirheo/core/pvs/particle_vector.h>
 #include <mirheo/core/pvs/views/pv.h>
 #include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/half_precision.h>
 #include <mirheo/core/utils/kernel_launch.h>
 
 namespace mirheo
@@ -13,6 +15,22 @@ namespace mirheo
 namespace integration_kernels
 {
 
+/// \return the position of the particle before the step: see prepareOldPositions()
+__device__ inline real4 readPositionBeforeStep(const PVviewWithOldParticles& pvView, int pid)
+{
+    if (pvView.oldPositionDeltas != nullptr)
+        return readNoCache(pvView.positions + pid);
+    else
+        return readNoCache(pvView.oldPositions + pid);
+}
+
+/// store the old position as a delta, if required
+__device__ inline void writeOldPositionDelta(const PVviewWithOldParticles& pvView, int pid, real3 rOld, real3 rNew)
+{
+    if (pvView.oldPositionDeltas != nullptr)
+        pvView.oldPositionDeltas[pid] = half_precision::packHalf3(rOld - rNew);
+}
+
 /**
  * \code transform(Particle& p, const real3 f, const real invm, const real dt) \endcode
  *  is a callable that performs integration. It is called for
@@ -20,6 +38,7 @@ namespace integration_kernels
  *  of the Particle according to the chosen integration scheme.
  *
  * Will read positions from \c oldPositions channel and write to positions
+ * (or read and write positions and store the deltas, see OldPositionsStorage)
  * Will read velocities from velocities and write to velocities
  */
 template<typename Transform>
@@ -28,8 +47,32 @@ __global__ void integrate(PVviewWithOldParticles pvView, const real dt, Transfor
     const int pid = blockIdx.x * blockDim.x + threadIdx.x;
     if (pid >= pvView.size) return;
 
-    real4 pos = readNoCache(pvView.oldPositions + pid);
-    real4 vel = readNoCache(pvView.velocities   + pid);
+    real4 pos = readPositionBeforeStep(pvView, pid);
+    real4 vel = readNoCache(pvView.velocities + pid);
+    Real3_int frc(pvView.forces[pid]);
+
+    Particle p(pos, vel);
+
+    transform(p, frc.v, pvView.invMass, dt);
+
+    writeNoCache(pvView.positions  + pid, p.r2Real4());
+    writeNoCache(pvView.velocities + pid, p.u2Real4());
+    writeOldPositionDelta(pvView, pid, make_real3(pos), p.r);
+}
+
+/**
+ * Same as integrate(); in addition, counts the particles into the cells
+ * of \p binning and clears their forces.
+ */
+template<typename Transform>
+__global__ void integrateAndBin(PVviewWithOldParticles pvView, const real dt, Transform transform,
+                                FusedBinningView binning)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= pvView.size) return;
+
+    real4 pos = readPositionBeforeStep(pvView, pid);
+    real4 vel = readNoCache(pvView.velocities + pid);
     Real3_int frc(pvView.forces[pid]);
 
     Particle p(pos, vel);
@@ -38,18 +81,27 @@ __global__ void integrate(PVviewWithOldParticles pvView, const real dt, Transfor
 
     writeNoCache(pvView.positions  + pid, p.r2Real4());
     writeNoCache(pvView.velocities + pid, p.u2Real4());
+    writeOldPositionDelta(pvView, pid, make_real3(pos), p.r);
+    writeNoCache(pvView.forces     + pid, make_real4(0.0_r, 0.0_r, 0.0_r, 0.0_r));
+
+    binning.add(pid, p.r);
 }
 
 } // namespace integration_kernels
 
+/// New particles now become old; with OldPositionsStorage::HalfDelta, the kernels compute the deltas instead
+inline void prepareOldPositions(ParticleVector *pv)
+{
+    if (pv->getOldPositionsStorage() == OldPositionsStorage::Full)
+        std::swap(pv->local()->positions(), *pv->local()->dataPerParticle.getData<real4>(channel_names::oldPositions));
+}
 
 template<typename Transform>
 static void integrate(ParticleVector *pv, real dt, Transform transform, cudaStream_t stream)
 {
     constexpr int nthreads = 128;
 
-    // New particles now become old
-    std::swap(pv->local()->positions(), *pv->local()->dataPerParticle.getData<real4>(channel_names::oldPositions));
+    prepareOldPositions(pv);
     PVviewWithOldParticles pvView(pv, pv->local());
 
     SAFE_KERNEL_LAUNCH(
@@ -58,4 +110,19 @@ static void integrate(ParticleVector *pv, real dt, Transform transform, cudaStre
         pvView, dt, transform );
 }
 
+template<typename Transform>
+static void integrateAndBin(ParticleVector *pv, real dt, Transform transform, PrimaryCellList *cl, cudaStream_t stream)
+{
+    constexpr int nthreads = 128;
+
+    prepareOldPositions(pv);
+    PVviewWithOldParticles pvView(pv, pv->local());
+    const FusedBinningView binning = cl->prepareFusedBinning(stream);
+
+    SAFE_KERNEL_LAUNCH(
+        integration_kernels::integrateAndBin,
+        getNblocks(pvView.size, nthreads), nthreads, 0, stream,
+        pvView, dt, transform, binning );
+}
+
 } // namespace mirheo
@@ -1,6 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "interface.h"
 
+#include <mirheo/core/logger.h>
 #include <mirheo/core/pvs/particle_vector.h>
 #include <mirheo/core/utils/config.h>
 
@@ -16,6 +17,16 @@ Integrator::~Integrator() = default;
 void Integrator::setPrerequisites(__UNUSED ParticleVector *pv)
 {}
 
+void Integrator::executeAndBin(ParticleVector *pv, __UNUSED PrimaryCellList *cl, __UNUSED cudaStream_t stream)
+{
+    die("Integrator '%s' can not be fused with the cell-list build of pv '%s'", getCName(), pv->getCName());
+}
+
+bool Integrator::supportsFusedBinning() const
+{
+    return false;
+}
+
 void Integrator::invalidatePV_(ParticleVector *pv)
 {
     pv->haloValid   = false;
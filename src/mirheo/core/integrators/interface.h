@@ -10,6 +10,7 @@ namespace mirheo
 {
 
 class ParticleVector;
+class PrimaryCellList;
 
 /** \brief Advance ParticleVector objects in time.
 
@@ -46,6 +47,19 @@ public:
      */
     virtual void execute(ParticleVector *pv, cudaStream_t stream) = 0;
 
+    /** \brief Advance the ParticledVector for one time step and count its particles into cells in the same pass.
+        \param [in,out] pv The ParticleVector that will be advanced in time.
+        \param [in,out] cl The primary cell-list of \p pv; its next build uses the counts (see PrimaryCellList::prepareFusedBinning()).
+        \param [in] stream The stream used for execution.
+
+        The result is the same as execute(); in addition, the forces of \p pv are cleared.
+        Default: die. Must only be called if supportsFusedBinning() returns \c true.
+     */
+    virtual void executeAndBin(ParticleVector *pv, PrimaryCellList *cl, cudaStream_t stream);
+
+    /// \return \c true if the integrator implements executeAndBin(). Default: \c false.
+    virtual bool supportsFusedBinning() const;
+
 protected:
     /** \brief Invalidate ParticledVector cell-lists, halo and redistributed statuses.
         \param [in,out] pv The ParticleVector that must be invalidated.
@@ -4,6 +4,7 @@
 #include <mirheo/core/interactions/membrane/base_membrane.h>
 #include <mirheo/core/logger.h>
 #include <mirheo/core/pvs/membrane_vector.h>
+#include <mirheo/core/pvs/utils/old_positions.h>
 #include <mirheo/core/pvs/views/ov.h>
 #include <mirheo/core/utils/common.h>
 #include <mirheo/core/utils/config.h>
@@ -51,6 +52,45 @@ __global__ void velocityVerletStep2(PVview view, const real dt_2m)
     view.velocities[i] = v.toReal4();
 }
 
+/// Shardlow update of the velocities of the two vertices \p i and \p j connected by an edge.
+__device__ inline void sweepEdge(real3 ri, real3 rj, real3& vi, real3& vj, int i, int j,
+                                 real dt, real gamma, real sigma, real invMass, real seed)
+{
+    const real3 eij = normalize(rj - ri);
+
+    const real inv2m = 0.5_r * invMass;
+    const real dtgamma = dt * gamma;
+    const real sqrtdtsigma = math::sqrt(dt) * sigma;
+
+    // step 1: explicit
+    {
+        const real3 vij = vj - vi;
+        constexpr real sqrt_12 = 3.4641016151_r;
+        const real xiij = sqrt_12 * (Saru::uniform01(seed, i, j) - 0.5_r);
+
+        const real3 dv = (dtgamma * inv2m * dot(eij, vij) -
+                          sqrtdtsigma * inv2m * xiij) * eij;
+
+        vi += dv;
+        vj -= dv;
+    }
+
+    // step 2: implicit
+    {
+        const real3 vij = vj - vi;
+        constexpr real sqrt_12 = 3.4641016151_r;
+        const real xiij = sqrt_12 * (Saru::uniform01(seed, i, j) - 0.5_r);
+
+        const real frac = inv2m * dtgamma / (1.0_r + dtgamma);
+
+        const real3 dv = (frac * (dot(eij, vij) + sqrtdtsigma * xiij)
+                          - inv2m * sqrtdtsigma * xiij) * eij;
+
+        vi += dv;
+        vj -= dv;
+    }
+}
+
 __global__ void sweepVelocities(int nEdges, const int2 *edges, OVview view,
                                 real dt, real gamma, real sigma, real invMass, real seed)
 {
@@ -62,54 +102,89 @@ __global__ void sweepVelocities(int nEdges, const int2 *edges, OVview view,
     if (rbcId >= view.nObjects)
         return;
 
-    const real startId = rbcId * view.objSize;
+    const int startId = rbcId * view.objSize;
 
     const int i = startId + edges[edgeId].x;
     const int j = startId + edges[edgeId].y;
 
-
     const real3 ri = Real3_int( view.positions[i] ).v;
     const real3 rj = Real3_int( view.positions[j] ).v;
 
     Real3_int vi ( view.velocities[i] );
     Real3_int vj ( view.velocities[j] );
 
-    const real3 eij = normalize(rj - ri);
+    sweepEdge(ri, rj, vi.v, vj.v, i, j, dt, gamma, sigma, invMass, seed);
 
-    const real inv2m = 0.5_r * invMass;
-    const real dtgamma = dt * gamma;
-    const real sqrtdtsigma = math::sqrt(dt) * sigma;
+    view.velocities[i] = vi.toReal4();
+    view.velocities[j] = vj.toReal4();
+}
 
-    // step 1: explicit
+/** One sub step of IntegratorSubStepShardlowSweep, except for the fast forces, in a single kernel.
+    One block per membrane; the velocities of the membrane stay in shared memory during the sweeps.
+
+    Performs, in this order: the second velocity-Verlet half step of the previous sub step (if not \p firstSubStep),
+    all viscous sweeps, the first velocity-Verlet half step, and resets the forces to the slow forces.
+ */
+__global__ void fusedSubStep(OVview view, const Force *slowForces,
+                             int numColors, const int *colorStarts, const int2 *edges,
+                             int nsweeps, const real *seeds,
+                             real dtSweep, real gamma, real sigma, real invMass,
+                             real dt_2m, real dt, bool firstSubStep)
+{
+    extern __shared__ real3 velocities[];
+
+    const int startId = blockIdx.x * view.objSize;
+
+    for (int i = threadIdx.x; i < view.objSize; i += blockDim.x)
     {
-        const real3 vij = vj.v - vi.v;
-        constexpr real sqrt_12 = 3.4641016151_r;
-        const real xiij = sqrt_12 * (Saru::uniform01(seed, i, j) - 0.5_r);
+        auto v = Real3_int( view.velocities[startId + i] );
 
-        const real3 dv = (dtgamma * inv2m * dot(eij, vij) -
-                          sqrtdtsigma * inv2m * xiij) * eij;
+        if (!firstSubStep)
+            v.v += dt_2m * Force(view.forces[startId + i]).f;
 
-        vi.v += dv;
-        vj.v -= dv;
+        velocities[i] = v.v;
     }
 
-    // step 2: implicit
+    __syncthreads();
+
+    for (int sweep = 0; sweep < nsweeps; ++sweep)
     {
-        const real3 vij = vj.v - vi.v;
-        constexpr real sqrt_12 = 3.4641016151_r;
-        const real xiij = sqrt_12 * (Saru::uniform01(seed, i, j) - 0.5_r);
+        for (int color = 0; color < numColors; ++color)
+        {
+            const real seed = seeds[sweep * numColors + color];
 
-        const real frac = inv2m * dtgamma / (1.0_r + dtgamma);
+            for (int e = colorStarts[color] + threadIdx.x; e < colorStarts[color+1]; e += blockDim.x)
+            {
+                const int2 edge = edges[e];
 
-        const real3 dv = (frac * (dot(eij, vij) + sqrtdtsigma * xiij)
-                          - inv2m * sqrtdtsigma * xiij) * eij;
+                const real3 ri = Real3_int( view.positions[startId + edge.x] ).v;
+                const real3 rj = Real3_int( view.positions[startId + edge.y] ).v;
+
+                // edges of the same color do not share vertices
+                sweepEdge(ri, rj, velocities[edge.x], velocities[edge.y],
+                          startId + edge.x, startId + edge.y,
+                          dtSweep, gamma, sigma, invMass, seed);
+            }
 
-        vi.v += dv;
-        vj.v -= dv;
+            __syncthreads();
+        }
     }
 
-    view.velocities[i] = vi.toReal4();
-    view.velocities[j] = vj.toReal4();
+    for (int i = threadIdx.x; i < view.objSize; i += blockDim.x)
+    {
+        const int pid = startId + i;
+
+        auto r = Real3_int( view.positions[pid] );
+        auto v = Real3_int( view.velocities[pid] );
+        const real3 f = Force(view.forces[pid]).f;
+
+        v.v = velocities[i] + dt_2m * f;
+        r.v += dt * v.v;
+
+        view.positions[pid] = r.toReal4();
+        view.velocities[pid] = v.toReal4();
+        view.forces[pid] = slowForces[pid].toReal4();
+    }
 }
 
 } // namespace rbc_shardlow_kernels
@@ -117,7 +192,7 @@ __global__ void sweepVelocities(int nEdges, const int2 *edges, OVview view,
 
 IntegratorSubStepShardlowSweep::IntegratorSubStepShardlowSweep(const MirState *state, const std::string& name, int substeps,
                                                                BaseMembraneInteraction* fastForces,
-                                                               real gammaC, real kBT, int nsweeps) :
+                                                               real gammaC, real kBT, int nsweeps, bool fused) :
 
     Integrator(state, name),
     substeps_(substeps),
@@ -125,10 +200,11 @@ IntegratorSubStepShardlowSweep::IntegratorSubStepShardlowSweep(const MirState *s
     subState_(*state),
     gammaC_(gammaC),
     kBT_(kBT),
-    nsweeps_(nsweeps)
+    nsweeps_(nsweeps),
+    fused_(fused)
 {
-    debug("setup substep integrator '%s' for %d substeps with %d sweeps",
-          getCName(), substeps_, nsweeps_);
+    debug("setup substep integrator '%s' for %d substeps with %d sweeps%s",
+          getCName(), substeps_, nsweeps_, fused_ ? " (fused)" : "");
 }
 
 IntegratorSubStepShardlowSweep::~IntegratorSubStepShardlowSweep() = default;
@@ -141,6 +217,12 @@ void IntegratorSubStepShardlowSweep::execute(ParticleVector *pv, cudaStream_t st
         die("'%s' expects a MembraneVector, got '%s'",
             getCName(), pv->getCName());
 
+    if (fused_ && _canFuse(mv))
+    {
+        _executeFused(mv, stream);
+        return;
+    }
+
     // save "slow forces"
     slowForces_.copyFromDevice(pv->local()->forces(), stream);
 
@@ -177,7 +259,7 @@ void IntegratorSubStepShardlowSweep::execute(ParticleVector *pv, cudaStream_t st
     }
 
     // restore previous positions into old_particles channel
-    pv->local()->dataPerParticle.getData<real4>(channel_names::oldPositions)->copy(previousPositions_, stream);
+    storeOldPositions(pv, previousPositions_.devPtr(), stream);
 
     invalidatePV_(pv);
 }
@@ -191,7 +273,11 @@ void IntegratorSubStepShardlowSweep::setPrerequisites(ParticleVector *pv)
 
         auto mesh = dynamic_cast<MembraneMesh*>(mv->mesh.get());
         assert(mesh);
-        pvToEdgeSets_[mv->getName()] = std::make_unique<MeshDistinctEdgeSets>(mesh);
+        pvToEdgeSets_[mv->getName()] = &mesh->getTopology().getDistinctEdgeSets();
+
+        if (fused_ && !_canFuse(mv))
+            warn("%s: the mesh of '%s' has too many vertices to fit in shared memory; "
+                 "the sub steps will not be fused", getCName(), pv->getCName());
     }
     else
     {
@@ -208,7 +294,7 @@ void IntegratorSubStepShardlowSweep::_viscousSweeps(MembraneVector *mv, cudaStre
     const real invMass = 1.0_r / ovview.mass;
     const real sigma = math::sqrt(2 * gammaC_ * kBT_);
 
-    const auto edgeSets = pvToEdgeSets_[mv->getName()].get();
+    const auto edgeSets = pvToEdgeSets_[mv->getName()];
 
     for (int sweep = 0; sweep < nsweeps_; ++sweep)
     {
@@ -230,4 +316,72 @@ void IntegratorSubStepShardlowSweep::_viscousSweeps(MembraneVector *mv, cudaStre
     }
 }
 
+// the default limit, available without opting in for larger shared memory
+static constexpr size_t maxSharedMemoryPerBlock = 48 * 1024;
+
+bool IntegratorSubStepShardlowSweep::_canFuse(const MembraneVector *mv) const
+{
+    return static_cast<size_t>(mv->getObjectSize()) * sizeof(real3) <= maxSharedMemoryPerBlock;
+}
+
+void IntegratorSubStepShardlowSweep::_executeFused(MembraneVector *mv, cudaStream_t stream)
+{
+    const auto edgeSets = pvToEdgeSets_[mv->getName()];
+    const int numColors = edgeSets->numColors();
+    const int seedsPerSubStep = nsweeps_ * numColors;
+
+    // the previous upload of the seeds (possibly for another vector) must be completed before the host buffer is overwritten
+    CUDA_Check( cudaStreamSynchronize(stream) );
+
+    // same sequence of random numbers as the multi-kernel path
+    seeds_.resize_anew(substeps_ * seedsPerSubStep);
+    std::uniform_real_distribution<real> u(0.0_r, 1.0_r);
+    for (auto& seed : seeds_)
+        seed = u(rnd_);
+    seeds_.uploadToDevice(stream);
+
+    // save "slow forces"
+    slowForces_.copyFromDevice(mv->local()->forces(), stream);
+
+    // initialize the forces for the first half step
+    fastForces_->local(mv, mv, nullptr, nullptr, stream);
+
+    // save previous positions
+    previousPositions_.copyFromDevice(mv->local()->positions(), stream);
+
+    OVview view(mv, mv->local());
+
+    const real dt = getState()->getDt() / substeps_;
+    const real dt_2m = 0.5_r * dt / view.mass;
+    const real dtSweep = dt / nsweeps_;
+    const real invMass = 1.0_r / view.mass;
+    const real sigma = math::sqrt(2 * gammaC_ * kBT_);
+
+    constexpr int nthreads = 128;
+    const size_t shMem = static_cast<size_t>(view.objSize) * sizeof(real3);
+
+    for (int substep = 0; substep < substeps_; ++substep)
+    {
+        SAFE_KERNEL_LAUNCH(
+            rbc_shardlow_kernels::fusedSubStep,
+            view.nObjects, nthreads, shMem, stream,
+            view, slowForces_.devPtr(),
+            numColors, edgeSets->colorStarts().devPtr(), edgeSets->allEdges().devPtr(),
+            nsweeps_, seeds_.devPtr() + substep * seedsPerSubStep,
+            dtSweep, gammaC_, sigma, invMass, dt_2m, dt, substep == 0);
+
+        fastForces_->local(mv, mv, nullptr, nullptr, stream);
+    }
+
+    SAFE_KERNEL_LAUNCH(
+        rbc_shardlow_kernels::velocityVerletStep2,
+        getNblocks(view.size, nthreads), nthreads, 0, stream,
+        view, dt_2m);
+
+    // restore previous positions into old_particles channel
+    storeOldPositions(mv, previousPositions_.devPtr(), stream);
+
+    invalidatePV_(mv);
+}
+
 } // namespace mirheo
@@ -34,6 +34,9 @@ class MembraneVector;
         The fast forces should NOT be registered in the \c Simulation.
         Otherwise, it will be executed twice (by the simulation and by this class).
     \endrst
+
+    In fused mode, each sub step is performed by a single kernel (one block per membrane, velocities in shared memory),
+    followed by the fast forces. This mode falls back to the multi-kernel path for meshes that do not fit in shared memory.
  */
 class IntegratorSubStepShardlowSweep : public Integrator
 {
@@ -46,9 +49,11 @@ public:
         \param [in] gammaC The dissipation coefficient.
         \param [in] kBT The temperature in energy units.
         \param [in] nsweeps The number of iterations spent for each viscous update. Must be at least 1.
+        \param [in] fused If \c true, fuse the sweeps and the velocity-Verlet steps of each sub step into one kernel.
     */
     IntegratorSubStepShardlowSweep(const MirState *state, const std::string& name, int substeps,
-                                   BaseMembraneInteraction* fastForces, real gammaC, real kBT, int nsweeps);
+                                   BaseMembraneInteraction* fastForces, real gammaC, real kBT, int nsweeps,
+                                   bool fused);
 
 
     ~IntegratorSubStepShardlowSweep();
@@ -59,6 +64,8 @@ public:
 
 private:
     void _viscousSweeps(MembraneVector *mv, cudaStream_t stream);
+    bool _canFuse(const MembraneVector *mv) const;
+    void _executeFused(MembraneVector *mv, cudaStream_t stream);
 
 private:
     int substeps_; /* number of substeps */
@@ -67,14 +74,16 @@ private:
     real gammaC_;
     real kBT_;
     int nsweeps_;
+    bool fused_;
 
     MirState subState_;
 
     DeviceBuffer<Force> slowForces_ {};
     DeviceBuffer<real4> previousPositions_ {};
+    PinnedBuffer<real> seeds_ {}; ///< random seeds of all sweeps of one time step (fused mode)
 
     std::mt19937 rnd_;
-    std::map<std::string, std::unique_ptr<MeshDistinctEdgeSets>> pvToEdgeSets_;
+    std::map<std::string, const MeshDistinctEdgeSets*> pvToEdgeSets_; ///< owned by the mesh topologies
 };
 
 } // namespace mirheo
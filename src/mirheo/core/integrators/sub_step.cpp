@@ -7,6 +7,7 @@
 #include <mirheo/core/interactions/interface.h>
 #include <mirheo/core/logger.h>
 #include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/utils/old_positions.h>
 #include <mirheo/core/snapshot.h>
 #include <mirheo/core/utils/common.h>
 #include <mirheo/core/utils/config.h>
@@ -112,7 +113,7 @@ void IntegratorSubStep::execute(ParticleVector *pv, cudaStream_t stream)
     }
 
     // restore previous positions into old_particles channel
-    pv->local()->dataPerParticle.getData<real4>(channel_names::oldPositions)->copy(previousPositions_, stream);
+    storeOldPositions(pv, previousPositions_.devPtr(), stream);
 
     // restore state of fastForces
     for (auto& ff : fastForces_)
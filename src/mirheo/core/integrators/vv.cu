@@ -74,6 +74,24 @@ ConfigObject IntegratorVV<ForcingTerm>::_saveSnapshot(
  */
 template<class ForcingTerm>
 void IntegratorVV<ForcingTerm>::execute(ParticleVector *pv, cudaStream_t stream)
+{
+    _execute(pv, nullptr, stream);
+}
+
+template<class ForcingTerm>
+void IntegratorVV<ForcingTerm>::executeAndBin(ParticleVector *pv, PrimaryCellList *cl, cudaStream_t stream)
+{
+    _execute(pv, cl, stream);
+}
+
+template<class ForcingTerm>
+bool IntegratorVV<ForcingTerm>::supportsFusedBinning() const
+{
+    return true;
+}
+
+template<class ForcingTerm>
+void IntegratorVV<ForcingTerm>::_execute(ParticleVector *pv, PrimaryCellList *cl, cudaStream_t stream)
 {
     const auto t  = static_cast<real>(getState()->currentTime);
     const auto dt = static_cast<real>(getState()->getDt());
@@ -93,7 +111,11 @@ void IntegratorVV<ForcingTerm>::execute(ParticleVector *pv, cudaStream_t stream)
         p.r += p.u * dt;
     };
 
-    integrate(pv, dt, st2, stream);
+    if (cl)
+        integrateAndBin(pv, dt, st2, cl, stream);
+    else
+        integrate(pv, dt, st2, stream);
+
     invalidatePV_(pv);
 }
 
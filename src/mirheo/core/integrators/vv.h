@@ -34,6 +34,8 @@ public:
     void saveSnapshotAndRegister(Saver& saver);
 
     void execute(ParticleVector *pv, cudaStream_t stream) override;
+    void executeAndBin(ParticleVector *pv, PrimaryCellList *cl, cudaStream_t stream) override;
+    bool supportsFusedBinning() const override;
 
 protected:
     /** \brief Implementation of the snapshot saving. Reusable by potential derived classes.
@@ -42,6 +44,10 @@ protected:
       */
     ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
 
+private:
+    /// Implementation of execute() and executeAndBin(); \p cl is \c nullptr in the former case.
+    void _execute(ParticleVector *pv, PrimaryCellList *cl, cudaStream_t stream);
+
 private:
     ForcingTerm forcingTerm_;
 };
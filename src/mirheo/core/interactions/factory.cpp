@@ -194,6 +194,15 @@ static StatesSpinParameters readStatesSpinRodParameters(ParametersWrap& desc)
     return p;
 }
 
+static StatesTransferMatrixParameters readStatesTransferMatrixRodParameters(ParametersWrap& desc)
+{
+    StatesTransferMatrixParameters p;
+
+    p.kBT = desc.read<real>("kBT");
+    p.J   = desc.read<real>("J");
+    return p;
+}
+
 
 std::shared_ptr<BaseRodInteraction>
 interaction_factory::createInteractionRod(const MirState *state, std::string name, std::string stateUpdate,
@@ -210,6 +219,8 @@ interaction_factory::createInteractionRod(const MirState *state, std::string nam
         spinParams = readStatesSmoothingRodParameters(desc);
     else if (stateUpdate == "spin")
         spinParams = readStatesSpinRodParameters(desc);
+    else if (stateUpdate == "transfer_matrix")
+        spinParams = readStatesTransferMatrixRodParameters(desc);
     else
         die("unrecognised state update method: '%s'", stateUpdate.c_str());
 
@@ -40,6 +40,11 @@ bool Interaction::isSelfObjectInteraction() const
     return false;
 }
 
+bool Interaction::needsFullObjectHalo() const
+{
+    return false;
+}
+
 real Interaction::getCutoffRadius() const
 {
     return 1.0_r;
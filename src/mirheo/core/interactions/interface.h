@@ -109,6 +109,14 @@ public:
      */
     virtual bool isSelfObjectInteraction() const;
 
+    /** \return boolean describing if the halo part of the interaction needs the full halo objects.
+
+        By default, the halo of an ObjectVector only contains the particles close to the subdomain boundaries,
+        which is enough for pairwise interactions.
+        Interactions that need the object structure of the halo (e.g. bindings between objects) must return \c true.
+     */
+    virtual bool needsFullObjectHalo() const;
+
     /// returns the Stage corresponding of this interaction.
     virtual Stage getStage() const {return Stage::Final;}
 
@@ -135,7 +135,7 @@ __device__ inline mReal3 dihedralForce(int locId, int rbcId,
 
         f0 += dihedralInteraction(v0, v1, v2, v3, f1);
 
-        atomicAdd(view.forces + idv1, make_real3(f1));
+        view.atomicAddForce(idv1, make_real3(f1));
 
         v1   = v2  ; v2   = v3  ;
         idv1 = idv2; idv2 = idv3;
@@ -168,7 +168,7 @@ __global__ void computeMembraneForces(TriangleInteraction triangleInteraction,
     f  = triangleForce(triangleInteraction, r0, locId, rbcId, view, mesh, parameters);
     f += dihedralForce(locId, rbcId, dihedralView, dihedralInteraction, mesh);
 
-    atomicAdd(view.forces + pid, make_real3(f));
+    view.atomicAddForce(pid, make_real3(f));
 }
 
 
@@ -239,7 +239,7 @@ __global__ void computeMembraneViscousFluctForces(OVview view,
 
     const mReal3 f = bondForces(p, locId, rbcId, view, mesh, parameters);
 
-    atomicAdd(view.forces + pid, make_real3(f));
+    view.atomicAddForce(pid, make_real3(f));
 }
 
 } // namespace membrane_forces_kernels
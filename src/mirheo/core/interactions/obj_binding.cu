@@ -3,6 +3,7 @@
 #include "obj_binding.h"
 
 #include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/utils/gid_map.h>
 #include <mirheo/core/pvs/views/pv.h>
 #include <mirheo/core/utils/common.h>
 #include <mirheo/core/utils/cuda_common.h>
@@ -27,20 +28,7 @@ __global__ void fill(int n, int *array, int value)
     array[i] = value;
 }
 
-__global__ void createGidMap(int maxGid, int *map, PVview view)
-{
-    const int i = blockIdx.x * blockDim.x + threadIdx.x;
-
-    if (i >= view.size)
-        return;
-
-    const auto gid = view.readParticle(i).getId();
-
-    if (gid < maxGid)
-        map[gid] = i;
-}
-
-__global__ void createPartnersMap(int npairs, const int2 *pairs, const int *gidToPv1Ids, const int *gidToPv2Ids, int *partnerIds)
+__global__ void createPartnersMap(int npairs, const int2 *pairs, GidMapView gidToPv1Ids, GidMapView gidToPv2Ids, int *partnerIds)
 {
     const int i = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -49,10 +37,10 @@ __global__ void createPartnersMap(int npairs, const int2 *pairs, const int *gidT
 
     const auto pair = pairs[i];
 
-    const int from = gidToPv1Ids[pair.x];
-    const int to = gidToPv2Ids[pair.y];
+    const int from = gidToPv1Ids.find(pair.x);
+    const int to   = gidToPv2Ids.find(pair.y);
 
-    if (from != NoPartner)
+    if (from != GidMapView::NotFound && to != GidMapView::NotFound)
         partnerIds[from] = to;
 }
 
@@ -80,8 +68,8 @@ __global__ void applyBindingForces(real kBound, const int *partnerIds, PVview vi
 
     const real3 f = kBound * dr;
 
-    atomicAdd(view1.forces + i,  f);
-    atomicAdd(view2.forces + j, -f);
+    view1.atomicAddForce(i,  f);
+    view2.atomicAddForce(j, -f);
 }
 
 } // namespace obj_binding_kernels
@@ -93,16 +81,6 @@ ObjectBindingInteraction::ObjectBindingInteraction(const MirState *state, std::s
     kBound_(kBound),
     pairs_(pairs.size())
 {
-    int maxId1 {-1}, maxId2 {-1};
-    for (const auto& pair : pairs)
-    {
-        maxId1 = std::max(maxId1, pair.x);
-        maxId2 = std::max(maxId2, pair.y);
-    }
-
-    gidToPv1Ids_.resize_anew(maxId1+1);
-    gidToPv2Ids_.resize_anew(maxId2+1);
-
     CUDA_Check( cudaMemcpy(pairs_.devPtr(), pairs.data(), sizeof(pairs[0]) * pairs.size(), cudaMemcpyHostToDevice) );
 }
 
@@ -125,35 +103,21 @@ void ObjectBindingInteraction::halo(ParticleVector *pv1, ParticleVector *pv2,
     _computeForces(pv1, pv2, pv1->halo(), pv2->local(), stream);
 }
 
+bool ObjectBindingInteraction::needsFullObjectHalo() const
+{
+    return true;
+}
+
 void ObjectBindingInteraction::_buildInteractionMap(ParticleVector *pv1, ParticleVector *pv2,
                                                     LocalParticleVector *lpv1, LocalParticleVector *lpv2,
                                                     cudaStream_t stream)
 {
-    auto createGidMap = [stream](DeviceBuffer<int>& gidToPvIds, const PVview view)
-    {
-        constexpr int nthreads = 128;
-        const int nblocks = getNblocks(gidToPvIds.size(), nthreads);
-
-        SAFE_KERNEL_LAUNCH(
-            obj_binding_kernels::fill,
-            nblocks, nthreads, 0, stream,
-            gidToPvIds.size(), gidToPvIds.devPtr(), NoPartner);
-
-        SAFE_KERNEL_LAUNCH(
-            obj_binding_kernels::createGidMap,
-            nblocks, nthreads, 0, stream,
-            gidToPvIds.size(), gidToPvIds.devPtr(), view);
-    };
-
-    PVview view1(pv1, lpv1);
-    PVview view2(pv2, lpv2);
-
-    createGidMap(gidToPv1Ids_, view1);
-    createGidMap(gidToPv2Ids_, view2);
+    gidToPv1Ids_.build(pv1, lpv1, stream);
+    gidToPv2Ids_.build(pv2, lpv2, stream);
 
     constexpr int nthreads = 128;
 
-    partnersMaps_.resize_anew(view1.size);
+    partnersMaps_.resize_anew(lpv1->size());
 
     SAFE_KERNEL_LAUNCH(
         obj_binding_kernels::fill,
@@ -164,7 +128,7 @@ void ObjectBindingInteraction::_buildInteractionMap(ParticleVector *pv1, Particl
         obj_binding_kernels::createPartnersMap,
         getNblocks(pairs_.size(), nthreads), nthreads, 0, stream,
         pairs_.size(), pairs_.devPtr(),
-        gidToPv1Ids_.devPtr(), gidToPv2Ids_.devPtr(),
+        gidToPv1Ids_.view(), gidToPv2Ids_.view(),
         partnersMaps_.devPtr());
 }
 
@@ -4,6 +4,7 @@
 #include "interface.h"
 
 #include <mirheo/core/containers.h>
+#include <mirheo/core/pvs/utils/gid_map.h>
 
 namespace mirheo
 {
@@ -32,6 +33,8 @@ public:
     void local(ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2, cudaStream_t stream) override;
     void halo (ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2, cudaStream_t stream) override;
 
+    bool needsFullObjectHalo() const override;
+
 private:
 
     void _buildInteractionMap(ParticleVector *pv1, ParticleVector *pv2,
@@ -47,8 +50,8 @@ private:
     real kBound_; ///< The spring constant
     DeviceBuffer<int2> pairs_; ///< Global ids of particles that interact.
 
-    DeviceBuffer<int> gidToPv1Ids_; ///< helper map from global Id to local Ids of pv1.
-    DeviceBuffer<int> gidToPv2Ids_; ///< helper map from global Id to local Ids of pv2.
+    GidMap gidToPv1Ids_; ///< helper map from global Id to local Ids of pv1.
+    GidMap gidToPv2Ids_; ///< helper map from global Id to local Ids of pv2.
     DeviceBuffer<int> partnersMaps_; ///< map from pv1 (local ids) to pv2 (local ids).
 };
 
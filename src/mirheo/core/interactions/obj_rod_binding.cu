@@ -67,9 +67,9 @@ __device__ void applyBindingForce(const DomainInfo& domain,
     real3 fu0     = 0.5_r * cross(T, dp);
     real3 Tanchor = cross(relAnchor, fanchor);
 
-    atomicAdd(&rods.forces[start + 0], -fanchor);
-    atomicAdd(&rods.forces[start + 1],  fu0);
-    atomicAdd(&rods.forces[start + 2], -fu0);
+    rods.atomicAddForce(start + 0, -fanchor);
+    rods.atomicAddForce(start + 1,  fu0);
+    rods.atomicAddForce(start + 2, -fu0);
 
     atomicAdd(&objs.motions[i].force , make_rigidReal3(fanchor));
     atomicAdd(&objs.motions[i].torque, make_rigidReal3(Tanchor + T));
@@ -157,6 +157,11 @@ void ObjectRodBindingInteraction::halo(ParticleVector *pv1, ParticleVector *pv2,
     die("Local interactions '%s' must be given one RigidObjectVector and one RodVector", getCName());
 }
 
+bool ObjectRodBindingInteraction::needsFullObjectHalo() const
+{
+    return true;
+}
+
 
 void ObjectRodBindingInteraction::_local(RigidObjectVector *rov, RodVector *rv, cudaStream_t stream) const
 {
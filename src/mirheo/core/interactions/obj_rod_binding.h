@@ -30,6 +30,8 @@ public:
     void local(ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2, cudaStream_t stream) override;
     void halo (ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2, cudaStream_t stream) override;
 
+    bool needsFullObjectHalo() const override;
+
 private:
 
     void _local(RigidObjectVector *rov, RodVector *rv, cudaStream_t stream) const;
@@ -46,8 +46,10 @@ enum class InteractionFetchMode
 
      \param [in] pstart lower bound of id range of the particles to be worked on (inclusive)
      \param [in] pend  upper bound of id range (exclusive)
+     \param [in] srcIds maps the ids of the range to the local indices of the src particles; identity if \c nullptr
      \param [in] dstP destination particle
      \param [in] dstId destination particle local index
+     \param [in] dstSlot id of the destination particle in the range of the cell-list; only used for self interactions
      \param [in,out] srcView The view of the src particle vector
      \param [in] interaction The pairwise interaction kernel
      \param [in,out] accumulator Manages the accumulated output on the dst particle
@@ -55,19 +57,21 @@ enum class InteractionFetchMode
 template<InteractionOutMode NeedDstOutput, InteractionOutMode NeedSrcOutput, InteractionWith InteractWith,
          typename Interaction, typename Accumulator>
 __device__ inline void computeCell(
-        int pstart, int pend,
-        typename Interaction::ParticleType dstP, int dstId, typename Interaction::ViewType srcView,
+        int pstart, int pend, const int *srcIds,
+        typename Interaction::ParticleType dstP, int dstId, int dstSlot, typename Interaction::ViewType srcView,
         Interaction& interaction, Accumulator& accumulator)
 {
-    for (int srcId = pstart; srcId < pend; srcId++)
+    for (int srcSlot = pstart; srcSlot < pend; srcSlot++)
     {
+        const int srcId = srcIds != nullptr ? srcIds[srcSlot] : srcSlot;
+
         typename Interaction::ParticleType srcP;
         interaction.readCoordinates(srcP, srcView, srcId);
 
         bool interacting = interaction.withinCutoff(srcP, dstP);
 
         if (InteractWith == InteractionWith::Self)
-            if (dstId <= srcId)
+            if (dstSlot <= srcSlot)
                 interacting = false;
 
         if (interacting)
@@ -92,7 +96,7 @@ __device__ inline void computeCell(
     \param [in,out] view The view that contains the particle data
     \param [in] interaction The pairwise interaction kernel
 
-    Mapping is one thread per particle. The thread will traverse half
+    Mapping is one thread per particle, in cell order. The thread will traverse half
     of the neighbouring cells and compute all the interactions between
     the destination particle and all the particles in the cells.
  */
@@ -101,8 +105,10 @@ __launch_bounds__(128, 16)
 __global__ void computeSelfInteractions(
         CellListInfo cinfo, typename Interaction::ViewType view, Interaction interaction)
 {
-    const int dstId = blockIdx.x*blockDim.x + threadIdx.x;
-    if (dstId >= view.size) return;
+    const int dstSlot = blockIdx.x*blockDim.x + threadIdx.x;
+    if (dstSlot >= view.size) return;
+
+    const int dstId = cinfo.particleIds != nullptr ? cinfo.particleIds[dstSlot] : dstSlot;
 
     const auto dstP = interaction.read(view, dstId);
 
@@ -128,10 +134,10 @@ __global__ void computeSelfInteractions(
 
             if (cellY == cell0.y && cellZ == cell0.z)
                 computeCell<InteractionOutMode::NeedOutput, InteractionOutMode::NeedOutput, InteractionWith::Self>
-                    (pstart, pend, dstP, dstId, view, interaction, accumulator);
+                    (pstart, pend, cinfo.particleIds, dstP, dstId, dstSlot, view, interaction, accumulator);
             else
                 computeCell<InteractionOutMode::NeedOutput, InteractionOutMode::NeedOutput, InteractionWith::Other>
-                    (pstart, pend, dstP, dstId, view, interaction, accumulator);
+                    (pstart, pend, cinfo.particleIds, dstP, dstId, dstSlot, view, interaction, accumulator);
         }
     }
 
@@ -191,7 +197,7 @@ __global__ void computeExternalInteractions_1tpp(
                 const int pend   = srcCinfo.cellStarts[rowEnd];
 
                 computeCell<NeedDstOutput, NeedSrcOutput, InteractionWith::Other>
-                    (pstart, pend, dstP, dstId, srcView, interaction, accumulator);
+                    (pstart, pend, srcCinfo.particleIds, dstP, dstId, dstId, srcView, interaction, accumulator);
             }
             else
             {
@@ -204,7 +210,7 @@ __global__ void computeExternalInteractions_1tpp(
                     const int pend   = srcCinfo.cellStarts[cid+1];
 
                     computeCell<NeedDstOutput, NeedSrcOutput, InteractionWith::Other>
-                        (pstart, pend, dstP, dstId, srcView, interaction, accumulator);
+                        (pstart, pend, srcCinfo.particleIds, dstP, dstId, dstId, srcView, interaction, accumulator);
                 }
             }
 
@@ -256,7 +262,7 @@ __global__ void computeExternalInteractions_3tpp(
             const int pend   = srcCinfo.cellStarts[rowEnd];
 
             computeCell<NeedDstOutput, NeedSrcOutput, InteractionWith::Other>
-                (pstart, pend, dstP, dstId, srcView, interaction, accumulator);
+                (pstart, pend, srcCinfo.particleIds, dstP, dstId, dstId, srcView, interaction, accumulator);
         }
         else
         {
@@ -269,7 +275,7 @@ __global__ void computeExternalInteractions_3tpp(
                 const int pend   = srcCinfo.cellStarts[cid+1];
 
                 computeCell<NeedDstOutput, NeedSrcOutput, InteractionWith::Other>
-                    (pstart, pend, dstP, dstId, srcView, interaction, accumulator);
+                    (pstart, pend, srcCinfo.particleIds, dstP, dstId, dstId, srcView, interaction, accumulator);
             }
         }
     }
@@ -321,7 +327,7 @@ __global__ void computeExternalInteractions_9tpp(
         const int pend   = srcCinfo.cellStarts[rowEnd];
 
         computeCell<NeedDstOutput, NeedSrcOutput, InteractionWith::Other>
-            (pstart, pend, dstP, dstId, srcView, interaction, accumulator);
+            (pstart, pend, srcCinfo.particleIds, dstP, dstId, dstId, srcView, interaction, accumulator);
     }
     else
     {
@@ -334,7 +340,7 @@ __global__ void computeExternalInteractions_9tpp(
             const int pend   = srcCinfo.cellStarts[cid+1];
 
             computeCell<NeedDstOutput, NeedSrcOutput, InteractionWith::Other>
-                (pstart, pend, dstP, dstId, srcView, interaction, accumulator);
+                (pstart, pend, srcCinfo.particleIds, dstP, dstId, dstId, srcView, interaction, accumulator);
         }
     }
 
@@ -381,7 +387,7 @@ __global__ void computeExternalInteractions_27tpp(
     const int pend   = srcCinfo.cellStarts[cid+1];
 
     computeCell<NeedDstOutput, NeedSrcOutput, InteractionWith::Other>
-        (pstart, pend, dstP, dstId, srcView, interaction, accumulator);
+        (pstart, pend, srcCinfo.particleIds, dstP, dstId, dstId, srcView, interaction, accumulator);
 
     if (NeedDstOutput == InteractionOutMode::NeedOutput)
         accumulator.atomicAddToDst(accumulator.get(), dstView, dstId);
@@ -24,7 +24,7 @@ public:
      */
     __D__ void atomicAddToDst(real3 f, PVview& view, int id) const
     {
-        atomicAdd(view.forces + id, f);
+        view.atomicAddForce(id, f);
     }
 
     /** \brief Atomically add the force \p f to the source \p view at id \p id.
@@ -34,7 +34,7 @@ public:
      */
     __D__ void atomicAddToSrc(real3 f, PVview& view, int id) const
     {
-        atomicAdd(view.forces + id, -f);
+        view.atomicAddForce(id, -f);
     }
 
     /// \return the internal accumulated force
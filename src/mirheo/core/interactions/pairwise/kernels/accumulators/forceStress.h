@@ -38,7 +38,7 @@ public:
      */
     __D__ void atomicAddToDst(const ForceStress& fs, PVviewWithStresses<BasicView>& view, int id) const
     {
-        atomicAdd(      view.forces   + id, fs.force );
+        view.atomicAddForce(id, fs.force);
         atomicAddStress(view.stresses + id, fs.stress);
     }
 
@@ -49,8 +49,8 @@ public:
      */
     __D__ void atomicAddToSrc(const ForceStress& fs, PVviewWithStresses<BasicView>& view, int id) const
     {
-        atomicAdd(      view.forces   + id, -fs.force );
-        atomicAddStress(view.stresses + id,  fs.stress);
+        view.atomicAddForce(id, -fs.force);
+        atomicAddStress(view.stresses + id, fs.stress);
     }
 
     /// \return the internal accumulated force and stress
@@ -89,12 +89,12 @@ __global__ void computeRodBoundForces(RVview view, GPU_RodBoundsParameters param
 
 #undef BOUND
 
-    atomicAdd(view.forces + start + 0, make_real3(fr0));
-    atomicAdd(view.forces + start + 1, make_real3(fu0));
-    atomicAdd(view.forces + start + 2, make_real3(fu1));
-    atomicAdd(view.forces + start + 3, make_real3(fv0));
-    atomicAdd(view.forces + start + 4, make_real3(fv1));
-    atomicAdd(view.forces + start + 5, make_real3(fr1));
+    view.atomicAddForce(start + 0, make_real3(fr0));
+    view.atomicAddForce(start + 1, make_real3(fu0));
+    view.atomicAddForce(start + 2, make_real3(fu1));
+    view.atomicAddForce(start + 3, make_real3(fv0));
+    view.atomicAddForce(start + 4, make_real3(fv1));
+    view.atomicAddForce(start + 5, make_real3(fr1));
 }
 
 template <int Nstates>
@@ -132,14 +132,14 @@ __global__ void computeRodBiSegmentForces(RVview view, GPU_RodBiSegmentParameter
     auto fpp0 = -fpm0;
     auto fpp1 = -fpm1;
 
-    atomicAdd(view.forces + start + 0 * stride, make_real3(fr0));
-    atomicAdd(view.forces + start + 1 * stride, make_real3(fr1));
-    atomicAdd(view.forces + start + 2 * stride, make_real3(fr2));
+    view.atomicAddForce(start + 0 * stride, make_real3(fr0));
+    view.atomicAddForce(start + 1 * stride, make_real3(fr1));
+    view.atomicAddForce(start + 2 * stride, make_real3(fr2));
 
-    atomicAdd(view.forces + start +          1, make_real3(fpm0));
-    atomicAdd(view.forces + start +          2, make_real3(fpp0));
-    atomicAdd(view.forces + start + stride + 1, make_real3(fpm1));
-    atomicAdd(view.forces + start + stride + 2, make_real3(fpp1));
+    view.atomicAddForce(start +          1, make_real3(fpm0));
+    view.atomicAddForce(start +          2, make_real3(fpp0));
+    view.atomicAddForce(start + stride + 1, make_real3(fpm1));
+    view.atomicAddForce(start + stride + 2, make_real3(fpp1));
 
     if (saveEnergies) view.energies[i] = bisegment.computeEnergy(state, params);
 }
@@ -225,14 +225,14 @@ __global__ void computeRodCurvatureSmoothing(RVview view, real kbi,
     auto fpp0 = -fpm0;
     auto fpp1 = -fpm1;
 
-    atomicAdd(view.forces + start + 0 * stride, make_real3(fr0));
-    atomicAdd(view.forces + start + 1 * stride, make_real3(fr1));
-    atomicAdd(view.forces + start + 2 * stride, make_real3(fr2));
+    view.atomicAddForce(start + 0 * stride, make_real3(fr0));
+    view.atomicAddForce(start + 1 * stride, make_real3(fr1));
+    view.atomicAddForce(start + 2 * stride, make_real3(fr2));
 
-    atomicAdd(view.forces + start +          1, make_real3(fpm0));
-    atomicAdd(view.forces + start +          2, make_real3(fpp0));
-    atomicAdd(view.forces + start + stride + 1, make_real3(fpm1));
-    atomicAdd(view.forces + start + stride + 2, make_real3(fpp1));
+    view.atomicAddForce(start +          1, make_real3(fpm0));
+    view.atomicAddForce(start +          2, make_real3(fpp0));
+    view.atomicAddForce(start + stride + 1, make_real3(fpm1));
+    view.atomicAddForce(start + stride + 2, make_real3(fpp1));
 }
 
 
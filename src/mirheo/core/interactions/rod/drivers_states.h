@@ -3,6 +3,7 @@
 
 #include "kernels/real.h"
 #include "kernels/bisegment.h"
+#include "kernels/transfer_matrix.h"
 
 #include <mirheo/core/pvs/rod_vector.h>
 #include <mirheo/core/pvs/views/rv.h>
@@ -79,7 +80,7 @@ __global__ void findPolymorphicStates(RVview view, GPU_RodBiSegmentParameters<Ns
 
     const int nBiSegments = view.nSegments - 1;
 
-    for (int biSegmentId = tid; biSegmentId < nBiSegments; ++biSegmentId)
+    for (int biSegmentId = tid; biSegmentId < nBiSegments; biSegmentId += blockDim.x)
     {
         rReal2 k0, k1;
         rReal tau, l;
@@ -197,6 +198,37 @@ __global__ void findPolymorphicStatesMCStep(RVview view, GPU_RodBiSegmentParamet
     }
 }
 
+/// Exact ground state (zero temperature) or Boltzmann sample of the states of each rod; one block per rod.
+/// See transfer_matrix::sampleStatesBlock().
+template <int Nstates>
+__global__ void findPolymorphicStatesTransferMatrix(RVview view, GPU_RodBiSegmentParameters<Nstates> params,
+                                                    GPU_SpinParameters spinParams, const real4 *kappa, const real2 *tau_l)
+{
+    const int rodId = blockIdx.x;
+    const int nBiSegments = view.nSegments - 1;
+
+    extern __shared__ char transferMatrixBuffer[];
+
+    auto energies = [&](int biSegmentId, real *e)
+    {
+        rReal2 k0, k1;
+        rReal tau, l;
+        fetchBisegmentData(rodId * nBiSegments + biSegmentId, kappa, tau_l, k0, k1, tau, l);
+
+        #pragma unroll
+        for (int s = 0; s < Nstates; ++s)
+            e[s] = static_cast<real>(computeEnergy(l, k0, k1, tau, s, params));
+    };
+
+    auto uniforms = [&](int biSegmentId)
+    {
+        return Saru::uniform01(spinParams.seed, rodId, biSegmentId);
+    };
+
+    transfer_matrix::sampleStatesBlock<Nstates>(nBiSegments, energies, uniforms, spinParams.J, spinParams.kBT,
+                                                view.states + rodId * nBiSegments, transferMatrixBuffer);
+}
+
 } // namespace rod_states_kernels
 
 } // namespace mirheo
@@ -13,7 +13,8 @@ namespace mirheo
 /// variant that contains all possible parameters for the polymorphic states transition models
 using VarSpinParams = mpark::variant<StatesParametersNone,
                                      StatesSmoothingParameters,
-                                     StatesSpinParameters>;
+                                     StatesSpinParameters,
+                                     StatesTransferMatrixParameters>;
 
 class BaseRodInteraction;
 
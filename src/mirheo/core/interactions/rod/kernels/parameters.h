@@ -48,4 +48,20 @@ private:
     std::uniform_real_distribution<real> udistr_;
 };
 
+/** Parameters used when polymorphic states are drawn exactly from the Ising kind of model,
+    with a transfer matrix solver instead of Monte-Carlo steps
+ */
+struct StatesTransferMatrixParameters
+{
+    real kBT;   ///< temeperature in energy units; the ground state is selected if zero
+    real J;     ///< Ising energy coupling
+
+    /// \return a random seed
+    inline auto generate() {return udistr_(gen_);}
+
+private:
+    std::mt19937 gen_;
+    std::uniform_real_distribution<real> udistr_;
+};
+
 } // namespace mirheo
@@ -0,0 +1,373 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/helper_math.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mirheo
+{
+
+/** \brief Exact solver for the polymorphic states of a rod with Ising coupling.
+
+    The states \f$ s_0, \dots, s_{n-1} \f$ of the n bisegments of a rod have the energy
+    \f[
+        E = \sum_b e_b(s_b) + J \sum_{b=1}^{n-1} |s_b - s_{b-1}|.
+    \f]
+    The partition function is a product of transfer matrices
+    \f$ A_b(s', s) = e_b(s) + J |s - s'| \f$ in the "soft-min" semiring
+    \f$ a \oplus b = -k_BT \log(e^{-a/k_BT} + e^{-b/k_BT}) \f$, \f$ a \otimes b = a + b \f$,
+    which becomes the (min, +) semiring for \f$ k_BT \to 0 \f$ (ground state).
+
+    Forward messages \f$ \alpha_b = \alpha_{b-1} \otimes A_b \f$ give the exact conditional distributions
+    \f$ P(s_b | s_{b+1}) \propto e^{-(\alpha_b(s_b) + J|s_b - s_{b+1}|)/k_BT} \f$, from which states are drawn backwards.
+    Both the matrix products and the composition of the backward maps \f$ s_{b+1} \mapsto s_b \f$ are associative:
+    the device version computes them with block-wide scans (see sampleStatesBlock()).
+
+    All messages are in energy units and shifted by their minimum to stay bounded.
+ */
+namespace transfer_matrix
+{
+
+/// temperatures below this value select the ground state (same threshold as the Monte-Carlo update)
+constexpr real zeroTemperature = 1e-6_r;
+
+/// "zero" of the semiring: no path
+__HD__ constexpr inline real infinity()
+{
+    return std::numeric_limits<real>::infinity();
+}
+
+/// \return a (+) b: soft minimum of two energies, or minimum if \p kBT is zero
+__HD__ inline real combine(real a, real b, real kBT)
+{
+    const real lo = math::min(a, b);
+    const real hi = math::max(a, b);
+
+    if (kBT < zeroTemperature || hi == infinity())
+        return lo;
+
+    return lo - kBT * math::log(1.0_r + math::exp((lo - hi) / kBT));
+}
+
+/// fill the N x N identity matrix of the semiring
+template <int N>
+__HD__ inline void identity(real *M)
+{
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < N; ++j)
+            M[i*N + j] = (i == j) ? 0.0_r : infinity();
+}
+
+/// subtract the minimum entry from the \p n entries of \p a
+__HD__ inline void normalize(real *a, int n)
+{
+    real m = a[0];
+    for (int i = 1; i < n; ++i)
+        m = math::min(m, a[i]);
+
+    if (m == infinity())
+        return;
+
+    for (int i = 0; i < n; ++i)
+        a[i] -= m;
+}
+
+/** \brief C = A (x) B in the semiring, normalized.
+    \p C must not alias \p A or \p B.
+ */
+template <int N>
+__HD__ inline void multiply(const real *A, const real *B, real *C, real kBT)
+{
+    for (int i = 0; i < N; ++i)
+        for (int k = 0; k < N; ++k)
+        {
+            real c = infinity();
+            for (int j = 0; j < N; ++j)
+                c = combine(c, A[i*N + j] + B[j*N + k], kBT);
+            C[i*N + k] = c;
+        }
+    normalize(C, N*N);
+}
+
+/** \brief M = M (x) A_b, where A_b is the transfer matrix of a bisegment with energies \p e.
+    The first bisegment has no left neighbour: set \p coupled to \c false.
+ */
+template <int N>
+__HD__ inline void multiplyTransfer(real *M, const real *e, real J, bool coupled, real kBT)
+{
+    real row[N];
+
+    for (int i = 0; i < N; ++i)
+    {
+        for (int k = 0; k < N; ++k)
+        {
+            real c = infinity();
+            for (int j = 0; j < N; ++j)
+                c = combine(c, M[i*N + j] + (coupled ? J * math::abs(j - k) : 0.0_r), kBT);
+            row[k] = c + e[k];
+        }
+        for (int k = 0; k < N; ++k)
+            M[i*N + k] = row[k];
+    }
+    normalize(M, N*N);
+}
+
+/** \brief alpha = alpha (x) A_b: forward message of a bisegment with energies \p e.
+    \p alpha is the message of the previous bisegment, or the row of a virtual state 0 for the first one.
+ */
+template <int N>
+__HD__ inline void forward(real *alpha, const real *e, real J, bool coupled, real kBT)
+{
+    real next[N];
+
+    for (int k = 0; k < N; ++k)
+    {
+        real c = infinity();
+        for (int j = 0; j < N; ++j)
+            c = combine(c, alpha[j] + (coupled ? J * math::abs(j - k) : 0.0_r), kBT);
+        next[k] = c + e[k];
+    }
+    for (int k = 0; k < N; ++k)
+        alpha[k] = next[k];
+
+    normalize(alpha, N);
+}
+
+/** \brief Draw the state of a bisegment from its conditional distribution.
+    \param [in] alpha The forward message of the bisegment
+    \param [in] next The state of the next bisegment, or -1 for the last bisegment
+    \param [in] J The coupling energy
+    \param [in] kBT The temperature; the most probable state is returned if it is zero
+    \param [in] u A uniform random number in [0, 1)
+    \return the state
+ */
+template <int N>
+__HD__ inline int select(const real *alpha, int next, real J, real kBT, real u)
+{
+    real w[N];
+    real wmin = infinity();
+    int smin = 0;
+
+    for (int s = 0; s < N; ++s)
+    {
+        w[s] = alpha[s] + (next >= 0 ? J * math::abs(s - next) : 0.0_r);
+        if (w[s] < wmin)
+        {
+            wmin = w[s];
+            smin = s;
+        }
+    }
+
+    if (kBT < zeroTemperature)
+        return smin;
+
+    real total = 0.0_r;
+    for (int s = 0; s < N; ++s)
+    {
+        w[s] = math::exp((wmin - w[s]) / kBT);
+        total += w[s];
+    }
+
+    const real target = u * total;
+    real cumul = 0.0_r;
+    int last = smin;
+
+    for (int s = 0; s < N; ++s)
+    {
+        if (w[s] <= 0.0_r)
+            continue;
+        cumul += w[s];
+        last = s;
+        if (target < cumul)
+            return s;
+    }
+    return last;
+}
+
+/// h = f o g for maps of N states: h(x) = f(g(x)). \p h must not alias \p g.
+template <int N>
+__HD__ inline void compose(const uint8_t *f, const uint8_t *g, uint8_t *h)
+{
+    for (int x = 0; x < N; ++x)
+        h[x] = f[g[x]];
+}
+
+/** \brief Sequential host reference of the solver.
+    \param [in] energies The energies \f$ e_b(s) \f$, stored as energies[b * N + s]
+    \param [in] J The coupling energy
+    \param [in] kBT The temperature; the ground state is returned if it is zero
+    \param [in] uniforms One uniform random number in [0, 1) per bisegment
+    \return The states of the bisegments
+ */
+template <int N>
+std::vector<int> sampleStatesReference(const std::vector<real>& energies, real J, real kBT,
+                                       const std::vector<real>& uniforms)
+{
+    const int n = static_cast<int>(energies.size()) / N;
+    std::vector<real> alphas(energies.size());
+
+    real alpha[N];
+    for (int s = 0; s < N; ++s)
+        alpha[s] = (s == 0) ? 0.0_r : infinity();
+
+    for (int b = 0; b < n; ++b)
+    {
+        forward<N>(alpha, energies.data() + b*N, J, b > 0, kBT);
+        for (int s = 0; s < N; ++s)
+            alphas[b*N + s] = alpha[s];
+    }
+
+    std::vector<int> states(n);
+    int next = -1;
+    for (int b = n - 1; b >= 0; --b)
+    {
+        next = select<N>(alphas.data() + b*N, next, J, kBT, uniforms[b]);
+        states[b] = next;
+    }
+    return states;
+}
+
+/// \return the dynamic shared memory in bytes needed by sampleStatesBlock()
+template <int N>
+inline size_t sampleStatesSharedMemory(int nBiSegments, int nthreads)
+{
+    const size_t matrices = nthreads * N * N * sizeof(real);
+    const size_t maps = (nBiSegments + nthreads) * N * sizeof(uint8_t);
+    return matrices + maps;
+}
+
+#ifdef __CUDACC__
+/** \brief Block-parallel version of sampleStatesReference(), for one rod per block.
+
+    Each thread works sequentially on a contiguous chunk of bisegments.
+    The forward messages at the chunk boundaries are obtained with a block-wide scan of the chunk transfer matrices,
+    and the states at the chunk boundaries with a block-wide scan of the composed backward maps.
+    The depth is O(n / nthreads + log(nthreads)).
+
+    \param [in] n Number of bisegments
+    \param [in] energies Callable; energies(b, e) fills e[s] with the energy of state s of bisegment b
+    \param [in] uniforms Callable; uniforms(b) returns a uniform random number in [0, 1) for bisegment b
+    \param [in] J The coupling energy
+    \param [in] kBT The temperature
+    \param [out] states The states of the bisegments
+    \param [in] shMem Dynamic shared memory of size sampleStatesSharedMemory()
+ */
+template <int N, class EnergyFunc, class UniformFunc>
+__device__ void sampleStatesBlock(int n, EnergyFunc energies, UniformFunc uniforms,
+                                  real J, real kBT, int *states, char *shMem)
+{
+    const int tid = threadIdx.x;
+    const int nthreads = blockDim.x;
+    const int chunk = (n + nthreads - 1) / nthreads;
+    const int lo = math::min(tid * chunk, n);
+    const int hi = math::min(lo + chunk, n);
+
+    real *matrices = reinterpret_cast<real*>(shMem);
+    uint8_t *maps = reinterpret_cast<uint8_t*>(matrices + nthreads * N * N);
+    uint8_t *chunkMaps = maps + n * N;
+
+    real e[N];
+    real M[N*N];
+
+    // transfer matrix of the chunk
+    identity<N>(M);
+    for (int b = lo; b < hi; ++b)
+    {
+        energies(b, e);
+        multiplyTransfer<N>(M, e, J, b > 0, kBT);
+    }
+    for (int i = 0; i < N*N; ++i)
+        matrices[tid * N*N + i] = M[i];
+
+    __syncthreads();
+
+    // inclusive scan of the chunk matrices, earlier chunks on the left
+    for (int offset = 1; offset < nthreads; offset *= 2)
+    {
+        const bool active = tid >= offset;
+        if (active)
+            multiply<N>(matrices + (tid - offset) * N*N, matrices + tid * N*N, M, kBT);
+
+        __syncthreads();
+
+        if (active)
+            for (int i = 0; i < N*N; ++i)
+                matrices[tid * N*N + i] = M[i];
+
+        __syncthreads();
+    }
+
+    // forward message before the chunk: row of the virtual state 0 of the exclusive prefix
+    real alpha[N];
+    for (int s = 0; s < N; ++s)
+        alpha[s] = (tid == 0) ? (s == 0 ? 0.0_r : infinity()) : matrices[(tid - 1) * N*N + s];
+
+    // backward maps of each bisegment and their composition over the chunk
+    uint8_t C[N], tmp[N];
+    for (int x = 0; x < N; ++x)
+        C[x] = static_cast<uint8_t>(x);
+
+    for (int b = lo; b < hi; ++b)
+    {
+        energies(b, e);
+        forward<N>(alpha, e, J, b > 0, kBT);
+
+        const real u = uniforms(b);
+        uint8_t *g = maps + b * N;
+
+        if (b == n - 1)
+        {
+            const int s = select<N>(alpha, -1, J, kBT, u);
+            for (int x = 0; x < N; ++x)
+                g[x] = static_cast<uint8_t>(s);
+        }
+        else
+        {
+            for (int x = 0; x < N; ++x)
+                g[x] = static_cast<uint8_t>(select<N>(alpha, x, J, kBT, u));
+        }
+
+        compose<N>(C, g, tmp);
+        for (int x = 0; x < N; ++x)
+            C[x] = tmp[x];
+    }
+    for (int x = 0; x < N; ++x)
+        chunkMaps[tid * N + x] = C[x];
+
+    __syncthreads();
+
+    // inclusive scan of the chunk maps, from the end of the rod
+    for (int offset = 1; offset < nthreads; offset *= 2)
+    {
+        const bool active = tid + offset < nthreads;
+        if (active)
+            compose<N>(chunkMaps + tid * N, chunkMaps + (tid + offset) * N, tmp);
+
+        __syncthreads();
+
+        if (active)
+            for (int x = 0; x < N; ++x)
+                chunkMaps[tid * N + x] = tmp[x];
+
+        __syncthreads();
+    }
+
+    // the composition of all later maps ends with the constant map of the last bisegment
+    int s = (tid + 1 < nthreads) ? chunkMaps[(tid + 1) * N] : 0;
+
+    for (int b = hi - 1; b >= lo; --b)
+    {
+        s = maps[b * N + s];
+        states[b] = s;
+    }
+}
+#endif // __CUDACC__
+
+} // namespace transfer_matrix
+} // namespace mirheo
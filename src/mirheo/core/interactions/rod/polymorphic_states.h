@@ -47,7 +47,8 @@ static void updateStatesAndApplyForces(RodVector *rv,
                        view, stateParams.kSmoothing, kappa, tau_l);
 }
 
-static auto getGPUParams(StatesSpinParameters& p)
+template <class SpinParameters>
+static auto getGPUParams(SpinParameters& p)
 {
     GPU_SpinParameters dp;
     dp.J    = p.J;
@@ -97,4 +98,34 @@ static void updateStatesAndApplyForces(RodVector *rv,
     }
 }
 
+template <int Nstates>
+static void updateStatesAndApplyForces(RodVector *rv,
+                                       const GPU_RodBiSegmentParameters<Nstates> devParams,
+                                       StatesTransferMatrixParameters& stateParams, cudaStream_t stream)
+{
+    auto lrv = rv->local();
+    RVview view(rv, lrv);
+
+    auto kappa = lrv->dataPerBisegment.getData<real4>(channel_names::rodKappa)->devPtr();
+    auto tau_l = lrv->dataPerBisegment.getData<real2>(channel_names::rodTau_l)->devPtr();
+
+    // one warp per rod: the scans cost log(nthreads) matrix products, the chunks are swept sequentially
+    const int nthreads = 32;
+    const int nblocks = view.nObjects;
+
+    // the default limit, available without opting in for larger shared memory
+    constexpr size_t maxShMemSize = 48 * 1024;
+    const size_t shMemSize = transfer_matrix::sampleStatesSharedMemory<Nstates>(view.nSegments - 1, nthreads);
+
+    if (shMemSize > maxShMemSize)
+        die("Rods of '%s' are too long for the transfer matrix state update (%d segments, %d states)",
+            rv->getCName(), view.nSegments, Nstates);
+
+    auto devSpinParams = getGPUParams(stateParams);
+
+    SAFE_KERNEL_LAUNCH(rod_states_kernels::findPolymorphicStatesTransferMatrix<Nstates>,
+                       nblocks, nthreads, shMemSize, stream,
+                       view, devParams, devSpinParams, kappa, tau_l);
+}
+
 } // namespace mirheo
@@ -1,16 +1,21 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "logger.h"
 
+#include <mirheo/core/utils/log_record_buffer.h>
 #include <mirheo/core/utils/path.h>
 #include <mirheo/core/utils/stacktrace_explicit.h>
 #include <mirheo/core/utils/strprintf.h>
 
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstring>
 #include <ctime>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 namespace mirheo
 {
@@ -24,8 +29,59 @@ static void printStacktrace(FILE *fout)
     fwrite(strace.str().c_str(), sizeof(char), strace.str().size(), fout);
 }
 
+/// Magic string at the beginning of binary log files; see `python -m mirheo decode_log`
+static const char binaryLogMagic[8] = {'M', 'I', 'R', 'L', 'O', 'G', 'B', '1'};
+
+/// Wall time period between two flushes of the asynchronous backend
+static constexpr std::chrono::milliseconds asyncFlushPeriod {50};
+
+/** The state of the asynchronous backend.
+    The records are consumed either by the background thread or, when the queue is full
+    or a message does not fit in a record, by a logging thread itself.
+    In both cases the consumer holds fileMutex, which keeps a single consumer at a time
+    and preserves the order of the records in the file.
+ */
+struct Logger::AsyncBackend
+{
+    explicit AsyncBackend(int capacity) :
+        buffer(capacity)
+    {}
+
+    LogRecordBuffer buffer;
+
+    std::mutex fileMutex;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    bool wake {false};
+    bool stop {false};
+
+    std::thread worker;
+};
+
+
+static int64_t getTimeMs()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+Logger::Logger() = default;
+
+Logger::~Logger()
+{
+    setAsync(false);
+}
+
 void Logger::init(MPI_Comm comm, const std::string& fname, int debugLvl)
 {
+    init(comm, fname, debugLvl, LogFormat::Text);
+}
+
+void Logger::init(MPI_Comm comm, const std::string& fname, int debugLvl, LogFormat format)
+{
+    setAsync(false);
+
     MPI_Comm_rank(comm, &rank_);
     constexpr int zeroPadding = 5;
     const std::string rankStr = createStrZeroPadded(rank_, zeroPadding);
@@ -34,7 +90,7 @@ void Logger::init(MPI_Comm comm, const std::string& fname, int debugLvl)
     const auto start = fname.substr(0, pos);
     const auto end   = fname.substr(pos);
 
-    const auto status = fout_.open(start + "_" + rankStr + end, "w");
+    const auto status = fout_.open(start + "_" + rankStr + end, format == LogFormat::Binary ? "wb" : "w");
 
     if (status != FileWrapper::Status::Success)
     {
@@ -42,6 +98,10 @@ void Logger::init(MPI_Comm comm, const std::string& fname, int debugLvl)
         exit(1);
     }
 
+    format_ = format;
+    if (format_ == LogFormat::Binary)
+        _writeBinaryHeader();
+
     setDebugLvl(debugLvl);
 
     stacktrace::registerSignals();
@@ -49,8 +109,11 @@ void Logger::init(MPI_Comm comm, const std::string& fname, int debugLvl)
 
 void Logger::init(MPI_Comm comm, FileWrapper&& fout, int debugLvl)
 {
+    setAsync(false);
+
     MPI_Comm_rank(comm, &rank_);
     this->fout_ = std::move(fout);
+    format_ = LogFormat::Text;
 
     setDebugLvl(debugLvl);
 }
@@ -66,6 +129,61 @@ void Logger::setDebugLvl(int debugLvl)
     }
 }
 
+void Logger::setAsync(bool async, int capacity)
+{
+    if (async && !async_)
+    {
+        int roundedCapacity = 1;
+        while (roundedCapacity < capacity)
+            roundedCapacity *= 2;
+
+        async_ = std::make_unique<AsyncBackend>(roundedCapacity);
+        AsyncBackend *backend = async_.get();
+
+        backend->worker = std::thread([this, backend]()
+        {
+            bool stop = false;
+            while (!stop)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(backend->wakeMutex);
+                    backend->wakeCv.wait_for(lock, asyncFlushPeriod,
+                                             [backend]() {return backend->wake || backend->stop;});
+                    backend->wake = false;
+                    stop = backend->stop;
+                }
+
+                std::lock_guard<std::mutex> lock(backend->fileMutex);
+                backend->buffer.popAll([this](const LogRecord& r)
+                {
+                    _writeRecord(r.timeMs, r.key, r.filename, r.line, r.message, r.length);
+                });
+
+                // also flushes the records written by the logging threads themselves
+                fflush(fout_.get());
+            }
+        });
+    }
+    else if (!async)
+    {
+        _stopAsync();
+    }
+}
+
+void Logger::_stopAsync() const
+{
+    if (!async_)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(async_->wakeMutex);
+        async_->stop = true;
+    }
+    async_->wakeCv.notify_one();
+    async_->worker.join(); // the worker drains the queue before returning
+    async_.reset();
+}
+
 void Logger::log(const char *key, const char *filename, int line, const char *fmt, ...) const {
     va_list args;
     va_start(args, fmt);
@@ -86,30 +204,102 @@ void Logger::_logImpl(const char *key, const char *filename, int line, const cha
         throw std::runtime_error("Logger used before initialization. Message was printed to stderr.");
     }
 
-    using namespace std::chrono;
-    auto now   = system_clock::now();
-    auto now_c = system_clock::to_time_t(now);
-    auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
-
-    char time[16];    // "%T" --> "HH:MM:SS".
-    size_t len = std::strftime(time, sizeof(time), "%T", std::localtime(&now_c));
-    (void)len;
-    assert(len > 0);  // Returns 0 if the format does not fit, which is impossible here.
-
-    // It's not really possible to extend a va_list, so we have to add an
-    // fprintf before and after to print extra formatting. It may be necessary
-    // to replace this with first constructing a string with (v)s(n)printf and
-    // then fprintf-ing it once.
-    fprintf(fout_.get(), "%s:%03d  Rank %04d %7s at %s:%d ",
-            time, (int)ms.count(), rank_, key, filename, line);
-    vfprintf(fout_.get(), fmt, args);
-    fprintf(fout_.get(), "\n");
+    const int64_t timeMs = getTimeMs();
+
+    const bool flushEveryMessage = runtimeDebugLvl_  >= flushThreshold_ &&
+                                   COMPILE_DEBUG_LVL >= flushThreshold_;
+
+    // the arguments may be needed twice if the message is too long for the fixed size buffers
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+
+    if (async_ && !flushEveryMessage)
+    {
+        AsyncBackend& backend = *async_;
+        bool fits = true;
+
+        auto fill = [&](LogRecord& r)
+        {
+            r.timeMs   = timeMs;
+            r.key      = key;
+            r.filename = filename;
+            r.line     = line;
+            r.length   = vsnprintf(r.message, sizeof(r.message), fmt, args);
+
+            if (r.length < 0)
+                r.length = 0;
+
+            if (r.length >= LogRecord::maxMessageLength)
+            {
+                // publish the truncated record anyway (the slot is reserved);
+                // it is replaced by the complete message below
+                fits = false;
+                r.length = 0;
+                r.key = nullptr;
+            }
+        };
+
+        while (!backend.buffer.tryPush(fill))
+        {
+            // the queue is full: drain it ourselves rather than waiting for the worker
+            std::lock_guard<std::mutex> lock(backend.fileMutex);
+            backend.buffer.popAll([this](const LogRecord& r)
+            {
+                _writeRecord(r.timeMs, r.key, r.filename, r.line, r.message, r.length);
+            });
+        }
+
+        if (!fits)
+        {
+            const std::string message = vstrprintf(fmt, argsCopy);
+            std::lock_guard<std::mutex> lock(backend.fileMutex);
+            backend.buffer.popAll([this](const LogRecord& r)
+            {
+                _writeRecord(r.timeMs, r.key, r.filename, r.line, r.message, r.length);
+            });
+            _writeRecord(timeMs, key, filename, line, message.c_str(), static_cast<int>(message.size()));
+        }
+        else if (backend.buffer.size() > backend.buffer.capacity() / 2)
+        {
+            {
+                std::lock_guard<std::mutex> lock(backend.wakeMutex);
+                backend.wake = true;
+            }
+            backend.wakeCv.notify_one();
+        }
+
+        va_end(argsCopy);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock;
+    if (async_)
+    {
+        // keep the file consistent with the records still in the queue
+        lock = std::unique_lock<std::mutex>(async_->fileMutex);
+        async_->buffer.popAll([this](const LogRecord& r)
+        {
+            _writeRecord(r.timeMs, r.key, r.filename, r.line, r.message, r.length);
+        });
+    }
+
+    char message[LogRecord::maxMessageLength];
+    const int length = vsnprintf(message, sizeof(message), fmt, args);
+
+    if (length >= LogRecord::maxMessageLength)
+    {
+        const std::string longMessage = vstrprintf(fmt, argsCopy);
+        _writeRecord(timeMs, key, filename, line, longMessage.c_str(), static_cast<int>(longMessage.size()));
+    }
+    else
+    {
+        _writeRecord(timeMs, key, filename, line, message, std::max(length, 0));
+    }
+    va_end(argsCopy);
 
     ++numLogsSinceLastFlush_;
 
-    bool needToFlush = runtimeDebugLvl_  >= flushThreshold_ &&
-                       COMPILE_DEBUG_LVL >= flushThreshold_;
-    needToFlush = needToFlush || (numLogsSinceLastFlush_ > numLogsBetweenFlushes_);
+    const bool needToFlush = flushEveryMessage || (numLogsSinceLastFlush_ > numLogsBetweenFlushes_);
 
     if (needToFlush)
     {
@@ -118,8 +308,63 @@ void Logger::_logImpl(const char *key, const char *filename, int line, const cha
     }
 }
 
+void Logger::_writeRecord(int64_t timeMs, const char *key, const char *filename, int line,
+                          const char *message, int length) const
+{
+    if (key == nullptr) // placeholder of a message too long for the ring buffer, written separately
+        return;
+
+    FILE *f = fout_.get();
+
+    if (format_ == LogFormat::Binary)
+    {
+        // record layout: int64 time [ms], int32 line, int32 key length, int32 filename length,
+        // int32 message length, followed by the three strings without null characters
+        const int32_t header[4] = {line,
+                                   static_cast<int32_t>(strlen(key)),
+                                   static_cast<int32_t>(strlen(filename)),
+                                   length};
+        fwrite(&timeMs, sizeof(timeMs), 1, f);
+        fwrite(header, sizeof(header), 1, f);
+        fwrite(key,      sizeof(char), header[1], f);
+        fwrite(filename, sizeof(char), header[2], f);
+        fwrite(message,  sizeof(char), header[3], f);
+        return;
+    }
+
+    // localtime is the expensive part; consecutive messages mostly share the same second
+    thread_local time_t cachedSeconds {-1};
+    thread_local char cachedTime[16]; // "%T" --> "HH:MM:SS".
+
+    const time_t seconds = static_cast<time_t>(timeMs / 1000);
+    const int ms = static_cast<int>(timeMs % 1000);
+
+    if (seconds != cachedSeconds)
+    {
+        tm localTime;
+        localtime_r(&seconds, &localTime);
+        size_t len = std::strftime(cachedTime, sizeof(cachedTime), "%T", &localTime);
+        (void)len;
+        assert(len > 0);  // Returns 0 if the format does not fit, which is impossible here.
+        cachedSeconds = seconds;
+    }
+
+    fprintf(f, "%s:%03d  Rank %04d %7s at %s:%d %.*s\n",
+            cachedTime, ms, rank_, key, filename, line, length, message);
+}
+
+void Logger::_writeBinaryHeader() const
+{
+    const int32_t rank = rank_;
+    fwrite(binaryLogMagic, sizeof(binaryLogMagic), 1, fout_.get());
+    fwrite(&rank, sizeof(rank), 1, fout_.get());
+}
+
 void Logger::_die [[noreturn]](const char *filename, int line, const char *fmt, ...) const
 {
+    // write all pending messages before the error, and stay synchronous from now on
+    _stopAsync();
+
     va_list args;
     va_start(args, fmt);
     _logImpl("", filename, line, fmt, args);
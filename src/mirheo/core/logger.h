@@ -5,6 +5,7 @@
 #include <mirheo/core/utils/macros.h>
 
 #include <cuda_runtime.h>
+#include <memory>
 #include <mpi.h>
 #include <string>
 
@@ -38,10 +39,25 @@ namespace mirheo
     \endcode
     has to be defined in one the objective file (typically the one that contains main()).
     Prior to any logging the method init() must be called.
+
+    By default, each logging call writes to the file synchronously.
+    With setAsync(), the messages are instead formatted into a lock-free ring buffer
+    and written to the file by a background thread.
+    The records can optionally be written in a binary format (see LogFormat), that can be
+    converted to text with `python -m mirheo decode_log`.
  */
 class Logger
 {
 public:
+    /// Format of the log files
+    enum class LogFormat
+    {
+        Text,  ///< human readable text, one line per message
+        Binary ///< binary records, cheaper to write
+    };
+
+    Logger();
+    ~Logger();
 
     /** \brief Setup the logger object
         \param [in] comm MPI communicator that contains all ranks that will use the logger
@@ -52,6 +68,16 @@ public:
      */
     void init(MPI_Comm comm, const std::string& filename, int debugLvl = 3);
 
+    /** \brief Setup the logger object
+        \param [in] comm MPI communicator that contains all ranks that will use the logger
+        \param [in] filename log files will be prefixed with \e filename: e.g. \e filename_<rank_with_leading_zeros>.log
+        \param [in] debugLvl debug level
+        \param [in] format The format of the records in the file
+
+        Must be called before any logging method.
+     */
+    void init(MPI_Comm comm, const std::string& filename, int debugLvl, LogFormat format);
+
     /** \brief Setup the logger object to write to a given file.
         \param [in] comm  MPI communicator that contains all ranks that will use the logger
         \param [in] fout file handler, must be open, typically \e stdout or \e stderr
@@ -70,6 +96,23 @@ public:
     */
     void setDebugLvl(int debugLvl);
 
+    /** \brief Enable or disable the asynchronous logging backend.
+        \param [in] async If \c true, messages are queued and written by a background thread.
+        \param [in] capacity The maximum number of queued messages (rounded up to a power of 2).
+
+        Enabling the backend starts the background thread and returns.
+        Disabling it blocks: the background thread writes all pending messages and is joined before returning.
+        Pending messages are also written in die() and at exit.
+
+        While the backend is enabled, a logging call only queues its message, except when the queue is full
+        or the message is too long for a record: the calling thread then writes all pending messages
+        itself, under the file lock, before returning.
+        Messages are flushed to the file at least every few tens of milliseconds, which bounds
+        the amount of lost messages in case of abnormal program termination.
+        Has no effect when the debug level is above the flush threshold (see log()).
+     */
+    void setAsync(bool async, int capacity = 4096);
+
     /** \brief Main logging function.
 
         Construct and dump a log entry with time prefix, importance string,
@@ -131,9 +174,17 @@ public:
 
 private:
     void _logImpl(const char *key, const char *filename, int line, const char *pattern, va_list) const;
+    void _writeRecord(int64_t timeMs, const char *key, const char *filename, int line,
+                      const char *message, int length) const;
+    void _writeBinaryHeader() const;
+    void _stopAsync() const;
+
+    struct AsyncBackend;
 
 private:
     int runtimeDebugLvl_ {0};  ///< debug level defined at runtime through setDebugLvl
+    LogFormat format_ {LogFormat::Text};
+    mutable std::unique_ptr<AsyncBackend> async_; ///< non null when logging asynchronously
 
     static constexpr int flushThreshold_ = 8; ///< value of debug level starting with which every
                                              ///< message will be flushed to disk immediately
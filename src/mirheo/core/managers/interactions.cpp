@@ -3,6 +3,8 @@
 
 #include <mirheo/core/celllist.h>
 #include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/utils/fixed_point_forces.h>
+#include <mirheo/core/utils/compile_options.h>
 
 #include <algorithm>
 #include <set>
@@ -15,6 +17,25 @@ static inline Interaction::ActivePredicate predicateOr(Interaction::ActivePredic
     return [p1, p2]() {return p1() || p2();};
 }
 
+/// with deterministic forces, the fixed-point accumulators are cleared, accumulated and sent back together with the forces
+static std::vector<Interaction::InteractionChannel>
+addFixedPointForceChannels(std::vector<Interaction::InteractionChannel> channels)
+{
+#ifdef MIRHEO_DETERMINISTIC_FORCES
+    const auto it = std::find_if(channels.begin(), channels.end(),
+                                 [](const Interaction::InteractionChannel& c) {return c.name == channel_names::forces;});
+
+    if (it != channels.end())
+    {
+        const auto active = it->active;
+        channels.push_back({channel_names::fixedForcesX, active});
+        channels.push_back({channel_names::fixedForcesY, active});
+        channels.push_back({channel_names::fixedForcesZ, active});
+    }
+#endif
+    return channels;
+}
+
 static void insertClist(CellList *cl, std::vector<CellList*>& clists)
 {
     auto it = std::find(clists.begin(), clists.end(), cl);
@@ -25,10 +46,10 @@ static void insertClist(CellList *cl, std::vector<CellList*>& clists)
 
 void InteractionManager::add(Interaction *interaction,
                              ParticleVector *pv1, ParticleVector *pv2,
-                             CellList *cl1, CellList *cl2)
+                             CellList *cl1, CellList *cl2, int level)
 {
     const auto input  = interaction->getInputChannels();
-    const auto output = interaction->getOutputChannels();
+    const auto output = addFixedPointForceChannels(interaction->getOutputChannels());
 
     auto insertChannels = [&](CellList *cl)
     {
@@ -64,7 +85,7 @@ void InteractionManager::add(Interaction *interaction,
     insertClist(cl1, cellListMap_[pv1]);
     insertClist(cl2, cellListMap_[pv2]);
 
-    interactions_.push_back({interaction, pv1, pv2, cl1, cl2});
+    interactions_.push_back({interaction, pv1, pv2, cl1, cl2, level});
 }
 
 bool InteractionManager::empty() const
@@ -161,6 +182,29 @@ void InteractionManager::clearOutput(ParticleVector *pv, cudaStream_t stream)
     }
 }
 
+void InteractionManager::clearOutputExceptLocalForces(ParticleVector *pv, cudaStream_t stream)
+{
+    auto clListIt = cellListMap_.find(pv);
+
+    if (clListIt == cellListMap_.end())
+        return;
+
+    for (auto cl : clListIt->second)
+    {
+        auto it = outputChannels_.find(cl);
+
+        if (it != outputChannels_.end()) {
+            auto activeChannels = _getActiveChannels(it->second);
+
+            if (cl->getLocalParticleVector() == pv->local())
+                activeChannels.erase(std::remove(activeChannels.begin(), activeChannels.end(), channel_names::forces),
+                                     activeChannels.end());
+
+            cl->clearChannels(activeChannels, stream);
+        }
+    }
+}
+
 void InteractionManager::clearOutputLocalPV(ParticleVector *pv, LocalParticleVector *lpv, cudaStream_t stream) const
 {
     const auto activeChannels = _getActiveChannelsFrom(pv, outputChannels_);
@@ -177,6 +221,18 @@ void InteractionManager::accumulateOutput(cudaStream_t stream)
         auto activeChannels = _getActiveChannels(entry.second);
         cl->accumulateChannels(activeChannels, stream);
     }
+
+    if (CompileOptions::deterministicForces)
+    {
+        for (const auto& entry : cellListMap_)
+        {
+            auto pv = entry.first;
+            const auto activeChannels = _getActiveChannelsFrom(pv, outputChannels_);
+
+            if (std::find(activeChannels.begin(), activeChannels.end(), channel_names::forces) != activeChannels.end())
+                addFixedPointForces(pv, pv->local(), stream);
+        }
+    }
 }
 
 void InteractionManager::gatherInputToCells(cudaStream_t stream)
@@ -190,9 +246,15 @@ void InteractionManager::gatherInputToCells(cudaStream_t stream)
 }
 
 void InteractionManager::executeLocal(cudaStream_t stream)
+{
+    executeLocalLevel(0, stream);
+}
+
+void InteractionManager::executeLocalLevel(int level, cudaStream_t stream)
 {
     for (auto& p : interactions_)
-        p.interaction->local(p.pv1, p.pv2, p.cl1, p.cl2, stream);
+        if (p.level == level)
+            p.interaction->local(p.pv1, p.pv2, p.cl1, p.cl2, stream);
 }
 
 void InteractionManager::executeHalo (cudaStream_t stream)
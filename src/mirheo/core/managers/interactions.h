@@ -22,8 +22,16 @@ public:
     InteractionManager() = default;
     ~InteractionManager() = default;
 
-    /// aregister an interaction with the given particle vectors and cell lists
-    void add(Interaction *interaction, ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2);
+    /** \brief register an interaction with the given particle vectors and cell lists
+        \param interaction The interaction to register
+        \param pv1 The first ParticleVector
+        \param pv2 The second ParticleVector
+        \param cl1 The cell list of pv1
+        \param cl2 The cell list of pv2
+        \param level The time-scale level of the interaction. The local part of the interactions of level > 0
+               is not executed by executeLocal() but by executeLocalLevel() (see MultiTimeStepping).
+     */
+    void add(Interaction *interaction, ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2, int level = 0);
 
     bool empty() const; ///< \return \c true if no interactions were registered
 
@@ -37,12 +45,17 @@ public:
     void clearInputLocalPV(ParticleVector *pv, LocalParticleVector *lpv, cudaStream_t stream) const;  ///< clear input channels of the given LocalParticleVector
 
     void clearOutput(ParticleVector *pv, cudaStream_t stream);  ///< clear output channels of the given ParticleVector
+    void clearOutputExceptLocalForces(ParticleVector *pv, cudaStream_t stream); ///< same as clearOutput(), but keeps the forces stored in the ParticleVector itself (the copies in the cell-lists are cleared)
     void clearOutputLocalPV(ParticleVector *pv, LocalParticleVector *lpv, cudaStream_t stream) const; ///< clear output channels of the given LocalParticleVector
 
-    void accumulateOutput  (cudaStream_t stream); ///< accumulate all output channels of all registerd ParticleVector objects
+    /** \brief accumulate all output channels of all registerd ParticleVector objects
+        With MIRHEO_DETERMINISTIC_FORCES, also add the fixed-point force accumulators to the forces.
+     */
+    void accumulateOutput  (cudaStream_t stream);
     void gatherInputToCells(cudaStream_t stream); ///< gather all the input channels of the registered ParticleVector objects into cell lists
 
-    void executeLocal(cudaStream_t stream); ///< execute the local interactions
+    void executeLocal(cudaStream_t stream); ///< execute the local interactions of level 0
+    void executeLocalLevel(int level, cudaStream_t stream); ///< execute the local interactions of the given time-scale level
     void executeHalo (cudaStream_t stream); ///< execute the halo interactions
 
     /** \brief check if the output of this stage is compatible with the input of the next
@@ -59,6 +72,7 @@ private:
         Interaction *interaction;
         ParticleVector *pv1, *pv2;
         CellList *cl1, *cl2;
+        int level;
     };
 
     using ChannelList = std::vector<Channel>;
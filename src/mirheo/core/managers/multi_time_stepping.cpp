@@ -0,0 +1,155 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "multi_time_stepping.h"
+#include "interactions.h"
+
+#include <mirheo/core/integrators/interface.h>
+#include <mirheo/core/interactions/interface.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/rigid_object_vector.h>
+#include <mirheo/core/pvs/utils/old_positions.h>
+
+#include <algorithm>
+
+namespace mirheo
+{
+
+MultiTimeStepping::MultiTimeStepping(const MirState *state, std::vector<int> substeps, InteractionManager *interactions) :
+    state_(state),
+    substeps_(std::move(substeps)),
+    interactions_(interactions),
+    levelStates_(substeps_.size() + 1, *state),
+    levelInteractions_(substeps_.size() + 1)
+{
+    for (auto n : substeps_)
+        if (n < 1)
+            die("Multiple time stepping: the number of sub steps must be positive, got %d", n);
+}
+
+int MultiTimeStepping::getNumLevels() const
+{
+    return static_cast<int>(levelStates_.size());
+}
+
+void MultiTimeStepping::addInteraction(Interaction *interaction, int level, ParticleVector *pv1, ParticleVector *pv2)
+{
+    if (level <= 0 || level >= getNumLevels())
+        die("Multiple time stepping: interaction '%s' has level %d, must be in [1, %d]",
+            interaction->getCName(), level, getNumLevels() - 1);
+
+    auto& interactions = levelInteractions_[level];
+    if (std::find(interactions.begin(), interactions.end(), interaction) == interactions.end())
+        interactions.push_back(interaction);
+
+    for (auto pv : {pv1, pv2})
+    {
+        auto& entry = pvs_[pv];
+        entry.level = std::max(entry.level, level);
+        entry.slowForces.resize(getNumLevels());
+    }
+}
+
+void MultiTimeStepping::addIntegrator(Integrator *integrator, ParticleVector *pv)
+{
+    auto it = pvs_.find(pv);
+    if (it != pvs_.end())
+        it->second.integrators.push_back(integrator);
+}
+
+bool MultiTimeStepping::manages(ParticleVector *pv) const
+{
+    return pvs_.find(pv) != pvs_.end();
+}
+
+std::vector<ParticleVector*> MultiTimeStepping::getManagedPVs() const
+{
+    std::vector<ParticleVector*> pvs;
+    for (const auto& entry : pvs_)
+        pvs.push_back(entry.first);
+    return pvs;
+}
+
+void MultiTimeStepping::execute(cudaStream_t stream)
+{
+    for (auto& entry : pvs_)
+    {
+        auto pv = entry.first;
+        entry.second.previousPositions.copyFromDevice(pv->local()->positions(), stream);
+        entry.second.integrated = false;
+    }
+
+    levelStates_[0] = *state_;
+    _advance(0, stream);
+
+    for (int level = 1; level < getNumLevels(); ++level)
+        _setInteractionsState(level, state_);
+
+    for (auto& entry : pvs_)
+        storeOldPositions(entry.first, entry.second.previousPositions.devPtr(), stream);
+}
+
+void MultiTimeStepping::_advance(int level, cudaStream_t stream)
+{
+    const MirState *levelState = &levelStates_[level];
+
+    for (auto& entry : pvs_)
+        if (entry.second.level == level)
+            _integrate(entry.first, entry.second, levelState, stream);
+
+    const int next = level + 1;
+    if (next >= getNumLevels())
+        return;
+
+    // forces of all levels up to this one, frozen during the sub steps
+    for (auto& entry : pvs_)
+        if (entry.second.level >= next)
+            entry.second.slowForces[next].copyFromDevice(entry.first->local()->forces(), stream);
+
+    MirState& subState = levelStates_[next];
+    subState = *levelState;
+    subState.setDt(levelState->getDt() / static_cast<real>(substeps_[level]));
+
+    _setInteractionsState(next, &subState);
+
+    for (int substep = 0; substep < substeps_[level]; ++substep)
+    {
+        if (substep != 0)
+        {
+            for (auto& entry : pvs_)
+                if (entry.second.level >= next)
+                    entry.first->local()->forces().copy(entry.second.slowForces[next], stream);
+        }
+
+        interactions_->executeLocalLevel(next, stream);
+
+        _advance(next, stream);
+
+        subState.currentTime += subState.getDt();
+        subState.currentStep++;
+    }
+}
+
+void MultiTimeStepping::_integrate(ParticleVector *pv, PVEntry& entry, const MirState *levelState, cudaStream_t stream)
+{
+    // the rigid integrator accumulates the particle forces into the rigid motions
+    if (entry.integrated)
+        if (auto rov = dynamic_cast<RigidObjectVector*>(pv))
+            rov->local()->clearRigidForces(stream);
+
+    for (auto integrator : entry.integrators)
+    {
+        integrator->setState(levelState);
+        integrator->execute(pv, stream);
+        integrator->setState(state_);
+    }
+
+    entry.integrated = true;
+}
+
+void MultiTimeStepping::_setInteractionsState(int level, const MirState *levelState)
+{
+    for (auto interaction : levelInteractions_[level])
+        interaction->setState(levelState);
+}
+
+} // namespace mirheo
@@ -0,0 +1,101 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/mirheo_state.h>
+
+#include <map>
+#include <vector>
+
+namespace mirheo
+{
+
+class Integrator;
+class Interaction;
+class InteractionManager;
+class ParticleVector;
+
+/** \brief Advance the ParticleVector objects subject to fast interactions with nested sub steps (multiple time stepping).
+
+    Each interaction has a time-scale level. Level 0 is the simulation time step; one time step of level k
+    is split into substeps[k-1] time steps of level k+1.
+    The level of a ParticleVector is the largest level of the interactions that act on it.
+    The ParticleVector objects of level 0 are not managed by this class.
+
+    At each time step of level k, the forces of all the levels below k are frozen;
+    the local part of the interactions of level k is evaluated, then the ParticleVector objects of level k are
+    integrated with the time step of that level while the others recursively perform their sub steps.
+    This is the "frozen slow forces" splitting of IntegratorSubStep, generalized to several levels,
+    any interactions and several ParticleVector objects.
+
+    The halo part of the interactions of levels k > 0 (e.g. bonds that cross the boundary of the subdomain)
+    is evaluated at the simulation time step only, as the halos are exchanged once per time step.
+ */
+class MultiTimeStepping
+{
+public:
+    /** \brief Construct a MultiTimeStepping object.
+        \param [in] state The global state of the system
+        \param [in] substeps substeps[k] is the number of time steps of level k+1 per time step of level k
+        \param [in] interactions The manager that executes the local part of the interactions of each level
+     */
+    MultiTimeStepping(const MirState *state, std::vector<int> substeps, InteractionManager *interactions);
+
+    /// \return the number of levels, including the simulation time step
+    int getNumLevels() const;
+
+    /** \brief Register an interaction of level > 0 and the ParticleVector objects it acts on.
+        \param [in] interaction The interaction
+        \param [in] level The time-scale level of the interaction
+        \param [in] pv1 The first ParticleVector
+        \param [in] pv2 The second ParticleVector
+     */
+    void addInteraction(Interaction *interaction, int level, ParticleVector *pv1, ParticleVector *pv2);
+
+    /** \brief Register the integrator of a ParticleVector.
+        \param [in] integrator The integrator
+        \param [in] pv The ParticleVector; ignored if no interaction of level > 0 acts on it
+     */
+    void addIntegrator(Integrator *integrator, ParticleVector *pv);
+
+    /// \return \c true if the ParticleVector is integrated by this object instead of the simulation
+    bool manages(ParticleVector *pv) const;
+
+    /// \return The ParticleVector objects integrated by this object
+    std::vector<ParticleVector*> getManagedPVs() const;
+
+    /** \brief Advance all the managed ParticleVector objects by one simulation time step.
+        \param [in] stream The execution stream
+
+        The forces of the managed ParticleVector objects must contain the forces of level 0 and the halo part of the
+        forces of the other levels.
+        The old positions are set to the positions at the beginning of the time step.
+     */
+    void execute(cudaStream_t stream);
+
+private:
+    struct PVEntry
+    {
+        int level {0};
+        std::vector<Integrator*> integrators;
+        DeviceBuffer<real4> previousPositions;
+        std::vector<DeviceBuffer<Force>> slowForces; ///< forces of the levels below, one buffer per level
+        bool integrated {false}; ///< already integrated during the current time step
+    };
+
+    void _advance(int level, cudaStream_t stream);
+    void _integrate(ParticleVector *pv, PVEntry& entry, const MirState *levelState, cudaStream_t stream);
+    void _setInteractionsState(int level, const MirState *levelState);
+
+private:
+    const MirState *state_;
+    std::vector<int> substeps_;
+    InteractionManager *interactions_;
+
+    std::vector<MirState> levelStates_;
+    std::vector<std::vector<Interaction*>> levelInteractions_;
+    std::map<ParticleVector*, PVEntry> pvs_;
+};
+
+} // namespace mirheo
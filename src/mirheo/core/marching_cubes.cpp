@@ -1,7 +1,9 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "marching_cubes.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <thread>
 
 namespace mirheo
 {
@@ -90,100 +92,269 @@ static int getConfig(const real vs[8])
         ((vs[7] < 0.0_r) << 7);
 }
 
-void computeTriangles(DomainInfo domain, real3 resolution,
-                      const ImplicitSurfaceFunction& field,
-                      std::vector<Triangle>& triangles)
+namespace
+{
+/// Grid of the values of the scalar field on the corners of the cells.
+struct Grid
 {
-    int3 N {int (domain.localSize.x / resolution.x),
-            int (domain.localSize.y / resolution.y),
-            int (domain.localSize.z / resolution.z)};
+    int3 n;      ///< number of cells along each direction
+    real3 h;     ///< size of one cell
+    real3 start; ///< global position of the first corner
 
-    real3 h {domain.localSize.x / static_cast<real>(N.x),
-             domain.localSize.y / static_cast<real>(N.y),
-             domain.localSize.z / static_cast<real>(N.z)};
+    /// \return linear index of the corner (ix, iy, iz); x is the slowest dimension
+    inline size_t point(int ix, int iy, int iz) const
+    {
+        return (static_cast<size_t>(ix) * static_cast<size_t>(n.y + 1) + static_cast<size_t>(iy))
+            * static_cast<size_t>(n.z + 1) + static_cast<size_t>(iz);
+    }
 
-    std::vector<real3> vertices;
-    std::vector<int> indices;
-    triangles.clear();
-
-    real3 dx {h.x, 0.0, 0.0};
-    real3 dy {0.0, h.y, 0.0};
-    real3 dz {0.0, 0.0, h.z};
-
-    for (int ix = 0; ix < N.x; ++ix) {
-        for (int iy = 0; iy < N.y; ++iy) {
-            for (int iz = 0; iz < N.z; ++iz) {
-
-                real3 r {domain.globalStart.x + static_cast<real>(ix) * h.x,
-                         domain.globalStart.y + static_cast<real>(iy) * h.y,
-                         domain.globalStart.z + static_cast<real>(iz) * h.z};
-
-                const real vs[8] =
-                    {field(r               ),
-                     field(r + dx          ),
-                     field(r      + dy     ),
-                     field(r + dx + dy     ),
-                     field(r           + dz),
-                     field(r + dx      + dz),
-                     field(r      + dy + dz),
-                     field(r + dx + dy + dz),
-                    };
+    inline size_t numPoints() const {return point(n.x + 1, 0, 0);}
 
-                const int configN = getConfig(vs);
+    inline real3 position(int ix, int iy, int iz) const
+    {
+        return {start.x + static_cast<real>(ix) * h.x,
+                start.y + static_cast<real>(iy) * h.y,
+                start.z + static_cast<real>(iz) * h.z};
+    }
+};
 
-                if (configN == 0 || configN == 255)
-                    continue;
+/// The 12 edges of a cell, as (corner offset, axis), following the numbering of marchingCubeTris.
+struct CellEdge
+{
+    int dx, dy, dz; ///< offset of the lower corner of the edge
+    int axis;       ///< direction of the edge (0: x, 1: y, 2: z)
+};
 
-                int edgeIndices[12];
+constexpr CellEdge cellEdges[12] = {
+    {0, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 1, 1, 0},
+    {0, 0, 0, 1}, {1, 0, 0, 1}, {0, 0, 1, 1}, {1, 0, 1, 1},
+    {0, 0, 0, 2}, {1, 0, 0, 2}, {0, 1, 0, 2}, {1, 1, 0, 2}
+};
 
-                auto processEdge = [&](int edgeId, real va, real vb, real3 axis, const real3 &base)
-                {
-                    if ((va < 0.0) == (vb < 0.0))
-                        return;
-
-                    real3 v = base;
-                    v += axis * va / (va - vb);
-                    edgeIndices[edgeId] = static_cast<int>(vertices.size());
-                    vertices.push_back(v);
-                };
-
-                processEdge(0,  vs[0], vs[1], dx, r          );
-                processEdge(1,  vs[2], vs[3], dx, r + dy     );
-                processEdge(2,  vs[4], vs[5], dx, r      + dz);
-                processEdge(3,  vs[6], vs[7], dx, r + dy + dz);
-
-                processEdge(4,  vs[0], vs[2], dy, r          );
-                processEdge(5,  vs[1], vs[3], dy, r + dx     );
-                processEdge(6,  vs[4], vs[6], dy, r      + dz);
-                processEdge(7,  vs[5], vs[7], dy, r + dx + dz);
-
-                processEdge(8,  vs[0], vs[4], dz, r          );
-                processEdge(9,  vs[1], vs[5], dz, r + dx     );
-                processEdge(10, vs[2], vs[6], dz, r      + dy);
-                processEdge(11, vs[3], vs[7], dz, r + dx + dy);
-
-                const uint64_t config = marchingCubeTris[configN];
-                const int  nTriangles = config & 0xF;
-                const int    nIndices = nTriangles * 3;
-
-                int offset = 4;
-
-                for (int i = 0; i < nIndices; i++) {
-                    const int edge = static_cast<int>((config >> offset) & 0xF);
-                    indices.push_back(edgeIndices[edge]);
-                    offset += 4;
-                }
+inline bool crosses(real va, real vb)
+{
+    return (va < 0.0_r) != (vb < 0.0_r);
+}
+
+/// Run func(chunkId, begin, end) on nchunks contiguous ranges of [0, n), one thread per chunk.
+template <typename Func>
+void parallelChunks(int n, int nchunks, Func func)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(nchunks);
+
+    for (int c = 0; c < nchunks; ++c)
+    {
+        const int begin = static_cast<int>(static_cast<long long>(n) *  c      / nchunks);
+        const int end   = static_cast<int>(static_cast<long long>(n) * (c + 1) / nchunks);
+        threads.emplace_back(func, c, begin, end);
+    }
+
+    for (auto& t : threads)
+        t.join();
+}
+
+/** Visit the edges crossed by the surface and owned by the corners of the x planes [begin, end).
+    Each edge is owned by its lower corner; corners are visited in increasing index order and
+    their edges in the order x, y, z.
+ */
+template <typename Func>
+void forEachCrossedEdge(const Grid& grid, const std::vector<real>& values, int begin, int end, Func func)
+{
+    const int3 n = grid.n;
+
+    for (int ix = begin; ix < end; ++ix)
+        for (int iy = 0; iy <= n.y; ++iy)
+            for (int iz = 0; iz <= n.z; ++iz)
+            {
+                const size_t p = grid.point(ix, iy, iz);
+                const real v = values[p];
+
+                if (ix < n.x && crosses(v, values[grid.point(ix+1, iy, iz)]))
+                    func(p, 0, ix, iy, iz);
+                if (iy < n.y && crosses(v, values[grid.point(ix, iy+1, iz)]))
+                    func(p, 1, ix, iy, iz);
+                if (iz < n.z && crosses(v, values[grid.point(ix, iy, iz+1)]))
+                    func(p, 2, ix, iy, iz);
             }
+}
+} // anonymous namespace
+
+void computeMesh(DomainInfo domain, real3 resolution,
+                 const ImplicitSurfaceBatchFunction& surface,
+                 std::vector<real3>& vertices, std::vector<int3>& faces,
+                 int nthreads)
+{
+    Grid grid;
+    grid.n = {int (domain.localSize.x / resolution.x),
+              int (domain.localSize.y / resolution.y),
+              int (domain.localSize.z / resolution.z)};
+
+    grid.h = {domain.localSize.x / static_cast<real>(grid.n.x),
+              domain.localSize.y / static_cast<real>(grid.n.y),
+              domain.localSize.z / static_cast<real>(grid.n.z)};
+
+    grid.start = domain.globalStart;
+
+    const int3 n = grid.n;
+
+    vertices.clear();
+    faces.clear();
+
+    if (n.x <= 0 || n.y <= 0 || n.z <= 0)
+        return;
+
+    // Evaluate the field once per corner, one x plane at a time.
+    // This is done on the calling thread, as the function might not be thread safe (e.g. python).
+    std::vector<real> values(grid.numPoints());
+    {
+        const size_t planeSize = static_cast<size_t>(n.y + 1) * static_cast<size_t>(n.z + 1);
+        std::vector<real3> positions(planeSize);
+
+        for (int ix = 0; ix <= n.x; ++ix)
+        {
+            size_t i = 0;
+            for (int iy = 0; iy <= n.y; ++iy)
+                for (int iz = 0; iz <= n.z; ++iz)
+                    positions[i++] = grid.position(ix, iy, iz);
+
+            surface(positions.data(), static_cast<int>(planeSize), values.data() + grid.point(ix, 0, 0));
         }
     }
 
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        Triangle t;
-        t.a = domain.global2local(vertices[indices[i+0]]);
-        t.b = domain.global2local(vertices[indices[i+1]]);
-        t.c = domain.global2local(vertices[indices[i+2]]);
-        triangles.push_back(t);
-    }
+    if (nthreads <= 0)
+        nthreads = static_cast<int>(std::thread::hardware_concurrency());
+    nthreads = std::max(1, std::min(nthreads, n.x));
+
+    // Chunks of x planes of corners; the last one includes the last plane.
+    // Chunks of cells are the same, without the last plane.
+    const int nplanes = n.x + 1;
+
+    // 1. count the vertices (crossed edges) of each chunk.
+    std::vector<int> vertexOffsets(nthreads + 1, 0);
+
+    parallelChunks(nplanes, nthreads, [&](int c, int begin, int end)
+    {
+        int count = 0;
+        forEachCrossedEdge(grid, values, begin, end, [&](size_t, int, int, int, int) {++count;});
+        vertexOffsets[c + 1] = count;
+    });
+
+    for (int c = 0; c < nthreads; ++c)
+        vertexOffsets[c + 1] += vertexOffsets[c];
+
+    // 2. create the vertices; each edge of the grid gets at most one vertex, shared by its cells.
+    vertices.resize(vertexOffsets[nthreads]);
+    std::vector<int> edgeVertex(3 * grid.numPoints(), -1);
+
+    parallelChunks(nplanes, nthreads, [&](int c, int begin, int end)
+    {
+        int id = vertexOffsets[c];
+
+        forEachCrossedEdge(grid, values, begin, end, [&](size_t p, int axis, int ix, int iy, int iz)
+        {
+            const real va = values[p];
+            const real vb = values[grid.point(ix + (axis == 0), iy + (axis == 1), iz + (axis == 2))];
+
+            real3 dir {0.0_r, 0.0_r, 0.0_r};
+            if      (axis == 0) dir.x = grid.h.x;
+            else if (axis == 1) dir.y = grid.h.y;
+            else                dir.z = grid.h.z;
+
+            real3 v = grid.position(ix, iy, iz);
+            v += dir * va / (va - vb);
+
+            vertices[id] = domain.global2local(v);
+            edgeVertex[3 * p + axis] = id;
+            ++id;
+        });
+    });
+
+    // 3. create the faces of each chunk of cells, in the order of the cells.
+    std::vector<std::vector<int3>> chunkFaces(nthreads);
+
+    parallelChunks(n.x, nthreads, [&](int c, int begin, int end)
+    {
+        auto& dst = chunkFaces[c];
+
+        for (int ix = begin; ix < end; ++ix)
+            for (int iy = 0; iy < n.y; ++iy)
+                for (int iz = 0; iz < n.z; ++iz)
+                {
+                    const real vs[8] = {
+                        values[grid.point(ix,   iy,   iz  )],
+                        values[grid.point(ix+1, iy,   iz  )],
+                        values[grid.point(ix,   iy+1, iz  )],
+                        values[grid.point(ix+1, iy+1, iz  )],
+                        values[grid.point(ix,   iy,   iz+1)],
+                        values[grid.point(ix+1, iy,   iz+1)],
+                        values[grid.point(ix,   iy+1, iz+1)],
+                        values[grid.point(ix+1, iy+1, iz+1)]
+                    };
+
+                    const int configN = getConfig(vs);
+
+                    if (configN == 0 || configN == 255)
+                        continue;
+
+                    auto edgeIndex = [&](int edge)
+                    {
+                        const CellEdge& e = cellEdges[edge];
+                        return edgeVertex[3 * grid.point(ix + e.dx, iy + e.dy, iz + e.dz) + e.axis];
+                    };
+
+                    const uint64_t config = marchingCubeTris[configN];
+                    const int  nTriangles = config & 0xF;
+
+                    int offset = 4;
+
+                    for (int i = 0; i < nTriangles; ++i)
+                    {
+                        int3 f;
+                        f.x = edgeIndex(static_cast<int>((config >> (offset + 0)) & 0xF));
+                        f.y = edgeIndex(static_cast<int>((config >> (offset + 4)) & 0xF));
+                        f.z = edgeIndex(static_cast<int>((config >> (offset + 8)) & 0xF));
+                        dst.push_back(f);
+                        offset += 12;
+                    }
+                }
+    });
+
+    size_t nfaces = 0;
+    for (const auto& f : chunkFaces)
+        nfaces += f.size();
+
+    faces.reserve(nfaces);
+    for (const auto& f : chunkFaces)
+        faces.insert(faces.end(), f.begin(), f.end());
+}
+
+void computeMesh(DomainInfo domain, real3 resolution,
+                 const ImplicitSurfaceFunction& surface,
+                 std::vector<real3>& vertices, std::vector<int3>& faces,
+                 int nthreads)
+{
+    auto batch = [&surface](const real3 *positions, int n, real *values)
+    {
+        for (int i = 0; i < n; ++i)
+            values[i] = surface(positions[i]);
+    };
+
+    computeMesh(domain, resolution, batch, vertices, faces, nthreads);
+}
+
+void computeTriangles(DomainInfo domain, real3 resolution,
+                      const ImplicitSurfaceFunction& surface,
+                      std::vector<Triangle>& triangles)
+{
+    std::vector<real3> vertices;
+    std::vector<int3> faces;
+    computeMesh(domain, resolution, surface, vertices, faces);
+
+    triangles.resize(faces.size());
+
+    for (size_t i = 0; i < faces.size(); ++i)
+        triangles[i] = {vertices[faces[i].x], vertices[faces[i].y], vertices[faces[i].z]};
 }
 
 } // namespace marching_cubes
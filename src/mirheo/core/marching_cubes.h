@@ -15,6 +15,9 @@ namespace marching_cubes
 /// The zero level set represents the surface
 using ImplicitSurfaceFunction = std::function< real(real3) >;
 
+/// Same as ImplicitSurfaceFunction, evaluated at \p n positions at once: values[i] = f(positions[i])
+using ImplicitSurfaceBatchFunction = std::function< void(const real3 *positions, int n, real *values) >;
+
 /// simple tructure that represents a triangle in 3D
 struct Triangle
 {
@@ -23,12 +26,37 @@ struct Triangle
     real3 c; ///< vertex 2
 };
 
+/** \brief Create an explicit surface (indexed triangle mesh) from implicit surface (scalar field)
+    using marching cubes
+    \param [in] domain Domain information
+    \param [in] resolution the number of grid points in each direction
+    \param [in] surface The scalar field that represents implicitly the surface (0 levelset)
+    \param [out] vertices The vertices of the mesh, in local coordinates; shared by adjacent triangles
+    \param [out] faces The triangles of the mesh, as indices in \p vertices
+    \param [in] nthreads The number of threads used to build the mesh; 0 means one per hardware thread
+
+    The field is evaluated once per grid point, one plane of the grid at a time, on the calling thread.
+    The output does not depend on \p nthreads.
+ */
+void computeMesh(DomainInfo domain, real3 resolution,
+                 const ImplicitSurfaceBatchFunction& surface,
+                 std::vector<real3>& vertices, std::vector<int3>& faces,
+                 int nthreads = 0);
+
+/// see computeMesh(); the field is evaluated one point at a time
+void computeMesh(DomainInfo domain, real3 resolution,
+                 const ImplicitSurfaceFunction& surface,
+                 std::vector<real3>& vertices, std::vector<int3>& faces,
+                 int nthreads = 0);
+
 /** \brief Create an explicit surface (triangles) from implicit surface (scalar field)
     using marching cubes
     \param [in] domain Domain information
     \param [in] resolution the number of grid points in each direction
     \param [in] surface The scalar field that represents implicitly the surface (0 levelset)
     \param [out] triangles The explicit surface representation
+
+    Same as computeMesh(), with the vertices duplicated in each triangle.
  */
 void computeTriangles(DomainInfo domain, real3 resolution,
                       const ImplicitSurfaceFunction& surface,
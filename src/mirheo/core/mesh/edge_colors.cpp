@@ -10,11 +10,16 @@ namespace mirheo
 
 std::vector<int> computeEdgeColors(const MembraneMesh *mesh)
 {
-    const int maxDegree = mesh->getMaxDegree();
-    const int nv = mesh->getNvertices();
+    return computeEdgeColors(mesh->getTopology());
+}
+
+std::vector<int> computeEdgeColors(const MeshTopology& topology)
+{
+    const int maxDegree = topology.getMaxDegree();
+    const int nv = topology.getNvertices();
 
-    const auto& adj = mesh->getAdjacents();
-    const auto& deg = mesh->getDegrees();
+    const auto& adj = topology.getAdjacents();
+    const auto& deg = topology.getDegrees();
 
     constexpr int noColor = -1;
 
@@ -65,18 +70,22 @@ std::vector<int> computeEdgeColors(const MembraneMesh *mesh)
 }
 
 
-MeshDistinctEdgeSets::MeshDistinctEdgeSets(const MembraneMesh *mesh)
+MeshDistinctEdgeSets::MeshDistinctEdgeSets(const MembraneMesh *mesh) :
+    MeshDistinctEdgeSets(mesh->getTopology())
+{}
+
+MeshDistinctEdgeSets::MeshDistinctEdgeSets(const MeshTopology& topology)
 {
-    const auto colors = computeEdgeColors(mesh);
+    const auto colors = computeEdgeColors(topology);
     const int maxColor = *std::max_element(colors.begin(), colors.end());
     const int numColors = maxColor + 1;
 
     std::vector<std::vector<int2>> edges(numColors);
 
-    const int nv = mesh->getNvertices();
-    const int md = mesh->getMaxDegree();
-    const auto& deg = mesh->getDegrees();
-    const auto& adj = mesh->getAdjacents();
+    const int nv = topology.getNvertices();
+    const int md = topology.getMaxDegree();
+    const auto& deg = topology.getDegrees();
+    const auto& adj = topology.getAdjacents();
 
     for (int i = 0; i < nv; ++i)
     {
@@ -101,6 +110,18 @@ MeshDistinctEdgeSets::MeshDistinctEdgeSets(const MembraneMesh *mesh)
         std::copy(edges[c].begin(), edges[c].end(), edges_[c].begin());
         edges_[c].uploadToDevice(defaultStream);
     }
+
+    colorStarts_.resize_anew(numColors + 1);
+    colorStarts_[0] = 0;
+    for (int c = 0; c < numColors; ++c)
+        colorStarts_[c+1] = colorStarts_[c] + static_cast<int>(edges[c].size());
+
+    allEdges_.resize_anew(colorStarts_[numColors]);
+    for (int c = 0; c < numColors; ++c)
+        std::copy(edges[c].begin(), edges[c].end(), allEdges_.begin() + colorStarts_[c]);
+
+    colorStarts_.uploadToDevice(defaultStream);
+    allEdges_   .uploadToDevice(defaultStream);
 }
 
 int MeshDistinctEdgeSets::numColors() const
@@ -116,5 +137,15 @@ const PinnedBuffer<int2>& MeshDistinctEdgeSets::edgeSet(int color) const
     return edges_[color];
 }
 
+const PinnedBuffer<int2>& MeshDistinctEdgeSets::allEdges() const
+{
+    return allEdges_;
+}
+
+const PinnedBuffer<int>& MeshDistinctEdgeSets::colorStarts() const
+{
+    return colorStarts_;
+}
+
 
 } // namespace mirheo
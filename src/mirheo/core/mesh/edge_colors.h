@@ -2,6 +2,7 @@
 #pragma once
 
 #include "membrane.h"
+#include "topology.h"
 
 #include <vector>
 
@@ -14,6 +15,9 @@ namespace mirheo
  */
 std::vector<int> computeEdgeColors(const MembraneMesh *mesh);
 
+/// \see computeEdgeColors(const MembraneMesh*)
+std::vector<int> computeEdgeColors(const MeshTopology& topology);
+
 
 /** Stores sets of edges that share the same colors as computed by computeEdgeColors().
     This allows to work on edges in parallel with no race conditions.
@@ -26,14 +30,27 @@ public:
     */
     MeshDistinctEdgeSets(const MembraneMesh *mesh);
 
+    /** Construct a MeshDistinctEdgeSets.
+        \param [in] topology The input mesh connectivity.
+    */
+    MeshDistinctEdgeSets(const MeshTopology& topology);
+
     /// \return the number of colors in the associated mesh.
     int numColors() const;
 
     /// \return The list of edges (vertex indices pairs) that have the given color.
     const PinnedBuffer<int2>& edgeSet(int color) const;
 
+    /// \return The edges of all colors, stored contiguously by color.
+    const PinnedBuffer<int2>& allEdges() const;
+
+    /// \return The offsets of each color in allEdges(); has numColors() + 1 entries.
+    const PinnedBuffer<int>& colorStarts() const;
+
 private:
     std::vector<PinnedBuffer<int2>> edges_;
+    PinnedBuffer<int2> allEdges_;
+    PinnedBuffer<int> colorStarts_;
 };
 
 } // namespace mirheo
@@ -13,6 +13,7 @@ namespace mirheo
 
     A stress-free state can be associated to the mesh.
     The precomputed geometric quantities that are stored in the object are computed from the stress free state.
+    They are shared by all membrane meshes with the same topology and stress-free state (\see MeshTopology).
 
     Additionally to the list of faces (\see Mesh), this class contains a list of
     adjacent vertices for each vertex.
@@ -27,15 +28,15 @@ public:
     /// construct an empty mesh
     MembraneMesh();
 
-    /** \brief Construct a MembraneMesh from an off file
-        \param initialMesh File (in off format) that contains the mesh information.
+    /** \brief Construct a MembraneMesh from an off or ply file
+        \param initialMesh File (in off or ply format) that contains the mesh information.
         \note The stress free state will be the one given by \p initialMesh
      */
     MembraneMesh(const std::string& initialMesh);
 
-    /** \brief Construct a MembraneMesh from an off file
-        \param initialMesh File (in off format) that contains the mesh information.
-        \param stressFreeMesh File (in off format) that contains the stress free state of the mesh.
+    /** \brief Construct a MembraneMesh from an off or ply file
+        \param initialMesh File (in off or ply format) that contains the mesh information.
+        \param stressFreeMesh File (in off or ply format) that contains the stress free state of the mesh.
         \note \p initialMesh and \p stressFreeMesh must have the same topology.
     */
     MembraneMesh(const std::string& initialMesh, const std::string& stressFreeMesh);
@@ -75,10 +76,10 @@ public:
     void saveSnapshotAndRegister(Saver& saver) override;
 
     /// \return The adjacency list of each vertex
-    const PinnedBuffer<int>& getAdjacents() const {return adjacent_;}
+    const PinnedBuffer<int>& getAdjacents() const {return topology_->getAdjacents();}
 
     /// \return The degree of each vertex
-    const PinnedBuffer<int>& getDegrees() const {return degrees_; }
+    const PinnedBuffer<int>& getDegrees() const {return topology_->getDegrees();}
 
 protected:
     /** \brief Implementation of the snapshot saving. Reusable by potential derived classes.
@@ -88,25 +89,7 @@ protected:
     ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
 
 private:
-    /// compute the adjacent vertices lists of all vertices
-    void _findAdjacent();
-
-    /// compute the stress free information from the given vertices
-    void _computeInitialQuantities(const PinnedBuffer<real4>& vertices);
-    /// compute the edge lengths of the stress-free state
-    void _computeInitialLengths(const PinnedBuffer<real4>& vertices);
-    /// compute the areas of the stress-free state
-    void _computeInitialAreas(const PinnedBuffer<real4>& vertices);
-    /// compute the dot product between adjacent edges from the stress-free state
-    /// used in Lim to determine if cos(phi) < 0
-    void _computeInitialDotProducts(const PinnedBuffer<real4>& vertices); ///
-
-private:
-    PinnedBuffer<int> adjacent_; ///< list of adjacent vertices for each vertex
-    PinnedBuffer<int> degrees_;  ///< degree (or valence) of each vertex
-    PinnedBuffer<real> initialLengths_; ///< length of each edge in the stress-free state; data layout is the same as adjacent_
-    PinnedBuffer<real> initialAreas_;    ///< length of each triangle in the stress-free state; data layout is the same as adjacent_
-    PinnedBuffer<real> initialDotProducts_;  ///< dot product between two consecutive edges in the stress-free state; data layout is the same as adjacent_
+    std::shared_ptr<const MembraneStressFreeState> stressFree_; ///< lengths, areas and dot products of the stress-free state
 };
 
 /// A device-compatible structure that represents a data stored in a MembraneMesh additionally to its topology
@@ -2,6 +2,7 @@
 #include "mesh.h"
 
 #include <mirheo/core/mesh/off.h>
+#include <mirheo/core/mesh/ply.h>
 #include <mirheo/core/snapshot.h>
 #include <mirheo/core/utils/config.h>
 #include <mirheo/core/utils/cuda_common.h>
@@ -15,11 +16,12 @@
 namespace mirheo
 {
 
-Mesh::Mesh()
+Mesh::Mesh() :
+    topology_(getSharedMeshTopology(0, {}))
 {}
 
 Mesh::Mesh(const std::string& fileName) :
-    Mesh(readOff(fileName))
+    Mesh(readMeshFile(fileName))
 {}
 
 Mesh::Mesh(const std::tuple<std::vector<real3>, std::vector<int3>>& mesh) :
@@ -31,27 +33,17 @@ Mesh::Mesh(Loader& loader, const ConfigObject& config) :
 {}
 
 Mesh::Mesh(const std::vector<real3>& vertices, const std::vector<int3>& faces) :
-    nvertices_ (static_cast<int>(vertices.size())),
-    ntriangles_(static_cast<int>(faces   .size()))
+    topology_(getSharedMeshTopology(static_cast<int>(vertices.size()), faces))
 {
-    vertices_.resize_anew(nvertices_);
-    faces_   .resize_anew(ntriangles_);
+    vertices_.resize_anew(vertices.size());
 
-    for (int i = 0; i < ntriangles_; ++i)
-        faces_[i] = faces[i];
-
-    for (int i = 0; i < nvertices_; ++i)
+    for (size_t i = 0; i < vertices.size(); ++i)
     {
         const real3 v = vertices[i];
         vertices_[i] = make_real4(v.x, v.y, v.z, 0.0_r);
     }
 
-    _check();
-
     vertices_.uploadToDevice(defaultStream);
-    faces_   .uploadToDevice(defaultStream);
-
-    _computeMaxDegree();
 }
 
 Mesh::Mesh(Mesh&&) = default;
@@ -60,17 +52,13 @@ Mesh& Mesh::operator=(Mesh&&) = default;
 
 Mesh::~Mesh() = default;
 
-const int& Mesh::getNtriangles() const {return ntriangles_;}
-const int& Mesh::getNvertices()  const {return nvertices_;}
-
-const int& Mesh::getMaxDegree() const {
-    if (maxDegree_ < 0)
-        die("maxDegree was not computed");
-    return maxDegree_;
-}
+const int& Mesh::getNtriangles() const {return topology_->getNtriangles();}
+const int& Mesh::getNvertices()  const {return topology_->getNvertices();}
+const int& Mesh::getMaxDegree()  const {return topology_->getMaxDegree();}
 
 const PinnedBuffer<real4>& Mesh::getVertices() const {return vertices_;}
-const PinnedBuffer<int3>& Mesh::getFaces() const {return faces_;}
+const PinnedBuffer<int3>& Mesh::getFaces() const {return topology_->getFaces();}
+const MeshTopology& Mesh::getTopology() const {return *topology_;}
 
 py_types::VectorOfReal3 Mesh::getPyVertices()
 {
@@ -89,12 +77,13 @@ py_types::VectorOfReal3 Mesh::getPyVertices()
 
 py_types::VectorOfInt3 Mesh::getPyFaces()
 {
-    faces_.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+    // the topology is immutable: the host copy is always up to date
+    const auto& faces = getFaces();
     py_types::VectorOfInt3 ret(getNtriangles());
 
     for (int i = 0; i < getNtriangles(); ++i)
     {
-        auto t = faces_[i];
+        auto t = faces[i];
         ret[i][0] = t.x;
         ret[i][1] = t.y;
         ret[i][2] = t.z;
@@ -116,7 +105,8 @@ ConfigObject Mesh::_saveSnapshot(Saver& saver, const std::string& typeName)
     if (saver.getContext().isGroupMasterTask()) {
         // Dump the mesh to a file.
         std::string fileName = joinPaths(saver.getContext().path, name + ".off");
-        std::vector<int3> tmpTriangles(faces_.begin(), faces_.end());
+        const auto& faces = getFaces();
+        std::vector<int3> tmpTriangles(faces.begin(), faces.end());
         std::vector<real3> tmpVertices(vertices_.size());
         for (size_t i = 0; i < tmpVertices.size(); ++i) {
             tmpVertices[i].x = vertices_[i].x;
@@ -134,37 +124,6 @@ ConfigObject Mesh::_saveSnapshot(Saver& saver, const std::string& typeName)
     };
 }
 
-void Mesh::_computeMaxDegree()
-{
-    std::vector<int> degrees(nvertices_);
-
-    for (auto t : faces_)
-    {
-        degrees[t.x] ++;
-        degrees[t.y] ++;
-        degrees[t.z] ++;
-    }
-
-    maxDegree_ = *std::max_element(degrees.begin(), degrees.end());
-    debug("max degree is %d", maxDegree_);
-}
-
-void Mesh::_check() const
-{
-    auto check = [this] (int tr)
-    {
-        if (tr < 0 || tr >= nvertices_)
-            die("Bad triangle indices");
-    };
-
-    for (int i = 0; i < getNtriangles(); ++i)
-    {
-        check(faces_[i].x);
-        check(faces_[i].y);
-        check(faces_[i].z);
-    }
-}
-
 MeshView::MeshView(const Mesh *m) :
     nvertices  (m->getNvertices()),
     ntriangles (m->getNtriangles()),
@@ -1,10 +1,13 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include "topology.h"
+
 #include <mirheo/core/containers.h>
 #include <mirheo/core/utils/common.h>
 #include <mirheo/core/utils/pytypes.h>
 
+#include <memory>
 #include <tuple>
 #include <vector>
 #include <vector_types.h>
@@ -15,6 +18,7 @@ namespace mirheo
 /** \brief A triangle mesh structure.
 
     The topology is represented by a list of faces (three vertex indices per face).
+    It is shared with all other meshes that have the same connectivity (\see MeshTopology).
  */
 class Mesh : public AutoObjectSnapshotTag
 {
@@ -22,7 +26,7 @@ public:
     /// Default constructor. no vertex and faces.
     Mesh();
 
-    /** Construct a \c Mesh from a off file
+    /** Construct a \c Mesh from a off (ASCII or binary) or ply file
         \param fileName The name of the file (contains the extension).
      */
     Mesh(const std::string& fileName);
@@ -49,6 +53,7 @@ public:
 
     const PinnedBuffer<real4>& getVertices() const; ///< \return the list of vertices
     const PinnedBuffer<int3>& getFaces() const;     ///< \return the list of faces
+    const MeshTopology& getTopology() const;        ///< \return the connectivity of the mesh
 
     py_types::VectorOfReal3 getPyVertices();  ///< \return the list of vertices (python compatible)
     py_types::VectorOfInt3  getPyFaces();     ///< \return the list of faces (python compatible)
@@ -67,22 +72,9 @@ protected:
       */
     ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
 
-    /// Update the internal value maxDegree_ from the current topology.
-    void _computeMaxDegree();
-
-    /// Check if all faces contain valid indices; dies otherwise
-    void _check() const;
-
 protected:
-    PinnedBuffer<int3> faces_; ///< The list of faces
+    std::shared_ptr<const MeshTopology> topology_; ///< The list of faces and derived quantities
     PinnedBuffer<real4> vertices_; ///< coordinates of all vertices (float4 to reduce number of load instructions)
-
-private:
-    int nvertices_{0};  ///< number of vertices
-    int ntriangles_{0}; ///< number of faces
-
-    /// max degree of all vertices in the mesh
-    int maxDegree_ {-1};
 };
 
 /// A device-compatible structure that represents a triangle mesh topology (\see \c Mesh)
@@ -1,58 +1,137 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "off.h"
 
+#include "scanner.h"
+
 #include <mirheo/core/logger.h>
+#include <mirheo/core/utils/mapped_file.h>
 
+#include <cstdint>
 #include <fstream>
 
 namespace mirheo
 {
 
-std::tuple<std::vector<real3>, std::vector<int3>> readOff(const std::string& fileName)
+static std::tuple<std::vector<real3>, std::vector<int3>> readOffAscii(MeshFileScanner& scanner, int nvertices, int nfaces)
 {
-    std::vector<int3> faces;
-    std::vector<real3> vertices;
-    int nfaces {0}, nvertices {0}, nedges {0};
-    std::ifstream fin(fileName);
-
-    if (!fin.good())
-        die("off file '%s' not found", fileName.c_str());
-
-    debug("Reading off file '%s'", fileName.c_str());
+    constexpr char comment = '#';
+    const std::string& fileName = scanner.getFileName();
 
-    std::string line;
-    std::getline(fin, line); // OFF header
+    if (nvertices < 0 || nfaces < 0)
+        die("Bad mesh file '%s': negative number of vertices or faces", fileName.c_str());
 
-    fin >> nvertices >> nfaces >> nedges;
-    std::getline(fin, line); // Finish with this line
-
-    vertices.reserve(nvertices);
-    faces.reserve(nfaces);
+    std::vector<real3> vertices(nvertices);
+    std::vector<int3> faces(nfaces);
 
     // Read the vertex coordinates
-    for (int i = 0; i < nvertices; ++i)
+    for (auto& v : vertices)
     {
-        real3 v;
-        fin >> v.x >> v.y >> v.z;
-        vertices.push_back(v);
+        v.x = static_cast<real>(scanner.number(comment));
+        v.y = static_cast<real>(scanner.number(comment));
+        v.z = static_cast<real>(scanner.number(comment));
     }
 
     // Read the connectivity data
     for (int i = 0; i < nfaces; ++i)
     {
-        int number;
-        int3 f;
-        fin >> number;
+        const long long number = scanner.integer(comment);
         if (number != 3)
-            die("Bad mesh file '%s' on line %d, number of face vertices is %d instead of 3",
-                fileName.c_str(), 3 /* header */ + nvertices + i, number);
+            die("Bad mesh file '%s' on face %d, number of face vertices is %lld instead of 3",
+                fileName.c_str(), i, number);
+
+        int3& f = faces[i];
+        f.x = static_cast<int>(scanner.integer(comment));
+        f.y = static_cast<int>(scanner.integer(comment));
+        f.z = static_cast<int>(scanner.integer(comment));
+        scanner.skipLine(); // optional face colors
+    }
+
+    return {std::move(vertices), std::move(faces)};
+}
 
-        fin >> f.x >> f.y >> f.z;
-        faces.push_back(f);
+/// Binary OFF, as defined by geomview: all numbers are 32 bits and stored in big endian order.
+static std::tuple<std::vector<real3>, std::vector<int3>> readOffBinary(MeshFileScanner& scanner)
+{
+    constexpr bool bigEndian = true;
+    const std::string& fileName = scanner.getFileName();
+
+    const int nvertices = scanner.binary<int32_t>(bigEndian);
+    const int nfaces    = scanner.binary<int32_t>(bigEndian);
+    scanner.binary<int32_t>(bigEndian); // number of edges, unused
+
+    if (nvertices < 0 || nfaces < 0)
+        die("Bad mesh file '%s': negative number of vertices or faces", fileName.c_str());
+
+    std::vector<real3> vertices(nvertices);
+    std::vector<int3> faces(nfaces);
+
+    for (auto& v : vertices)
+    {
+        v.x = static_cast<real>(scanner.binary<float>(bigEndian));
+        v.y = static_cast<real>(scanner.binary<float>(bigEndian));
+        v.z = static_cast<real>(scanner.binary<float>(bigEndian));
     }
+
+    for (int i = 0; i < nfaces; ++i)
+    {
+        const int number = scanner.binary<int32_t>(bigEndian);
+        if (number != 3)
+            die("Bad mesh file '%s' on face %d, number of face vertices is %d instead of 3",
+                fileName.c_str(), i, number);
+
+        int3& f = faces[i];
+        f.x = scanner.binary<int32_t>(bigEndian);
+        f.y = scanner.binary<int32_t>(bigEndian);
+        f.z = scanner.binary<int32_t>(bigEndian);
+
+        const int ncolors = scanner.binary<int32_t>(bigEndian);
+        if (ncolors < 0 || ncolors > 4)
+            die("Bad mesh file '%s' on face %d, invalid number of color components %d",
+                fileName.c_str(), i, ncolors);
+        scanner.skipBytes(static_cast<size_t>(ncolors) * sizeof(float));
+    }
+
     return {std::move(vertices), std::move(faces)};
 }
 
+std::tuple<std::vector<real3>, std::vector<int3>> readOff(const std::string& fileName)
+{
+    MappedFile file(fileName);
+    MeshFileScanner scanner(file.data(), file.end(), fileName);
+
+    debug("Reading off file '%s'", fileName.c_str());
+
+    scanner.skipSpaces('#');
+    const std::string header = scanner.word();
+
+    if (header != "OFF")
+        die("Bad mesh file '%s': expected header 'OFF', got '%s'", fileName.c_str(), header.c_str());
+
+    const std::string rest = scanner.line();
+
+    if (rest.find("BINARY") != std::string::npos)
+        return readOffBinary(scanner);
+
+    constexpr char comment = '#';
+    int nvertices, nfaces;
+
+    // the counts are usually on their own line, but may follow the header
+    if (rest.find_first_not_of(" \t\r") != std::string::npos)
+    {
+        MeshFileScanner countsScanner(rest.data(), rest.data() + rest.size(), fileName);
+        nvertices = static_cast<int>(countsScanner.integer());
+        nfaces    = static_cast<int>(countsScanner.integer());
+    }
+    else
+    {
+        nvertices = static_cast<int>(scanner.integer(comment));
+        nfaces    = static_cast<int>(scanner.integer(comment));
+        scanner.skipLine(); // number of edges, unused
+    }
+
+    return readOffAscii(scanner, nvertices, nfaces);
+}
+
 void writeOff(const std::vector<real3>& vertices, const std::vector<int3>& faces, const std::string& fileName)
 {
     std::ofstream fout(fileName);
@@ -10,7 +10,9 @@
 namespace mirheo
 {
 
-/** Read a file in .off format (ASCII) representing a triangle mesh into vertex coordinates and faces connectivity.
+/** Read a file in .off format (ASCII, or binary as defined by geomview) representing a triangle mesh
+    into vertex coordinates and faces connectivity.
+    The file is mapped in memory and parsed without streams.
     This method will die if the found is not found or if the internal structure is not correct.
  */
 std::tuple<std::vector<real3>, std::vector<int3>> readOff(const std::string& fileName);
@@ -0,0 +1,264 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "ply.h"
+#include "off.h"
+#include "scanner.h"
+
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/mapped_file.h>
+
+#include <cstdint>
+
+namespace mirheo
+{
+
+namespace
+{
+enum class PlyFormat {Ascii, BinaryLittleEndian, BinaryBigEndian};
+
+enum class PlyType {Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64};
+
+struct PlyProperty
+{
+    std::string name;
+    bool isList {false};
+    PlyType countType {PlyType::UInt8}; ///< only for lists
+    PlyType type {PlyType::Float32};    ///< type of the value or of the list items
+};
+
+struct PlyElement
+{
+    std::string name;
+    long long count {0};
+    std::vector<PlyProperty> properties;
+};
+
+struct PlyHeader
+{
+    PlyFormat format {PlyFormat::Ascii};
+    std::vector<PlyElement> elements;
+};
+
+PlyType parseType(const std::string& name, const std::string& fileName)
+{
+    if (name == "char"   || name == "int8")    return PlyType::Int8;
+    if (name == "uchar"  || name == "uint8")   return PlyType::UInt8;
+    if (name == "short"  || name == "int16")   return PlyType::Int16;
+    if (name == "ushort" || name == "uint16")  return PlyType::UInt16;
+    if (name == "int"    || name == "int32")   return PlyType::Int32;
+    if (name == "uint"   || name == "uint32")  return PlyType::UInt32;
+    if (name == "float"  || name == "float32") return PlyType::Float32;
+    if (name == "double" || name == "float64") return PlyType::Float64;
+    die("Bad ply file '%s': unknown type '%s'", fileName.c_str(), name.c_str());
+}
+
+PlyHeader readHeader(MeshFileScanner& scanner)
+{
+    const std::string& fileName = scanner.getFileName();
+
+    if (scanner.word() != "ply")
+        die("Bad ply file '%s': missing 'ply' header", fileName.c_str());
+    scanner.skipLine();
+
+    PlyHeader header;
+    bool hasFormat {false};
+
+    while (!scanner.atEnd())
+    {
+        const std::string keyword = scanner.word();
+
+        if (keyword == "end_header")
+        {
+            scanner.skipLine();
+            if (!hasFormat)
+                die("Bad ply file '%s': missing format", fileName.c_str());
+            return header;
+        }
+        else if (keyword == "format")
+        {
+            const std::string format = scanner.word();
+            if      (format == "ascii")                header.format = PlyFormat::Ascii;
+            else if (format == "binary_little_endian") header.format = PlyFormat::BinaryLittleEndian;
+            else if (format == "binary_big_endian")    header.format = PlyFormat::BinaryBigEndian;
+            else die("Bad ply file '%s': unknown format '%s'", fileName.c_str(), format.c_str());
+            hasFormat = true;
+        }
+        else if (keyword == "element")
+        {
+            PlyElement element;
+            element.name = scanner.word();
+            element.count = scanner.integer();
+            header.elements.push_back(std::move(element));
+        }
+        else if (keyword == "property")
+        {
+            if (header.elements.empty())
+                die("Bad ply file '%s': property declared before any element", fileName.c_str());
+
+            PlyProperty property;
+            std::string type = scanner.word();
+
+            if (type == "list")
+            {
+                property.isList = true;
+                property.countType = parseType(scanner.word(), fileName);
+                type = scanner.word();
+            }
+            property.type = parseType(type, fileName);
+            property.name = scanner.word();
+            header.elements.back().properties.push_back(std::move(property));
+        }
+        else if (keyword != "comment" && keyword != "obj_info" && !keyword.empty())
+        {
+            die("Bad ply file '%s': unknown header keyword '%s'", fileName.c_str(), keyword.c_str());
+        }
+        scanner.skipLine();
+    }
+
+    die("Bad ply file '%s': missing 'end_header'", fileName.c_str());
+}
+
+/// Reads the values of the body of a ply file, converted to double.
+class PlyValueReader
+{
+public:
+    PlyValueReader(MeshFileScanner& scanner, PlyFormat format) :
+        scanner_(scanner),
+        format_(format)
+    {}
+
+    double read(PlyType type)
+    {
+        if (format_ == PlyFormat::Ascii)
+            return scanner_.number();
+
+        const bool bigEndian = format_ == PlyFormat::BinaryBigEndian;
+
+        switch (type)
+        {
+        case PlyType::Int8:    return scanner_.binary<int8_t>  (bigEndian);
+        case PlyType::UInt8:   return scanner_.binary<uint8_t> (bigEndian);
+        case PlyType::Int16:   return scanner_.binary<int16_t> (bigEndian);
+        case PlyType::UInt16:  return scanner_.binary<uint16_t>(bigEndian);
+        case PlyType::Int32:   return scanner_.binary<int32_t> (bigEndian);
+        case PlyType::UInt32:  return scanner_.binary<uint32_t>(bigEndian);
+        case PlyType::Float32: return scanner_.binary<float>   (bigEndian);
+        case PlyType::Float64: return scanner_.binary<double>  (bigEndian);
+        }
+        return 0.0;
+    }
+
+private:
+    MeshFileScanner& scanner_;
+    PlyFormat format_;
+};
+
+int findProperty(const PlyElement& element, const std::string& name)
+{
+    for (size_t i = 0; i < element.properties.size(); ++i)
+        if (element.properties[i].name == name)
+            return static_cast<int>(i);
+    return -1;
+}
+} // anonymous namespace
+
+std::tuple<std::vector<real3>, std::vector<int3>> readPly(const std::string& fileName)
+{
+    MappedFile file(fileName);
+    MeshFileScanner scanner(file.data(), file.end(), fileName);
+
+    debug("Reading ply file '%s'", fileName.c_str());
+
+    const PlyHeader header = readHeader(scanner);
+    PlyValueReader reader(scanner, header.format);
+
+    std::vector<real3> vertices;
+    std::vector<int3> faces;
+    bool hasVertices {false}, hasFaces {false};
+
+    for (const auto& element : header.elements)
+    {
+        const bool isVertex = element.name == "vertex";
+        const bool isFace   = element.name == "face";
+
+        const int ix = findProperty(element, "x");
+        const int iy = findProperty(element, "y");
+        const int iz = findProperty(element, "z");
+        int ind = findProperty(element, "vertex_indices");
+        if (ind < 0)
+            ind = findProperty(element, "vertex_index");
+
+        if (isVertex)
+        {
+            if (ix < 0 || iy < 0 || iz < 0)
+                die("Bad ply file '%s': vertex element must have x, y and z properties", fileName.c_str());
+
+            vertices.resize(element.count);
+            hasVertices = true;
+        }
+        else if (isFace)
+        {
+            if (ind < 0 || !element.properties[ind].isList)
+                die("Bad ply file '%s': face element must have a vertex_indices list property", fileName.c_str());
+
+            faces.resize(element.count);
+            hasFaces = true;
+        }
+
+        for (long long i = 0; i < element.count; ++i)
+        {
+            for (int p = 0; p < static_cast<int>(element.properties.size()); ++p)
+            {
+                const auto& property = element.properties[p];
+
+                if (!property.isList)
+                {
+                    const double val = reader.read(property.type);
+
+                    if (isVertex)
+                    {
+                        if      (p == ix) vertices[i].x = static_cast<real>(val);
+                        else if (p == iy) vertices[i].y = static_cast<real>(val);
+                        else if (p == iz) vertices[i].z = static_cast<real>(val);
+                    }
+                    continue;
+                }
+
+                const long long n = static_cast<long long>(reader.read(property.countType));
+
+                if (isFace && p == ind)
+                {
+                    if (n != 3)
+                        die("Bad mesh file '%s' on face %lld, number of face vertices is %lld instead of 3",
+                            fileName.c_str(), i, n);
+
+                    faces[i].x = static_cast<int>(reader.read(property.type));
+                    faces[i].y = static_cast<int>(reader.read(property.type));
+                    faces[i].z = static_cast<int>(reader.read(property.type));
+                }
+                else
+                {
+                    for (long long j = 0; j < n; ++j)
+                        reader.read(property.type);
+                }
+            }
+        }
+    }
+
+    if (!hasVertices || !hasFaces)
+        die("Bad ply file '%s': expected vertex and face elements", fileName.c_str());
+
+    return {std::move(vertices), std::move(faces)};
+}
+
+std::tuple<std::vector<real3>, std::vector<int3>> readMeshFile(const std::string& fileName)
+{
+    const std::string ext = ".ply";
+    const bool isPly = fileName.size() >= ext.size() &&
+        fileName.compare(fileName.size() - ext.size(), ext.size(), ext) == 0;
+
+    if (isPly)
+        return readPly(fileName);
+    return readOff(fileName);
+}
+
+} // namespace mirheo
@@ -0,0 +1,28 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace mirheo
+{
+
+/** Read a file in .ply format (ASCII, binary little or big endian) representing a triangle mesh
+    into vertex coordinates and faces connectivity.
+    The vertex coordinates are read from the properties x, y and z of the "vertex" element; the
+    connectivity from the list property vertex_indices (or vertex_index) of the "face" element.
+    Other elements and properties are ignored.
+    This method will die if the file is not found, if the internal structure is not correct
+    or if a face is not a triangle.
+ */
+std::tuple<std::vector<real3>, std::vector<int3>> readPly(const std::string& fileName);
+
+/** Read a triangle mesh from a file, in a format chosen from its extension:
+    .ply files are read with readPly(), all others with readOff().
+ */
+std::tuple<std::vector<real3>, std::vector<int3>> readMeshFile(const std::string& fileName);
+
+} // namespace mirheo
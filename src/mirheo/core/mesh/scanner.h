@@ -0,0 +1,199 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/logger.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace mirheo
+{
+
+/** \brief Sequential reader over the content of a mesh file held in memory.
+
+    Provides the tokenization of ASCII formats and the decoding of binary values.
+    All functions die with the name of the file if the content is not as expected.
+ */
+class MeshFileScanner
+{
+public:
+    /** \brief Construct a MeshFileScanner
+        \param begin Start of the content
+        \param end End of the content (exclusive)
+        \param fileName Name of the file, used for error messages
+     */
+    MeshFileScanner(const char *begin, const char *end, const std::string& fileName) :
+        cur_(begin),
+        end_(end),
+        fileName_(fileName)
+    {}
+
+    /// \return \c true if all the content has been consumed
+    bool atEnd() const {return cur_ >= end_;}
+
+    /// \return the number of bytes that remain to be read
+    size_t remaining() const {return static_cast<size_t>(end_ - cur_);}
+
+    /// Skip spaces, tabs and new lines; if \p comment is not 0, also skip the lines starting with it
+    void skipSpaces(char comment = 0)
+    {
+        while (cur_ < end_)
+        {
+            if (isSpace(*cur_))
+                ++cur_;
+            else if (comment != 0 && *cur_ == comment)
+                skipLine();
+            else
+                break;
+        }
+    }
+
+    /// Move past the next new line character
+    void skipLine()
+    {
+        const void *nl = memchr(cur_, '\n', remaining());
+        cur_ = nl ? static_cast<const char*>(nl) + 1 : end_;
+    }
+
+    /// \return the next word (sequence of non space characters), after skipping spaces on the current line
+    std::string word()
+    {
+        skipBlanks();
+        const char *start = cur_;
+        while (cur_ < end_ && !isSpace(*cur_))
+            ++cur_;
+        return std::string(start, cur_);
+    }
+
+    /// \return the rest of the current line, without the new line characters; moves to the next line
+    std::string line()
+    {
+        const char *start = cur_;
+        skipLine();
+        const char *stop = cur_;
+        while (stop > start && (stop[-1] == '\n' || stop[-1] == '\r'))
+            --stop;
+        return std::string(start, stop);
+    }
+
+    /// \return the next integer in ASCII format
+    long long integer(char comment = 0)
+    {
+        skipSpaces(comment);
+
+        const char *start = cur_;
+        const bool negative = cur_ < end_ && *cur_ == '-';
+        if (cur_ < end_ && (*cur_ == '-' || *cur_ == '+'))
+            ++cur_;
+
+        long long val = 0;
+        const char *digits = cur_;
+        while (cur_ < end_ && *cur_ >= '0' && *cur_ <= '9')
+            val = 10 * val + (*cur_++ - '0');
+
+        if (cur_ == digits || (cur_ < end_ && !isSpace(*cur_)))
+        {
+            cur_ = start;
+            die("Mesh file '%s': expected an integer, got '%s'", fileName_.c_str(), token(comment).str);
+        }
+        return negative ? -val : val;
+    }
+
+    /// \return the next floating point number in ASCII format
+    double number(char comment = 0)
+    {
+        const Token t = token(comment);
+        char *last;
+        const double val = strtod(t.str, &last);
+        if (last == t.str || *last != '\0')
+            die("Mesh file '%s': expected a number, got '%s'", fileName_.c_str(), t.str);
+        return val;
+    }
+
+    /** \return the next value of type \p T in binary format
+        \param bigEndian Byte order of the value in the file
+     */
+    template <typename T>
+    T binary(bool bigEndian)
+    {
+        if (remaining() < sizeof(T))
+            die("Mesh file '%s': unexpected end of file", fileName_.c_str());
+
+        char bytes[sizeof(T)];
+        memcpy(bytes, cur_, sizeof(T));
+        cur_ += sizeof(T);
+
+        if (bigEndian != hostIsBigEndian())
+            for (size_t i = 0; i < sizeof(T) / 2; ++i)
+                std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+
+        T val;
+        memcpy(&val, bytes, sizeof(T));
+        return val;
+    }
+
+    /// Advance by \p n bytes
+    void skipBytes(size_t n)
+    {
+        if (remaining() < n)
+            die("Mesh file '%s': unexpected end of file", fileName_.c_str());
+        cur_ += n;
+    }
+
+    /// \return the name of the file being read
+    const std::string& getFileName() const {return fileName_;}
+
+    /// \return \c true if the host stores numbers in big endian order
+    static bool hostIsBigEndian()
+    {
+        const uint16_t one = 1;
+        char first;
+        memcpy(&first, &one, 1);
+        return first == 0;
+    }
+
+private:
+    /// A null terminated copy of a short word, so that it can be parsed with the C library.
+    struct Token
+    {
+        char str[64];
+    };
+
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+    }
+
+    void skipBlanks()
+    {
+        while (cur_ < end_ && (*cur_ == ' ' || *cur_ == '\t'))
+            ++cur_;
+    }
+
+    Token token(char comment)
+    {
+        skipSpaces(comment);
+        if (atEnd())
+            die("Mesh file '%s': unexpected end of file", fileName_.c_str());
+
+        Token t;
+        size_t n = 0;
+        while (cur_ < end_ && !isSpace(*cur_) && n + 1 < sizeof(t.str))
+            t.str[n++] = *cur_++;
+        t.str[n] = '\0';
+
+        if (cur_ < end_ && !isSpace(*cur_))
+            die("Mesh file '%s': token '%s...' is too long", fileName_.c_str(), t.str);
+        return t;
+    }
+
+private:
+    const char *cur_;
+    const char *end_;
+    std::string fileName_;
+};
+
+} // namespace mirheo
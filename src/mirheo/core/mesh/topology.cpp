@@ -0,0 +1,343 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "topology.h"
+#include "edge_colors.h"
+
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/helper_math.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+namespace mirheo
+{
+
+/// 64-bit FNV-1a hash of a sequence of bytes.
+static uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL)
+{
+    const auto bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+MeshTopology::MeshTopology(int nvertices, const std::vector<int3>& faces) :
+    nvertices_ (nvertices),
+    ntriangles_(static_cast<int>(faces.size())),
+    hash_(computeHash(nvertices, faces))
+{
+    for (const auto& f : faces)
+        if (f.x < 0 || f.x >= nvertices_ ||
+            f.y < 0 || f.y >= nvertices_ ||
+            f.z < 0 || f.z >= nvertices_)
+            die("Bad triangle indices");
+
+    faces_.resize_anew(ntriangles_);
+    std::copy(faces.begin(), faces.end(), faces_.begin());
+    faces_.uploadToDevice(defaultStream);
+
+    if (nvertices_ > 0)
+    {
+        std::vector<int> degrees(nvertices_, 0);
+
+        for (const auto& t : faces)
+        {
+            degrees[t.x] ++;
+            degrees[t.y] ++;
+            degrees[t.z] ++;
+        }
+
+        maxDegree_ = *std::max_element(degrees.begin(), degrees.end());
+        debug("max degree is %d", maxDegree_);
+    }
+}
+
+MeshTopology::~MeshTopology() = default;
+
+const int& MeshTopology::getMaxDegree() const
+{
+    if (maxDegree_ < 0)
+        die("maxDegree was not computed");
+    return maxDegree_;
+}
+
+const PinnedBuffer<int>& MeshTopology::getAdjacents() const
+{
+    std::call_once(adjacencyFlag_, [this]() {_computeAdjacency();});
+    return adjacent_;
+}
+
+const PinnedBuffer<int>& MeshTopology::getDegrees() const
+{
+    std::call_once(adjacencyFlag_, [this]() {_computeAdjacency();});
+    return degrees_;
+}
+
+const MeshDistinctEdgeSets& MeshTopology::getDistinctEdgeSets() const
+{
+    std::call_once(edgeSetsFlag_, [this]()
+    {
+        edgeSets_ = std::make_unique<MeshDistinctEdgeSets>(*this);
+    });
+    return *edgeSets_;
+}
+
+bool MeshTopology::matches(int nvertices, const std::vector<int3>& faces) const
+{
+    if (nvertices != nvertices_ || static_cast<int>(faces.size()) != ntriangles_)
+        return false;
+
+    for (int i = 0; i < ntriangles_; ++i)
+    {
+        const int3 a = faces_[i];
+        const int3 b = faces[i];
+
+        if (a.x != b.x || a.y != b.y || a.z != b.z)
+            return false;
+    }
+    return true;
+}
+
+uint64_t MeshTopology::computeHash(int nvertices, const std::vector<int3>& faces)
+{
+    const uint64_t hash = hashBytes(&nvertices, sizeof(nvertices));
+    return hashBytes(faces.data(), faces.size() * sizeof(int3), hash);
+}
+
+
+using EdgeMapPerVertex = std::vector< std::map<int, int> >;
+constexpr int invalidId = -1;
+
+static void findDegrees(const EdgeMapPerVertex& adjacentPairs, PinnedBuffer<int>& degrees)
+{
+    const size_t nvertices = adjacentPairs.size();
+    degrees.resize_anew(nvertices);
+
+    for (size_t i = 0; i < nvertices; ++i)
+        degrees[i] = static_cast<int>(adjacentPairs[i].size());
+}
+
+static void findNearestNeighbours(const EdgeMapPerVertex& adjacentPairs, int maxDegree, PinnedBuffer<int>& adjacent)
+{
+    const size_t nvertices = adjacentPairs.size();
+
+    adjacent.resize_anew(nvertices * maxDegree);
+    std::fill(adjacent.begin(), adjacent.end(), invalidId);
+
+    for (size_t v = 0; v < nvertices; ++v)
+    {
+        auto& l = adjacentPairs[v];
+        auto myadjacent = &adjacent[maxDegree*v];
+
+        // Add all the vertices on the adjacent edges one by one.
+        myadjacent[0] = l.begin()->first;
+        for (size_t i = 1; i < l.size(); ++i)
+        {
+            const int current = myadjacent[i-1];
+
+            if (l.find(current) == l.end())
+                die("Unexpected adjacent pairs. This might come from a bad connectivity of the input mesh");
+
+            myadjacent[i] = l.find(current)->second;
+        }
+    }
+}
+
+void MeshTopology::_computeAdjacency() const
+{
+    /*
+     For every vertex: map from neigbouring vertex to a neigbour of both of vertices
+
+      all of such edges:
+         V
+
+      <=====>
+       \   /
+        \ /
+         *
+    */
+    EdgeMapPerVertex adjacentPairs(getNvertices());
+
+    for (const auto& t : faces_)
+    {
+        adjacentPairs [t.x][t.y] = t.z;
+        adjacentPairs [t.y][t.z] = t.x;
+        adjacentPairs [t.z][t.x] = t.y;
+    }
+
+    findDegrees(adjacentPairs, degrees_);
+    findNearestNeighbours(adjacentPairs, getMaxDegree(), adjacent_);
+
+    adjacent_.uploadToDevice(defaultStream);
+    degrees_.uploadToDevice(defaultStream);
+}
+
+
+namespace
+{
+struct TopologyCache
+{
+    std::mutex mutex;
+    std::unordered_multimap<uint64_t, std::weak_ptr<const MeshTopology>> entries;
+};
+
+struct StressFreeCacheEntry
+{
+    std::weak_ptr<const MeshTopology> topology;
+    std::vector<real4> vertices;
+    std::weak_ptr<const MembraneStressFreeState> state;
+};
+
+struct StressFreeCache
+{
+    std::mutex mutex;
+    std::unordered_multimap<uint64_t, StressFreeCacheEntry> entries;
+};
+
+TopologyCache& getTopologyCache()
+{
+    static TopologyCache cache;
+    return cache;
+}
+
+StressFreeCache& getStressFreeCache()
+{
+    static StressFreeCache cache;
+    return cache;
+}
+
+/// Remove the entries whose value is not used anymore.
+template <class Map, class IsExpired>
+void pruneExpired(Map& entries, IsExpired isExpired)
+{
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (isExpired(it->second))
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+}
+} // anonymous namespace
+
+std::shared_ptr<const MeshTopology> getSharedMeshTopology(int nvertices, const std::vector<int3>& faces)
+{
+    auto& cache = getTopologyCache();
+    const uint64_t hash = MeshTopology::computeHash(nvertices, faces);
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    const auto range = cache.entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (auto topology = it->second.lock())
+        {
+            if (topology->matches(nvertices, faces))
+            {
+                debug("Reusing mesh topology with %d vertices and %d faces", nvertices, static_cast<int>(faces.size()));
+                return topology;
+            }
+        }
+    }
+
+    pruneExpired(cache.entries, [](const std::weak_ptr<const MeshTopology>& p) {return p.expired();});
+
+    auto topology = std::make_shared<const MeshTopology>(nvertices, faces);
+    cache.entries.emplace(hash, topology);
+    return topology;
+}
+
+
+static real computeArea(real3 v0, real3 v1, real3 v2)
+{
+    return 0.5_r * length(cross(v1 - v0, v2 - v0));
+}
+
+static std::shared_ptr<MembraneStressFreeState>
+computeStressFreeState(const MeshTopology& topology, const PinnedBuffer<real4>& vertices)
+{
+    auto state = std::make_shared<MembraneStressFreeState>();
+
+    const int nvertices = topology.getNvertices();
+    const int maxDegree = topology.getMaxDegree();
+    const auto& adjacent = topology.getAdjacents();
+    const auto& degrees  = topology.getDegrees();
+
+    state->initialLengths    .resize_anew(nvertices * maxDegree);
+    state->initialAreas      .resize_anew(nvertices * maxDegree);
+    state->initialDotProducts.resize_anew(nvertices * maxDegree);
+
+    for (int i = 0; i < nvertices * maxDegree; i++)
+    {
+        if (adjacent[i] != invalidId)
+            state->initialLengths[i] = length(vertices[i / maxDegree] - vertices[adjacent[i]]);
+    }
+
+    for (int id0 = 0; id0 < nvertices; ++id0)
+    {
+        const int degree = degrees[id0];
+        const int startId = id0 * maxDegree;
+        const real3 v0 = make_real3(vertices[id0]);
+
+        for (int j = 0; j < degree; ++j)
+        {
+            const int id1 = adjacent[startId + j];
+            const int id2 = adjacent[startId + (j + 1) % degree];
+
+            const real3 v1 = make_real3(vertices[id1]);
+            const real3 v2 = make_real3(vertices[id2]);
+
+            state->initialAreas      [startId + j] = computeArea(v0, v1, v2);
+            // used in Lim to determine if cos(phi) < 0
+            state->initialDotProducts[startId + j] = dot(v1 - v0, v2 - v0);
+        }
+    }
+
+    state->initialLengths    .uploadToDevice(defaultStream);
+    state->initialAreas      .uploadToDevice(defaultStream);
+    state->initialDotProducts.uploadToDevice(defaultStream);
+
+    return state;
+}
+
+static bool sameVertices(const std::vector<real4>& a, const PinnedBuffer<real4>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    return a.empty() || memcmp(a.data(), b.hostPtr(), a.size() * sizeof(real4)) == 0;
+}
+
+std::shared_ptr<const MembraneStressFreeState>
+getSharedStressFreeState(const std::shared_ptr<const MeshTopology>& topology, const PinnedBuffer<real4>& vertices)
+{
+    auto& cache = getStressFreeCache();
+    const uint64_t hash = hashBytes(vertices.hostPtr(), vertices.size() * sizeof(real4), topology->getHash());
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    const auto range = cache.entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const auto& entry = it->second;
+        auto state = entry.state.lock();
+
+        if (state && entry.topology.lock() == topology && sameVertices(entry.vertices, vertices))
+        {
+            debug("Reusing stress-free state of mesh with %d vertices", topology->getNvertices());
+            return state;
+        }
+    }
+
+    pruneExpired(cache.entries, [](const StressFreeCacheEntry& e) {return e.state.expired() || e.topology.expired();});
+
+    std::shared_ptr<const MembraneStressFreeState> state = computeStressFreeState(*topology, vertices);
+    cache.entries.emplace(hash, StressFreeCacheEntry{topology, std::vector<real4>(vertices.begin(), vertices.end()), state});
+    return state;
+}
+
+} // namespace mirheo
@@ -0,0 +1,113 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/datatypes.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mirheo
+{
+
+class MeshDistinctEdgeSets;
+
+/** \brief The connectivity of a triangle mesh and the quantities derived from it.
+
+    A MeshTopology is immutable once constructed.
+    Meshes that have the same connectivity share a single instance, hence a single device copy,
+    obtained through getSharedMeshTopology().
+
+    The adjacency lists and the edge sets are only needed by membranes;
+    they are computed at their first use and then kept with the topology.
+ */
+class MeshTopology
+{
+public:
+    /** \brief Construct a MeshTopology; dies if a face contains an invalid vertex index.
+        \param nvertices The number of vertices of the mesh.
+        \param faces List of faces that contains the vertex indices.
+     */
+    MeshTopology(int nvertices, const std::vector<int3>& faces);
+    ~MeshTopology();
+
+    MeshTopology           (const MeshTopology&) = delete;
+    MeshTopology& operator=(const MeshTopology&) = delete;
+
+    const int& getNtriangles() const {return ntriangles_;} ///< \return the number of faces
+    const int& getNvertices()  const {return nvertices_;}  ///< \return the number of vertices
+    const int& getMaxDegree()  const;                      ///< \return the maximum valence of all vertices
+
+    const PinnedBuffer<int3>& getFaces() const {return faces_;} ///< \return the list of faces
+
+    /** \return The adjacency list of each vertex, see MembraneMesh.
+        Dies if the connectivity does not describe a closed manifold.
+     */
+    const PinnedBuffer<int>& getAdjacents() const;
+
+    /// \return The degree of each vertex
+    const PinnedBuffer<int>& getDegrees() const;
+
+    /// \return The sets of edges with distinct colors, see MeshDistinctEdgeSets
+    const MeshDistinctEdgeSets& getDistinctEdgeSets() const;
+
+    /// \return the hash of the connectivity, used to find identical topologies
+    uint64_t getHash() const {return hash_;}
+
+    /// \return \c true if the topology has the given number of vertices and list of faces
+    bool matches(int nvertices, const std::vector<int3>& faces) const;
+
+    /// \return the hash of a connectivity, as returned by getHash()
+    static uint64_t computeHash(int nvertices, const std::vector<int3>& faces);
+
+private:
+    void _computeAdjacency() const;
+
+private:
+    int nvertices_  {0};
+    int ntriangles_ {0};
+    int maxDegree_  {-1};
+    uint64_t hash_  {0};
+
+    PinnedBuffer<int3> faces_; ///< The list of faces
+
+    mutable std::once_flag adjacencyFlag_;
+    mutable PinnedBuffer<int> adjacent_; ///< list of adjacent vertices for each vertex
+    mutable PinnedBuffer<int> degrees_;  ///< degree (or valence) of each vertex
+
+    mutable std::once_flag edgeSetsFlag_;
+    mutable std::unique_ptr<MeshDistinctEdgeSets> edgeSets_;
+};
+
+/** \brief Find or create the topology corresponding to the given connectivity.
+    \param nvertices The number of vertices of the mesh.
+    \param faces List of faces that contains the vertex indices.
+    \return A topology shared by all meshes with the same connectivity.
+
+    The topologies are cached by content for as long as at least one mesh uses them.
+ */
+std::shared_ptr<const MeshTopology> getSharedMeshTopology(int nvertices, const std::vector<int3>& faces);
+
+
+/** \brief Quantities of a membrane in its stress-free state.
+
+    The data layout is the same as the adjacency lists of the associated MeshTopology.
+ */
+struct MembraneStressFreeState
+{
+    PinnedBuffer<real> initialLengths;     ///< length of each edge
+    PinnedBuffer<real> initialAreas;       ///< area of each triangle
+    PinnedBuffer<real> initialDotProducts; ///< dot product between two consecutive edges
+};
+
+/** \brief Find or compute the stress-free quantities of a membrane.
+    \param topology The connectivity of the membrane.
+    \param vertices The vertex coordinates of the stress-free state.
+    \return A state shared by all membranes with the same topology and stress-free vertices.
+ */
+std::shared_ptr<const MembraneStressFreeState>
+getSharedStressFreeState(const std::shared_ptr<const MeshTopology>& topology, const PinnedBuffer<real4>& vertices);
+
+} // namespace mirheo
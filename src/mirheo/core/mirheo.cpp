@@ -30,12 +30,15 @@
 namespace mirheo
 {
 
-LogInfo::LogInfo(const std::string& fileName_, int verbosityLvl_, bool noSplash_) :
+LogInfo::LogInfo(const std::string& fileName_, int verbosityLvl_, bool noSplash_,
+                 bool async_, bool binary_) :
     fileName(fileName_),
     verbosityLvl(verbosityLvl_),
-    noSplash(noSplash_)
+    noSplash(noSplash_),
+    async(async_),
+    binary(binary_)
 {}
-MIRHEO_MEMBER_VARS(LogInfo, fileName, verbosityLvl, noSplash);
+MIRHEO_MEMBER_VARS(LogInfo, fileName, verbosityLvl, noSplash, async, binary);
 
 static void createCartComm(MPI_Comm comm, int3 nranks3D, MPI_Comm *cartComm)
 {
@@ -71,6 +74,42 @@ static void selectIntraNodeGPU(const MPI_Comm& source)
     MPI_Check( MPI_Comm_free(&shmcomm) );
 }
 
+/// \return \c true if the given rank of \p comm runs on the same node as the current rank
+static bool isOnSameNode(const MPI_Comm& comm, int otherRank)
+{
+    MPI_Comm shmcomm;
+    MPI_Check( MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &shmcomm) );
+
+    MPI_Group group, shmgroup;
+    MPI_Check( MPI_Comm_group(comm,    &group)    );
+    MPI_Check( MPI_Comm_group(shmcomm, &shmgroup) );
+
+    int otherShmRank;
+    MPI_Check( MPI_Group_translate_ranks(group, 1, &otherRank, shmgroup, &otherShmRank) );
+
+    MPI_Check( MPI_Group_free(&shmgroup) );
+    MPI_Check( MPI_Group_free(&group) );
+    MPI_Check( MPI_Comm_free(&shmcomm) );
+
+    return otherShmRank != MPI_UNDEFINED;
+}
+
+/** Use shared memory for the plugins communication if all pairs of simulation and postprocess ranks
+    share a node, MPI otherwise. The decision is global so that all plugins behave the same way.
+ */
+static PluginTransport selectPluginTransport(const MPI_Comm& comm, int partnerRank)
+{
+    int sameNode = isOnSameNode(comm, partnerRank) ? 1 : 0;
+    MPI_Check( MPI_Allreduce(MPI_IN_PLACE, &sameNode, 1, MPI_INT, MPI_MIN, comm) );
+
+    if (sameNode)
+    {
+        info("Simulation and postprocess ranks share the same nodes: plugins will communicate through shared memory");
+        return PluginTransport::SharedMemory;
+    }
+    return PluginTransport::MPI;
+}
+
 void Mirheo::init(int3 nranks3D, real3 globalDomainSize, LogInfo logInfo,
                   CheckpointInfo checkpointInfo, bool gpuAwareMPI,
                   UnitConversion units, LoaderContext *load)
@@ -118,6 +157,9 @@ void Mirheo::init(int3 nranks3D, real3 globalDomainSize, LogInfo logInfo,
     computeTask_ = rank_ % 2;
     MPI_Check( MPI_Comm_split(comm_, computeTask_, rank_, &splitComm) );
 
+    // simulation rank i communicates with postprocess rank i, i.e. world ranks 2i+1 and 2i
+    pluginTransport_ = selectPluginTransport(comm_, rank_ ^ 1);
+
     const int localLeader  = 0;
     const int remoteLeader = isComputeTask() ? 1 : 0;
     const int tag = 42;
@@ -178,8 +220,11 @@ void Mirheo::initLogger(MPI_Comm comm, LogInfo logInfo)
     }
     else
     {
-        logger.init(comm, logInfo.fileName+".log", logInfo.verbosityLvl);
+        logger.init(comm, logInfo.fileName+".log", logInfo.verbosityLvl,
+                    logInfo.binary ? Logger::LogFormat::Binary : Logger::LogFormat::Text);
     }
+
+    logger.setAsync(logInfo.async);
 }
 
 Mirheo::Mirheo(int3 nranks3D, real3 globalDomainSize,
@@ -301,12 +346,18 @@ void Mirheo::registerPlugins(const std::shared_ptr<SimulationPlugin>& simPlugin,
     if (isComputeTask())
     {
         if ( simPlugin != nullptr && !(simPlugin->needPostproc() && noPostprocess_) )
+        {
+            simPlugin->setTransport(pluginTransport_);
             sim_->registerPlugin(simPlugin, tag);
+        }
     }
     else
     {
         if ( postPlugin != nullptr && !noPostprocess_ )
+        {
+            postPlugin->setTransport(pluginTransport_);
             post_->registerPlugin(postPlugin, tag);
+        }
     }
 }
 
@@ -364,6 +415,69 @@ void Mirheo::setWallBounce(Wall *wall, ParticleVector *pv, real maximumPartTrave
         sim_->setWallBounce(wall->getName(), pv->getName(), maximumPartTravel);
 }
 
+void Mirheo::setIncrementalCellLists(ParticleVector *pv, bool incremental)
+{
+    ensureNotInitialized();
+
+    if (isComputeTask())
+        sim_->setIncrementalCellLists(pv->getName(), incremental);
+}
+
+void Mirheo::setInPlaceObjectCellLists(ObjectVector *ov, bool inPlace)
+{
+    ensureNotInitialized();
+
+    if (isComputeTask())
+        sim_->setInPlaceObjectCellLists(ov->getName(), inPlace);
+}
+
+void Mirheo::setHaloCompression(ParticleVector *pv, bool compressed)
+{
+    ensureNotInitialized();
+
+    if (isComputeTask())
+        sim_->setHaloCompression(pv->getName(), compressed);
+}
+
+void Mirheo::setFusedIntegration(ParticleVector *pv, bool fused)
+{
+    ensureNotInitialized();
+
+    if (isComputeTask())
+        sim_->setFusedIntegration(pv->getName(), fused);
+}
+
+void Mirheo::setMultipleTimeStepping(const std::vector<int>& substeps)
+{
+    ensureNotInitialized();
+
+    if (isComputeTask())
+        sim_->setMultipleTimeStepping(substeps);
+}
+
+void Mirheo::setInteractionLevel(Interaction *interaction, int level)
+{
+    ensureNotInitialized();
+
+    if (isComputeTask())
+        sim_->setInteractionLevel(interaction->getName(), level);
+}
+
+void Mirheo::setOldPositionsStorage(ParticleVector *pv, const std::string& storage)
+{
+    ensureNotInitialized();
+
+    OldPositionsStorage s;
+    if      (storage == "full")       s = OldPositionsStorage::Full;
+    else if (storage == "half_delta") s = OldPositionsStorage::HalfDelta;
+    else
+        die("Unknown storage '%s' for the old positions of pv '%s'; choose 'full' or 'half_delta'",
+            storage.c_str(), pv->getCName());
+
+    if (isComputeTask())
+        sim_->setOldPositionsStorage(pv->getName(), s);
+}
+
 MirState* Mirheo::getState()
 {
     return state_.get();
@@ -715,6 +829,21 @@ void Mirheo::logCompileOptions() const
     info("MIRHEO_MEMBRANE_DOUBLE : %d", compile_options.membraneDouble);
     info("MIRHEO_ROD_DOUBLE      : %d", compile_options.rodDouble     );
     info("MIRHEO_USE_NVTX        : %d", compile_options.useNvtx       );
+    info("MIRHEO_DETERMINISTIC_FORCES : %d", compile_options.deterministicForces);
+}
+
+void Mirheo::setSnapshotFormat(const std::string& format)
+{
+    ConfigFormat configFormat;
+
+    if      (format == "json")   configFormat = ConfigFormat::JSON;
+    else if (format == "binary") configFormat = ConfigFormat::Binary;
+    else
+        die("Unknown snapshot format '%s'; expected 'json' or 'binary'", format.c_str());
+
+    // Only the compute side needs it, the postprocess side receives it with the config.
+    if (isComputeTask())
+        sim_->setSnapshotFormat(configFormat);
 }
 
 void Mirheo::saveSnapshot(const std::string& path)
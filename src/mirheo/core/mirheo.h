@@ -4,6 +4,7 @@
 #include <mirheo/core/datatypes.h>
 #include <mirheo/core/logger.h>
 #include <mirheo/core/mirheo_state.h>
+#include <mirheo/core/plugins.h>
 #include <mirheo/core/utils/common.h>
 #include <mirheo/core/utils/config.h>
 
@@ -38,11 +39,14 @@ using PairPlugin = std::pair<std::shared_ptr<SimulationPlugin>,
 struct LogInfo
 {
     /// \brief Construct a LogInfo object
-    LogInfo(const std::string& fileName, int verbosityLvl, bool noSplash = false);
+    LogInfo(const std::string& fileName, int verbosityLvl, bool noSplash = false,
+            bool async = false, bool binary = false);
 
     std::string fileName; ///< file to dump the logs to
     int verbosityLvl;     ///< higher = more debug output
     bool noSplash;        ///< if \c true, will not print the mirheo hello message
+    bool async;           ///< if \c true, messages are written to the file by a background thread
+    bool binary;          ///< if \c true, write binary records instead of text (ignored for stdout and stderr)
 };
 
 /** Coordinator class for a full simulation.
@@ -208,6 +212,47 @@ public:
     */
     void setWallBounce(Wall *wall, ParticleVector *pv, real maximumPartTravel = 0.25f);
 
+    /** \brief Choose how the primary cell-list of a registered ParticleVector is built.
+        \param pv The registered ParticleVector (will die if it is not registered)
+        \param incremental If \c true, use the incremental cell-list build.
+    */
+    void setIncrementalCellLists(ParticleVector *pv, bool incremental);
+
+    /** \brief Reorder a registered ObjectVector in place instead of copying it into its cell-list.
+        \param ov The registered ObjectVector (will die if it is not registered)
+        \param inPlace If \c true, sort the local objects by cell and let the pairwise interactions read them directly.
+    */
+    void setInPlaceObjectCellLists(ObjectVector *ov, bool inPlace);
+
+    /** \brief Choose the format of the halo exchange of a registered ParticleVector.
+        \param pv The registered ParticleVector (will die if it is not registered)
+        \param compressed If \c true, send positions and velocities of halo particles with reduced size.
+    */
+    void setHaloCompression(ParticleVector *pv, bool compressed);
+
+    /** \brief Choose how the positions of the previous time step of a registered ParticleVector are stored.
+        \param pv The registered ParticleVector (will die if it is not registered)
+        \param storage Either "full" or "half_delta"; see OldPositionsStorage.
+    */
+    void setOldPositionsStorage(ParticleVector *pv, const std::string& storage);
+
+    /** \brief Fuse the integration of a registered ParticleVector with its cell-list build.
+        \param pv The registered ParticleVector (will die if it is not registered)
+        \param fused If \c true, count the particles into cells and clear their forces during the integration.
+    */
+    void setFusedIntegration(ParticleVector *pv, bool fused);
+
+    /** \brief Define the time-scale levels used for multiple time stepping.
+        \param substeps substeps[k] is the number of time steps of level k+1 per time step of level k.
+    */
+    void setMultipleTimeStepping(const std::vector<int>& substeps);
+
+    /** \brief Set the time-scale level of a registered \c Interaction.
+        \param interaction The registered interaction (will die if it is not registered)
+        \param level 0 for the simulation time step, k > 0 for the time step of level k.
+    */
+    void setInteractionLevel(Interaction *interaction, int level);
+
     MirState* getState(); ///< \return the global state of the system
     const MirState* getState() const; ///< \return the global state of the system (const version)
     Simulation* getSimulation();  ///< \return the Simulation object; \c nullptr on postprocess tasks.
@@ -298,6 +343,11 @@ public:
       */
     void saveSnapshot(const std::string& path);
 
+    /** \brief Set the format of the config file of the snapshots.
+        \param format "json" (default, human-readable) or "binary" (compact and faster to save and load).
+      */
+    void setSnapshotFormat(const std::string& format);
+
 private:
     std::unique_ptr<Simulation> sim_;
     std::unique_ptr<Postprocess> post_;
@@ -307,6 +357,7 @@ private:
     int computeTask_;
     bool noPostprocess_;
     int pluginsTag_ {0}; ///< used to create unique tag per plugin
+    PluginTransport pluginTransport_ {PluginTransport::MPI}; ///< how plugins move data to the postprocess ranks
 
     bool initialized_    = false; ///< has the setup been called at least once?
     bool initializedMpi_ = false;
@@ -3,8 +3,12 @@
 
 #include <mirheo/core/logger.h>
 #include <mirheo/core/utils/config.h>
+#include <mirheo/core/utils/strprintf.h>
 
 #include <cassert>
+#include <cstring>
+#include <limits>
+#include <unistd.h>
 
 namespace mirheo
 {
@@ -24,6 +28,11 @@ void Plugin::setTag(int tag)
     tag_ = tag;
 }
 
+void Plugin::setTransport(PluginTransport transport)
+{
+    transport_ = transport;
+}
+
 void Plugin::_setup(const MPI_Comm& comm, const MPI_Comm& interComm)
 {
     if (comm_ != MPI_COMM_NULL) {
@@ -38,8 +47,14 @@ void Plugin::_setup(const MPI_Comm& comm, const MPI_Comm& interComm)
     MPI_Check( MPI_Comm_size(comm_, &nranks_) );
 }
 
-int Plugin::_sizeTag() const {_checkTag(); return 2 * tag_ + 0;}
-int Plugin::_dataTag() const {_checkTag(); return 2 * tag_ + 1;}
+int Plugin::_sizeTag() const {_checkTag(); return 3 * tag_ + 0;}
+int Plugin::_dataTag() const {_checkTag(); return 3 * tag_ + 1;}
+int Plugin::_ackTag()  const {_checkTag(); return 3 * tag_ + 2;}
+
+std::string Plugin::_segmentName(int pid, int segmentId) const
+{
+    return strprintf("/mirheo-plugin-%d-%d-%d", pid, tag_, segmentId);
+}
 
 void Plugin::_checkTag() const
 {
@@ -52,7 +67,8 @@ SimulationPlugin::SimulationPlugin(const MirState *state, const std::string& nam
     Plugin(),
     MirSimulationObject(state, name),
     sizeReq_(MPI_REQUEST_NULL),
-    dataReq_(MPI_REQUEST_NULL)
+    dataReq_(MPI_REQUEST_NULL),
+    ackReq_(MPI_REQUEST_NULL)
 {}
 
 SimulationPlugin::~SimulationPlugin() = default;
@@ -71,6 +87,11 @@ void SimulationPlugin::beforeParticleDistribution (__UNUSED cudaStream_t stream)
 
 void SimulationPlugin::serializeAndSend (__UNUSED cudaStream_t stream) {}
 
+bool SimulationPlugin::actsBeforeCellLists(__UNUSED const ParticleVector *pv) const
+{
+    return false;
+}
+
 
 void SimulationPlugin::finalize()
 {
@@ -82,8 +103,10 @@ void SimulationPlugin::_waitPrevSend()
 {
     MPI_Check( MPI_Wait(&sizeReq_, MPI_STATUS_IGNORE) );
     MPI_Check( MPI_Wait(&dataReq_, MPI_STATUS_IGNORE) );
+    MPI_Check( MPI_Wait(&ackReq_,  MPI_STATUS_IGNORE) );
     sizeReq_ = MPI_REQUEST_NULL;
     dataReq_ = MPI_REQUEST_NULL;
+    ackReq_  = MPI_REQUEST_NULL;
 }
 
 void SimulationPlugin::_send(const std::vector<char>& data)
@@ -93,15 +116,74 @@ void SimulationPlugin::_send(const std::vector<char>& data)
 
 void SimulationPlugin::_send(const void *data, size_t sizeInBytes)
 {
-    // So that async Isend of the size works on
-    // valid address
-    localSendSize_ = static_cast<int>(sizeInBytes);
+    if (transport_ == PluginTransport::SharedMemory)
+    {
+        char *dst = _prepareSend(sizeInBytes);
+        memcpy(dst, data, sizeInBytes);
+        _sendPrepared();
+        return;
+    }
 
     _waitPrevSend();
 
-    debug2("Plugin '%s' is sending the data (%zu bytes)", getCName(), sizeInBytes);
-    MPI_Check( MPI_Issend(&localSendSize_, 1, MPI_INT,  rank_, _sizeTag(), interComm_, &sizeReq_) );
-    MPI_Check( MPI_Issend(data, static_cast<int>(sizeInBytes), MPI_BYTE, rank_, _dataTag(), interComm_, &dataReq_) );
+    _setMessageSize(sizeInBytes);
+    _sendHeader();
+    MPI_Check( MPI_Issend(data, header_.size, MPI_BYTE, rank_, _dataTag(), interComm_, &dataReq_) );
+}
+
+char* SimulationPlugin::_prepareSend(size_t sizeInBytes)
+{
+    _waitPrevSend();
+
+    _setMessageSize(sizeInBytes);
+
+    if (transport_ == PluginTransport::MPI)
+    {
+        prepareBuffer_.resize(sizeInBytes);
+        return prepareBuffer_.data();
+    }
+
+    if (segment_.data() == nullptr || segment_.size() < sizeInBytes)
+    {
+        const size_t capacity = SharedMemorySegment::computeCapacity(sizeInBytes);
+        ++segmentId_;
+        debug("Plugin '%s' creates a shared memory segment of %zu bytes", getCName(), capacity);
+        segment_ = SharedMemorySegment::create(_segmentName(static_cast<int>(getpid()), segmentId_), capacity);
+    }
+    return segment_.data();
+}
+
+void SimulationPlugin::_sendPrepared()
+{
+    if (transport_ == PluginTransport::MPI)
+    {
+        _sendHeader();
+        MPI_Check( MPI_Issend(prepareBuffer_.data(), header_.size, MPI_BYTE, rank_, _dataTag(), interComm_, &dataReq_) );
+        return;
+    }
+
+    header_.pid             = static_cast<int>(getpid());
+    header_.segmentId       = segmentId_;
+    header_.segmentCapacity = segment_.size();
+
+    // the segment can be overwritten only once the postprocess side has consumed it
+    MPI_Check( MPI_Irecv(&ackMsg_, 1, MPI_INT, rank_, _ackTag(), interComm_, &ackReq_) );
+    _sendHeader();
+}
+
+void SimulationPlugin::_setMessageSize(size_t sizeInBytes)
+{
+    // the size is sent as an int, and MPI messages are limited to INT_MAX elements
+    if (sizeInBytes > static_cast<size_t>(std::numeric_limits<int>::max()))
+        die("Plugin '%s': message of %zu bytes is too large", getCName(), sizeInBytes);
+
+    header_.size = static_cast<int>(sizeInBytes);
+}
+
+void SimulationPlugin::_sendHeader()
+{
+    debug2("Plugin '%s' is sending the data (%d bytes)", getCName(), header_.size);
+    MPI_Check( MPI_Issend(&header_, static_cast<int>(sizeof(header_)), MPI_BYTE, rank_, _sizeTag(), interComm_, &sizeReq_) );
 }
 
 ConfigObject SimulationPlugin::_saveSnapshot(Saver& saver, const std::string& typeName)
@@ -126,26 +208,57 @@ void PostprocessPlugin::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
 
 void PostprocessPlugin::recv()
 {
-    data_.resize(size_);
+    if (transport_ == PluginTransport::SharedMemory)
+    {
+        if (segment_.data() == nullptr || header_.segmentId != segmentId_)
+        {
+            // the simulation side created a new (larger) segment
+            const std::string name = _segmentName(header_.pid, header_.segmentId);
+            segment_ = SharedMemorySegment::open(name, header_.segmentCapacity, true);
+            segmentId_ = header_.segmentId;
+        }
+        data_ = segment_.data();
+        needsAck_ = true;
+
+        debug3("Plugin '%s' has received the data in shared memory (%d bytes)", getCName(), header_.size);
+        return;
+    }
+
+    recvBuffer_.resize(header_.size);
     MPI_Status status;
     int count;
-    MPI_Check( MPI_Recv(data_.data(), size_, MPI_BYTE, rank_, _dataTag(), interComm_, &status) );
+    MPI_Check( MPI_Recv(recvBuffer_.data(), header_.size, MPI_BYTE, rank_, _dataTag(), interComm_, &status) );
     MPI_Check( MPI_Get_count(&status, MPI_BYTE, &count) );
 
-    if (count != size_)
+    if (count != header_.size)
         error("Plugin '%s' was going to receive %d bytes, but actually got %d. That may be fatal",
-              getCName(), size_, count);
+              getCName(), header_.size, count);
 
+    data_ = recvBuffer_.data();
     debug3("Plugin '%s' has received the data (%d bytes)", getCName(), count);
 }
 
 MPI_Request PostprocessPlugin::waitData()
 {
+    _releaseData();
+
     MPI_Request req;
-    MPI_Check( MPI_Irecv(&size_, 1, MPI_INT, rank_, _sizeTag(), interComm_, &req) );
+    MPI_Check( MPI_Irecv(&header_, static_cast<int>(sizeof(header_)), MPI_BYTE, rank_, _sizeTag(), interComm_, &req) );
     return req;
 }
 
+void PostprocessPlugin::_releaseData()
+{
+    data_ = nullptr;
+
+    if (needsAck_)
+    {
+        const int ackMsg = 1;
+        MPI_Check( MPI_Send(&ackMsg, 1, MPI_INT, rank_, _ackTag(), interComm_) );
+        needsAck_ = false;
+    }
+}
+
 void PostprocessPlugin::deserialize() {}
 
 ConfigObject PostprocessPlugin::_saveSnapshot(Saver& saver, const std::string& typeName)
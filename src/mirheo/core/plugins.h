@@ -2,6 +2,7 @@
 #pragma once
 
 #include <mirheo/core/mirheo_object.h>
+#include <mirheo/core/utils/shared_memory.h>
 #include <mirheo/core/utils/unique_mpi_comm.h>
 
 #include <mpi.h>
@@ -11,6 +12,17 @@ namespace mirheo
 {
 
 class Simulation;
+class ParticleVector;
+
+/** \brief Describes how the serialized data is moved from a SimulationPlugin to its PostprocessPlugin.
+
+    The size of each message (and the location of the data) is always sent through MPI.
+ */
+enum class PluginTransport
+{
+    MPI,         ///< the data is sent through the inter communicator
+    SharedMemory ///< the data is written to a shared memory segment and read in place; requires both ranks to be on the same node
+};
 
 /** \brief Base class to represent a Plugin.
 
@@ -39,6 +51,13 @@ public:
     */
     void setTag(int tag);
 
+    /** \brief Set the mechanism used to transfer data between SimulationPlugin and PostprocessPlugin.
+        \param transport The transport; must be the same on the simulation and postprocess sides.
+
+        Must be called before setup. Default is PluginTransport::MPI.
+    */
+    void setTransport(PluginTransport transport);
+
 protected:
     /** Setup the internal state from the given MPI communicators.
         Must be called before any other method of the class.
@@ -49,6 +68,22 @@ protected:
     void _setup(const MPI_Comm& comm, const MPI_Comm& interComm);
     int _sizeTag() const; ///< generate a tag to communicate the size of a message
     int _dataTag() const; ///< generate a tag to communicate the content of a message
+    int _ackTag() const;  ///< generate a tag to notify that a message in shared memory has been consumed
+
+    /// The information sent before each message
+    struct MessageHeader
+    {
+        int size;            ///< size of the message in bytes
+        int pid;             ///< process id of the sender; only used with shared memory
+        int segmentId;       ///< index of the shared memory segment holding the data; only used with shared memory
+        size_t segmentCapacity; ///< size of the shared memory segment; only used with shared memory
+    };
+
+    /** \return The name of a shared memory segment, unique for a given sender process and plugin.
+        \param pid The process id of the sender.
+        \param segmentId The index of the segment.
+     */
+    std::string _segmentName(int pid, int segmentId) const;
 
 private:
     void _checkTag() const; ///< die if the tag has not been set.
@@ -58,6 +93,7 @@ protected:
     MPI_Comm interComm_; ///< The communicator used to communicate between simulation and postprocess ranks.
     int rank_;   ///< rank id within comm_
     int nranks_; ///< number of ranks in comm_
+    PluginTransport transport_ {PluginTransport::MPI}; ///< how the data is moved to the postprocess side
 
 private:
     static constexpr int invalidTag = -1;
@@ -110,6 +146,16 @@ public:
      */
     virtual void serializeAndSend (cudaStream_t stream);
 
+    /** \brief Tell if the plugin acts on the particles of a ParticleVector between the integration and the cell-list build.
+        \param pv The ParticleVector of interest.
+        \return \c true if afterIntegration() or beforeCellLists() add, remove, mark or move particles of \p pv,
+                 or use its cell-lists. \c false by default.
+
+        Such plugins can not be used with Simulation::setFusedIntegration().
+        Must be called after setup().
+     */
+    virtual bool actsBeforeCellLists(const ParticleVector *pv) const;
+
     virtual void finalize(); ///< hook that happens once at the end of the simulation loop
 
 protected:
@@ -121,6 +167,20 @@ protected:
     /// see send()
     void _send(const void *data, size_t sizeInBytes);
 
+    /** \brief Get a buffer in which the next message can be serialized directly.
+        \param sizeInBytes The size of the message.
+        \return A pointer to at least \p sizeInBytes bytes.
+
+        Waits for the previous send to complete.
+        With PluginTransport::SharedMemory, the buffer is the shared segment read by the postprocess side,
+        which avoids any intermediate copy.
+        Must be followed by _sendPrepared().
+     */
+    char* _prepareSend(size_t sizeInBytes);
+
+    /// post an asynchronous send of the data written in the buffer returned by _prepareSend()
+    void _sendPrepared();
+
     /** \brief Implementation of the snapshot saving. Reusable by potential derived classes.
         \param [in,out] saver The \c Saver object. Provides save context and serialization functions.
         \param [in] typeName The name of the type being saved.
@@ -128,9 +188,19 @@ protected:
     ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
 
 private:
-    int localSendSize_;
+    void _setMessageSize(size_t sizeInBytes); ///< set the size of the next message; dies if it does not fit in an int
+    void _sendHeader();
+
+private:
+    MessageHeader header_ {0, 0, -1, 0};
     MPI_Request sizeReq_;
     MPI_Request dataReq_;
+    MPI_Request ackReq_;
+    int ackMsg_;
+
+    std::vector<char> prepareBuffer_;
+    SharedMemorySegment segment_;
+    int segmentId_ {-1};
 };
 
 /** \brief Base class for the postprocess side of a \c Plugin.
@@ -159,7 +229,10 @@ public:
     /// Post an asynchronous receive request to get a message from the associated SimulationPlugin
     void recv();
 
-    /// wait for the completion of the asynchronous receive request. Must be called after recv() and before deserialize().
+    /** \brief Post an asynchronous receive request for the size of the next message.
+        Must be called before recv(). This also releases the data of the previous message, which
+        can not be accessed anymore.
+     */
     MPI_Request waitData();
 
     /// Perform the action implemented by the plugin using the data received from the SimulationPlugin.
@@ -172,9 +245,18 @@ protected:
       */
     ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
 
-    std::vector<char> data_; ///< will hold the data sent by the associated SimulationPlugin
+    /// points to the data sent by the associated SimulationPlugin; valid until the next call of waitData()
+    const char *data_ {nullptr};
+
+private:
+    void _releaseData();
+
 private:
-    int size_; ///< size of the recv data
+    MessageHeader header_ {0, 0, -1, 0}; ///< information about the received data
+    std::vector<char> recvBuffer_; ///< holds the received data with PluginTransport::MPI
+    SharedMemorySegment segment_;  ///< holds the received data with PluginTransport::SharedMemory
+    int segmentId_ {-1};           ///< index of the currently mapped segment
+    bool needsAck_ {false};        ///< \c true if the simulation side waits for the current data to be released
 };
 
 } // namespace mirheo
@@ -201,15 +201,16 @@ void Postprocess::snapshot(const std::string& path)
     int rank;
     MPI_Comm_rank(comm_, &rank);
     if (rank == 0) {
-        // Get the JSON object from the simulation side.
-        int size;
+        // Get the config format and the binary config object from the simulation side.
+        int format, size;
+        MPI_Check( MPI_Recv(&format, 1, MPI_INT, 0, snapshotTag, interComm_, MPI_STATUS_IGNORE) );
         MPI_Check( MPI_Recv(&size, 1, MPI_INT, 0, snapshotTag, interComm_, MPI_STATUS_IGNORE) );
-        std::string simJson(size, '_');
-        MPI_Check( MPI_Recv(const_cast<char *>(simJson.data()), size, MPI_CHAR,
+        std::string simConfig(size, '_');
+        MPI_Check( MPI_Recv(const_cast<char *>(simConfig.data()), size, MPI_CHAR,
                             0, snapshotTag, interComm_, MPI_STATUS_IGNORE) );
 
         // Postprocessing side will be merged into the simulation side.
-        ConfigObject all = configFromJSON(simJson).getObject();
+        ConfigObject all = configFromBinary(simConfig).getObject();
         ConfigObject &post = saver.getConfig();
         assert(post.size() == 1 || post.size() == 2);  // Only plugins (optionally) and Postprocess.
         auto it = post.find("PostprocessPlugin");
@@ -224,10 +225,8 @@ void Postprocess::snapshot(const std::string& path)
         // Store compile options as a special category.
         all.unsafe_insert("CompileOptions", compileOptionsToConfig(saver));
 
-        // Save the config.json.
-        std::string content = ConfigValue(std::move(all)).toJSONString() + '\n';
-        FileWrapper f(joinPaths(path, "config.json"), "w");
-        fwrite(content.data(), 1, content.size(), f.get());
+        // Save the config.json or config.bin.
+        writeSnapshotConfig(path, static_cast<ConfigFormat>(format), ConfigValue{std::move(all)});
     }
 }
 
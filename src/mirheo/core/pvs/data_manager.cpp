@@ -187,6 +187,11 @@ const DataManager::ChannelDescription& DataManager::getChannelDescOrDie(const st
 }
 
 
+void DataManager::deleteData(const std::string& name)
+{
+    _deleteChannel(name);
+}
+
 void DataManager::_deleteChannel(const std::string& name)
 {
     if (!channelMap_.erase(name))
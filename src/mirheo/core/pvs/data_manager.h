@@ -194,6 +194,13 @@ public:
      */
     void* getGenericPtr(const std::string& name);
 
+    /** \brief Delete a channel
+        \param [in] name buffer name
+
+        This method will die if the required name does not exist.
+     */
+    void deleteData(const std::string& name);
+
     /// \c true if channel with given \c name exists, \c false otherwise
     bool checkChannelExists(const std::string& name) const;
 
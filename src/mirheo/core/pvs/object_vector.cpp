@@ -51,6 +51,13 @@ void LocalObjectVector::resize_anew(int np)
     dataPerObject.resize_anew(nObjects_);
 }
 
+void LocalObjectVector::resizePartialObjects_anew(int np)
+{
+    nObjects_ = 0;
+    LocalParticleVector::resize_anew(np);
+    dataPerObject.resize_anew(nObjects_);
+}
+
 void LocalObjectVector::computeGlobalIds(MPI_Comm comm, cudaStream_t stream)
 {
     LocalParticleVector::computeGlobalIds(comm, stream);
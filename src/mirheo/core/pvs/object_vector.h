@@ -35,6 +35,14 @@ public:
     void resize(int np, cudaStream_t stream) override;
     void resize_anew(int np) override;
 
+    /** \brief Resize the particle data without preserving it; the particles do not form complete objects.
+        \param [in] np The new number of particles (not necessarily a multiple of the object size)
+
+        The number of objects is set to zero and no object data is stored.
+        This is used for halos that contain only the particles of the objects close to the subdomain boundaries.
+     */
+    void resizePartialObjects_anew(int np);
+
     void computeGlobalIds(MPI_Comm comm, cudaStream_t stream) override;
 
     /// get positions of the mesh vertices
@@ -0,0 +1,44 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "compressed_particles.h"
+
+#include <mirheo/core/pvs/particle_vector.h>
+
+namespace mirheo
+{
+
+static PackPredicate withoutPositionsAndVelocities(PackPredicate predicate)
+{
+    return [predicate](const DataManager::NamedChannelDesc& namedDesc)
+    {
+        return namedDesc.first != channel_names::positions
+            && namedDesc.first != channel_names::velocities
+            && predicate(namedDesc);
+    };
+}
+
+CompressedParticlePacker::CompressedParticlePacker(PackPredicate predicate, int3 ncells, real3 localDomainSize) :
+    ParticlePacker(withoutPositionsAndVelocities(predicate)),
+    codec_(ncells, localDomainSize)
+{}
+
+CompressedParticlePacker::~CompressedParticlePacker() = default;
+
+void CompressedParticlePacker::update(LocalParticleVector *lpv, cudaStream_t stream)
+{
+    ParticlePacker::update(lpv, stream);
+    positions_  = lpv->positions ().devPtr();
+    velocities_ = lpv->velocities().devPtr();
+}
+
+CompressedParticlePackerHandler CompressedParticlePacker::compressedHandler()
+{
+    return {particleData_.handler(), positions_, velocities_, codec_};
+}
+
+size_t CompressedParticlePacker::getSizeBytes(int numElements) const
+{
+    return CompressedParticlePackerHandler::compressedSizeBytes(numElements)
+        + ParticlePacker::getSizeBytes(numElements);
+}
+
+} // namespace mirheo
@@ -0,0 +1,246 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "particles.h"
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+#include <mirheo/core/utils/half_precision.h>
+#include <mirheo/core/utils/helper_math.h>
+
+#include <cstdint>
+
+namespace mirheo
+{
+
+/** \brief Reduced size encoding of positions and velocities of halo particles.
+
+    Positions are stored as the index of their cell in the grid of the receiving rank extended by one
+    cell in each direction, and 16-bit fixed-point offsets inside that cell.
+    The error on each coordinate is at most h / 2^17, where h is the cell size.
+
+    Velocities are stored as IEEE half precision numbers (relative error at most 2^-11).
+
+    The particle ids are kept exactly.
+ */
+namespace halo_compression
+{
+
+/// position inside a cell, in units of h / 2^16
+struct QuantizedPosition
+{
+    uint16_t x, y, z;
+};
+
+/// velocity in half precision
+struct HalfVelocity
+{
+    uint16_t x, y, z;
+};
+
+/// encode a velocity in half precision
+__HD__ inline HalfVelocity encodeVelocity(real3 v)
+{
+    return {half_precision::floatToHalf(static_cast<float>(v.x)),
+            half_precision::floatToHalf(static_cast<float>(v.y)),
+            half_precision::floatToHalf(static_cast<float>(v.z))};
+}
+
+/// decode a velocity stored in half precision
+__HD__ inline real3 decodeVelocity(HalfVelocity v)
+{
+    return {static_cast<real>(half_precision::halfToFloat(v.x)),
+            static_cast<real>(half_precision::halfToFloat(v.y)),
+            static_cast<real>(half_precision::halfToFloat(v.z))};
+}
+
+/** \brief Encode and decode positions relative to the cells of the local subdomain.
+
+    The grid is extended by one cell on each side so that halo positions (which lie
+    outside of the subdomain after the shift) are representable.
+ */
+struct PositionCodec
+{
+    PositionCodec() = default;
+
+    /** \param [in] ncells_ Number of cells of the local subdomain along each direction
+        \param [in] localDomainSize Size of the local subdomain
+     */
+    __HD__ PositionCodec(int3 ncells_, real3 localDomainSize) :
+        ncells(ncells_ + 2),
+        h(localDomainSize / make_real3(ncells_)),
+        invh(make_real3(ncells_) / localDomainSize),
+        origin(-0.5_r * localDomainSize - h)
+    {}
+
+    /** \brief encode a position
+        \param [in] r Position in local coordinates of the receiving rank
+        \param [out] q offset of the position inside its cell
+        \return the cell index
+     */
+    __HD__ inline int encode(real3 r, QuantizedPosition& q) const
+    {
+        const real3 s = (r - origin) * invh;
+        const int3 c = math::min(ncells - 1, math::max(make_int3(0), make_int3(math::floor(s))));
+        const real3 frac = s - make_real3(c);
+
+        q.x = quantize(frac.x);
+        q.y = quantize(frac.y);
+        q.z = quantize(frac.z);
+
+        return (c.z * ncells.y + c.y) * ncells.x + c.x;
+    }
+
+    /// \return the position encoded by the cell index \p cid and the offset \p q
+    __HD__ inline real3 decode(int cid, QuantizedPosition q) const
+    {
+        const int cx = cid % ncells.x;
+        const int cy = (cid / ncells.x) % ncells.y;
+        const int cz = cid / (ncells.x * ncells.y);
+
+        constexpr real inv = 1.0_r / 65536.0_r;
+        const real3 s {static_cast<real>(cx) + (static_cast<real>(q.x) + 0.5_r) * inv,
+                       static_cast<real>(cy) + (static_cast<real>(q.y) + 0.5_r) * inv,
+                       static_cast<real>(cz) + (static_cast<real>(q.z) + 0.5_r) * inv};
+        return origin + s * h;
+    }
+
+    /// \return the fixed-point representation of \p frac (clamped to [0, 1))
+    __HD__ static inline uint16_t quantize(real frac)
+    {
+        const int v = static_cast<int>(math::floor(frac * 65536.0_r));
+        return static_cast<uint16_t>(v < 0 ? 0 : (v > 65535 ? 65535 : v));
+    }
+
+    int3 ncells;  ///< number of cells of the extended grid
+    real3 h;      ///< cell size
+    real3 invh;   ///< 1 / h
+    real3 origin; ///< lower corner of the extended grid
+};
+
+} // namespace halo_compression
+
+/** \brief A packer that encodes positions and velocities with halo_compression.
+
+    The other channels are packed as with ParticlePackerHandler.
+    The buffer contains, in that order: the cell indices, the quantized positions,
+    the particle ids, the half precision velocities and the other channels.
+ */
+struct CompressedParticlePackerHandler
+{
+    /// The packer responsible for the channels other than positions and velocities
+    GenericPackerHandler particles;
+
+    real4 *positions;  ///< positions of the particles
+    real4 *velocities; ///< velocities of the particles
+    halo_compression::PositionCodec codec; ///< position encoding
+
+    /// Get the required size (in bytes) of the buffer to hold the packed data
+    __HD__ size_t getSizeBytes(int numElements) const
+    {
+        return compressedSizeBytes(numElements) + particles.getSizeBytes(numElements);
+    }
+
+    /// \return the size (in bytes) of the encoded positions, ids and velocities
+    __HD__ static size_t compressedSizeBytes(int numElements)
+    {
+        return getPaddedSize<int>(numElements)
+            + getPaddedSize<halo_compression::QuantizedPosition>(numElements)
+            + getPaddedSize<int64_t>(numElements)
+            + getPaddedSize<halo_compression::HalfVelocity>(numElements);
+    }
+
+    /** \brief Fetch one particle, shift it and pack it into the buffer
+        \param [in] srcId Index of the particle to pack
+        \param [in] dstId Index of the particle in the buffer
+        \param [out] dstBuffer Destination buffer
+        \param [in] numElements Total number of particles that will be packed in the buffer.
+        \param [in] shift The coordinate shift
+     */
+    __D__ void packShift(int srcId, int dstId, char *dstBuffer, int numElements, real3 shift) const
+    {
+        Particle p(positions[srcId], velocities[srcId]);
+        Buffers b(dstBuffer, numElements);
+
+        b.cellIds[dstId] = codec.encode(p.r + shift, b.positions[dstId]);
+        b.ids[dstId] = p.getId();
+        b.velocities[dstId] = halo_compression::encodeVelocity(p.u);
+
+        particles.packShift(srcId, dstId, b.rest, numElements, shift);
+    }
+
+    /** \brief Unpack one particle from the buffer
+        \param [in] srcId Index of the particle in the buffer
+        \param [in] dstId Index of the particle to store
+        \param [in] srcBuffer Source buffer that contains packed data.
+        \param [in] numElements Total number of particles that are packed in the buffer.
+     */
+    __D__ void unpack(int srcId, int dstId, const char *srcBuffer, int numElements) const
+    {
+        Buffers b(const_cast<char*>(srcBuffer), numElements);
+
+        Particle p;
+        p.r = codec.decode(b.cellIds[srcId], b.positions[srcId]);
+        p.u = halo_compression::decodeVelocity(b.velocities[srcId]);
+        p.setId(b.ids[srcId]);
+
+        positions [dstId] = p.r2Real4();
+        velocities[dstId] = p.u2Real4();
+
+        particles.unpack(srcId, dstId, b.rest, numElements);
+    }
+
+private:
+    struct Buffers
+    {
+        __HD__ Buffers(char *buffer, int n)
+        {
+            cellIds = reinterpret_cast<int*>(buffer);
+            buffer += getPaddedSize<int>(n);
+            positions = reinterpret_cast<halo_compression::QuantizedPosition*>(buffer);
+            buffer += getPaddedSize<halo_compression::QuantizedPosition>(n);
+            ids = reinterpret_cast<int64_t*>(buffer);
+            buffer += getPaddedSize<int64_t>(n);
+            velocities = reinterpret_cast<halo_compression::HalfVelocity*>(buffer);
+            buffer += getPaddedSize<halo_compression::HalfVelocity>(n);
+            rest = buffer;
+        }
+
+        int *cellIds;
+        halo_compression::QuantizedPosition *positions;
+        int64_t *ids;
+        halo_compression::HalfVelocity *velocities;
+        char *rest;
+    };
+};
+
+/** \brief Helper class to construct a CompressedParticlePackerHandler.
+
+    Positions and velocities are always packed (compressed); the predicate selects the other channels.
+ */
+class CompressedParticlePacker : public ParticlePacker
+{
+public:
+    /** \brief Construct a CompressedParticlePacker
+        \param [in] predicate The channel filter that selects the channels to be packed additionally
+                              to positions and velocities.
+        \param [in] ncells Number of cells of the local subdomain along each direction (see halo_compression::PositionCodec)
+        \param [in] localDomainSize Size of the local subdomain
+     */
+    CompressedParticlePacker(PackPredicate predicate, int3 ncells, real3 localDomainSize);
+    ~CompressedParticlePacker();
+
+    void update(LocalParticleVector *lpv, cudaStream_t stream) override;
+
+    /// get a handler usable on device
+    CompressedParticlePackerHandler compressedHandler();
+
+    size_t getSizeBytes(int numElements) const override;
+
+private:
+    halo_compression::PositionCodec codec_;
+    real4 *positions_  {nullptr};
+    real4 *velocities_ {nullptr};
+};
+
+} // namespace mirheo
@@ -36,7 +36,7 @@ public:
         \param [in] predicate The channel filter that will be used to select the channels to be registered.
      */
     ParticlePacker(PackPredicate predicate);
-    ~ParticlePacker();
+    virtual ~ParticlePacker();
 
     /** \brief Register the channels of a LocalParticleVector that meet the predicate requirements.
         \param [in] lpv The LocalParticleVector that holds the channels to be registered.
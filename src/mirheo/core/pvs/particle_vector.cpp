@@ -31,6 +31,12 @@ LocalParticleVector::LocalParticleVector(ParticleVector *pv, int numParts) :
     dataPerParticle.createData<real4>(channel_names::velocities, numParts);
     dataPerParticle.createData<Force>(channel_names::forces, numParts);
 
+#ifdef MIRHEO_DETERMINISTIC_FORCES
+    dataPerParticle.createData<int64_t>(channel_names::fixedForcesX, numParts);
+    dataPerParticle.createData<int64_t>(channel_names::fixedForcesY, numParts);
+    dataPerParticle.createData<int64_t>(channel_names::fixedForcesZ, numParts);
+#endif
+
     dataPerParticle.setPersistenceMode(channel_names::positions,  DataManager::PersistenceMode::Active);
     dataPerParticle.setShiftMode      (channel_names::positions,  DataManager::ShiftMode::Active);
     dataPerParticle.setPersistenceMode(channel_names::velocities, DataManager::PersistenceMode::Active);
@@ -121,7 +127,33 @@ ParticleVector::ParticleVector(const MirState *state, const std::string& name, r
     halo_(std::move(halo))
 {
     // old positions and velocities don't need to exchanged in general
-    requireDataPerParticle<real4> (channel_names::oldPositions, DataManager::PersistenceMode::None);
+    requireOldPositions(DataManager::PersistenceMode::None);
+}
+
+void ParticleVector::requireOldPositions(DataManager::PersistenceMode persistence, DataManager::ShiftMode shift)
+{
+    if (oldPositionsStorage_ == OldPositionsStorage::Full)
+        requireDataPerParticle<real4> (channel_names::oldPositions, persistence, shift);
+    else
+        requireDataPerParticle<int64_t> (channel_names::oldPositionDeltas, persistence, DataManager::ShiftMode::None);
+}
+
+void ParticleVector::setOldPositionsStorage(OldPositionsStorage storage)
+{
+    if (storage == oldPositionsStorage_)
+        return;
+
+    const std::string& oldName = oldPositionsStorage_ == OldPositionsStorage::Full ?
+        channel_names::oldPositions : channel_names::oldPositionDeltas;
+
+    const auto persistence = local()->dataPerParticle.getChannelDescOrDie(oldName).persistence;
+
+    local()->dataPerParticle.deleteData(oldName);
+    halo() ->dataPerParticle.deleteData(oldName);
+
+    oldPositionsStorage_ = storage;
+    // full positions always need to be shifted when they move to another rank
+    requireOldPositions(persistence, DataManager::ShiftMode::Active);
 }
 
 ParticleVector::~ParticleVector() = default;
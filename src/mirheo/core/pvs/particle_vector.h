@@ -23,6 +23,13 @@ enum class ParticleVectorLocality
     Halo
 };
 
+/// Designs how the positions of the previous time step are stored
+enum class OldPositionsStorage
+{
+    Full,     ///< positions in the channel_names::oldPositions channel
+    HalfDelta ///< old minus current positions, in half precision, in the channel_names::oldPositionDeltas channel
+};
+
 /** Transform a ParticleVectorLocality into a string.
     \param [in] locality Data locality
     \return a string that describes the locality
@@ -173,6 +180,27 @@ public:
         _requireDataPerParticle<T>(halo(),  name, persistence, shift);
     }
 
+    /** Add the channel that holds the positions of the previous time step, see setOldPositionsStorage().
+        \param [in] persistence If the data should stich to the particles or not when exchanged
+        \param [in] shift If the data needs to be shifted when exchanged. Ignored with OldPositionsStorage::HalfDelta,
+                     since the deltas do not depend on the origin.
+     */
+    void requireOldPositions(DataManager::PersistenceMode persistence,
+                             DataManager::ShiftMode shift = DataManager::ShiftMode::None);
+
+    /** \brief Change how the positions of the previous time step are stored.
+        \param [in] storage The new storage
+
+        The channel of the previous storage is replaced; its persistence is kept.
+        OldPositionsStorage::HalfDelta takes 8 bytes per particle instead of 16 (32 in double precision);
+        the error on the old positions is at most 2^-11 times the displacement of the particle during the last step.
+        This must be called before the simulation starts.
+     */
+    void setOldPositionsStorage(OldPositionsStorage storage);
+
+    /// \return how the positions of the previous time step are stored
+    OldPositionsStorage getOldPositionsStorage() const noexcept { return oldPositionsStorage_; }
+
     /// get the particle mass
     real getMassPerParticle() const noexcept { return mass_; }
 
@@ -246,6 +274,7 @@ public:
 private:
     real mass_;
     std::unique_ptr<LocalParticleVector> local_, halo_;
+    OldPositionsStorage oldPositionsStorage_ {OldPositionsStorage::Full};
 };
 
 } // namespace mirheo
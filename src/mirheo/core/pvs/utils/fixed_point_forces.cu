@@ -0,0 +1,51 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "fixed_point_forces.h"
+
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/views/pv.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+namespace mirheo
+{
+
+#ifdef MIRHEO_DETERMINISTIC_FORCES
+
+namespace fixed_point_forces_kernels
+{
+
+__global__ void addFixedPointForces(PVview view)
+{
+    const int pid = threadIdx.x + blockIdx.x * blockDim.x;
+    if (pid >= view.size) return;
+
+    const real3 f = fixed_point::toReal3(view.fixedForcesX[pid],
+                                         view.fixedForcesY[pid],
+                                         view.fixedForcesZ[pid]);
+    view.forces[pid].x += f.x;
+    view.forces[pid].y += f.y;
+    view.forces[pid].z += f.z;
+}
+
+} // namespace fixed_point_forces_kernels
+
+void addFixedPointForces(ParticleVector *pv, LocalParticleVector *lpv, cudaStream_t stream)
+{
+    PVview view(pv, lpv);
+
+    const int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(
+        fixed_point_forces_kernels::addFixedPointForces,
+        getNblocks(view.size, nthreads), nthreads, 0, stream,
+        view );
+}
+
+#else
+
+void addFixedPointForces(__UNUSED ParticleVector *pv, __UNUSED LocalParticleVector *lpv, __UNUSED cudaStream_t stream)
+{}
+
+#endif // MIRHEO_DETERMINISTIC_FORCES
+
+} // namespace mirheo
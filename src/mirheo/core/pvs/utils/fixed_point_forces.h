@@ -0,0 +1,21 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <cuda_runtime.h>
+
+namespace mirheo
+{
+class ParticleVector;
+class LocalParticleVector;
+
+/** \brief Add the fixed-point force accumulators to the forces of the particles.
+    \param [in] pv The parent of lpv
+    \param [in,out] lpv The LocalParticleVector that holds the forces
+    \param [in] stream The execution stream.
+
+    Only relevant when compiled with MIRHEO_DETERMINISTIC_FORCES; does nothing otherwise.
+    The accumulators are not cleared here, they are cleared together with the forces.
+ */
+void addFixedPointForces(ParticleVector *pv, LocalParticleVector *lpv, cudaStream_t stream);
+
+} // namespace mirheo
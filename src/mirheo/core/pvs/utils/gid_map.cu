@@ -0,0 +1,59 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "gid_map.h"
+
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/views/pv.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+namespace mirheo
+{
+
+namespace gid_map_kernels
+{
+
+__global__ void insertIds(PVview view, GidMapView map)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= view.size)
+        return;
+
+    map.insert(view.readParticle(i).getId(), i);
+}
+
+} // namespace gid_map_kernels
+
+int GidMap::capacityFor(int n)
+{
+    int capacity = 1;
+    while (capacity < 2 * n)
+        capacity *= 2;
+    return capacity;
+}
+
+void GidMap::build(ParticleVector *pv, LocalParticleVector *lpv, cudaStream_t stream)
+{
+    PVview pvView(pv, lpv);
+    const int capacity = capacityFor(pvView.size);
+
+    keys_  .resize_anew(capacity);
+    values_.resize_anew(capacity);
+
+    // all bits set: EmptyKey
+    CUDA_Check( cudaMemsetAsync(keys_.devPtr(), 0xff, capacity * sizeof(int64_t), stream) );
+
+    constexpr int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(
+        gid_map_kernels::insertIds,
+        getNblocks(pvView.size, nthreads), nthreads, 0, stream,
+        pvView, view() );
+}
+
+GidMapView GidMap::view()
+{
+    return {static_cast<int>(keys_.size()), keys_.devPtr(), values_.devPtr()};
+}
+
+} // namespace mirheo
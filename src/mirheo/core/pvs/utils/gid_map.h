@@ -0,0 +1,122 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+
+#include <cstdint>
+#include <cuda_runtime.h>
+
+namespace mirheo
+{
+class ParticleVector;
+class LocalParticleVector;
+
+/** \brief A view of an open addressing hash table that maps global particle ids to local indices.
+
+    The table uses linear probing; its capacity must be a power of two.
+    Empty slots hold the key GidMapView::EmptyKey (global ids are non negative).
+
+    insert() can be used concurrently on the device; on the host it serves as the reference implementation.
+ */
+struct GidMapView
+{
+    static constexpr int64_t EmptyKey = -1; ///< key of the empty slots
+    static constexpr int NotFound = -1;     ///< value returned by find() for absent keys
+
+    /// \return the hash of a global id (finalizer of MurmurHash3)
+    __HD__ static inline uint64_t hash(int64_t key)
+    {
+        uint64_t h = static_cast<uint64_t>(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /** \brief Insert or update an entry.
+        \param [in] key The global id, must not be EmptyKey
+        \param [in] value The local index
+        \return \c false if the table is full
+     */
+    __HD__ inline bool insert(int64_t key, int value) const
+    {
+        const int mask = capacity - 1;
+        int slot = static_cast<int>(hash(key)) & mask;
+
+        for (int probe = 0; probe < capacity; ++probe)
+        {
+#ifdef __CUDA_ARCH__
+            using ull = unsigned long long int;
+            const int64_t prev = static_cast<int64_t>(atomicCAS(reinterpret_cast<ull*>(keys + slot),
+                                                                static_cast<ull>(EmptyKey), static_cast<ull>(key)));
+#else
+            const int64_t prev = keys[slot];
+            if (prev == EmptyKey)
+                keys[slot] = key;
+#endif
+            if (prev == EmptyKey || prev == key)
+            {
+                values[slot] = value;
+                return true;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return false;
+    }
+
+    /// \return the local index of the global id \p key, or NotFound
+    __HD__ inline int find(int64_t key) const
+    {
+        if (capacity == 0)
+            return NotFound;
+
+        const int mask = capacity - 1;
+        int slot = static_cast<int>(hash(key)) & mask;
+
+        for (int probe = 0; probe < capacity; ++probe)
+        {
+            const int64_t k = keys[slot];
+            if (k == key)
+                return values[slot];
+            if (k == EmptyKey)
+                return NotFound;
+            slot = (slot + 1) & mask;
+        }
+        return NotFound;
+    }
+
+    int capacity {0};          ///< number of slots, power of two
+    int64_t *keys {nullptr};   ///< global ids
+    int *values {nullptr};     ///< local indices
+};
+
+/** \brief Map from the global ids of the particles of a LocalParticleVector to their indices.
+
+    Memory and build time scale with the number of local particles, not with the largest global id.
+    The load factor is kept below 1/2.
+ */
+class GidMap
+{
+public:
+    /// \return The smallest power of two capacity that keeps the load factor of \p n entries below 1/2
+    static int capacityFor(int n);
+
+    /** \brief Rebuild the map from the ids of the particles in \p lpv.
+        \param [in] pv The parent of lpv
+        \param [in] lpv The particles to map
+        \param [in] stream The execution stream.
+     */
+    void build(ParticleVector *pv, LocalParticleVector *lpv, cudaStream_t stream);
+
+    /// \return A view usable on the device
+    GidMapView view();
+
+private:
+    DeviceBuffer<int64_t> keys_;
+    DeviceBuffer<int> values_;
+};
+
+} // namespace mirheo
@@ -0,0 +1,50 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "old_positions.h"
+
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/views/pv.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/half_precision.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+namespace mirheo
+{
+
+namespace old_positions_kernels
+{
+
+__global__ void storeDeltas(PVviewWithOldParticles view, const real4 *oldPositions)
+{
+    const int pid = threadIdx.x + blockIdx.x * blockDim.x;
+    if (pid >= view.size) return;
+
+    const real3 rOld = make_real3(oldPositions[pid]);
+    const real3 r    = make_real3(view.positions[pid]);
+    view.oldPositionDeltas[pid] = half_precision::packHalf3(rOld - r);
+}
+
+} // namespace old_positions_kernels
+
+void storeOldPositions(ParticleVector *pv, const real4 *oldPositions, cudaStream_t stream)
+{
+    auto lpv = pv->local();
+    const int n = lpv->size();
+
+    if (pv->getOldPositionsStorage() == OldPositionsStorage::Full)
+    {
+        auto dst = lpv->dataPerParticle.getData<real4>(channel_names::oldPositions);
+        if (n > 0)
+            CUDA_Check( cudaMemcpyAsync(dst->devPtr(), oldPositions, n * sizeof(real4), cudaMemcpyDeviceToDevice, stream) );
+        return;
+    }
+
+    PVviewWithOldParticles view(pv, lpv);
+    const int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(
+        old_positions_kernels::storeDeltas,
+        getNblocks(view.size, nthreads), nthreads, 0, stream,
+        view, oldPositions );
+}
+
+} // namespace mirheo
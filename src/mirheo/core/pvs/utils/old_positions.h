@@ -0,0 +1,22 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+
+#include <cuda_runtime.h>
+
+namespace mirheo
+{
+class ParticleVector;
+
+/** \brief Set the positions of the previous time step of the local particles of a ParticleVector.
+    \param [in] pv The ParticleVector
+    \param [in] oldPositions Device array of the previous positions, in the same order as the local particles
+    \param [in] stream The execution stream.
+
+    The positions are stored according to ParticleVector::getOldPositionsStorage().
+    With OldPositionsStorage::HalfDelta, the current positions must be up to date on the device.
+ */
+void storeOldPositions(ParticleVector *pv, const real4 *oldPositions, cudaStream_t stream);
+
+} // namespace mirheo
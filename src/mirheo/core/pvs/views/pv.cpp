@@ -13,6 +13,12 @@ PVview::PVview(ParticleVector *pv, LocalParticleVector *lpv)
     velocities = lpv->velocities().devPtr();
     forces     = reinterpret_cast<real4*>(lpv->forces().devPtr());
 
+#ifdef MIRHEO_DETERMINISTIC_FORCES
+    fixedForcesX = lpv->dataPerParticle.getData<int64_t>(channel_names::fixedForcesX)->devPtr();
+    fixedForcesY = lpv->dataPerParticle.getData<int64_t>(channel_names::fixedForcesY)->devPtr();
+    fixedForcesZ = lpv->dataPerParticle.getData<int64_t>(channel_names::fixedForcesZ)->devPtr();
+#endif
+
     mass = pv->getMassPerParticle();
     invMass = 1.0_r / mass;
 }
@@ -20,8 +26,13 @@ PVview::PVview(ParticleVector *pv, LocalParticleVector *lpv)
 PVviewWithOldParticles::PVviewWithOldParticles(ParticleVector *pv, LocalParticleVector *lpv) :
     PVview(pv, lpv)
 {
-    if (lpv != nullptr)
+    if (lpv == nullptr)
+        return;
+
+    if (pv->getOldPositionsStorage() == OldPositionsStorage::Full)
         oldPositions = lpv->dataPerParticle.getData<real4>(channel_names::oldPositions)->devPtr();
+    else
+        oldPositionDeltas = lpv->dataPerParticle.getData<int64_t>(channel_names::oldPositionDeltas)->devPtr();
 }
 
 PVviewWithDensities::PVviewWithDensities(ParticleVector *pv, LocalParticleVector *lpv) :
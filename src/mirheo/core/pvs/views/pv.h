@@ -3,6 +3,8 @@
 
 #include <mirheo/core/utils/common.h>
 #include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/fixed_point.h>
+#include <mirheo/core/utils/half_precision.h>
 
 namespace mirheo
 {
@@ -86,11 +88,36 @@ struct PVview
         velocities[id] = p.u2Real4();
     }
 
+#ifdef __CUDACC__
+    /** \brief Atomically add \p f to the force of the particle \p id.
+
+        With MIRHEO_DETERMINISTIC_FORCES, the force is accumulated in fixed point;
+        the result does not depend on the order of the additions.
+        The fixed-point forces are added to #forces once all interactions are computed.
+     */
+    __D__ inline void atomicAddForce(int id, real3 f) const
+    {
+#ifdef MIRHEO_DETERMINISTIC_FORCES
+        fixed_point::atomicAdd(fixedForcesX + id, f.x);
+        fixed_point::atomicAdd(fixedForcesY + id, f.y);
+        fixed_point::atomicAdd(fixedForcesZ + id, f.z);
+#else
+        atomicAdd(forces + id, f);
+#endif
+    }
+#endif // __CUDACC__
+
     int size {0}; ///< number of particles
     real4 *positions  {nullptr}; ///< particle positions in local coordinates
     real4 *velocities {nullptr}; ///< particle velocities
     real4 *forces     {nullptr}; ///< particle forces
 
+#ifdef MIRHEO_DETERMINISTIC_FORCES
+    int64_t *fixedForcesX {nullptr}; ///< x component of the fixed-point force accumulators
+    int64_t *fixedForcesY {nullptr}; ///< y component of the fixed-point force accumulators
+    int64_t *fixedForcesZ {nullptr}; ///< z component of the fixed-point force accumulators
+#endif
+
     real mass {0._r};    ///< mass of one particle
     real invMass {0._r}; ///< 1 / mass
 };
@@ -107,6 +134,7 @@ struct PVviewWithOldParticles : public PVview
         \rst
         .. note::
             if pv does not have old positions channel, this will be ignored and oldPositions will be set to nullptr.
+            Only one of oldPositions and oldPositionDeltas is set, depending on ParticleVector::getOldPositionsStorage().
         \endrst
      */
     PVviewWithOldParticles(ParticleVector *pv, LocalParticleVector *lpv);
@@ -114,11 +142,33 @@ struct PVviewWithOldParticles : public PVview
     /// fetch positions at previous time step
     __HD__ inline real3 readOldPosition(int id) const
     {
+        if (oldPositionDeltas != nullptr)
+        {
+            const auto r = positions[id];
+            return real3{r.x, r.y, r.z} + half_precision::unpackHalf3(oldPositionDeltas[id]);
+        }
+
         const auto r = oldPositions[id];
         return {r.x, r.y, r.z};
     }
 
+    /// Store position at the given particle id; the old position is left unchanged
+    __HD__ inline void writePosition(int id, const real4& r)
+    {
+        if (oldPositionDeltas != nullptr)
+            oldPositionDeltas[id] = half_precision::packHalf3(readOldPosition(id) - real3{r.x, r.y, r.z});
+        positions[id] = r;
+    }
+
+    /// Store particle at the given particle id; the old position is left unchanged
+    __HD__ inline void writeParticle(int id, const Particle& p)
+    {
+        writePosition(id, p.r2Real4());
+        velocities[id] = p.u2Real4();
+    }
+
     real4 *oldPositions {nullptr}; ///< particle positions from previous time steps
+    int64_t *oldPositionDeltas {nullptr}; ///< old minus current positions in half precision (see half_precision::packHalf3())
 };
 
 /** \brief \c PVview with additionally densities data
@@ -43,11 +43,38 @@ __global__ void collectRigidForces(ROVview ovView)
     force  = warpReduce( force,  [] (RigidReal a, RigidReal b) { return a+b; } );
     torque = warpReduce( torque, [] (RigidReal a, RigidReal b) { return a+b; } );
 
+#ifdef MIRHEO_DETERMINISTIC_FORCES
+    // sum the warp contributions in a fixed order instead of with concurrent atomics
+    constexpr int maxWarps = 32;
+    __shared__ RigidReal3 warpForces [maxWarps];
+    __shared__ RigidReal3 warpTorques[maxWarps];
+
+    const int warpId = tid / warpSize;
+    if (tid % warpSize == 0)
+    {
+        warpForces [warpId] = force;
+        warpTorques[warpId] = torque;
+    }
+    __syncthreads();
+
+    if (tid == 0)
+    {
+        const int nwarps = (blockDim.x + warpSize - 1) / warpSize;
+        for (int i = 1; i < nwarps; ++i)
+        {
+            force  += warpForces [i];
+            torque += warpTorques[i];
+        }
+        ovView.motions[objId].force  += force;
+        ovView.motions[objId].torque += torque;
+    }
+#else
     if ( tid % warpSize == 0 )
     {
         atomicAdd(&ovView.motions[objId].force,  force);
         atomicAdd(&ovView.motions[objId].torque, torque);
     }
+#endif
 }
 
 /**
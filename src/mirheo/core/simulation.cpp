@@ -7,7 +7,9 @@
 #include <mirheo/core/initial_conditions/interface.h>
 #include <mirheo/core/integrators/interface.h>
 #include <mirheo/core/interactions/interface.h>
+#include <mirheo/core/interactions/pairwise/base_pairwise.h>
 #include <mirheo/core/managers/interactions.h>
+#include <mirheo/core/managers/multi_time_stepping.h>
 #include <mirheo/core/mirheo_state.h>
 #include <mirheo/core/object_belonging/interface.h>
 #include <mirheo/core/plugins.h>
@@ -15,6 +17,7 @@
 #include <mirheo/core/pvs/rigid_object_vector.h>
 #include <mirheo/core/snapshot.h>
 #include <mirheo/core/task_scheduler.h>
+#include <mirheo/core/utils/compile_options.h>
 #include <mirheo/core/utils/config.h>
 #include <mirheo/core/utils/path.h>
 #include <mirheo/core/utils/restart_helpers.h>
@@ -22,6 +25,7 @@
 
 #include <algorithm>
 #include <cuda_profiler_api.h>
+#include <limits>
 #include <memory>
 #include <set>
 
@@ -102,6 +106,15 @@ struct RunData {
 
     std::map<ParticleVector*, std::vector< std::unique_ptr<CellList> >> cellListMap;
 
+    /// Primary cell-lists filled during the integration, see Simulation::setFusedIntegration().
+    std::map<ParticleVector*, PrimaryCellList*> fusedCellLists;
+
+    /// Cell-lists that reorder their ObjectVector in place, see Simulation::setInPlaceObjectCellLists().
+    std::vector<ObjectPrimaryCellList*> objectPrimaryCellLists;
+
+    /// Sub steps of the fast interactions, see Simulation::setMultipleTimeStepping().
+    std::unique_ptr<MultiTimeStepping> multiTimeStepping;
+
     std::vector<std::function<void(cudaStream_t)>> regularBouncers, haloBouncers;
 };
 
@@ -259,6 +272,14 @@ real Simulation::getCurrentDt() const
     return state_->getDt();
 }
 
+void Simulation::setCurrentDt(real dt)
+{
+    if (dt <= 0.0_r)
+        die("The time step must be positive, got %g", dt);
+
+    state_->setDt(dt);
+}
+
 real Simulation::getCurrentTime() const
 {
     return static_cast<real>(state_->currentTime);
@@ -271,6 +292,15 @@ real Simulation::getMaxEffectiveCutoff() const
     return rcIntermediate + rcFinal;
 }
 
+real Simulation::getMaxWallPartTravel(const ParticleVector *pv) const
+{
+    real maxTravel = std::numeric_limits<real>::infinity();
+    for (const auto& prototype : wallPrototypes_)
+        if (prototype.pv == pv)
+            maxTravel = std::min(maxTravel, prototype.maximumPartTravel);
+    return maxTravel;
+}
+
 void Simulation::startProfiler() const
 {
     CUDA_Check( cudaProfilerStart() );
@@ -490,6 +520,88 @@ void Simulation::setWallBounce(const std::string& wallName, const std::string& p
     wallPrototypes_.push_back( {wall, pv, maximumPartTravel} );
 }
 
+void Simulation::setIncrementalCellLists(const std::string& pvName, bool incremental)
+{
+    auto pv = getPVbyNameOrDie(pvName);
+
+    if (auto ov = dynamic_cast<ObjectVector*>(pv))
+        die("Object Vectors do not use primary cell-lists; "
+            "incremental cell-lists can not be used with OV '%s'", ov->getCName());
+
+    if (incremental)
+        incrementalCellListPVs_.insert(pv);
+    else
+        incrementalCellListPVs_.erase(pv);
+}
+
+void Simulation::setInPlaceObjectCellLists(const std::string& ovName, bool inPlace)
+{
+    auto ov = getOVbyNameOrDie(ovName);
+
+    if (inPlace)
+        inPlaceObjectCellListOVs_.insert(ov);
+    else
+        inPlaceObjectCellListOVs_.erase(ov);
+}
+
+void Simulation::setHaloCompression(const std::string& pvName, bool compressed)
+{
+    auto pv = getPVbyNameOrDie(pvName);
+
+    if (auto ov = dynamic_cast<ObjectVector*>(pv))
+        die("Compressed halo is only supported for particles; can not be used with OV '%s'", ov->getCName());
+
+    if (compressed)
+        compressedHaloPVs_.insert(pv);
+    else
+        compressedHaloPVs_.erase(pv);
+}
+
+void Simulation::setOldPositionsStorage(const std::string& pvName, OldPositionsStorage storage)
+{
+    auto pv = getPVbyNameOrDie(pvName);
+
+    // object vectors use their old positions as mesh vertices and rod segments
+    if (auto ov = dynamic_cast<ObjectVector*>(pv))
+        die("Reduced precision old positions are only supported for particles; can not be used with OV '%s'", ov->getCName());
+
+    pv->setOldPositionsStorage(storage);
+}
+
+void Simulation::setFusedIntegration(const std::string& pvName, bool fused)
+{
+    auto pv = getPVbyNameOrDie(pvName);
+
+    if (auto ov = dynamic_cast<ObjectVector*>(pv))
+        die("Object Vectors do not use primary cell-lists; "
+            "fused integration can not be used with OV '%s'", ov->getCName());
+
+    if (fused)
+        fusedIntegrationPVs_.insert(pv);
+    else
+        fusedIntegrationPVs_.erase(pv);
+}
+
+void Simulation::setMultipleTimeStepping(const std::vector<int>& substeps)
+{
+    for (auto n : substeps)
+        if (n < 1)
+            die("Multiple time stepping: the number of sub steps must be positive, got %d", n);
+
+    timeScaleSubsteps_ = substeps;
+}
+
+void Simulation::setInteractionLevel(const std::string& interactionName, int level)
+{
+    if (interactionMap_.find(interactionName) == interactionMap_.end())
+        die("No such interaction: %s", interactionName.c_str());
+
+    if (level < 0)
+        die("Interaction '%s': the time-scale level must be non negative, got %d", interactionName.c_str(), level);
+
+    interactionLevels_[interactionName] = level;
+}
+
 void Simulation::setObjectBelongingChecker(const std::string& checkerName, const std::string& objName)
 {
     if (belongingCheckerMap_.find(checkerName) == belongingCheckerMap_.end())
@@ -570,6 +682,24 @@ void Simulation::_prepareCellLists()
 
     std::map<ParticleVector*, std::vector<real>> cutOffMap;
 
+    auto makeCellList = [this](ParticleVector *pv, real rc, bool primary) -> std::unique_ptr<CellList>
+    {
+        if (!primary)
+            return std::make_unique<CellList>(pv, rc, state_->domain.localSize);
+
+        if (auto ov = dynamic_cast<ObjectVector*>(pv))
+        {
+            _checkInPlaceObjectCellList(ov);
+            auto cl = std::make_unique<ObjectPrimaryCellList>(ov, rc, state_->domain.localSize);
+            run_->objectPrimaryCellLists.push_back(cl.get());
+            return cl;
+        }
+
+        auto cl = std::make_unique<PrimaryCellList>(pv, rc, state_->domain.localSize);
+        cl->setIncrementalBuild(incrementalCellListPVs_.find(pv) != incrementalCellListPVs_.end());
+        return cl;
+    };
+
     // Deal with the cell-lists and interactions
     for (auto prototype : interactionPrototypes_)
     {
@@ -588,15 +718,13 @@ void Simulation::_prepareCellLists()
 
         bool primary = true;
 
-        // Don't use primary cell-lists with ObjectVectors
+        // Don't use primary cell-lists with ObjectVectors, unless they can be reordered in place
         if (dynamic_cast<ObjectVector*>(pv))
-            primary = false;
+            primary = inPlaceObjectCellListOVs_.find(pv) != inPlaceObjectCellListOVs_.end();
 
         for (auto rc : cutoffs)
         {
-            run_->cellListMap[pv].push_back(primary ?
-                    std::make_unique<PrimaryCellList>(pv, rc, state_->domain.localSize) :
-                    std::make_unique<CellList>       (pv, rc, state_->domain.localSize));
+            run_->cellListMap[pv].push_back(makeCellList(pv, rc, primary));
             primary = false;
         }
     }
@@ -609,18 +737,39 @@ void Simulation::_prepareCellLists()
             const real defaultRc = 1._r;
             bool primary = true;
 
-            // Don't use primary cell-lists with ObjectVectors
+            // Don't use primary cell-lists with ObjectVectors, unless they can be reordered in place
             if (dynamic_cast<ObjectVector*>(pvptr))
-                primary = false;
+                primary = inPlaceObjectCellListOVs_.find(pvptr) != inPlaceObjectCellListOVs_.end();
 
-            run_->cellListMap[pvptr].push_back
-                (primary ?
-                 std::make_unique<PrimaryCellList>(pvptr, defaultRc, state_->domain.localSize) :
-                 std::make_unique<CellList>       (pvptr, defaultRc, state_->domain.localSize));
+            run_->cellListMap[pvptr].push_back(makeCellList(pvptr, defaultRc, primary));
         }
     }
 }
 
+void Simulation::_checkInPlaceObjectCellList(ObjectVector *ov) const
+{
+    // these read the cell ranges of the particles directly
+    for (const auto& prototype : wallPrototypes_)
+        if (prototype.pv == ov)
+            die("In-place cell-lists can not be used with OV '%s' bouncing on wall '%s'",
+                ov->getCName(), prototype.wall->getCName());
+
+    for (const auto& prototype : bouncerPrototypes_)
+        if (prototype.pv == ov)
+            die("In-place cell-lists can not be used with OV '%s' bouncing with '%s'",
+                ov->getCName(), prototype.bouncer->getCName());
+
+    for (const auto& prototype : belongingCorrectionPrototypes_)
+        if (prototype.pvIn == ov || prototype.pvOut == ov)
+            die("In-place cell-lists can not be used with OV '%s' corrected by '%s'",
+                ov->getCName(), prototype.checker->getCName());
+
+    for (const auto& prototype : splitterPrototypes_)
+        if (prototype.pvSrc == ov)
+            die("In-place cell-lists can not be used with OV '%s' split by '%s'",
+                ov->getCName(), prototype.checker->getCName());
+}
+
 // Choose a CL with smallest but bigger than rc cell
 static CellList* selectBestClist(const std::vector<std::unique_ptr<CellList>>& cellLists, real rc, real tolerance)
 {
@@ -659,10 +808,19 @@ void Simulation::_prepareInteractions()
 
         inter->setPrerequisites(pv1, pv2, cl1, cl2);
 
+        const auto levelIt = interactionLevels_.find(inter->getName());
+        const int level = levelIt != interactionLevels_.end() ? levelIt->second : 0;
+
         if (inter->getStage() == Interaction::Stage::Intermediate)
+        {
+            if (level != 0)
+                die("Interaction '%s': intermediate interactions can only have the time-scale level 0", inter->getCName());
             run_->interactionsIntermediate.add(inter, pv1, pv2, cl1, cl2);
+        }
         else
-            run_->interactionsFinal      .add(inter, pv1, pv2, cl1, cl2);
+        {
+            run_->interactionsFinal.add(inter, pv1, pv2, cl1, cl2, level);
+        }
     }
 }
 
@@ -725,6 +883,102 @@ void Simulation::_prepareWalls()
     }
 }
 
+void Simulation::_prepareFusedIntegration()
+{
+    for (auto pv : fusedIntegrationPVs_)
+    {
+        info("Fusing the integration of pv '%s' with its cell-list build", pv->getCName());
+
+        if (incrementalCellListPVs_.find(pv) != incrementalCellListPVs_.end())
+            die("Fused integration can not be used together with incremental cell-lists (pv '%s')", pv->getCName());
+
+        int nIntegrators = 0;
+        for (const auto& prototype : integratorPrototypes_)
+        {
+            if (prototype.pv != pv)
+                continue;
+            if (!prototype.integrator->supportsFusedBinning())
+                die("Integrator '%s' does not support fused integration (pv '%s')",
+                    prototype.integrator->getCName(), pv->getCName());
+            ++nIntegrators;
+        }
+        if (nIntegrators != 1)
+            die("Fused integration requires exactly one integrator for pv '%s', got %d", pv->getCName(), nIntegrators);
+
+        // the particles must not move between the integration and the cell-list build
+        for (const auto& prototype : wallPrototypes_)
+            if (prototype.pv == pv)
+                die("Fused integration can not be used with pv '%s' bouncing on wall '%s'",
+                    pv->getCName(), prototype.wall->getCName());
+
+        for (const auto& prototype : bouncerPrototypes_)
+            if (prototype.pv == pv)
+                die("Fused integration can not be used with pv '%s' bouncing with '%s'",
+                    pv->getCName(), prototype.bouncer->getCName());
+
+        for (const auto& prototype : belongingCorrectionPrototypes_)
+            if (prototype.pvIn == pv || prototype.pvOut == pv)
+                die("Fused integration can not be used with pv '%s' corrected by '%s'",
+                    pv->getCName(), prototype.checker->getCName());
+
+        auto cl = dynamic_cast<PrimaryCellList*>(run_->cellListMap[pv][0].get());
+        if (cl == nullptr)
+            die("Fused integration requires a primary cell-list for pv '%s'", pv->getCName());
+
+        run_->fusedCellLists[pv] = cl;
+    }
+}
+
+void Simulation::_prepareMultiTimeStepping()
+{
+    bool hasFastInteractions = false;
+    for (const auto& entry : interactionLevels_)
+        hasFastInteractions |= entry.second > 0;
+
+    if (!hasFastInteractions)
+        return;
+
+    info("Preparing multiple time stepping with %d levels", static_cast<int>(timeScaleSubsteps_.size()) + 1);
+
+    // the forces of the sub steps would be accumulated twice in the fixed-point channels
+    if (CompileOptions::deterministicForces)
+        die("Multiple time stepping is not supported with deterministic forces");
+
+    run_->multiTimeStepping = std::make_unique<MultiTimeStepping>(state_, timeScaleSubsteps_, &run_->interactionsFinal);
+    auto mts = run_->multiTimeStepping.get();
+
+    for (const auto& prototype : interactionPrototypes_)
+    {
+        auto inter = prototype.interaction;
+        const auto levelIt = interactionLevels_.find(inter->getName());
+
+        if (levelIt == interactionLevels_.end() || levelIt->second == 0)
+            continue;
+
+        // the cell-lists are only built once per time step
+        if (dynamic_cast<BasePairwiseInteraction*>(inter))
+            die("Pairwise interaction '%s' can not be evaluated at sub steps; set its time-scale level to 0",
+                inter->getCName());
+
+        mts->addInteraction(inter, levelIt->second, prototype.pv1, prototype.pv2);
+    }
+
+    for (const auto& prototype : integratorPrototypes_)
+        mts->addIntegrator(prototype.integrator, prototype.pv);
+
+    for (auto pv : mts->getManagedPVs())
+    {
+        if (pvsIntegratorMap_.find(pv->getName()) == pvsIntegratorMap_.end())
+            die("Multiple time stepping: particle vector '%s' is subject to fast interactions but has no integrator",
+                pv->getCName());
+
+        if (run_->fusedCellLists.find(pv) != run_->fusedCellLists.end())
+            die("Fused integration can not be used with multiple time stepping (pv '%s')", pv->getCName());
+
+        info("Particle vector '%s' is integrated with sub steps", pv->getCName());
+    }
+}
+
 void Simulation::_preparePlugins()
 {
     info("Preparing plugins");
@@ -736,6 +990,19 @@ void Simulation::_preparePlugins()
     info("done Preparing plugins");
 }
 
+void Simulation::_checkFusedIntegrationPlugins() const
+{
+    // the fused cell-list build only knows about the particles seen by the integration kernel
+    for (const auto& entry : run_->fusedCellLists)
+    {
+        const ParticleVector *pv = entry.first;
+        for (const auto& pl : plugins)
+            if (pl->actsBeforeCellLists(pv))
+                die("Fused integration can not be used with pv '%s' modified by plugin '%s' before the cell-lists are built",
+                    pv->getCName(), pl->getCName());
+    }
+}
+
 
 std::vector<std::string> Simulation::_getExtraDataToExchange(ObjectVector *ov) const
 {
@@ -785,6 +1052,23 @@ std::vector<std::string> Simulation::_getDataToSendBack(const std::vector<std::s
     return {channels.begin(), channels.end()};
 }
 
+bool Simulation::_needsFullObjectHalo(ObjectVector *ov) const
+{
+    for (auto& entry : bouncerMap_)
+        if (entry.second->getObjectVector() == ov)
+            return true;
+
+    for (auto& entry : belongingCheckerMap_)
+        if (entry.second->getObjectVector() == ov)
+            return true;
+
+    for (const auto& prototype : interactionPrototypes_)
+        if ((prototype.pv1 == ov || prototype.pv2 == ov) && prototype.interaction->needsFullObjectHalo())
+            return true;
+
+    return false;
+}
+
 void Simulation::_prepareEngines()
 {
     auto partRedistImp                  = std::make_unique<ParticleRedistributor>();
@@ -819,7 +1103,8 @@ void Simulation::_prepareEngines()
             auto extraToExchange = _getExtraDataToExchange(ov);
             auto reverseExchange = _getDataToSendBack(extraInt, ov);
 
-            objHaloFinalImp->attach(ov, cl->rc, extraToExchange); // always active because of bounce back; TODO: check if bounce back is active
+            // only the bouncers, belonging checkers and some interactions need the full objects in the halo
+            objHaloFinalImp->attach(ov, cl->rc, extraToExchange, _needsFullObjectHalo(ov));
             objHaloReverseFinalImp->attach(ov, extraOut);
 
             objHaloIntermediateImp->attach(ov, extraInt);
@@ -829,11 +1114,22 @@ void Simulation::_prepareEngines()
         {
             partRedistImp->attach(pvPtr, cl);
 
+            const bool compressed = compressedHaloPVs_.find(pvPtr) != compressedHaloPVs_.end();
+
             if (clInt != nullptr)
-                partHaloIntermediateImp->attach(pvPtr, clInt, {});
+                partHaloIntermediateImp->attach(pvPtr, clInt, {}, compressed);
 
             if (clOut != nullptr)
-                partHaloFinalImp->attach(pvPtr, clOut, extraInt);
+            {
+                // only send the channels that are read by the final interactions
+                const auto inputOut = run_->interactionsFinal.getInputChannels(pvPtr);
+                std::vector<std::string> haloChannels;
+                for (const auto& name : extraInt)
+                    if (std::find(inputOut.begin(), inputOut.end(), name) != inputOut.end())
+                        haloChannels.push_back(name);
+
+                partHaloFinalImp->attach(pvPtr, clOut, haloChannels, compressed);
+            }
         }
     }
 
@@ -914,8 +1210,15 @@ void Simulation::_createTasks()
             run_->interactionsFinal       .clearInput (pvPtr, stream);
         } );
 
-        scheduler.addTask(tasks.partClearFinal, [this, pvPtr] (cudaStream_t stream) {
-              run_->interactionsFinal.clearOutput(pvPtr, stream);
+        auto fusedIt = run_->fusedCellLists.find(pvPtr);
+        PrimaryCellList *fusedCl = fusedIt != run_->fusedCellLists.end() ? fusedIt->second : nullptr;
+
+        scheduler.addTask(tasks.partClearFinal, [this, pvPtr, fusedCl] (cudaStream_t stream) {
+            // forces already cleared during the integration
+            if (fusedCl != nullptr && fusedCl->hasClearedForces())
+                run_->interactionsFinal.clearOutputExceptLocalForces(pvPtr, stream);
+            else
+                run_->interactionsFinal.clearOutput(pvPtr, stream);
         });
     }
 
@@ -1019,13 +1322,38 @@ void Simulation::_createTasks()
     {
         auto pv         = prototype.pv;
         auto integrator = prototype.integrator;
-        scheduler.addTask(tasks.integration, [integrator, pv] (cudaStream_t stream)
+        auto fusedIt = run_->fusedCellLists.find(pv);
+
+        if (run_->multiTimeStepping && run_->multiTimeStepping->manages(pv))
+            continue;
+
+        if (fusedIt != run_->fusedCellLists.end())
         {
-            integrator->execute(pv, stream);
-        });
+            auto cl = fusedIt->second;
+            scheduler.addTask(tasks.integration, [integrator, pv, cl] (cudaStream_t stream)
+            {
+                integrator->executeAndBin(pv, cl, stream);
+            });
+        }
+        else
+        {
+            scheduler.addTask(tasks.integration, [integrator, pv] (cudaStream_t stream)
+            {
+                integrator->execute(pv, stream);
+            });
+        }
     }
 
 
+    if (run_->multiTimeStepping)
+    {
+        auto mts = run_->multiTimeStepping.get();
+        scheduler.addTask(tasks.integration, [mts] (cudaStream_t stream)
+        {
+            mts->execute(stream);
+        });
+    }
+
     // As there are no primary cell-lists for objects
     // we need to separately clear real obj forces and forces in the cell-lists
     for (auto ov : objectVectors_)
@@ -1143,6 +1471,10 @@ void Simulation::_createTasks()
 
         scheduler.addTask(tasks.objRedistFinalize, [this] (cudaStream_t stream) {
             run_->objRedistibutor->finalize(stream);
+
+            // the objects change index; must happen before the halo maps are built
+            for (auto cl : run_->objectPrimaryCellLists)
+                cl->sortObjects(stream);
         });
     }
 
@@ -1269,12 +1601,15 @@ void Simulation::init()
     _prepareInteractions();
     _prepareBouncers();
     _prepareWalls();
+    _prepareFusedIntegration();
+    _prepareMultiTimeStepping();
 
     run_->interactionsIntermediate.checkCompatibleWith(run_->interactionsFinal);
 
     CUDA_Check( cudaDeviceSynchronize() );
 
     _preparePlugins();
+    _checkFusedIntegrationPlugins();
     _prepareEngines();
 
     info("Time-step is set to %f", getCurrentDt());
@@ -1292,6 +1627,10 @@ void Simulation::run(MirState::StepType nsteps)
     run_->scheduler.forceExec( run_->tasks.objClearLocalForces,  defaultStream );
     _execSplitters();
 
+    // the particles may have been modified since the last run
+    for (auto& entry : run_->fusedCellLists)
+        entry.second->discardFusedBinning();
+
     const MirState::StepType begin = state_->currentStep;
     const MirState::StepType end = state_->currentStep + nsteps;
 
@@ -1451,12 +1790,18 @@ MIRHEO_MEMBER_VARS(Simulation::BouncerPrototype, bouncer, pv);
 MIRHEO_MEMBER_VARS(Simulation::BelongingCorrectionPrototype, checker, pvIn, pvOut, every);
 MIRHEO_MEMBER_VARS(Simulation::SplitterPrototype, checker, pvSrc, pvIn, pvOut);
 
+void Simulation::setSnapshotFormat(ConfigFormat format)
+{
+    snapshotFormat_ = format;
+}
+
 void Simulation::snapshot(const std::string& path)
 {
     // Prepare context and the saver.
     SaverContext context;
     context.path = path;
     context.groupComm = cartComm_;
+    context.configFormat = snapshotFormat_;
     Saver saver{&context};
 
     // Create the snapshot folder before saving.
@@ -1470,15 +1815,27 @@ void Simulation::snapshot(const std::string& path)
     int rank;
     MPI_Comm_rank(cartComm_, &rank);
     if (rank == 0) {
-        std::string simJson = ConfigValue{std::move(saver).getConfig()}.toJSONString();
-        int size = (int)simJson.size();
+        // The config is always sent in binary, the postprocess side writes it in the requested format.
+        const int format = static_cast<int>(snapshotFormat_);
+        std::string simConfig = configToBinary(ConfigValue{std::move(saver).getConfig()});
+        int size = (int)simConfig.size();
+        MPI_Check( MPI_Send(&format, 1, MPI_INT, 0, snapshotTag, interComm_) );
         MPI_Check( MPI_Send(&size, 1, MPI_INT, 0, snapshotTag, interComm_) );
-        MPI_Check( MPI_Send(simJson.c_str(), size, MPI_CHAR, 0, snapshotTag, interComm_) );
+        MPI_Check( MPI_Send(simConfig.c_str(), size, MPI_CHAR, 0, snapshotTag, interComm_) );
     }
 
     CUDA_Check( cudaDeviceSynchronize() );
 }
 
+// sorted by name for reproducible snapshots
+static std::vector<ParticleVector*> sortedByName(const std::set<ParticleVector*>& pvs)
+{
+    std::vector<ParticleVector*> sorted(pvs.begin(), pvs.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const ParticleVector *a, const ParticleVector *b) {return a->getName() < b->getName();});
+    return sorted;
+}
+
 ConfigObject Simulation::_saveSnapshot(Saver& saver, const std::string& typeName)
 {
     ConfigObject config = MirObject::_saveSnapshot(saver, "Simulation", typeName);
@@ -1504,6 +1861,29 @@ ConfigObject Simulation::_saveSnapshot(Saver& saver, const std::string& typeName
     config.emplace("splitterPrototypes",            saver(splitterPrototypes_));
 
     config.emplace("pvsIntegratorMap",    saver(pvsIntegratorMap_));
+
+    config.emplace("incrementalCellListPVs",   saver(sortedByName(incrementalCellListPVs_)));
+    config.emplace("inPlaceObjectCellListOVs", saver(sortedByName(inPlaceObjectCellListOVs_)));
+    config.emplace("compressedHaloPVs",        saver(sortedByName(compressedHaloPVs_)));
+    config.emplace("fusedIntegrationPVs",      saver(sortedByName(fusedIntegrationPVs_)));
+
+    std::vector<ParticleVector*> halfDeltaOldPositionsPVs;
+    for (const auto& pv : particleVectors_)
+        if (pv->getOldPositionsStorage() == OldPositionsStorage::HalfDelta)
+            halfDeltaOldPositionsPVs.push_back(pv.get());
+    config.emplace("halfDeltaOldPositionsPVs", saver(halfDeltaOldPositionsPVs));
+
+    config.emplace("timeScaleSubsteps", saver(timeScaleSubsteps_));
+
+    ConfigArray interactionLevels;
+    for (const auto& entry : interactionLevels_)
+    {
+        interactionLevels.push_back(ConfigObject{
+            {"interaction", saver(interactionMap_.at(entry.first).get())},
+            {"level",       saver(entry.second)}});
+    }
+    config.emplace("interactionLevels", std::move(interactionLevels));
+
     return config;
 }
 
@@ -9,6 +9,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,7 @@ class MirState;
 class ParticleVector;
 class ObjectVector;
 class CellList;
+enum class OldPositionsStorage;
 
 class Wall;
 class Interaction;
@@ -73,6 +75,11 @@ public:
       */
     void snapshot(const std::string& path);
 
+    /** \brief Set the format of the config file of the snapshots.
+        \param format JSON (default, human-readable) or binary (compact and faster to save and load).
+      */
+    void setSnapshotFormat(ConfigFormat format);
+
     /** \brief register a ParticleVector and initialize it with the gien InitialConditions.
         \param pv The ParticleVector to register
         \param ic The InitialConditions that will be applied to \p pv when registered
@@ -159,6 +166,66 @@ public:
     */
     void setWallBounce(const std::string& wallName, const std::string& pvName, real maximumPartTravel);
 
+    /** \brief Choose how the primary cell-list of a registered ParticleVector is built.
+        \param pvName Name of the registered ParticleVector (will die if it does not exist)
+        \param incremental If \c true, only the particles that changed cell are sorted at each build.
+        \see PrimaryCellList::setIncrementalBuild().
+     */
+    void setIncrementalCellLists(const std::string& pvName, bool incremental);
+
+    /** \brief Reorder a registered ObjectVector in place instead of copying it into its cell-list.
+        \param ovName Name of the registered ObjectVector (will die if it does not exist)
+        \param inPlace If \c true, the local objects are sorted by cell after each redistribution and
+               the pairwise interactions read the particles directly from the ObjectVector.
+        \see ObjectPrimaryCellList.
+
+        Can not be used if the particles of the ObjectVector are bounced (on walls or objects), split or corrected by a belonging checker.
+     */
+    void setInPlaceObjectCellLists(const std::string& ovName, bool inPlace);
+
+    /** \brief Choose the format of the halo exchange of a registered ParticleVector.
+        \param pvName Name of the registered ParticleVector (will die if it does not exist)
+        \param compressed If \c true, positions and velocities of the halo particles are sent with reduced size.
+        \see halo_compression.
+     */
+    void setHaloCompression(const std::string& pvName, bool compressed);
+
+    /** \brief Choose how the positions of the previous time step of a registered ParticleVector are stored.
+        \param pvName Name of the registered ParticleVector (will die if it does not exist)
+        \param storage The storage of the old positions
+        \see ParticleVector::setOldPositionsStorage().
+     */
+    void setOldPositionsStorage(const std::string& pvName, OldPositionsStorage storage);
+
+    /** \brief Fuse the integration of a registered ParticleVector with its cell-list build.
+        \param pvName Name of the registered ParticleVector (will die if it does not exist)
+        \param fused If \c true, the particles are counted into cells and their forces are cleared while
+               they are integrated, instead of in separate passes.
+        \see PrimaryCellList::prepareFusedBinning().
+
+        Requires an integrator that supports it (see Integrator::supportsFusedBinning()).
+        Can not be used if the particles are modified after the integration, e.g. by walls, bouncers
+        or plugins (see SimulationPlugin::actsBeforeCellLists()).
+     */
+    void setFusedIntegration(const std::string& pvName, bool fused);
+
+    /** \brief Define the time-scale levels used for multiple time stepping.
+        \param substeps substeps[k] is the number of time steps of level k+1 per time step of level k;
+               level 0 is the simulation time step.
+        \see setInteractionLevel(), MultiTimeStepping.
+     */
+    void setMultipleTimeStepping(const std::vector<int>& substeps);
+
+    /** \brief Set the time-scale level of a registered Interaction.
+        \param interactionName Name of the registered Interaction (will die if it does not exist)
+        \param level 0 (default) to evaluate the interaction at every simulation time step.
+               Otherwise, the local part of the interaction is evaluated at every time step of that level
+               (see setMultipleTimeStepping()) and the ParticleVector objects it acts on are integrated with that time step.
+
+        The interactions of level > 0 can not use cell-lists: this excludes pairwise interactions.
+     */
+    void setInteractionLevel(const std::string& interactionName, int level);
+
     /** \brief Associate a registered ObjectBelongingChecker to a registered ObjectVector.
         \param checkerName Name of the registered ObjectBelongingChecker (will die if it does not exist)
         \param objName Name of the registered ObjectVector (will die if it does not exist)
@@ -222,6 +289,15 @@ public:
     int3 getNRanks3D() const;     ///< \return the dimensions of the cartesian communicator
 
     real getCurrentDt() const;   ///< \return The current time step
+
+    /** \brief Change the time step.
+        \param dt The new time step, must be positive
+
+        To be used from SimulationPlugin::beforeCellLists(), so that the forces and the integration
+        of the time step use the same value (e.g. the DPD random forces depend on dt).
+     */
+    void setCurrentDt(real dt);
+
     real getCurrentTime() const; ///< \return The current simulation time
 
     /** \return The largest cut-off radius of all "full" force computation.
@@ -233,6 +309,11 @@ public:
      */
     real getMaxEffectiveCutoff() const;
 
+    /** \return The smallest distance that the walls bouncing \p pv allow its particles to travel in one time step
+        (see setWallBounce()); infinite if no wall bounces \p pv.
+     */
+    real getMaxWallPartTravel(const ParticleVector *pv) const;
+
     /** \brief dump the task dependency of the simulation in graphML format.
         \param fname The file name to dump the graph to (without extension).
         \param current if \c true, will only dump the current tasks; otherwise, will dump all possible ones.
@@ -249,12 +330,17 @@ protected:
 private:
     std::vector<std::string> _getExtraDataToExchange(ObjectVector *ov) const;
     std::vector<std::string> _getDataToSendBack(const std::vector<std::string>& extraOut, ObjectVector *ov) const;
+    bool _needsFullObjectHalo(ObjectVector *ov) const;
+    void _checkInPlaceObjectCellList(ObjectVector *ov) const;
 
     void _prepareCellLists();
     void _prepareInteractions();
     void _prepareBouncers();
     void _prepareWalls();
+    void _prepareFusedIntegration();
+    void _prepareMultiTimeStepping();
     void _preparePlugins();
+    void _checkFusedIntegrationPlugins() const;
     void _prepareEngines();
 
     void _execSplitters();
@@ -332,6 +418,7 @@ private:
 
     int checkpointId_ {0};
     const CheckpointInfo checkpointInfo_;
+    ConfigFormat snapshotFormat_ {ConfigFormat::JSON};
     const int rank_;
 
     /// Data constructed in init() and used during the execution of run().
@@ -352,6 +439,14 @@ private:
 
     std::vector< std::shared_ptr<SimulationPlugin> > plugins;
 
+    std::set<ParticleVector*> incrementalCellListPVs_;
+    std::set<ParticleVector*> inPlaceObjectCellListOVs_;
+    std::set<ParticleVector*> compressedHaloPVs_;
+    std::set<ParticleVector*> fusedIntegrationPVs_;
+
+    std::vector<int> timeScaleSubsteps_;
+    std::map<std::string, int> interactionLevels_;
+
     std::vector<IntegratorPrototype>          integratorPrototypes_;
     std::vector<InteractionPrototype>         interactionPrototypes_;
     std::vector<WallPrototype>                wallPrototypes_;
@@ -10,10 +10,12 @@
 #include <mirheo/core/pvs/factory.h>
 #include <mirheo/core/utils/compile_options.h>
 #include <mirheo/core/utils/config.h>
+#include <mirheo/core/utils/file_wrapper.h>
 #include <mirheo/core/utils/path.h>
 #include <mirheo/core/utils/strprintf.h>
 #include <mirheo/plugins/factory.h>
 
+#include <cstdio>
 #include <typeinfo>
 
 namespace mirheo
@@ -36,11 +38,23 @@ bool SaverContext::isGroupMasterTask() const
 }
 
 
+static ConfigFormat detectConfigFormat(const std::string& path)
+{
+    FileWrapper f;
+    const auto status = f.open(joinPaths(path, getConfigFileName(ConfigFormat::Binary)), "r");
+    return status == FileWrapper::Status::Success ? ConfigFormat::Binary : ConfigFormat::JSON;
+}
+
 LoaderContext::LoaderContext(std::string path) :
-    LoaderContext{configFromJSONFile(joinPaths(path, "config.json")),
-                  std::move(path)}
+    LoaderContext{path, detectConfigFormat(path)}
 {}
 
+LoaderContext::LoaderContext(std::string path, ConfigFormat format) :
+    LoaderContext{readSnapshotConfig(path, format), path}
+{
+    configFormat_ = format;
+}
+
 LoaderContext::LoaderContext(ConfigValue config, std::string snapshotPath) :
     path_{std::move(snapshotPath)},
     config_{std::move(config)}
@@ -227,6 +241,41 @@ static void loadComputeSpecificObjects(Mirheo *mir, Loader& loader, const Config
             mir->registerWall(wall, info["every"]);
         }
     }
+
+    if (auto *refs = sim.get("incrementalCellListPVs")) {
+        for (const auto& ref : refs->getArray())
+            mir->setIncrementalCellLists(context.get<ParticleVector>(ref).get(), true);
+    }
+
+    if (auto *refs = sim.get("inPlaceObjectCellListOVs")) {
+        for (const auto& ref : refs->getArray())
+            mir->setInPlaceObjectCellLists(context.get<ObjectVector, ParticleVector>(ref).get(), true);
+    }
+
+    if (auto *refs = sim.get("compressedHaloPVs")) {
+        for (const auto& ref : refs->getArray())
+            mir->setHaloCompression(context.get<ParticleVector>(ref).get(), true);
+    }
+
+    if (auto *refs = sim.get("fusedIntegrationPVs")) {
+        for (const auto& ref : refs->getArray())
+            mir->setFusedIntegration(context.get<ParticleVector>(ref).get(), true);
+    }
+
+    if (auto *refs = sim.get("halfDeltaOldPositionsPVs")) {
+        for (const auto& ref : refs->getArray())
+            mir->setOldPositionsStorage(context.get<ParticleVector>(ref).get(), "half_delta");
+    }
+
+    if (auto *substeps = sim.get("timeScaleSubsteps"))
+        mir->setMultipleTimeStepping(loader.load<std::vector<int>>(*substeps));
+
+    if (auto *infos = sim.get("interactionLevels")) {
+        for (const auto& info : infos->getArray()) {
+            const auto& interaction = context.get<Interaction>(info["interaction"]);
+            mir->setInteractionLevel(interaction.get(), loader.load<int>(info["level"]));
+        }
+    }
 }
 
 void loadSnapshot(Mirheo *mir, Loader& loader)
@@ -247,6 +296,26 @@ void loadSnapshot(Mirheo *mir, Loader& loader)
     loadPlugins(mir, loader);
 }
 
+ConfigValue readSnapshotConfig(const std::string& snapshotPath, ConfigFormat format)
+{
+    const std::string filename = joinPaths(snapshotPath, getConfigFileName(format));
+    return format == ConfigFormat::Binary ? configFromBinaryFile(filename)
+                                          : configFromJSONFile(filename);
+}
+
+void writeSnapshotConfig(const std::string& snapshotPath, ConfigFormat format, const ConfigValue& config)
+{
+    const std::string filename = joinPaths(snapshotPath, getConfigFileName(format));
+    if (format == ConfigFormat::Binary)
+        writeToFile(filename, configToBinary(config));
+    else
+        writeToFile(filename, config.toJSONString() + '\n');
+
+    // The format is detected from the file name when loading, remove a stale config of the other format.
+    const ConfigFormat other = format == ConfigFormat::Binary ? ConfigFormat::JSON : ConfigFormat::Binary;
+    std::remove(joinPaths(snapshotPath, getConfigFileName(other)).c_str());
+}
+
 std::string createSnapshotPath(const std::string& pathPrefix, int snapshotId)
 {
     return strprintf("%s%06d", pathPrefix.c_str(), snapshotId);
@@ -33,6 +33,7 @@ public:
     std::string path {"snapshot/"};      ///< Snapshot folder path.
     MPI_Comm groupComm {MPI_COMM_NULL};  ///< Current's rank group communicator (compute or postprocessing).
     std::map<std::string, int> counters; ///< Map of named counters.
+    ConfigFormat configFormat {ConfigFormat::JSON}; ///< Format of the config file (metadata).
 
     /// Returns true if the current rank is a master compute or master postprocessing rank.
     bool isGroupMasterTask() const;
@@ -45,9 +46,18 @@ public:
  */
 class LoaderContext {
 public:
-    /// Construct a load context from a given snapshot path.
+    /** \brief Construct a load context from a given snapshot path.
+
+        The config is read from `config.bin` if the file exists, from `config.json` otherwise.
+     */
     LoaderContext(std::string snapshotPath);
 
+    /** \brief Construct a load context from a given snapshot path and config format.
+        \param snapshotPath The path to the snapshot folder.
+        \param format The format of the config file to read.
+     */
+    LoaderContext(std::string snapshotPath, ConfigFormat format);
+
     /** \brief Construct a load context from a manually given config object.
 
         Useful for altering the config object before it is loaded.
@@ -92,6 +102,9 @@ public:
     /// Return the config object.
     const ConfigObject& getConfig() const { return config_.getObject(); }
 
+    /// Return the format of the config file the context was loaded from.
+    ConfigFormat getConfigFormat() const noexcept { return configFormat_; }
+
 private:
     template <typename T, typename Factory>
     const std::shared_ptr<T>& _loadObject(Mirheo *mir, Factory factory);
@@ -104,6 +117,7 @@ private:
         std::map<std::string, std::shared_ptr<Wall>>> objects_;
     std::string path_;
     ConfigValue config_;
+    ConfigFormat configFormat_ {ConfigFormat::JSON};
 };
 
 /** This is a mechanism for avoiding undefined symbols during the linking phase
@@ -156,6 +170,12 @@ private:
 /// Load the snapshot to the Mirheo object.
 void loadSnapshot(Mirheo *mir, Loader& loader);
 
+/// Read the config (metadata) of the snapshot in the given folder and format.
+ConfigValue readSnapshotConfig(const std::string& snapshotPath, ConfigFormat format);
+
+/// Write the config (metadata) of the snapshot in the given folder and format, and remove the config of the other format, if any.
+void writeSnapshotConfig(const std::string& snapshotPath, ConfigFormat format, const ConfigValue& config);
+
 /// Create a snapshot path from the prefix (pattern) and the snapshot ID.
 std::string createSnapshotPath(const std::string& pathPrefix, int snapshotId);
 
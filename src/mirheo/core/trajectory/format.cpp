@@ -0,0 +1,311 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "format.h"
+
+#include <mirheo/core/logger.h>
+
+#include <cstring>
+#include <sys/types.h>
+
+namespace mirheo
+{
+
+namespace trajectory
+{
+
+static const char fileMagic   [8] = {'M', 'I', 'R', 'T', 'R', 'A', 'J', '\0'};
+static const char footerMagic [8] = {'T', 'R', 'A', 'J', 'I', 'D', 'X', '\0'};
+static const char frameMagic  [4] = {'F', 'R', 'M', '\0'};
+
+// number of frames, footer offset, magic
+static constexpr size_t trailerSize = 2 * sizeof(uint64_t) + sizeof(footerMagic);
+// offset, time, step
+static constexpr size_t footerEntrySize = sizeof(uint64_t) + sizeof(double) + sizeof(int64_t);
+
+namespace
+{
+
+void writeBytes(FILE *f, const void *data, size_t size)
+{
+    if (size > 0 && std::fwrite(data, 1, size, f) != size)
+        die("Trajectory: could not write %zu bytes", size);
+}
+
+template <typename T>
+void writeValue(FILE *f, T value)
+{
+    writeBytes(f, &value, sizeof(value));
+}
+
+void writeString(FILE *f, const std::string& str)
+{
+    writeValue(f, static_cast<uint32_t>(str.size()));
+    writeBytes(f, str.data(), str.size());
+}
+
+bool readBytes(FileWrapper& f, void *data, size_t size)
+{
+    return size == 0 || std::fread(data, 1, size, f.get()) == size;
+}
+
+template <typename T>
+bool readValue(FileWrapper& f, T& value)
+{
+    return readBytes(f, &value, sizeof(value));
+}
+
+bool readString(FileWrapper& f, std::string& str)
+{
+    uint32_t size;
+    if (!readValue(f, size))
+        return false;
+    str.resize(size);
+    return readBytes(f, &str[0], size);
+}
+
+uint64_t getFileSize(FileWrapper& f)
+{
+    if (fseeko(f.get(), 0, SEEK_END) != 0)
+        die("Trajectory: could not seek to the end of the file");
+    return static_cast<uint64_t>(ftello(f.get()));
+}
+
+bool seek(FileWrapper& f, uint64_t offset)
+{
+    return fseeko(f.get(), static_cast<off_t>(offset), SEEK_SET) == 0;
+}
+
+} // anonymous namespace
+
+size_t getElementSize(const XDMF::Channel& channel)
+{
+    return static_cast<size_t>(channel.nComponents() * channel.precision());
+}
+
+size_t getParticleSize(const Header& header)
+{
+    size_t size = 3 * static_cast<size_t>(header.realSize);
+    for (const auto& channel : header.channels)
+        size += getElementSize(channel);
+    return size;
+}
+
+size_t getFrameHeaderSize(size_t nChunks)
+{
+    const size_t fixedSize = sizeof(frameMagic) + 2 * sizeof(uint64_t) + sizeof(double) + sizeof(int64_t)
+        + sizeof(uint8_t) + sizeof(uint32_t);
+    const size_t chunkSize = 2 * sizeof(uint64_t) + 2 * sizeof(int64_t);
+    return fixedSize + nChunks * chunkSize;
+}
+
+void writeHeader(FILE *f, const Header& header)
+{
+    writeBytes(f, fileMagic, sizeof(fileMagic));
+    writeValue(f, formatVersion);
+    writeValue(f, static_cast<uint32_t>(header.realSize));
+    writeValue(f, header.chunkSize);
+    writeValue(f, static_cast<int32_t>(header.idChannel));
+    writeValue(f, static_cast<uint32_t>(header.channels.size()));
+
+    for (const auto& channel : header.channels)
+    {
+        writeString(f, channel.name);
+        writeString(f, XDMF::dataFormToDescription(channel.dataForm));
+        writeString(f, XDMF::numberTypeToString(channel.numberType));
+        writeValue(f, static_cast<uint32_t>(XDMF::numberTypeToPrecision(channel.numberType)));
+        writeString(f, typeDescriptorToString(channel.type));
+        writeValue(f, static_cast<uint8_t>(channel.needShift == XDMF::Channel::NeedShift::True));
+    }
+}
+
+Header readHeader(FileWrapper& f, const std::string& filename)
+{
+    char magic[sizeof(fileMagic)];
+    uint32_t version, realSize, nChannels;
+    int32_t idChannel;
+    Header header;
+
+    if (!readBytes(f, magic, sizeof(magic)) || std::memcmp(magic, fileMagic, sizeof(magic)) != 0)
+        die("'%s' is not a trajectory file", filename.c_str());
+
+    if (!readValue(f, version) || version != formatVersion)
+        die("Trajectory '%s': unsupported format version %u (expected %u)",
+            filename.c_str(), version, formatVersion);
+
+    if (!readValue(f, realSize) || !readValue(f, header.chunkSize) ||
+        !readValue(f, idChannel) || !readValue(f, nChannels))
+        die("Trajectory '%s': truncated header", filename.c_str());
+
+    header.realSize = static_cast<int>(realSize);
+    header.idChannel = static_cast<int>(idChannel);
+
+    if (realSize != sizeof(float) && realSize != sizeof(double))
+        die("Trajectory '%s': unsupported real size %u", filename.c_str(), realSize);
+
+    for (uint32_t i = 0; i < nChannels; ++i)
+    {
+        std::string name, form, numberType, type;
+        uint32_t precision;
+        uint8_t needShift;
+
+        if (!readString(f, name) || !readString(f, form) || !readString(f, numberType) ||
+            !readValue(f, precision) || !readString(f, type) || !readValue(f, needShift))
+            die("Trajectory '%s': truncated header", filename.c_str());
+
+        header.channels.push_back(XDMF::Channel{name, nullptr,
+                                                XDMF::descriptionToDataForm(form),
+                                                XDMF::infoToNumberType(numberType, static_cast<int>(precision)),
+                                                stringToTypeDescriptor(type),
+                                                needShift ? XDMF::Channel::NeedShift::True : XDMF::Channel::NeedShift::False});
+    }
+
+    if (header.idChannel >= static_cast<int>(nChannels))
+        die("Trajectory '%s': invalid id channel %d", filename.c_str(), header.idChannel);
+
+    return header;
+}
+
+void writeFrameHeader(FILE *f, const FrameHeader& frame)
+{
+    writeBytes(f, frameMagic, sizeof(frameMagic));
+    writeValue(f, frame.size);
+    writeValue(f, static_cast<double>(frame.time));
+    writeValue(f, static_cast<int64_t>(frame.step));
+    writeValue(f, frame.nParticles);
+    writeValue(f, static_cast<uint8_t>(frame.sortedById));
+    writeValue(f, static_cast<uint32_t>(frame.chunks.size()));
+
+    for (const auto& chunk : frame.chunks)
+    {
+        writeValue(f, chunk.offset);
+        writeValue(f, chunk.nParticles);
+        writeValue(f, chunk.minId);
+        writeValue(f, chunk.maxId);
+    }
+}
+
+bool readFrameHeader(FileWrapper& f, uint64_t offset, FrameHeader& frame)
+{
+    char magic[sizeof(frameMagic)];
+    double time;
+    int64_t step;
+    uint8_t sorted;
+    uint32_t nChunks;
+
+    if (!seek(f, offset) ||
+        !readBytes(f, magic, sizeof(magic)) || std::memcmp(magic, frameMagic, sizeof(magic)) != 0 ||
+        !readValue(f, frame.size) || !readValue(f, time) || !readValue(f, step) ||
+        !readValue(f, frame.nParticles) || !readValue(f, sorted) || !readValue(f, nChunks))
+        return false;
+
+    frame.time = static_cast<MirState::TimeType>(time);
+    frame.step = static_cast<MirState::StepType>(step);
+    frame.sortedById = sorted != 0;
+    frame.chunks.resize(nChunks);
+
+    for (auto& chunk : frame.chunks)
+        if (!readValue(f, chunk.offset) || !readValue(f, chunk.nParticles) ||
+            !readValue(f, chunk.minId) || !readValue(f, chunk.maxId))
+            return false;
+
+    return frame.size >= getFrameHeaderSize(nChunks);
+}
+
+void writeFooter(FILE *f, const std::vector<FrameInfo>& frames)
+{
+    const uint64_t footerOffset = static_cast<uint64_t>(ftello(f));
+
+    for (const auto& frame : frames)
+    {
+        writeValue(f, frame.offset);
+        writeValue(f, static_cast<double>(frame.time));
+        writeValue(f, static_cast<int64_t>(frame.step));
+    }
+
+    writeValue(f, static_cast<uint64_t>(frames.size()));
+    writeValue(f, footerOffset);
+    writeBytes(f, footerMagic, sizeof(footerMagic));
+}
+
+// read the footer; return false if it is not consistent with the file
+static bool readFooter(FileWrapper& f, uint64_t dataStart, uint64_t fileSize,
+                       std::vector<FrameInfo>& frames, uint64_t& framesEnd)
+{
+    if (fileSize < dataStart + trailerSize)
+        return false;
+
+    uint64_t nFrames, footerOffset;
+    char magic[sizeof(footerMagic)];
+
+    if (!seek(f, fileSize - trailerSize) ||
+        !readValue(f, nFrames) || !readValue(f, footerOffset) ||
+        !readBytes(f, magic, sizeof(magic)) || std::memcmp(magic, footerMagic, sizeof(magic)) != 0)
+        return false;
+
+    if (footerOffset < dataStart || footerOffset + nFrames * footerEntrySize + trailerSize != fileSize)
+        return false;
+
+    if (!seek(f, footerOffset))
+        return false;
+
+    frames.resize(nFrames);
+    for (auto& frame : frames)
+    {
+        double time;
+        int64_t step;
+        if (!readValue(f, frame.offset) || !readValue(f, time) || !readValue(f, step))
+            return false;
+        frame.time = static_cast<MirState::TimeType>(time);
+        frame.step = static_cast<MirState::StepType>(step);
+    }
+
+    framesEnd = footerOffset;
+    return true;
+}
+
+std::vector<FrameInfo> readIndex(FileWrapper& f, const std::string& filename, uint64_t& framesEnd)
+{
+    const uint64_t dataStart = static_cast<uint64_t>(ftello(f.get()));
+    const uint64_t fileSize = getFileSize(f);
+
+    std::vector<FrameInfo> frames;
+
+    if (readFooter(f, dataStart, fileSize, frames, framesEnd))
+        return frames;
+
+    warn("Trajectory '%s': no valid index found, scanning the frames", filename.c_str());
+
+    frames.clear();
+    framesEnd = dataStart;
+    FrameHeader frame;
+
+    while (readFrameHeader(f, framesEnd, frame) && framesEnd + frame.size <= fileSize)
+    {
+        frames.push_back({framesEnd, frame.time, frame.step});
+        framesEnd += frame.size;
+    }
+
+    return frames;
+}
+
+bool isCompatible(const Header& a, const Header& b)
+{
+    if (a.realSize  != b.realSize  ||
+        a.idChannel != b.idChannel ||
+        a.channels.size() != b.channels.size())
+        return false;
+
+    for (size_t i = 0; i < a.channels.size(); ++i)
+    {
+        const auto& ca = a.channels[i];
+        const auto& cb = b.channels[i];
+
+        if (ca.name != cb.name || ca.dataForm != cb.dataForm ||
+            ca.numberType != cb.numberType || ca.needShift != cb.needShift)
+            return false;
+    }
+    return true;
+}
+
+} // namespace trajectory
+
+} // namespace mirheo
@@ -0,0 +1,125 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/mirheo_state.h>
+#include <mirheo/core/utils/file_wrapper.h>
+#include <mirheo/core/xdmf/channel.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mirheo
+{
+
+/** \brief Append-only container for sequences of particle data (trajectories).
+
+    All the frames of a trajectory are stored in a single file, in native byte order:
+
+    - header: magic string, format version, size of the position components,
+      number of particles per chunk, index of the id channel and channel descriptions;
+    - frames, one after the other. Each frame starts with its size, time, step and number of particles,
+      followed by a table of chunks; each chunk contains the positions and the channels of at most
+      `chunkSize` particles, together with the range of ids it contains;
+    - footer: offset, time and step of every frame, followed by a fixed size trailer
+      (number of frames, offset of the footer and a magic string).
+
+    Appending a frame removes the footer, then writes the frame and a new footer after it.
+    The footer allows to seek to any frame without reading the others;
+    if it is missing (e.g. the writer was interrupted), the frames are found by scanning the file.
+    When the particles of a frame are sorted by id, the chunk table allows to read a range of ids
+    without reading the whole frame.
+ */
+namespace trajectory
+{
+
+/// Version of the file format, incremented when the layout changes.
+constexpr uint32_t formatVersion = 1;
+
+/// Value of the chunk ids range when the file has no id channel.
+constexpr int64_t noIdRangeMin = INT64_MIN;
+constexpr int64_t noIdRangeMax = INT64_MAX; ///< \see noIdRangeMin
+
+/// Global information about a trajectory file.
+struct Header
+{
+    int realSize;                       ///< size in bytes of one position component
+    int64_t chunkSize;                  ///< maximum number of particles per chunk
+    int idChannel;                      ///< index of the channel that contains the particle ids; -1 if there is none
+    std::vector<XDMF::Channel> channels; ///< descriptions of the channels; the data pointers are not used
+};
+
+/// Location and time stamp of one frame.
+struct FrameInfo
+{
+    uint64_t offset;         ///< position of the frame in the file, in bytes
+    MirState::TimeType time; ///< simulation time of the frame
+    MirState::StepType step; ///< simulation step of the frame
+};
+
+/// Location and range of ids of one chunk of a frame.
+struct ChunkInfo
+{
+    uint64_t offset;    ///< position of the chunk relative to the start of its frame, in bytes
+    uint64_t nParticles; ///< number of particles in the chunk
+    int64_t minId;      ///< smallest id of the chunk
+    int64_t maxId;      ///< largest id of the chunk
+};
+
+/// Everything that precedes the particle data of a frame.
+struct FrameHeader
+{
+    uint64_t size;           ///< size of the whole frame in bytes, including this header
+    MirState::TimeType time; ///< simulation time of the frame
+    MirState::StepType step; ///< simulation step of the frame
+    uint64_t nParticles;     ///< total number of particles of the frame
+    bool sortedById;         ///< \c true if the particles are sorted by increasing id
+    std::vector<ChunkInfo> chunks; ///< the chunks of the frame, in the order they are stored
+};
+
+/// \return The size in bytes of one element of the given channel
+size_t getElementSize(const XDMF::Channel& channel);
+
+/// \return The size in bytes of one particle: its position and all channels
+size_t getParticleSize(const Header& header);
+
+/// \return The size in bytes of the header of a frame with \p nChunks chunks
+size_t getFrameHeaderSize(size_t nChunks);
+
+/// Write the header at the current position of \p f. Dies on failure.
+void writeHeader(FILE *f, const Header& header);
+
+/// Read the header from the current position of \p f. Dies if the file is not a trajectory file.
+Header readHeader(FileWrapper& f, const std::string& filename);
+
+/// Write the header of a frame at the current position of \p f. Dies on failure.
+void writeFrameHeader(FILE *f, const FrameHeader& frame);
+
+/** \brief Read the header of a frame at the given position of \p f.
+    \param f The file.
+    \param offset Position of the frame in the file.
+    \param [out] frame The frame header.
+    \return \c false if there is no valid frame at this position.
+ */
+bool readFrameHeader(FileWrapper& f, uint64_t offset, FrameHeader& frame);
+
+/// Write the footer at the current position of \p f. Dies on failure.
+void writeFooter(FILE *f, const std::vector<FrameInfo>& frames);
+
+/** \brief Find all frames of a trajectory file.
+    \param f The file, whose header has been read already.
+    \param filename The name of the file, for error messages.
+    \param [out] framesEnd Position in bytes right after the last complete frame.
+    \return The frames stored in the file.
+
+    The footer is used if it is valid; otherwise the frames are found by reading all the frame headers.
+    An incomplete last frame is ignored.
+ */
+std::vector<FrameInfo> readIndex(FileWrapper& f, const std::string& filename, uint64_t& framesEnd);
+
+/// \return \c true if the two headers describe the same data layout
+bool isCompatible(const Header& a, const Header& b);
+
+} // namespace trajectory
+
+} // namespace mirheo
@@ -0,0 +1,180 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "reader.h"
+
+#include <mirheo/core/logger.h>
+
+#include <cstring>
+
+namespace mirheo
+{
+
+namespace trajectory
+{
+
+template <typename T>
+static real3 loadPosition(const char *src)
+{
+    T r[3];
+    std::memcpy(r, src, sizeof(r));
+    return {static_cast<real>(r[0]), static_cast<real>(r[1]), static_cast<real>(r[2])};
+}
+
+static int64_t loadId(const XDMF::Channel& idChannel, const char *src)
+{
+    if (idChannel.numberType == XDMF::Channel::NumberType::Int64)
+    {
+        int64_t id;
+        std::memcpy(&id, src, sizeof(id));
+        return id;
+    }
+    int id;
+    std::memcpy(&id, src, sizeof(id));
+    return id;
+}
+
+Reader::Reader(const std::string& filename) :
+    filename_(filename)
+{
+    if (file_.open(filename_, "rb") != FileWrapper::Status::Success)
+        die("Trajectory: could not open '%s'", filename_.c_str());
+
+    header_ = readHeader(file_, filename_);
+
+    uint64_t framesEnd;
+    frames_ = readIndex(file_, filename_, framesEnd);
+
+    debug("Trajectory '%s': %zu frames with %zu channels",
+          filename_.c_str(), frames_.size(), header_.channels.size());
+}
+
+int Reader::getNumFrames() const
+{
+    return static_cast<int>(frames_.size());
+}
+
+const FrameInfo& Reader::_getFrameInfo(int frameId) const
+{
+    if (frameId < 0 || frameId >= getNumFrames())
+        die("Trajectory '%s': frame %d out of range [0, %d)", filename_.c_str(), frameId, getNumFrames());
+    return frames_[frameId];
+}
+
+MirState::TimeType Reader::getTime(int frameId) const
+{
+    return _getFrameInfo(frameId).time;
+}
+
+MirState::StepType Reader::getStep(int frameId) const
+{
+    return _getFrameInfo(frameId).step;
+}
+
+int Reader::findFrame(MirState::TimeType time) const
+{
+    int found = -1;
+    for (int i = 0; i < getNumFrames(); ++i)
+        if (frames_[i].time <= time)
+            found = i;
+    return found;
+}
+
+const std::vector<XDMF::Channel>& Reader::getChannels() const
+{
+    return header_.channels;
+}
+
+std::string Reader::getIdChannelName() const
+{
+    if (header_.idChannel < 0)
+        return "";
+    return header_.channels[header_.idChannel].name;
+}
+
+XDMF::VertexChannelsData Reader::readFrame(int frameId)
+{
+    return _read(frameId, false, 0, 0);
+}
+
+XDMF::VertexChannelsData Reader::readFrame(int frameId, int64_t idMin, int64_t idMax)
+{
+    if (header_.idChannel < 0)
+        die("Trajectory '%s': cannot read a range of ids, the file has no id channel", filename_.c_str());
+    return _read(frameId, true, idMin, idMax);
+}
+
+XDMF::VertexChannelsData Reader::_read(int frameId, bool filterIds, int64_t idMin, int64_t idMax)
+{
+    const FrameInfo& frameInfo = _getFrameInfo(frameId);
+
+    FrameHeader frame;
+    if (!readFrameHeader(file_, frameInfo.offset, frame))
+        die("Trajectory '%s': corrupted frame %d", filename_.c_str(), frameId);
+
+    const size_t nChannels = header_.channels.size();
+    const size_t positionSize = 3 * static_cast<size_t>(header_.realSize);
+    const size_t particleSize = getParticleSize(header_);
+
+    std::vector<size_t> elementSizes;
+    for (const auto& channel : header_.channels)
+        elementSizes.push_back(getElementSize(channel));
+
+    XDMF::VertexChannelsData result;
+    result.descriptions = header_.channels;
+    result.data.resize(nChannels);
+
+    size_t nChunksRead = 0;
+
+    for (const auto& chunk : frame.chunks)
+    {
+        if (filterIds && (chunk.maxId < idMin || chunk.minId > idMax))
+            continue;
+
+        const size_t n = static_cast<size_t>(chunk.nParticles);
+        buffer_.resize(n * particleSize);
+
+        if (fseeko(file_.get(), static_cast<off_t>(frameInfo.offset + chunk.offset), SEEK_SET) != 0)
+            die("Trajectory '%s': could not seek to frame %d", filename_.c_str(), frameId);
+        file_.fread(buffer_.data(), 1, buffer_.size());
+        ++nChunksRead;
+
+        // start of each column in the chunk: positions first, then the channels
+        std::vector<const char*> columns {buffer_.data()};
+        columns.push_back(buffer_.data() + n * positionSize);
+        for (size_t c = 0; c + 1 < nChannels; ++c)
+            columns.push_back(columns.back() + n * elementSizes[c]);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (filterIds)
+            {
+                const int c = header_.idChannel;
+                const int64_t id = loadId(header_.channels[c], columns[c + 1] + i * elementSizes[c]);
+                if (id < idMin || id > idMax)
+                    continue;
+            }
+
+            const char *pos = columns[0] + i * positionSize;
+            result.positions.push_back(header_.realSize == static_cast<int>(sizeof(float)) ?
+                                       loadPosition<float> (pos) :
+                                       loadPosition<double>(pos));
+
+            for (size_t c = 0; c < nChannels; ++c)
+            {
+                const char *src = columns[c + 1] + i * elementSizes[c];
+                result.data[c].insert(result.data[c].end(), src, src + elementSizes[c]);
+            }
+        }
+    }
+
+    for (size_t c = 0; c < nChannels; ++c)
+        result.descriptions[c].data = result.data[c].data();
+
+    debug2("Trajectory '%s': read %zu particles from %zu out of %zu chunks of frame %d",
+           filename_.c_str(), result.positions.size(), nChunksRead, frame.chunks.size(), frameId);
+
+    return result;
+}
+
+} // namespace trajectory
+
+} // namespace mirheo
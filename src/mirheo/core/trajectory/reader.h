@@ -0,0 +1,82 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "format.h"
+
+#include <mirheo/core/xdmf/xdmf.h>
+
+#include <string>
+#include <vector>
+
+namespace mirheo
+{
+
+namespace trajectory
+{
+
+/** \brief Random access to the frames of a trajectory file.
+
+    See the trajectory namespace for a description of the file format.
+    The frames are returned in the same form as XDMF::readVertexData(), so that the same
+    post-processing code can be used for both formats.
+ */
+class Reader
+{
+public:
+    /** \brief Open a trajectory file and read its index.
+        \param filename The name of the file.
+     */
+    explicit Reader(const std::string& filename);
+
+    /// \return The number of frames in the file
+    int getNumFrames() const;
+
+    /// \return The simulation time of the given frame
+    MirState::TimeType getTime(int frameId) const;
+
+    /// \return The simulation step of the given frame
+    MirState::StepType getStep(int frameId) const;
+
+    /// \return The index of the last frame with a time not larger than \p time, or -1 if there is none
+    int findFrame(MirState::TimeType time) const;
+
+    /// \return The descriptions of the channels stored in each frame; the data pointers are null
+    const std::vector<XDMF::Channel>& getChannels() const;
+
+    /// \return The name of the channel that contains the particle ids; empty if there is none
+    std::string getIdChannelName() const;
+
+    /** \brief Read all the particles of one frame.
+        \param frameId The index of the frame, from 0 to getNumFrames() - 1.
+        \return The positions and channels of the particles.
+     */
+    XDMF::VertexChannelsData readFrame(int frameId);
+
+    /** \brief Read the particles of one frame with an id in a given range.
+        \param frameId The index of the frame, from 0 to getNumFrames() - 1.
+        \param idMin The smallest id to read.
+        \param idMax The largest id to read.
+        \return The positions and channels of the particles with ids in [idMin, idMax].
+
+        Only the chunks that may contain these ids are read from the file.
+        If the frame is sorted by id, the particles are returned in increasing id order.
+        Dies if the file has no id channel.
+     */
+    XDMF::VertexChannelsData readFrame(int frameId, int64_t idMin, int64_t idMax);
+
+private:
+    const FrameInfo& _getFrameInfo(int frameId) const;
+    XDMF::VertexChannelsData _read(int frameId, bool filterIds, int64_t idMin, int64_t idMax);
+
+private:
+    std::string filename_;
+    FileWrapper file_;
+    Header header_;
+    std::vector<FrameInfo> frames_;
+
+    std::vector<char> buffer_; ///< raw data of one chunk
+};
+
+} // namespace trajectory
+
+} // namespace mirheo
@@ -0,0 +1,220 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "writer.h"
+
+#include <mirheo/core/logger.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <unistd.h>
+
+namespace mirheo
+{
+
+namespace trajectory
+{
+
+static int findChannel(const std::vector<XDMF::Channel>& channels, const std::string& name)
+{
+    for (size_t i = 0; i < channels.size(); ++i)
+        if (channels[i].name == name)
+            return static_cast<int>(i);
+    return -1;
+}
+
+static int64_t getId(const XDMF::Channel& idChannel, size_t i)
+{
+    if (idChannel.numberType == XDMF::Channel::NumberType::Int64)
+        return reinterpret_cast<const int64_t*>(idChannel.data)[i];
+    return reinterpret_cast<const int*>(idChannel.data)[i];
+}
+
+Writer::Writer(const std::string& filename, const std::vector<XDMF::Channel>& channels, int64_t chunkSize,
+               const std::string& idChannelName, bool sortById, bool append) :
+    filename_(filename),
+    sortById_(sortById)
+{
+    if (chunkSize < 1)
+        die("Trajectory '%s': the chunk size must be positive, got %lld",
+            filename_.c_str(), static_cast<long long>(chunkSize));
+
+    header_.realSize = static_cast<int>(sizeof(real));
+    header_.chunkSize = chunkSize;
+    header_.channels = channels;
+    header_.idChannel = idChannelName.empty() ? -1 : findChannel(channels, idChannelName);
+
+    for (auto& channel : header_.channels)
+        channel.data = nullptr;
+
+    if (!idChannelName.empty())
+    {
+        if (header_.idChannel < 0)
+            die("Trajectory '%s': no channel named '%s'", filename_.c_str(), idChannelName.c_str());
+
+        const auto& idChannel = header_.channels[header_.idChannel];
+        if (idChannel.dataForm != XDMF::Channel::DataForm::Scalar ||
+            (idChannel.numberType != XDMF::Channel::NumberType::Int64 &&
+             idChannel.numberType != XDMF::Channel::NumberType::Int))
+            die("Trajectory '%s': the id channel '%s' must contain scalar integers",
+                filename_.c_str(), idChannelName.c_str());
+    }
+
+    if (sortById_ && header_.idChannel < 0)
+        die("Trajectory '%s': sorting by id requires an id channel", filename_.c_str());
+
+    if (append && file_.open(filename_, "r+b") == FileWrapper::Status::Success)
+    {
+        const Header existing = readHeader(file_, filename_);
+
+        if (existing.chunkSize != header_.chunkSize)
+            warn("Trajectory '%s': appending with chunks of %lld particles instead of %lld",
+                 filename_.c_str(), static_cast<long long>(existing.chunkSize),
+                 static_cast<long long>(header_.chunkSize));
+
+        if (!isCompatible(existing, header_))
+            die("Trajectory '%s': cannot append, the existing file has different channels", filename_.c_str());
+
+        header_.chunkSize = existing.chunkSize;
+        frames_ = readIndex(file_, filename_, framesEnd_);
+
+        info("Trajectory '%s': appending to %zu existing frames", filename_.c_str(), frames_.size());
+    }
+    else
+    {
+        if (file_.open(filename_, "w+b") != FileWrapper::Status::Success)
+            die("Trajectory: could not open '%s' for writing", filename_.c_str());
+
+        writeHeader(file_.get(), header_);
+        framesEnd_ = static_cast<uint64_t>(ftello(file_.get()));
+        writeFooter(file_.get(), frames_);
+        fflush(file_.get());
+    }
+}
+
+int Writer::getNumFrames() const
+{
+    return static_cast<int>(frames_.size());
+}
+
+void Writer::_computeOrder(const std::vector<XDMF::Channel>& channels, size_t n)
+{
+    order_.resize(n);
+    std::iota(order_.begin(), order_.end(), 0);
+
+    if (!sortById_)
+        return;
+
+    const auto& idChannel = channels[header_.idChannel];
+    std::sort(order_.begin(), order_.end(), [&idChannel](size_t a, size_t b)
+    {
+        return getId(idChannel, a) < getId(idChannel, b);
+    });
+}
+
+void Writer::_getIdRange(const XDMF::Channel& idChannel, size_t begin, size_t end, int64_t& minId, int64_t& maxId) const
+{
+    minId = noIdRangeMax;
+    maxId = noIdRangeMin;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const int64_t id = getId(idChannel, order_[i]);
+        minId = std::min(minId, id);
+        maxId = std::max(maxId, id);
+    }
+}
+
+void Writer::_writeColumn(const char *src, size_t elementSize, size_t begin, size_t end)
+{
+    const size_t size = (end - begin) * elementSize;
+    buffer_.resize(size);
+
+    for (size_t i = begin; i < end; ++i)
+        std::memcpy(buffer_.data() + (i - begin) * elementSize, src + order_[i] * elementSize, elementSize);
+
+    if (size > 0 && std::fwrite(buffer_.data(), 1, size, file_.get()) != size)
+        die("Trajectory '%s': could not write %zu bytes", filename_.c_str(), size);
+}
+
+void Writer::write(MirState::TimeType time, MirState::StepType step,
+                   const std::vector<real3>& positions, const std::vector<XDMF::Channel>& channels)
+{
+    if (channels.size() != header_.channels.size())
+        die("Trajectory '%s': expected %zu channels, got %zu",
+            filename_.c_str(), header_.channels.size(), channels.size());
+
+    for (size_t i = 0; i < channels.size(); ++i)
+        if (channels[i].name != header_.channels[i].name ||
+            getElementSize(channels[i]) != getElementSize(header_.channels[i]))
+            die("Trajectory '%s': channel %zu ('%s') does not match the description '%s'",
+                filename_.c_str(), i, channels[i].name.c_str(), header_.channels[i].name.c_str());
+
+    const size_t n = positions.size();
+    const size_t chunkSize = static_cast<size_t>(header_.chunkSize);
+    const size_t nChunks = (n + chunkSize - 1) / chunkSize;
+
+    _computeOrder(channels, n);
+
+    FrameHeader frame;
+    frame.time = time;
+    frame.step = step;
+    frame.nParticles = n;
+    frame.sortedById = sortById_;
+    frame.chunks.resize(nChunks);
+
+    uint64_t offset = getFrameHeaderSize(nChunks);
+    for (size_t c = 0; c < nChunks; ++c)
+    {
+        const size_t begin = c * chunkSize;
+        const size_t end = std::min(n, begin + chunkSize);
+        auto& chunk = frame.chunks[c];
+
+        chunk.offset = offset;
+        chunk.nParticles = end - begin;
+
+        if (header_.idChannel >= 0)
+            _getIdRange(channels[header_.idChannel], begin, end, chunk.minId, chunk.maxId);
+        else
+        {
+            chunk.minId = noIdRangeMin;
+            chunk.maxId = noIdRangeMax;
+        }
+
+        offset += chunk.nParticles * getParticleSize(header_);
+    }
+    frame.size = offset;
+
+    FILE *f = file_.get();
+    if (fseeko(f, static_cast<off_t>(framesEnd_), SEEK_SET) != 0)
+        die("Trajectory '%s': could not seek to the end of the frames", filename_.c_str());
+
+    // remove the index first: if the write is interrupted, the frame must not be read through a stale index
+    if (ftruncate(fileno(f), static_cast<off_t>(framesEnd_)) != 0)
+        die("Trajectory '%s': could not truncate the file", filename_.c_str());
+
+    writeFrameHeader(f, frame);
+
+    for (size_t c = 0; c < nChunks; ++c)
+    {
+        const size_t begin = c * chunkSize;
+        const size_t end = std::min(n, begin + chunkSize);
+
+        _writeColumn(reinterpret_cast<const char*>(positions.data()), sizeof(real3), begin, end);
+
+        for (const auto& channel : channels)
+            _writeColumn(reinterpret_cast<const char*>(channel.data), getElementSize(channel), begin, end);
+    }
+
+    frames_.push_back({framesEnd_, time, step});
+    framesEnd_ += frame.size;
+
+    writeFooter(f, frames_);
+    if (fflush(f) != 0)
+        die("Trajectory '%s': could not write frame %zu", filename_.c_str(), frames_.size() - 1);
+
+    debug2("Trajectory '%s': wrote frame %zu with %zu particles in %zu chunks",
+           filename_.c_str(), frames_.size() - 1, n, nChunks);
+}
+
+} // namespace trajectory
+
+} // namespace mirheo
@@ -0,0 +1,75 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "format.h"
+
+#include <mirheo/core/datatypes.h>
+
+#include <string>
+#include <vector>
+
+namespace mirheo
+{
+
+namespace trajectory
+{
+
+/** \brief Append frames of particle data to a trajectory file.
+
+    See the trajectory namespace for a description of the file format.
+    The footer is rewritten after every frame, so that the file can be read at any time between two frames.
+    The writer is serial: the data of all ranks must be gathered before calling write().
+ */
+class Writer
+{
+public:
+    /** \brief Open a trajectory file for writing.
+        \param filename The name of the file.
+        \param channels The descriptions of the channels of each frame; the data pointers are not used.
+        \param chunkSize The maximum number of particles in each chunk of a frame.
+        \param idChannelName The name of a scalar integer channel that contains unique particle ids;
+               used to sort the particles and to record the range of ids of each chunk. Can be empty.
+        \param sortById If \c true, the particles are sorted by id before being written. Requires \p idChannelName.
+        \param append If \c true and the file exists, the new frames are appended to the existing ones;
+               the file must then have the same channels. Otherwise, the file is overwritten.
+     */
+    Writer(const std::string& filename, const std::vector<XDMF::Channel>& channels, int64_t chunkSize,
+           const std::string& idChannelName, bool sortById, bool append);
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /// \return The number of frames in the file
+    int getNumFrames() const;
+
+    /** \brief Append one frame to the file.
+        \param time The simulation time of the frame.
+        \param step The simulation step of the frame.
+        \param positions The positions of the particles, in global coordinates.
+        \param channels The channels of the particles, in the same order and with the same descriptions
+               as the ones passed to the constructor.
+     */
+    void write(MirState::TimeType time, MirState::StepType step,
+               const std::vector<real3>& positions, const std::vector<XDMF::Channel>& channels);
+
+private:
+    void _computeOrder(const std::vector<XDMF::Channel>& channels, size_t n);
+    void _getIdRange(const XDMF::Channel& idChannel, size_t begin, size_t end, int64_t& minId, int64_t& maxId) const;
+    void _writeColumn(const char *src, size_t elementSize, size_t begin, size_t end);
+
+private:
+    std::string filename_;
+    FileWrapper file_;
+    Header header_;
+    bool sortById_;
+
+    std::vector<FrameInfo> frames_;
+    uint64_t framesEnd_; ///< position in bytes right after the last frame
+
+    std::vector<size_t> order_;  ///< order in which the particles are written
+    std::vector<char> buffer_;   ///< work buffer for the reordered data
+};
+
+} // namespace trajectory
+
+} // namespace mirheo
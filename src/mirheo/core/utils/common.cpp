@@ -22,6 +22,11 @@ const std::string forces        = "__forces"; // forces are special, as they are
 const std::string stresses      = "stresses";
 const std::string densities     = "densities";
 const std::string oldPositions  = "old_positions";
+const std::string oldPositionDeltas = "old_position_deltas";
+
+const std::string fixedForcesX  = "__fixed_forces_x";
+const std::string fixedForcesY  = "__fixed_forces_y";
+const std::string fixedForcesZ  = "__fixed_forces_z";
 
 const std::string motions     = "motions";
 const std::string oldMotions  = "old_motions";
@@ -41,7 +46,8 @@ const std::string rodTau_l      = "biseg_tau_l";
 
 
 const std::vector<std::string> reservedParticleFields =
-    {globalIds, positions, velocities, forces, stresses, densities, oldPositions};
+    {globalIds, positions, velocities, forces, stresses, densities, oldPositions, oldPositionDeltas,
+     fixedForcesX, fixedForcesY, fixedForcesZ};
 
 const std::vector<std::string> reservedObjectFields =
     {globalIds, motions, oldMotions, comExtents, areaVolumes, membraneTypeId,
@@ -17,6 +17,13 @@ class ConfigObject;
 template <typename T, typename Enable = void>
 struct TypeLoadSave;
 
+/// Encoding of the snapshot config (metadata).
+enum class ConfigFormat
+{
+    JSON,  ///< Human-readable, `config.json`.
+    Binary ///< Compact and fast, `config.bin`. See configToBinary().
+};
+
 /** Special channel names used in data managers
  */
 namespace channel_names
@@ -32,6 +39,12 @@ extern const std::string forces;       ///< forces
 extern const std::string stresses;     ///< stresses
 extern const std::string densities;    ///< number densities (computed from pairwise density kernels)
 extern const std::string oldPositions; ///< positions at previous time step
+extern const std::string oldPositionDeltas; ///< positions at previous time step minus current positions, in half precision
+
+// per particle fields, fixed-point force accumulators (see MIRHEO_DETERMINISTIC_FORCES)
+extern const std::string fixedForcesX; ///< x component of the forces
+extern const std::string fixedForcesY; ///< y component of the forces
+extern const std::string fixedForcesZ; ///< z component of the forces
 
 // per object fields
 extern const std::string motions;     ///< rigid object states
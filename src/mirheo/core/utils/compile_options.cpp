@@ -5,6 +5,7 @@ namespace mirheo
 {
 
 constexpr bool CompileOptions::useDouble;
+constexpr bool CompileOptions::deterministicForces;
 
 const CompileOptions compile_options{
 #ifdef MIRHEO_MEMBRANE_FORCES_DOUBLE
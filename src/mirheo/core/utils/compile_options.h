@@ -15,6 +15,13 @@ struct CompileOptions
     static constexpr bool useDouble = false;
 #endif
 
+    /// \c true if the forces are accumulated in fixed point (bitwise reproducible runs)
+#ifdef MIRHEO_DETERMINISTIC_FORCES
+    static constexpr bool deterministicForces = true;
+#else
+    static constexpr bool deterministicForces = false;
+#endif
+
     // Core-private flags. Cannot be constexpr. If changing the field or their
     // order, don't forget to update the .cpp file!
     bool membraneDouble; ///< \c true if the membrane forces are computed in double precision
@@ -29,6 +36,7 @@ extern const CompileOptions compile_options;
 #define MIRHEO_COMPILE_OPT_TABLE(OP)            \
     OP(useNvtx)                                 \
     OP(useDouble)                               \
+    OP(deterministicForces)                     \
     OP(membraneDouble)                          \
     OP(rodDouble)
 
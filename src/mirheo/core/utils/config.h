@@ -761,4 +761,21 @@ ConfigValue configFromJSONFile(const std::string& filename);
 /// Parse a ConfigValue from a JSON string.
 ConfigValue configFromJSON(const std::string& json);
 
+/** \brief Encode a ConfigValue in a compact binary format.
+
+    Arrays of numbers and arrays of equally sized arrays of floats are stored
+    as raw blobs. Int and Float values are preserved exactly. The encoding
+    assumes little-endian machines.
+ */
+std::string configToBinary(const ConfigValue& config);
+
+/// Decode a ConfigValue encoded with configToBinary().
+ConfigValue configFromBinary(const std::string& data);
+
+/// Load a ConfigValue from a file written with configToBinary().
+ConfigValue configFromBinaryFile(const std::string& filename);
+
+/// Return the name of the snapshot config file for the given format.
+const char* getConfigFileName(ConfigFormat format);
+
 } // namespace mirheo
@@ -0,0 +1,344 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "config.h"
+#include <mirheo/core/logger.h>
+
+#include <cstdint>
+#include <cstring>
+
+/* Binary encoding of ConfigValue trees.
+ *
+ * The layout follows the spirit of MessagePack: each value starts with a one
+ * byte tag, lengths are LEB128 varints and integers are zigzag varints.
+ * Arrays of numbers, and arrays of equally sized arrays of numbers (e.g. mesh
+ * vertices), are stored as raw little-endian 64 bit blobs, which are copied
+ * with a single memcpy when decoding.
+ *
+ * The Int and Float variants are preserved exactly, as opposed to JSON.
+ */
+
+namespace mirheo
+{
+
+namespace
+{
+    constexpr char kBinaryMagic[4] = {'M', 'C', 'F', 'G'};
+    constexpr uint8_t kBinaryVersion = 1;
+
+    /// Arrays of numbers shorter than this are stored element by element.
+    constexpr size_t kMinBlobSize = 4;
+
+    enum class Tag : uint8_t
+    {
+        Int         = 1,
+        Float       = 2,
+        String      = 3,
+        Array       = 4,
+        Object      = 5,
+        IntBlob     = 6, ///< n, then n int64
+        FloatBlob   = 7, ///< n, then n doubles
+        FloatMatrix = 8, ///< rows, cols, then rows * cols doubles (array of arrays)
+    };
+
+    static_assert(sizeof(ConfigValue::Int)   == 8, "Blobs assume 64 bit integers.");
+    static_assert(sizeof(ConfigValue::Float) == 8, "Blobs assume 64 bit floats.");
+
+    class BinaryWriter
+    {
+    public:
+        std::string finalize(const ConfigValue& value)
+        {
+            out_.append(kBinaryMagic, sizeof(kBinaryMagic));
+            out_.push_back(static_cast<char>(kBinaryVersion));
+            write(value);
+            return std::move(out_);
+        }
+
+    private:
+        void write(const ConfigValue& value)
+        {
+            if (auto i = value.get_if<ConfigValue::Int>())
+            {
+                writeTag(Tag::Int);
+                const auto u = static_cast<uint64_t>(*i);
+                writeVarint((u << 1) ^ static_cast<uint64_t>(*i >> 63)); // zigzag
+            }
+            else if (auto f = value.get_if<ConfigValue::Float>())
+            {
+                writeTag(Tag::Float);
+                writeRaw(f, sizeof(*f));
+            }
+            else if (auto s = value.get_if<ConfigValue::String>())
+            {
+                writeTag(Tag::String);
+                writeString(*s);
+            }
+            else if (auto o = value.get_if<ConfigValue::Object>())
+            {
+                writeTag(Tag::Object);
+                writeVarint(o->size());
+                for (const auto& kv : *o)
+                {
+                    writeString(kv.first);
+                    write(kv.second);
+                }
+            }
+            else if (auto a = value.get_if<ConfigValue::Array>())
+            {
+                writeArray(*a);
+            }
+        }
+
+        void writeArray(const ConfigValue::Array& array)
+        {
+            if (array.size() >= kMinBlobSize)
+            {
+                if (allOf<ConfigValue::Float>(array))
+                {
+                    writeTag(Tag::FloatBlob);
+                    writeVarint(array.size());
+                    for (const auto& v : array)
+                        writeRaw(&v.get<ConfigValue::Float>(), sizeof(ConfigValue::Float));
+                    return;
+                }
+                if (allOf<ConfigValue::Int>(array))
+                {
+                    writeTag(Tag::IntBlob);
+                    writeVarint(array.size());
+                    for (const auto& v : array)
+                        writeRaw(&v.get<ConfigValue::Int>(), sizeof(ConfigValue::Int));
+                    return;
+                }
+                if (isFloatMatrix(array))
+                {
+                    writeTag(Tag::FloatMatrix);
+                    writeVarint(array.size());
+                    writeVarint(array[0].getArray().size());
+                    for (const auto& row : array)
+                        for (const auto& v : row.getArray())
+                            writeRaw(&v.get<ConfigValue::Float>(), sizeof(ConfigValue::Float));
+                    return;
+                }
+            }
+
+            writeTag(Tag::Array);
+            writeVarint(array.size());
+            for (const auto& v : array)
+                write(v);
+        }
+
+        template <typename T>
+        static bool allOf(const ConfigValue::Array& array)
+        {
+            for (const auto& v : array)
+                if (!v.get_if<T>())
+                    return false;
+            return true;
+        }
+
+        static bool isFloatMatrix(const ConfigValue::Array& array)
+        {
+            const auto *first = array[0].get_if<ConfigValue::Array>();
+            if (first == nullptr || first->empty())
+                return false;
+
+            for (const auto& row : array)
+            {
+                const auto *r = row.get_if<ConfigValue::Array>();
+                if (r == nullptr || r->size() != first->size() || !allOf<ConfigValue::Float>(*r))
+                    return false;
+            }
+            return true;
+        }
+
+        void writeTag(Tag tag) { out_.push_back(static_cast<char>(tag)); }
+
+        void writeVarint(uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                out_.push_back(static_cast<char>((v & 0x7f) | 0x80));
+                v >>= 7;
+            }
+            out_.push_back(static_cast<char>(v));
+        }
+
+        void writeString(const std::string& s)
+        {
+            writeVarint(s.size());
+            out_.append(s);
+        }
+
+        void writeRaw(const void *data, size_t size)
+        {
+            out_.append(reinterpret_cast<const char*>(data), size);
+        }
+
+        std::string out_;
+    };
+
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const char *data, size_t size) :
+            cur_(data),
+            end_(data + size)
+        {}
+
+        ConfigValue parse()
+        {
+            if (static_cast<size_t>(end_ - cur_) < sizeof(kBinaryMagic) + 1 ||
+                memcmp(cur_, kBinaryMagic, sizeof(kBinaryMagic)) != 0)
+                die("Not a binary config: invalid header.");
+            cur_ += sizeof(kBinaryMagic);
+
+            const auto version = static_cast<uint8_t>(*cur_++);
+            if (version != kBinaryVersion)
+                die("Unsupported binary config version %d (expected %d).", version, kBinaryVersion);
+
+            ConfigValue value = read();
+            if (cur_ != end_)
+                die("Unexpected %zu trailing bytes in binary config.", static_cast<size_t>(end_ - cur_));
+            return value;
+        }
+
+    private:
+        ConfigValue read()
+        {
+            const auto tag = static_cast<Tag>(readByte());
+            switch (tag)
+            {
+            case Tag::Int:
+            {
+                const uint64_t u = readVarint();
+                return static_cast<ConfigValue::Int>((u >> 1) ^ (~(u & 1) + 1));
+            }
+            case Tag::Float:
+                return readScalar<ConfigValue::Float>();
+            case Tag::String:
+                return readString();
+            case Tag::Object:
+            {
+                const size_t n = readVarint();
+                ConfigValue::Object object;
+                object.reserve(n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    std::string key = readString();
+                    object.unsafe_insert(std::move(key), read());
+                }
+                return ConfigValue{std::move(object)};
+            }
+            case Tag::Array:
+            {
+                const size_t n = readVarint();
+                ConfigValue::Array array;
+                array.reserve(n);
+                for (size_t i = 0; i < n; ++i)
+                    array.push_back(read());
+                return ConfigValue{std::move(array)};
+            }
+            case Tag::IntBlob:
+                return readBlob<ConfigValue::Int>(readVarint());
+            case Tag::FloatBlob:
+                return readBlob<ConfigValue::Float>(readVarint());
+            case Tag::FloatMatrix:
+            {
+                const size_t rows = readVarint();
+                const size_t cols = readVarint();
+                ConfigValue::Array array;
+                array.reserve(rows);
+                for (size_t i = 0; i < rows; ++i)
+                    array.push_back(readBlob<ConfigValue::Float>(cols));
+                return ConfigValue{std::move(array)};
+            }
+            }
+            die("Unknown tag %d in binary config.", static_cast<int>(tag));
+        }
+
+        template <typename T>
+        ConfigValue readBlob(size_t n)
+        {
+            require(n * sizeof(T));
+
+            ConfigValue::Array array;
+            array.reserve(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                T v;
+                memcpy(&v, cur_ + i * sizeof(T), sizeof(T));
+                array.push_back(v);
+            }
+            cur_ += n * sizeof(T);
+            return ConfigValue{std::move(array)};
+        }
+
+        template <typename T>
+        T readScalar()
+        {
+            require(sizeof(T));
+            T v;
+            memcpy(&v, cur_, sizeof(T));
+            cur_ += sizeof(T);
+            return v;
+        }
+
+        std::string readString()
+        {
+            const size_t n = readVarint();
+            require(n);
+            std::string s(cur_, cur_ + n);
+            cur_ += n;
+            return s;
+        }
+
+        uint8_t readByte()
+        {
+            require(1);
+            return static_cast<uint8_t>(*cur_++);
+        }
+
+        uint64_t readVarint()
+        {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                const uint8_t b = readByte();
+                v |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if ((b & 0x80) == 0)
+                    return v;
+            }
+            die("Invalid varint in binary config.");
+        }
+
+        void require(size_t n) const
+        {
+            if (static_cast<size_t>(end_ - cur_) < n)
+                die("Unexpected end of binary config.");
+        }
+
+        const char *cur_;
+        const char *end_;
+    };
+} // anonymous namespace
+
+std::string configToBinary(const ConfigValue& config)
+{
+    return BinaryWriter{}.finalize(config);
+}
+
+ConfigValue configFromBinary(const std::string& data)
+{
+    return BinaryReader{data.data(), data.size()}.parse();
+}
+
+ConfigValue configFromBinaryFile(const std::string& filename)
+{
+    return configFromBinary(readWholeFile(filename));
+}
+
+const char* getConfigFileName(ConfigFormat format)
+{
+    return format == ConfigFormat::Binary ? "config.bin" : "config.json";
+}
+
+} // namespace mirheo
@@ -0,0 +1,63 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace mirheo
+{
+
+/** \brief Conversion between real numbers and 64-bit fixed-point integers.
+
+    Integer addition is associative, hence sums of fixed-point numbers do not depend
+    on the order in which the terms are added.
+    This is used to accumulate forces deterministically with atomic operations
+    (see MIRHEO_DETERMINISTIC_FORCES).
+
+    The values are stored with fractionalBits bits after the binary point:
+    the resolution is about 2.3e-10 and the largest representable magnitude about 2.1e9.
+ */
+namespace fixed_point
+{
+
+constexpr int fractionalBits = 32; ///< number of bits after the binary point
+constexpr double scale    = 4294967296.0;       ///< 2^fractionalBits
+constexpr double invScale = 1.0 / 4294967296.0; ///< 2^-fractionalBits
+
+/// \return the fixed-point representation of \p x, rounded to the nearest representable value
+__HD__ inline int64_t fromReal(double x)
+{
+    return static_cast<int64_t>(::llrint(x * scale));
+}
+
+/// \return the real number represented by \p v
+__HD__ inline double toReal(int64_t v)
+{
+    return static_cast<double>(v) * invScale;
+}
+
+/// \return the real vector represented by the fixed-point components
+__HD__ inline real3 toReal3(int64_t x, int64_t y, int64_t z)
+{
+    return {static_cast<real>(toReal(x)),
+            static_cast<real>(toReal(y)),
+            static_cast<real>(toReal(z))};
+}
+
+#ifdef __CUDACC__
+/// Atomically add \p x to the fixed-point number stored at \p addr.
+__device__ inline void atomicAdd(int64_t *addr, real x)
+{
+    // two's complement: the unsigned addition gives the correct signed result
+    using ull = unsigned long long;
+    static_assert(sizeof(int64_t) == sizeof(ull), "unexpected size of int64_t");
+    ::atomicAdd(reinterpret_cast<ull*>(addr), static_cast<ull>(fromReal(static_cast<double>(x))));
+}
+#endif // __CUDACC__
+
+} // namespace fixed_point
+
+} // namespace mirheo
@@ -0,0 +1,88 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+
+#include <cstdint>
+
+namespace mirheo
+{
+
+/** \brief Conversions from and to IEEE half precision numbers, usable on host and device.
+
+    Half precision numbers have 11 significant bits: the relative error of a conversion is at most 2^-11.
+ */
+namespace half_precision
+{
+
+/// \return the IEEE half precision representation of \p f, rounded to nearest even
+__HD__ inline uint16_t floatToHalf(float f)
+{
+    union {float f; uint32_t u;} b {f};
+    const uint32_t sign = (b.u >> 16) & 0x8000u;
+    const uint32_t a = b.u & 0x7fffffffu;
+
+    if (a > 0x7f800000u) return static_cast<uint16_t>(sign | 0x7e00u); // NaN
+    if (a >= 0x477ff000u) return static_cast<uint16_t>(sign | 0x7c00u); // rounds to infinity
+    if (a < 0x33000000u) return static_cast<uint16_t>(sign);            // rounds to zero
+
+    if (a < 0x38800000u) // subnormal half
+    {
+        const uint32_t m = (a & 0x7fffffu) | 0x800000u;
+        const uint32_t shift = 126u - (a >> 23);
+        const uint32_t rem  = m & ((1u << shift) - 1u);
+        const uint32_t half = 1u << (shift - 1u);
+        uint32_t h = m >> shift;
+        if (rem > half || (rem == half && (h & 1u)))
+            ++h;
+        return static_cast<uint16_t>(sign | h);
+    }
+
+    const uint32_t rounded = a + 0xfffu + ((a >> 13) & 1u);
+    return static_cast<uint16_t>(sign | ((rounded - 0x38000000u) >> 13));
+}
+
+/// \return the single precision value of the IEEE half precision number \p h
+__HD__ inline float halfToFloat(uint16_t h)
+{
+    const uint32_t sign = (static_cast<uint32_t>(h) & 0x8000u) << 16;
+    const uint32_t e    = (h >> 10) & 0x1fu;
+    const uint32_t m    =  h & 0x3ffu;
+
+    union {uint32_t u; float f;} b {0};
+
+    if (e == 0)
+    {
+        const float v = static_cast<float>(m) * 5.9604644775390625e-8f; // 2^-24
+        return sign ? -v : v;
+    }
+
+    if (e == 31)
+        b.u = sign | 0x7f800000u | (m << 13);
+    else
+        b.u = sign | ((e + 112u) << 23) | (m << 13);
+
+    return b.f;
+}
+
+/// \return the three components of \p v in half precision, packed in the lowest 48 bits
+__HD__ inline int64_t packHalf3(real3 v)
+{
+    const uint64_t x = floatToHalf(static_cast<float>(v.x));
+    const uint64_t y = floatToHalf(static_cast<float>(v.y));
+    const uint64_t z = floatToHalf(static_cast<float>(v.z));
+    return static_cast<int64_t>(x | (y << 16) | (z << 32));
+}
+
+/// \return the vector packed with packHalf3()
+__HD__ inline real3 unpackHalf3(int64_t packed)
+{
+    const uint64_t u = static_cast<uint64_t>(packed);
+    return {static_cast<real>(halfToFloat(static_cast<uint16_t>( u        & 0xffffu))),
+            static_cast<real>(halfToFloat(static_cast<uint16_t>((u >> 16) & 0xffffu))),
+            static_cast<real>(halfToFloat(static_cast<uint16_t>((u >> 32) & 0xffffu)))};
+}
+
+} // namespace half_precision
+} // namespace mirheo
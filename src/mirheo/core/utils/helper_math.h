@@ -58,6 +58,9 @@ static inline __HD__ double floor(double x) {return ::floor (x);}
 static inline __HD__ float  exp(float x)  {return ::expf(x);}
 static inline __HD__ double exp(double x) {return ::exp (x);}
 
+static inline __HD__ float  log(float x)  {return ::logf(x);}
+static inline __HD__ double log(double x) {return ::log (x);}
+
 static inline __HD__ float  cos(float x)  {return ::cosf(x);}
 static inline __HD__ double cos(double x) {return ::cos (x);}
 
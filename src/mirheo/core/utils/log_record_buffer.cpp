@@ -0,0 +1,29 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "log_record_buffer.h"
+
+#include <stdexcept>
+
+namespace mirheo
+{
+
+static bool isPowerOfTwo(int n)
+{
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+LogRecordBuffer::LogRecordBuffer(int capacity) :
+    mask_(capacity - 1)
+{
+    // the logger may not be available here, so we do not use die()
+    if (!isPowerOfTwo(capacity))
+        throw std::invalid_argument("LogRecordBuffer: capacity must be a power of 2");
+
+    slots_ = std::make_unique<Slot[]>(static_cast<size_t>(capacity));
+
+    for (int i = 0; i < capacity; ++i)
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+LogRecordBuffer::~LogRecordBuffer() = default;
+
+} // namespace mirheo
@@ -0,0 +1,140 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace mirheo
+{
+
+/** \brief A single log entry, as stored in LogRecordBuffer.
+
+    The key and filename are not copied: they must point to strings with static storage
+    (typically string literals and __FILE__).
+ */
+struct LogRecord
+{
+    static constexpr int maxMessageLength = 496; ///< maximum number of characters in the message, including the null character
+
+    int64_t timeMs;       ///< time since epoch in milliseconds
+    const char *key;      ///< importance string, e.g. "INFO"
+    const char *filename; ///< source file that created the record
+    int line;             ///< line in the source file
+    int length;           ///< number of characters in message, excluding the null character
+    char message[maxMessageLength]; ///< the formatted message
+};
+
+/** \brief Bounded lock-free queue of LogRecord objects with multiple producers and a single consumer.
+
+    Implementation of the bounded queue from D. Vyukov: each slot holds a sequence number
+    which tells producers and the consumer whether it is free or filled.
+    Producers never block; they get notified when the queue is full and must retry later.
+ */
+class LogRecordBuffer
+{
+public:
+    /** \brief Construct an empty buffer.
+        \param capacity Maximum number of records in the queue. Must be a power of 2.
+     */
+    explicit LogRecordBuffer(int capacity);
+    ~LogRecordBuffer();
+
+    LogRecordBuffer           (const LogRecordBuffer&) = delete;
+    LogRecordBuffer& operator=(const LogRecordBuffer&) = delete;
+
+    /// \return The maximum number of records that can be stored.
+    int capacity() const {return mask_ + 1;}
+
+    /// \return An estimate of the number of records currently stored.
+    int size() const
+    {
+        const int64_t n = enqueuePos_.load(std::memory_order_relaxed) - dequeuePos_.load(std::memory_order_relaxed);
+        return static_cast<int>(n > 0 ? n : 0);
+    }
+
+    /** \brief Reserve a slot, fill it and publish it.
+        \param fill A callable with signature void(LogRecord&) that fills the record in place.
+        \return \c false if the queue was full; in that case \p fill is not called.
+
+        Can be called concurrently by multiple threads.
+     */
+    template <class Fill>
+    bool tryPush(Fill&& fill)
+    {
+        int64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Slot *slot;
+
+        while (true)
+        {
+            slot = &slots_[pos & mask_];
+            const int64_t seq = slot->sequence.load(std::memory_order_acquire);
+            const int64_t diff = seq - pos;
+
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(slot->record);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** \brief Pop all records that have been published, in order.
+        \param consume A callable with signature void(const LogRecord&).
+        \return The number of records consumed.
+
+        Must be called by a single thread at a time.
+     */
+    template <class Consume>
+    int popAll(Consume&& consume)
+    {
+        int n = 0;
+        int64_t pos = dequeuePos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Slot& slot = slots_[pos & mask_];
+            const int64_t seq = slot.sequence.load(std::memory_order_acquire);
+
+            if (seq != pos + 1)
+                break; // empty, or the producer has not finished writing this slot yet
+
+            consume(slot.record);
+            slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+            ++pos;
+            ++n;
+        }
+
+        dequeuePos_.store(pos, std::memory_order_relaxed);
+        return n;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<int64_t> sequence;
+        LogRecord record;
+    };
+
+    const int mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // keep producers and consumer positions on separate cache lines
+    std::atomic<int64_t> enqueuePos_ {0};
+    char padding_[64];
+    std::atomic<int64_t> dequeuePos_ {0};
+};
+
+} // namespace mirheo
@@ -0,0 +1,57 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "mapped_file.h"
+
+#include <mirheo/core/logger.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mirheo
+{
+
+MappedFile::MappedFile(const std::string& fileName)
+{
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1)
+        die("Could not open file '%s': %s", fileName.c_str(), strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+    {
+        const int err = errno;
+        close(fd);
+        die("Could not stat file '%s': %s", fileName.c_str(), strerror(err));
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+
+    // mmap does not accept empty mappings; an empty file is represented by a null pointer.
+    if (size_ > 0)
+    {
+        void *ptr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        const int err = errno;
+        close(fd);
+
+        if (ptr == MAP_FAILED)
+            die("Could not map file '%s': %s", fileName.c_str(), strerror(err));
+
+        madvise(ptr, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(ptr);
+    }
+    else
+    {
+        close(fd);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+        munmap(const_cast<char*>(data_), size_);
+}
+
+} // namespace mirheo
@@ -0,0 +1,37 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace mirheo
+{
+
+/** \brief RAII wrapper around a file mapped in memory in read-only mode.
+
+    Used to parse large input files without going through streams.
+ */
+class MappedFile
+{
+public:
+    /** \brief Map the whole file in memory.
+        \param fileName The path to the file.
+
+        Dies if the file can not be opened or mapped.
+     */
+    MappedFile(const std::string& fileName);
+    ~MappedFile();
+
+    MappedFile           (const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char *data() const {return data_;} ///< \return Pointer to the beginning of the file content
+    const char *end()  const {return data_ + size_;} ///< \return Pointer past the end of the file content
+    size_t size() const {return size_;}      ///< \return The size of the file in bytes
+
+private:
+    const char *data_ {nullptr};
+    size_t size_ {0};
+};
+
+} // namespace mirheo
@@ -0,0 +1,111 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/logger.h>
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace mirheo
+{
+
+/** \brief A function of the position, that can be evaluated on one point or on a batch of points.
+
+    It is constructed either from a point-wise function or from a batch function.
+    The batch interface allows to evaluate many points with a single call, e.g. to a vectorized python function.
+    A point-wise function is evaluated in a loop when called on a batch, and a batch function with a single point
+    when called on one position.
+
+    \tparam T The type of the value of the function.
+ */
+template <typename T>
+class PositionFunction
+{
+public:
+    /// A function that is evaluated on a single position
+    using PointFunction = std::function<T(real3)>;
+
+    /// A function that is evaluated on \p n positions at once: values[i] = f(positions[i])
+    using BatchFunction = std::function<void(const real3 *positions, int n, T *values)>;
+
+    /// Construct an empty function, that can not be evaluated
+    PositionFunction() = default;
+
+    /// Construct from a point-wise function
+    PositionFunction(PointFunction func) :
+        pointFunc_(std::move(func))
+    {}
+
+    /// Construct from a batch function
+    PositionFunction(BatchFunction func) :
+        batchFunc_(std::move(func))
+    {}
+
+    /// Construct from a callable object with the signature of PointFunction
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same<std::decay_t<F>, PositionFunction>::value>,
+              typename = decltype(T(std::declval<const F&>()(std::declval<real3>())))>
+    PositionFunction(F func) :
+        pointFunc_(std::move(func))
+    {}
+
+    /// \return \c true if the function was constructed from a BatchFunction
+    bool isBatched() const {return static_cast<bool>(batchFunc_);}
+
+    /// \return \c true if the function can be evaluated
+    explicit operator bool() const {return pointFunc_ || batchFunc_;}
+
+    /// \return the value of the function at position \p r
+    T operator()(real3 r) const
+    {
+        if (pointFunc_)
+            return pointFunc_(r);
+
+        _checkBatch();
+        T value;
+        batchFunc_(&r, 1, &value);
+        return value;
+    }
+
+    /** \brief Evaluate the function at \p n positions.
+        \param [in] positions The positions
+        \param [in] n The number of positions
+        \param [out] values The values of the function at \p positions; must have space for \p n elements
+     */
+    void operator()(const real3 *positions, int n, T *values) const
+    {
+        if (n <= 0)
+            return;
+
+        if (batchFunc_)
+        {
+            batchFunc_(positions, n, values);
+            return;
+        }
+
+        _checkPoint();
+        for (int i = 0; i < n; ++i)
+            values[i] = pointFunc_(positions[i]);
+    }
+
+private:
+    void _checkBatch() const
+    {
+        if (!batchFunc_)
+            die("Evaluating an empty position function");
+    }
+
+    void _checkPoint() const
+    {
+        if (!pointFunc_)
+            die("Evaluating an empty position function");
+    }
+
+private:
+    PointFunction pointFunc_;
+    BatchFunction batchFunc_;
+};
+
+} // namespace mirheo
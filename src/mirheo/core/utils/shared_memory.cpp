@@ -0,0 +1,123 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "shared_memory.h"
+
+#include <mirheo/core/logger.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace mirheo
+{
+
+SharedMemorySegment::SharedMemorySegment() = default;
+
+SharedMemorySegment SharedMemorySegment::create(const std::string& name, size_t sizeInBytes)
+{
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd == -1)
+        die("Could not create shared memory segment '%s': %s", name.c_str(), strerror(errno));
+
+    if (ftruncate(fd, static_cast<off_t>(sizeInBytes)) == -1)
+    {
+        const int err = errno;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        die("Could not resize shared memory segment '%s' to %zu bytes: %s",
+            name.c_str(), sizeInBytes, strerror(err));
+    }
+
+    void *ptr = mmap(nullptr, sizeInBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (ptr == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        die("Could not map shared memory segment '%s': %s", name.c_str(), strerror(errno));
+    }
+
+    SharedMemorySegment segment;
+    segment.name_  = name;
+    segment.data_  = static_cast<char*>(ptr);
+    segment.size_  = sizeInBytes;
+    segment.owner_ = true;
+    return segment;
+}
+
+SharedMemorySegment SharedMemorySegment::open(const std::string& name, size_t sizeInBytes, bool unlink)
+{
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd == -1)
+        die("Could not open shared memory segment '%s': %s", name.c_str(), strerror(errno));
+
+    void *ptr = mmap(nullptr, sizeInBytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (ptr == MAP_FAILED)
+        die("Could not map shared memory segment '%s': %s", name.c_str(), strerror(errno));
+
+    if (unlink)
+        shm_unlink(name.c_str());
+
+    SharedMemorySegment segment;
+    segment.name_  = name;
+    segment.data_  = static_cast<char*>(ptr);
+    segment.size_  = sizeInBytes;
+    segment.owner_ = false;
+    return segment;
+}
+
+size_t SharedMemorySegment::computeCapacity(size_t sizeInBytes)
+{
+    // grow geometrically
+    const size_t margin = sizeInBytes / 2 + 4096;
+
+    if (sizeInBytes > std::numeric_limits<size_t>::max() - margin)
+        die("Shared memory segment too large: %zu bytes", sizeInBytes);
+
+    return sizeInBytes + margin;
+}
+
+SharedMemorySegment::~SharedMemorySegment()
+{
+    close();
+}
+
+SharedMemorySegment::SharedMemorySegment(SharedMemorySegment&& other)
+{
+    std::swap(name_,  other.name_);
+    std::swap(data_,  other.data_);
+    std::swap(size_,  other.size_);
+    std::swap(owner_, other.owner_);
+}
+
+SharedMemorySegment& SharedMemorySegment::operator=(SharedMemorySegment&& other)
+{
+    std::swap(name_,  other.name_);
+    std::swap(data_,  other.data_);
+    std::swap(size_,  other.size_);
+    std::swap(owner_, other.owner_);
+    return *this;
+}
+
+void SharedMemorySegment::close()
+{
+    if (data_ != nullptr)
+        munmap(data_, size_);
+
+    // the reader may already have unlinked the name; errors are not relevant here
+    if (owner_)
+        shm_unlink(name_.c_str());
+
+    name_.clear();
+    data_  = nullptr;
+    size_  = 0;
+    owner_ = false;
+}
+
+} // namespace mirheo
@@ -0,0 +1,68 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace mirheo
+{
+
+/** \brief RAII wrapper around a named POSIX shared memory segment.
+
+    The segment is created by one process (the owner) and mapped by another one
+    running on the same node, given the name of the segment.
+    Used to transfer data between processes without going through MPI.
+ */
+class SharedMemorySegment
+{
+public:
+    /// Default constructor; does not map anything.
+    SharedMemorySegment();
+
+    /** \brief Create a new segment and map it in read-write mode.
+        \param name The unique name of the segment; must start with '/'.
+        \param sizeInBytes The size of the segment.
+
+        Dies if a segment with the same name already exists.
+     */
+    static SharedMemorySegment create(const std::string& name, size_t sizeInBytes);
+
+    /** \brief Map an existing segment in read-only mode.
+        \param name The name of the segment, as passed to create().
+        \param sizeInBytes The size of the segment, as passed to create().
+        \param unlink If \c true, remove the name of the segment from the system once it is mapped.
+               The memory stays valid until all mappings are released.
+     */
+    static SharedMemorySegment open(const std::string& name, size_t sizeInBytes, bool unlink);
+
+    /** \brief Compute the size of a segment that can hold a message of the given size.
+        \param sizeInBytes The size of the message.
+        \return A capacity larger than \p sizeInBytes, with some margin so that the segment
+                 does not need to be recreated at every small size change.
+     */
+    static size_t computeCapacity(size_t sizeInBytes);
+
+    ~SharedMemorySegment();
+
+    SharedMemorySegment           (const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    SharedMemorySegment           (SharedMemorySegment&&); ///< move constructor
+    SharedMemorySegment& operator=(SharedMemorySegment&&); ///< move assignment
+
+    /// Unmap the segment, and unlink its name if this object created it.
+    void close();
+
+    char       *data()       {return data_;} ///< \return Pointer to the mapped memory
+    const char *data() const {return data_;} ///< \return Pointer to the mapped memory
+    size_t size() const {return size_;}      ///< \return The size of the mapped memory in bytes
+    const std::string& getName() const {return name_;} ///< \return The name of the segment
+
+private:
+    std::string name_;
+    char *data_ {nullptr};
+    size_t size_ {0};
+    bool owner_ {false};
+};
+
+} // namespace mirheo
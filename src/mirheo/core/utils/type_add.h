@@ -27,6 +27,18 @@ __D__ inline void _add(T *v, T s, real eps)
     }
 }
 
+__D__ inline void _addInt64(int64_t *v, int64_t s)
+{
+    if (s != 0)
+    {
+#ifdef __CUDACC__
+        atomicAdd(reinterpret_cast<unsigned long long*>(v), static_cast<unsigned long long>(s));
+#else
+        *v += s;
+#endif // __CUDACC__
+    }
+}
+
 template <typename T3>
 __D__ inline void _addVect3(T3 *addr, T3 s, real eps)
 {
@@ -43,6 +55,7 @@ __D__ inline void apply(__UNUSED T *addr, __UNUSED T s, __UNUSED const real eps
 
 __D__ inline void apply(float  *addr, float  s, real eps = 0._r) {details::_add(addr, s, eps);}
 __D__ inline void apply(double *addr, double s, real eps = 0._r) {details::_add(addr, s, eps);}
+__D__ inline void apply(int64_t *addr, int64_t s, __UNUSED real eps = 0._r) {details::_addInt64(addr, s);} // fixed-point forces
 __D__ inline void apply(Force  *addr, Force  s, real eps = 0._r) {details::_addVect3(&addr->f, s.f, eps);}
 
 __D__ inline void apply(Stress *addr, Stress s, real eps = 0._r)
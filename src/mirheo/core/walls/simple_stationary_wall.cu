@@ -291,7 +291,7 @@ template<class InsideWallChecker>
 void SimpleStationaryWall<InsideWallChecker>::setPrerequisites(ParticleVector *pv)
 {
     // do not set it to persistent because bounce happens after integration
-    pv->requireDataPerParticle<real4> (channel_names::oldPositions, DataManager::PersistenceMode::None, DataManager::ShiftMode::Active);
+    pv->requireOldPositions(DataManager::PersistenceMode::None, DataManager::ShiftMode::Active);
 }
 
 template<class InsideWallChecker>
@@ -0,0 +1,141 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "aggregated_writer.h"
+#include "grids.h"
+#include "xdmf.h"
+
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/path.h>
+
+#include <limits>
+
+namespace mirheo
+{
+
+namespace XDMF
+{
+
+AggregatedVertexWriter::AggregatedVertexWriter(MPI_Comm comm, int ranksPerAggregator, bool subfiling, IOHints hints) :
+    subfiling_(subfiling),
+    hints_(std::move(hints)),
+    positions_(std::make_shared<std::vector<real3>>())
+{
+    if (ranksPerAggregator < 1)
+        die("The number of ranks per aggregator must be positive, got %d", ranksPerAggregator);
+
+    int rank, size;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
+    MPI_Check( MPI_Comm_size(comm, &size) );
+
+    aggregatorId_ = rank / ranksPerAggregator;
+    nAggregators_ = (size + ranksPerAggregator - 1) / ranksPerAggregator;
+    isAggregator_ = (rank % ranksPerAggregator == 0);
+
+    MPI_Check( MPI_Comm_split(comm, aggregatorId_, rank, groupComm_.reset_and_get_address()) );
+    MPI_Check( MPI_Comm_split(comm, isAggregator_ ? 0 : MPI_UNDEFINED, rank, aggregatorsComm_.reset_and_get_address()) );
+
+    debug("Aggregated I/O: %d aggregators for %d ranks, subfiling %s",
+          nAggregators_, size, subfiling_ ? "on" : "off");
+}
+
+bool AggregatedVertexWriter::isAggregator() const
+{
+    return isAggregator_;
+}
+
+int AggregatedVertexWriter::getNumAggregators() const
+{
+    return nAggregators_;
+}
+
+std::string AggregatedVertexWriter::_subfileName(const std::string& filename, int aggregatorId) const
+{
+    return filename + "_sub" + createStrZeroPadded(aggregatorId);
+}
+
+void AggregatedVertexWriter::write(const std::string& filename, const std::vector<real3>& positions,
+                                   const std::vector<Channel>& channels, MirState::TimeType time)
+{
+    MPI_Comm groupComm = groupComm_;
+
+    int groupSize;
+    MPI_Check( MPI_Comm_size(groupComm, &groupSize) );
+
+    // 1. gather the data of the group on the aggregator
+    const int nLocal = static_cast<int>(positions.size());
+
+    counts_           .resize(groupSize);
+    byteCounts_       .resize(groupSize);
+    byteDisplacements_.resize(groupSize);
+    MPI_Check( MPI_Gather(&nLocal, 1, MPI_INT, counts_.data(), 1, MPI_INT, 0, groupComm) );
+
+    long long nTotal = 0;
+    if (isAggregator_)
+        for (auto c : counts_)
+            nTotal += c;
+
+    auto gather = [&](const void *src, int elementSize, void *dst)
+    {
+        if (isAggregator_)
+        {
+            if (nTotal * elementSize > std::numeric_limits<int>::max())
+                die("Aggregated I/O: too much data for one aggregator (%lld bytes); "
+                    "use fewer ranks per aggregator", nTotal * elementSize);
+
+            int displacement = 0;
+            for (int i = 0; i < groupSize; ++i)
+            {
+                byteCounts_[i] = counts_[i] * elementSize;
+                byteDisplacements_[i] = displacement;
+                displacement += byteCounts_[i];
+            }
+        }
+
+        MPI_Check( MPI_Gatherv(src, nLocal * elementSize, MPI_BYTE,
+                               dst, byteCounts_.data(), byteDisplacements_.data(), MPI_BYTE,
+                               0, groupComm) );
+    };
+
+    positions_->resize(static_cast<size_t>(nTotal));
+    gather(positions.data(), static_cast<int>(sizeof(real3)), positions_->data());
+
+    std::vector<Channel> gatheredChannels = channels;
+    channelData_.resize(channels.size());
+
+    for (size_t i = 0; i < channels.size(); ++i)
+    {
+        const int elementSize = channels[i].nComponents() * channels[i].precision();
+
+        channelData_[i].resize(static_cast<size_t>(nTotal * elementSize));
+        gather(channels[i].data, elementSize, channelData_[i].data());
+        gatheredChannels[i].data = channelData_[i].data();
+    }
+
+    if (!isAggregator_)
+        return;
+
+    // 2. only the aggregators write
+    if (subfiling_)
+    {
+        VertexGrid grid(positions_, MPI_COMM_SELF);
+        XDMF::write(_subfileName(filename, aggregatorId_), &grid, gatheredChannels, time, MPI_COMM_SELF, hints_);
+
+        if (aggregatorId_ == 0)
+        {
+            std::vector<std::string> pieces;
+            for (int i = 0; i < nAggregators_; ++i)
+                pieces.push_back(getBaseName(_subfileName(filename, i)) + ".xmf");
+
+            writeCollection(filename + ".xmf", pieces, time);
+        }
+    }
+    else
+    {
+        MPI_Comm aggregatorsComm = aggregatorsComm_;
+        VertexGrid grid(positions_, aggregatorsComm);
+        XDMF::write(filename, &grid, gatheredChannels, time, aggregatorsComm, hints_);
+    }
+}
+
+} // namespace XDMF
+
+} // namespace mirheo
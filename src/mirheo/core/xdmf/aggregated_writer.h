@@ -0,0 +1,83 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "channel.h"
+#include "io_hints.h"
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/mirheo_state.h>
+#include <mirheo/core/utils/unique_mpi_comm.h>
+
+#include <memory>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+namespace mirheo
+{
+
+namespace XDMF
+{
+
+/** \brief Dump vertex data in hdf5+xmf format through a subset of the ranks, the aggregators (two-phase I/O).
+
+    The ranks are split into groups of consecutive ranks.
+    The first rank of each group is the aggregator of the group: it gathers the data of the group and is the only
+    one that accesses the file system.
+
+    Without subfiling, the aggregators write a single shared file collectively, as XDMF::write() would do with all the
+    ranks; fewer ranks take part in the collective MPI-IO operations and in the file metadata updates.
+    With subfiling, each aggregator writes its own xmf + hdf5 pair independently; the first aggregator also writes a
+    master xmf file that references all the pieces.
+ */
+class AggregatedVertexWriter
+{
+public:
+    /** \brief Construct a AggregatedVertexWriter.
+        \param comm The communicator of all the ranks that contain data; this is a collective operation.
+        \param ranksPerAggregator The number of ranks in each group, including the aggregator.
+        \param subfiling If \c true, each aggregator writes its own file.
+        \param hints MPI-IO hints of the hdf5 files; the default hints are used if empty.
+     */
+    AggregatedVertexWriter(MPI_Comm comm, int ranksPerAggregator, bool subfiling, IOHints hints);
+
+    /// \return \c true if the current rank writes data to the file system
+    bool isAggregator() const;
+
+    /// \return The number of aggregators
+    int getNumAggregators() const;
+
+    /** \brief Dump particle data; this is a collective operation.
+        \param filename Base file name (without extension).
+               With subfiling, the pieces are named after it, with the index of the aggregator appended.
+        \param positions The positions of the local particles, in global coordinates.
+        \param channels The channels of the local particles, as in XDMF::write().
+        \param time A time stamp, useful when dumping sequences of files
+     */
+    void write(const std::string& filename, const std::vector<real3>& positions,
+               const std::vector<Channel>& channels, MirState::TimeType time);
+
+private:
+    /// \return the base file name of the piece written by the aggregator \p aggregatorId
+    std::string _subfileName(const std::string& filename, int aggregatorId) const;
+
+private:
+    bool subfiling_;
+    IOHints hints_;
+
+    int aggregatorId_;  ///< index of the group of the current rank
+    int nAggregators_;
+    bool isAggregator_;
+
+    UniqueMPIComm groupComm_;       ///< the ranks of the group of the current rank
+    UniqueMPIComm aggregatorsComm_; ///< the aggregators only; null on the other ranks
+
+    std::shared_ptr<std::vector<real3>> positions_; ///< gathered positions (aggregators only)
+    std::vector<std::vector<char>> channelData_;    ///< gathered channel data (aggregators only)
+    std::vector<int> counts_;                       ///< number of particles of each rank of the group (aggregators only)
+    std::vector<int> byteCounts_, byteDisplacements_; ///< work buffers for the gather operations
+};
+
+} // namespace XDMF
+
+} // namespace mirheo
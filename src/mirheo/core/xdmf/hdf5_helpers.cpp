@@ -15,7 +15,7 @@ namespace XDMF
 namespace HDF5
 {
 
-static hid_t createFileAccess(MPI_Comm comm)
+static hid_t createFileAccess(MPI_Comm comm, const IOHints& userHints)
 {
     int size;
     MPI_Check( MPI_Comm_size(comm, &size) );
@@ -24,7 +24,13 @@ static hid_t createFileAccess(MPI_Comm comm)
     const char* hints = getenv("MPICH_MPIIO_HINTS");
 
     MPI_Info info;
-    if (hints == nullptr || strlen(hints) < 1)
+    if (!userHints.empty())
+    {
+        MPI_Check( MPI_Info_create(&info) );
+        for (const auto& hint : userHints)
+            MPI_Check( MPI_Info_set(info, hint.first.c_str(), hint.second.c_str()) );
+    }
+    else if (hints == nullptr || strlen(hints) < 1)
     {
         // Collective buffers for mpi i/o
         int cb = 1;
@@ -48,12 +54,17 @@ static hid_t createFileAccess(MPI_Comm comm)
 
     hid_t plist_id_access = H5Pcreate(H5P_FILE_ACCESS);
     H5Pset_fapl_mpio(plist_id_access, comm, info);
+
+    // hdf5 keeps its own copy
+    if (info != MPI_INFO_NULL)
+        MPI_Check( MPI_Info_free(&info) );
+
     return plist_id_access;
 }
 
-hid_t create(const std::string& filename, MPI_Comm comm)
+hid_t create(const std::string& filename, MPI_Comm comm, const IOHints& hints)
 {
-    hid_t access_id = createFileAccess(comm);
+    hid_t access_id = createFileAccess(comm, hints);
     hid_t file_id   = H5Fcreate( filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, access_id );
     H5Pclose(access_id);
 
@@ -62,7 +73,7 @@ hid_t create(const std::string& filename, MPI_Comm comm)
 
 hid_t openReadOnly(const std::string& filename, MPI_Comm comm)
 {
-    hid_t access_id = createFileAccess(comm);
+    hid_t access_id = createFileAccess(comm, IOHints{});
     hid_t file_id   = H5Fopen( filename.c_str(), H5F_ACC_RDONLY, access_id );
     H5Pclose(access_id);
 
@@ -168,9 +179,10 @@ void close(hid_t file_id)
     H5Fclose(file_id);
 }
 
-void write(const std::string& filename, MPI_Comm comm, const Grid *grid, const std::vector<Channel>& channels)
+void write(const std::string& filename, MPI_Comm comm, const Grid *grid, const std::vector<Channel>& channels,
+           const IOHints& hints)
 {
-    auto file_id = create(filename, comm);
+    auto file_id = create(filename, comm, hints);
     if (file_id < 0)
     {
         if (file_id < 0) error("HDF5 failed to write to file '%s'", filename.c_str());
@@ -8,6 +8,7 @@
 #include <hdf5.h>
 
 #include "grids.h"
+#include "io_hints.h"
 
 namespace mirheo
 {
@@ -17,7 +18,7 @@ namespace XDMF
 namespace HDF5
 {
 
-hid_t create      (const std::string& filename, MPI_Comm comm);
+hid_t create      (const std::string& filename, MPI_Comm comm, const IOHints& hints = {});
 hid_t openReadOnly(const std::string& filename, MPI_Comm comm);
 
 void writeDataSet(hid_t file_id, const GridDims *gridDims, const Channel& channel);
@@ -29,7 +30,8 @@ void readData    (hid_t file_id, const GridDims *gridDims, std::vector<Channel>&
 void close       (hid_t file_id);
 
 
-void write(const std::string& filename, MPI_Comm comm, const Grid *grid, const std::vector<Channel>& channels);
+void write(const std::string& filename, MPI_Comm comm, const Grid *grid, const std::vector<Channel>& channels,
+           const IOHints& hints = {});
 void read (const std::string& filename, MPI_Comm comm, Grid *grid, std::vector<Channel>& channels);
 
 } // namespace HDF5
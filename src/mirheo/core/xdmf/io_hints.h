@@ -0,0 +1,21 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <map>
+#include <string>
+
+namespace mirheo
+{
+
+namespace XDMF
+{
+
+/** \brief MPI-IO hints (e.g. "cb_nodes", "striping_factor") passed to the hdf5 files, as key-value pairs.
+
+    When empty, the default hints are used, unless the environment variable MPICH_MPIIO_HINTS is set.
+ */
+using IOHints = std::map<std::string, std::string>;
+
+} // namespace XDMF
+
+} // namespace mirheo
@@ -18,7 +18,8 @@ namespace mirheo
 namespace XDMF
 {
 void write(const std::string& filename, const Grid *grid,
-           const std::vector<Channel>& channels, MirState::TimeType time, MPI_Comm comm)
+           const std::vector<Channel>& channels, MirState::TimeType time, MPI_Comm comm,
+           const IOHints& hints)
 {
     std::string h5Filename  = filename + ".h5";
     std::string xmfFilename = filename + ".xmf";
@@ -28,7 +29,7 @@ void write(const std::string& filename, const Grid *grid,
     mTimer timer;
     timer.start();
     XMF::write(xmfFilename, getBaseName(h5Filename), comm, grid, channels, time);
-    HDF5::write(h5Filename, comm, grid, channels);
+    HDF5::write(h5Filename, comm, grid, channels, hints);
     info("Writing took %f ms", timer.elapsed());
 }
 
@@ -39,6 +40,13 @@ void write(const std::string& filename, const Grid *grid,
     write(filename, grid, channels, arbitraryTime, comm);
 }
 
+void writeCollection(const std::string& filename, const std::vector<std::string>& xmfFilenames,
+                     MirState::TimeType time)
+{
+    debug("Writing XDMF collection of %zu files to %s", xmfFilenames.size(), filename.c_str());
+    XMF::writeCollection(filename, xmfFilenames, time);
+}
+
 inline long getLocalNumElements(const GridDims *gridDims)
 {
     long n = 1;
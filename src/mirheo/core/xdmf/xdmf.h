@@ -2,6 +2,7 @@
 #pragma once
 
 #include "grids.h"
+#include "io_hints.h"
 
 #include <mirheo/core/pvs/rigid_object_vector.h>
 
@@ -22,14 +23,27 @@ namespace XDMF
     \param channels A list of channel descriptions and associated data to dump
     \param time A time stamp, useful when dumping sequences of files
     \param comm MPI communicator shared by all ranks containing the data (simulation OR postprocess ranks)
+    \param hints MPI-IO hints of the hdf5 file; the default hints are used if empty
  */
 void write(const std::string& filename, const Grid *grid,
-           const std::vector<Channel>& channels, MirState::TimeType time, MPI_Comm comm);
+           const std::vector<Channel>& channels, MirState::TimeType time, MPI_Comm comm,
+           const IOHints& hints = {});
 
 /// \overload write()
 void write(const std::string& filename, const Grid *grid,
            const std::vector<Channel>& channels, MPI_Comm comm);
 
+/** \brief Write an xmf file that gathers the grids of several xmf files in a single spatial collection
+    \param filename The name of the collection file (with extension)
+    \param xmfFilenames The xmf files of the pieces, relative to the folder of \p filename
+    \param time A time stamp, useful when dumping sequences of files
+
+    The pieces are included with XInclude and are not read.
+    This is not a collective operation.
+ */
+void writeCollection(const std::string& filename, const std::vector<std::string>& xmfFilenames,
+                     MirState::TimeType time);
+
 /** \brief the data read by readVertexData()
 
     Represents particles data
@@ -71,6 +71,32 @@ void write(const std::string& filename, const std::string& h5filename, MPI_Comm
     MPI_Check( MPI_Barrier(comm) );
 }
 
+void writeCollection(const std::string& filename, const std::vector<std::string>& xmfFilenames,
+                     MirState::TimeType time)
+{
+    pugi::xml_document doc;
+    auto root = doc.append_child("Xdmf");
+    root.append_attribute("Version") = "3.0";
+    root.append_attribute("xmlns:xi") = "http://www.w3.org/2001/XInclude";
+    auto domain = root.append_child("Domain");
+
+    auto collection = domain.append_child("Grid");
+    collection.append_attribute("Name") = "collection";
+    collection.append_attribute("GridType") = "Collection";
+    collection.append_attribute("CollectionType") = "Spatial";
+
+    if (time > -1e-6) collection.append_child("Time").append_attribute("Value") = std::to_string(time).c_str();
+
+    for (const auto& xmfFilename : xmfFilenames)
+    {
+        auto include = collection.append_child("xi:include");
+        include.append_attribute("href") = xmfFilename.c_str();
+        include.append_attribute("xpointer") = "xpointer(//Xdmf/Domain/Grid)";
+    }
+
+    doc.save_file(filename.c_str());
+}
+
 inline Channel::NeedShift getNeedShiftValue(const std::string& str)
 {
     if      (str == "True" ) return Channel::NeedShift::True;
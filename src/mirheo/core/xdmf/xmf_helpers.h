@@ -26,6 +26,9 @@ void writeData   (pugi::xml_node node, const std::string& h5filename, const Grid
 void write(const std::string& filename, const std::string& h5filename, MPI_Comm comm,
            const Grid *grid, const std::vector<Channel>& channels, MirState::TimeType time);
 
+void writeCollection(const std::string& filename, const std::vector<std::string>& xmfFilenames,
+                     MirState::TimeType time);
+
 std::tuple<std::string /*h5filename*/, std::vector<Channel>>
 read(const std::string& filename, MPI_Comm comm, Grid *grid);
 
@@ -0,0 +1,150 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "adaptive_time_step.h"
+#include "utils/time_stamp.h"
+
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/views/pv.h>
+#include <mirheo/core/simulation.h>
+#include <mirheo/core/utils/config.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+namespace mirheo
+{
+
+namespace adaptive_time_step_kernels
+{
+
+/// Compute the maximum of the velocity and acceleration norms; the maxima must be non negative.
+__global__ void reduceMaxVelocityAcceleration(PVview view, float *maxima)
+{
+    const int tid = blockIdx.x * blockDim.x + threadIdx.x;
+
+    real vel = 0._r;
+    real acc = 0._r;
+
+    if (tid < view.size)
+    {
+        vel = length(make_real3(view.readVelocity(tid)));
+        acc = length(make_real3(view.forces[tid])) * view.invMass;
+    }
+
+    vel = warpReduce(vel, [](real a, real b) { return math::max(a, b); });
+    acc = warpReduce(acc, [](real a, real b) { return math::max(a, b); });
+
+    // non negative floats have the same order as their integer representation
+    if (laneId() == 0)
+    {
+        atomicMax((int*) &maxima[0], __float_as_int(static_cast<float>(vel)));
+        atomicMax((int*) &maxima[1], __float_as_int(static_cast<float>(acc)));
+    }
+}
+
+} // namespace adaptive_time_step_kernels
+
+
+AdaptiveTimeStepPlugin::AdaptiveTimeStepPlugin(const MirState *state, std::string name, std::vector<std::string> pvNames,
+                                               int checkEvery, real dtMin, real dtMax, real maxDisplacement, real hysteresis) :
+    SimulationPlugin(state, name),
+    pvNames_(std::move(pvNames)),
+    checkEvery_(checkEvery),
+    params_{dtMin, dtMax, maxDisplacement, hysteresis}
+{
+    if (dtMin <= 0.0_r || dtMax < dtMin)
+        die("Plugin '%s': invalid time step bounds [%g, %g]", getCName(), dtMin, dtMax);
+
+    if (maxDisplacement <= 0.0_r)
+        die("Plugin '%s': the maximum displacement must be positive, got %g", getCName(), maxDisplacement);
+
+    // the time step could never increase again without hysteresis
+    if (hysteresis <= 0.0_r)
+        die("Plugin '%s': the hysteresis must be positive, got %g", getCName(), hysteresis);
+}
+
+AdaptiveTimeStepPlugin::AdaptiveTimeStepPlugin(const MirState *state, Loader& loader, const ConfigObject& config) :
+    AdaptiveTimeStepPlugin{state, config["name"], loader.load<std::vector<std::string>>(config["pvNames"]),
+                           config["checkEvery"], config["dtMin"], config["dtMax"],
+                           config["maxDisplacement"], config["hysteresis"]}
+{}
+
+void AdaptiveTimeStepPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    SimulationPlugin::setup(simulation, comm, interComm);
+
+    simulation_ = simulation;
+
+    pvs_.clear();
+    for (const auto& pvName : pvNames_)
+        pvs_.push_back(simulation->getPVbyNameOrDie(pvName));
+
+    // the walls only bounce back particles that travel less than their maximum distance per step
+    for (auto pv : pvs_)
+    {
+        const real maxTravel = simulation->getMaxWallPartTravel(pv);
+        if (maxTravel < params_.maxDisplacement)
+        {
+            info("Plugin '%s': the maximum displacement is reduced from %g to %g to match the walls bouncing pv '%s'",
+                 getCName(), params_.maxDisplacement, maxTravel, pv->getCName());
+            params_.maxDisplacement = maxTravel;
+        }
+    }
+}
+
+void AdaptiveTimeStepPlugin::beforeCellLists(__UNUSED cudaStream_t stream)
+{
+    if (nextDt_ <= 0.0_r)
+        return;
+
+    if (nextDt_ != simulation_->getCurrentDt())
+    {
+        debug("Plugin '%s': time step changed from %g to %g", getCName(), simulation_->getCurrentDt(), nextDt_);
+        simulation_->setCurrentDt(nextDt_);
+    }
+
+    nextDt_ = -1.0_r;
+}
+
+void AdaptiveTimeStepPlugin::beforeIntegration(cudaStream_t stream)
+{
+    if (!isTimeEvery(getState(), checkEvery_)) return;
+
+    const int nthreads = 128;
+
+    maxima_.clearDevice(stream);
+
+    for (auto pv : pvs_)
+    {
+        PVview view(pv, pv->local());
+        SAFE_KERNEL_LAUNCH(
+            adaptive_time_step_kernels::reduceMaxVelocityAcceleration,
+            getNblocks(view.size, nthreads), nthreads, 0, stream,
+            view, maxima_.devPtr() );
+    }
+
+    maxima_.downloadFromDevice(stream, ContainersSynch::Synch);
+
+    // the time step must be the same on all ranks
+    float maxima[2] = {maxima_[0], maxima_[1]};
+    MPI_Check( MPI_Allreduce(MPI_IN_PLACE, maxima, 2, MPI_FLOAT, MPI_MAX, comm_) );
+
+    nextDt_ = time_step_controller::nextTimeStep(params_, getState()->getDt(), maxima[0], maxima[1]);
+}
+
+void AdaptiveTimeStepPlugin::saveSnapshotAndRegister(Saver& saver)
+{
+    saver.registerObject<AdaptiveTimeStepPlugin>(this, _saveSnapshot(saver, "AdaptiveTimeStepPlugin"));
+}
+
+ConfigObject AdaptiveTimeStepPlugin::_saveSnapshot(Saver& saver, const std::string& typeName)
+{
+    ConfigObject config = SimulationPlugin::_saveSnapshot(saver, typeName);
+    config.emplace("pvNames",         saver(pvNames_));
+    config.emplace("checkEvery",      saver(checkEvery_));
+    config.emplace("dtMin",           saver(params_.dtMin));
+    config.emplace("dtMax",           saver(params_.dtMax));
+    config.emplace("maxDisplacement", saver(params_.maxDisplacement));
+    config.emplace("hysteresis",      saver(params_.hysteresis));
+    return config;
+}
+
+} // namespace mirheo
@@ -0,0 +1,72 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "utils/time_step_controller.h"
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/plugins.h>
+
+#include <string>
+#include <vector>
+
+namespace mirheo
+{
+
+class ParticleVector;
+
+/** Adapt the time step of the simulation to the largest velocity and acceleration of the given particles.
+
+    Every few time steps, the maximum velocity and acceleration norms of the particles are reduced on the device
+    and over all ranks; the next time step is chosen with time_step_controller::nextTimeStep().
+
+    The new time step is applied at the beginning of the next time step, so that the forces and the integration
+    of a time step always use the same value.
+ */
+class AdaptiveTimeStepPlugin : public SimulationPlugin
+{
+public:
+    /** Create a AdaptiveTimeStepPlugin object.
+        \param [in] state The global state of the simulation.
+        \param [in] name The name of the plugin.
+        \param [in] pvNames The names of the ParticleVector s that limit the time step.
+        \param [in] checkEvery The time step is updated every this number of steps.
+        \param [in] dtMin The smallest allowed time step.
+        \param [in] dtMax The largest allowed time step.
+        \param [in] maxDisplacement The largest distance that a particle may travel in one time step.
+                     Reduced in setup() to the maximum travel allowed by the walls that bounce the particles.
+        \param [in] hysteresis The relative margin \f$ h \f$ used before increasing the time step; must be positive.
+     */
+    AdaptiveTimeStepPlugin(const MirState *state, std::string name, std::vector<std::string> pvNames,
+                           int checkEvery, real dtMin, real dtMax, real maxDisplacement, real hysteresis);
+
+    /// Load the plugin from a snasphot.
+    AdaptiveTimeStepPlugin(const MirState *state, Loader& loader, const ConfigObject& config);
+
+    void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void beforeCellLists(cudaStream_t stream) override;
+    void beforeIntegration(cudaStream_t stream) override;
+
+    bool needPostproc() override { return false; }
+
+    /// Create a \c ConfigObject describing the plugin state and register it in the saver.
+    void saveSnapshotAndRegister(Saver& saver) override;
+
+protected:
+    /// Implementation of snapshot saving. Reusable by potential derived classes.
+    ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
+
+private:
+    std::vector<std::string> pvNames_;
+    std::vector<ParticleVector*> pvs_;
+    Simulation *simulation_ {nullptr};
+
+    int checkEvery_;
+    time_step_controller::Parameters params_;
+
+    real nextDt_ {-1.0_r}; ///< time step to apply at the next step; negative if unchanged
+
+    /// maximum velocity and acceleration norms
+    PinnedBuffer<float> maxima_ {2};
+};
+
+} // namespace mirheo
@@ -44,6 +44,7 @@ public:
 
     void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
     void afterIntegration(cudaStream_t stream) override;
+    bool actsBeforeCellLists(const ParticleVector *pv) const override { return pv == pv_; }
     void serializeAndSend(cudaStream_t stream) override;
     void handshake() override;
 
@@ -33,14 +33,76 @@ __global__ void sample(PVview pvView, CellListInfo cinfo,
     sampling_helpers_kernels::sampleChannels(pid, cid, channelsInfo);
 }
 
+/** Segmented reduction over the cells of a primary cell list that has the same grid as the bins.
+    One thread per bin sums the particles that still belong to that cell.
+    The few particles that moved to another bin since the cell list was built are added with atomics.
+ */
+__global__ void sampleSorted(PVview pvView, CellListInfo cinfo,
+                             real *avgDensity, ChannelsInfo channelsInfo)
+{
+    const int cid = threadIdx.x + blockIdx.x*blockDim.x;
+    if (cid >= cinfo.totcells) return;
+
+    const int start = cinfo.cellStarts[cid];
+    const int end   = cinfo.cellStarts[cid+1];
+
+    int count = 0;
+
+    for (int pid = start; pid < end; ++pid)
+    {
+        const int binId = cinfo.getCellId(pvView.readPosition(pid));
+
+        if (binId == cid)
+        {
+            ++count;
+        }
+        else
+        {
+            atomicAdd(avgDensity + binId, 1.0_r);
+            sampling_helpers_kernels::sampleChannels(pid, binId, channelsInfo);
+        }
+    }
+
+    if (count == 0) return;
+
+    atomicAdd(avgDensity + cid, static_cast<real>(count));
+
+    for (int i = 0; i < channelsInfo.n; ++i)
+    {
+        const int nc = sampling_helpers_kernels::getNcomponents(channelsInfo.types[i]);
+        real sum[sampling_helpers_kernels::maxNcomponents] = {0.0_r};
+
+        for (int pid = start; pid < end; ++pid)
+        {
+            if (cinfo.getCellId(pvView.readPosition(pid)) != cid)
+                continue;
+
+            for (int c = 0; c < nc; ++c)
+                sum[c] += sampling_helpers_kernels::readComponent(channelsInfo, i, pid, c);
+        }
+
+        for (int c = 0; c < nc; ++c)
+            atomicAdd(channelsInfo.average[i] + nc * cid + c, sum[c]);
+    }
+}
+
+/// bin index of a position in local coordinates
+struct LocalBinIndex
+{
+    CellListInfo cinfo; ///< the bins
+
+    /// \return the bin index of \p r
+    __D__ int operator()(real3 r) const
+    {
+        return cinfo.getCellId(r);
+    }
+};
+
 } // namespace average_flow_kernels
 
 int Average3D::getNcomponents(Average3D::ChannelType type) const
 {
-    int components = 3;
-    if (type == Average3D::ChannelType::Scalar)  components = 1;
-    if (type == Average3D::ChannelType::Tensor6) components = 6;
-    return components;
+    return sampling_helpers_kernels::getNcomponents(type);
 }
 
 Average3D::Average3D(const MirState *state, std::string name,
@@ -157,18 +219,52 @@ void Average3D::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Co
     channelsInfo_.averagePtrs .uploadToDevice(defaultStream);
     channelsInfo_.types       .uploadToDevice(defaultStream);
 
+    // The particles of a PV with a primary cell list are already sorted by bin if the grids match.
+    // This excludes the in-place cell-lists of OVs (ObjectPrimaryCellList), sorted by object only.
+    for (auto pv : pvs_)
+    {
+        auto cl = dynamic_cast<PrimaryCellList*>(simulation->gelCellList(pv));
+
+        if (cl != nullptr &&
+            cl->ncells.x == resolution_.x &&
+            cl->ncells.y == resolution_.y &&
+            cl->ncells.z == resolution_.z)
+        {
+            debug("Plugin '%s' reuses the cell-list of pv '%s' for binning", getCName(), pv->getCName());
+            sortedCellLists_.push_back(cl);
+        }
+        else
+        {
+            sortedCellLists_.push_back(nullptr);
+        }
+    }
+
     info("Plugin '%s' initialized for the %zu PVs and channels %s, resolution %dx%dx%d",
          getCName(), pvs_.size(), allChannels.c_str(),
          resolution_.x, resolution_.y, resolution_.z);
 }
 
-void Average3D::sampleOnePv(ParticleVector *pv, cudaStream_t stream)
+void Average3D::sampleOnePv(ParticleVector *pv, PrimaryCellList *sortedCellList, cudaStream_t stream)
 {
     CellListInfo cinfo(binSize_, getState()->domain.localSize);
     PVview pvView(pv, pv->local());
     ChannelsInfo gpuInfo(channelsInfo_, pv, stream);
 
     const int nthreads = 128;
+
+    if (sortedCellList != nullptr)
+    {
+        SAFE_KERNEL_LAUNCH
+            (average_flow_kernels::sampleSorted,
+             getNblocks(cinfo.totcells, nthreads), nthreads, 0, stream,
+             pvView, sortedCellList->cellInfo(), numberDensity_.devPtr(), gpuInfo);
+        return;
+    }
+
+    if (trySamplePrivatized(pvView, average_flow_kernels::LocalBinIndex{cinfo}, cinfo.totcells,
+                            numberDensity_.devPtr(), channelsInfo_, gpuInfo, stream))
+        return;
+
     SAFE_KERNEL_LAUNCH
         (average_flow_kernels::sample,
          getNblocks(pvView.size, nthreads), nthreads, 0, stream,
@@ -211,8 +307,8 @@ void Average3D::afterIntegration(cudaStream_t stream)
 
     debug2("Plugin %s is sampling now", getCName());
 
-    for (auto& pv : pvs_)
-        sampleOnePv(pv, stream);
+    for (size_t i = 0; i < pvs_.size(); ++i)
+        sampleOnePv(pvs_[i], sortedCellLists_[i], stream);
 
     accumulateSampledAndClear(stream);
 
@@ -10,6 +10,7 @@ namespace mirheo
 {
 
 class ParticleVector;
+class PrimaryCellList;
 
 /** Average particles quantities into spacial bins over a cartesian grid and average it over time.
     Useful to compute e.g. velocity or density profiles.
@@ -80,12 +81,17 @@ protected:
 
     /** Perform the binning for all channels on one ParticleVector.
         \param [in] pv The ParticleVector to bin.
+        \param [in] sortedCellList A primary cell list of \p pv with the same grid as the bins, or \c nullptr.
         \param [in] stream The compute stream.
+
+        When \p sortedCellList is given, the particles are already sorted by bin and are reduced per cell.
+        Otherwise, the bins are privatised per block in shared memory if they fit, or updated with global atomics.
      */
-    void sampleOnePv(ParticleVector *pv, cudaStream_t stream);
+    void sampleOnePv(ParticleVector *pv, PrimaryCellList *sortedCellList, cudaStream_t stream);
 
 protected:
     std::vector<ParticleVector*> pvs_; ///< list of ParticleVector to collect bin information from.
+    std::vector<PrimaryCellList*> sortedCellLists_; ///< for each ParticleVector, its primary cell list if it matches the bins, nullptr otherwise.
 
     int nSamples_ {0}; ///< Current number of per time step samples.
     int sampleEvery_;  ///< Sample every this number of time steps.
@@ -103,8 +109,9 @@ protected:
 
     std::vector<char> sendBuffer_; ///< buffer used to communicate with postprocessing side.
 
+    static const std::string numberDensityChannelName_; ///< name of the number density, which is always sampled.
+
 private:
-    static const std::string numberDensityChannelName_;
     std::vector<std::string> pvNames_;
 };
 
@@ -38,6 +38,21 @@ __global__ void sampleRelative(
 
     sampling_helpers_kernels::sampleChannels(pid, cid, channelsInfo);
 }
+
+/// bin index of a position relative to a point, in periodic global bins
+struct RelativeBinIndex
+{
+    CellListInfo cinfo;  ///< the bins over the global domain
+    real3 relativePoint; ///< origin of the bins
+
+    /// \return the bin index of \p r
+    __D__ int operator()(real3 r) const
+    {
+        int3 cid3 = cinfo.getCellIdAlongAxes<CellListsProjection::NoClamp>(r - relativePoint);
+        cid3 = (cid3 + cinfo.ncells) % cinfo.ncells;
+        return cinfo.encode(cid3);
+    }
+};
 } // namespace average_relative_flow_kernels
 
 AverageRelative3D::AverageRelative3D(
@@ -99,6 +114,11 @@ void AverageRelative3D::sampleOnePv(real3 relativeParam, ParticleVector *pv, cud
     PVview pvView(pv, pv->local());
     ChannelsInfo gpuInfo(channelsInfo_, pv, stream);
 
+    const average_relative_flow_kernels::RelativeBinIndex binIndex {cinfo, relativeParam};
+
+    if (trySamplePrivatized(pvView, binIndex, cinfo.totcells, numberDensity_.devPtr(), channelsInfo_, gpuInfo, stream))
+        return;
+
     const int nthreads = 128;
     SAFE_KERNEL_LAUNCH
         (average_relative_flow_kernels::sampleRelative,
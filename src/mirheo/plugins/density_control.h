@@ -7,6 +7,7 @@
 #include <mirheo/core/containers.h>
 #include <mirheo/core/datatypes.h>
 #include <mirheo/core/utils/file_wrapper.h>
+#include <mirheo/core/utils/position_function.h>
 
 #include <functional>
 #include <memory>
@@ -29,7 +30,7 @@ class DensityControlPlugin : public SimulationPlugin
 {
 public:
     /// functor that describes the region in terms of level sets.
-    using RegionFunc = std::function<real(real3)>;
+    using RegionFunc = PositionFunction<real>;
 
     /** Create a DensityControlPlugin object.
         \param [in] state The global state of the simulation.
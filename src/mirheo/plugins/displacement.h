@@ -25,6 +25,7 @@ public:
     ~ParticleDisplacementPlugin();
 
     void afterIntegration(cudaStream_t stream) override;
+    bool actsBeforeCellLists(const ParticleVector *pv) const override { return pv == pv_; }
 
     void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
 
@@ -58,12 +58,15 @@ void MeshPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
 
     MirState::StepType timeStamp = getTimeStamp(getState(), dumpEvery_);
 
-    _waitPrevSend();
-    SimpleSerializer::serialize(sendBuffer_, timeStamp, ov_->getName(),
-                                mesh->getNvertices(), mesh->getNtriangles(), mesh->getFaces(),
-                                vertices_);
-
-    _send(sendBuffer_);
+    const std::string& ovName = ov_->getName();
+    const int nvertices  = mesh->getNvertices();
+    const int ntriangles = mesh->getNtriangles();
+    const auto& faces = mesh->getFaces();
+
+    const int size = SimpleSerializer::totSize(timeStamp, ovName, nvertices, ntriangles, faces, vertices_);
+    char *buffer = _prepareSend(size);
+    SimpleSerializer::serialize(buffer, timeStamp, ovName, nvertices, ntriangles, faces, vertices_);
+    _sendPrepared();
 }
 
 void MeshPlugin::saveSnapshotAndRegister(Saver& saver)
@@ -100,7 +103,7 @@ template<typename T> inline std::string getTypeStr();
 template<> inline std::string getTypeStr<float> () {return "float";}
 template<> inline std::string getTypeStr<double>() {return "double";}
 
-static void writePLY(
+void writePLY(
         MPI_Comm comm, std::string fname,
         int nvertices, int nverticesPerObject,
         int ntriangles, int ntrianglesPerObject,
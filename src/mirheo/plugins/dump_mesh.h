@@ -14,6 +14,24 @@ class ParticleVector;
 class ObjectVector;
 class CellList;
 
+/** Dump a set of meshes with the same connectivity to a file in binary ply format using MPI IO.
+    \param [in] comm The MPI communicator.
+    \param [in] fname The name of the target file.
+    \param [in] nvertices Local number of vertices.
+    \param [in] nverticesPerObject Number of vertices of one mesh.
+    \param [in] ntriangles Local number of triangles.
+    \param [in] ntrianglesPerObject Number of triangles of one mesh.
+    \param [in] nObjects Local number of meshes.
+    \param [in] mesh The triangles of one mesh, as indices of its vertices.
+    \param [in] vertices The vertices of all the local meshes.
+ */
+void writePLY(MPI_Comm comm, std::string fname,
+              int nvertices, int nverticesPerObject,
+              int ntriangles, int ntrianglesPerObject,
+              int nObjects,
+              const std::vector<int3>& mesh,
+              const std::vector<real3>& vertices);
+
 /** Send mesh information of an object for dump to MeshDumper postprocess plugin.
  */
 class MeshPlugin : public SimulationPlugin
@@ -52,7 +70,6 @@ private:
     std::string ovName_;
     int dumpEvery_;
 
-    std::vector<char> sendBuffer_;
     std::vector<real3> vertices_;
     PinnedBuffer<real4>* srcVerts_;
 
@@ -11,6 +11,8 @@
 #include <mirheo/core/utils/kernel_launch.h>
 #include <mirheo/core/xdmf/type_map.h>
 
+#include <limits>
+
 namespace mirheo
 {
 
@@ -237,9 +239,12 @@ void ParticleSenderPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
 
     debug2("Plugin %s is packing now data consisting of %zu particles",
            getCName(), positions_.size());
-    _waitPrevSend();
-    SimpleSerializer::serialize(sendBuffer_, timeStamp, getState()->currentTime, positions_, velocities_, channelData_);
-    _send(sendBuffer_);
+    // serialize directly into the send buffer, which is shared with the postprocess side when possible
+    const MirState::TimeType currentTime = getState()->currentTime;
+    const int size = SimpleSerializer::totSize(timeStamp, currentTime, positions_, velocities_, channelData_);
+    char *buffer = _prepareSend(size);
+    SimpleSerializer::serialize(buffer, timeStamp, currentTime, positions_, velocities_, channelData_);
+    _sendPrepared();
 }
 
 void ParticleSenderPlugin::saveSnapshotAndRegister(Saver& saver)
@@ -373,4 +378,162 @@ ConfigObject ParticleDumperPlugin::_saveSnapshot(Saver& saver, const std::string
     return config;
 }
 
+
+
+AggregatedParticleDumperPlugin::AggregatedParticleDumperPlugin(std::string name, std::string path,
+                                                               int ranksPerAggregator, bool subfiling,
+                                                               XDMF::IOHints hints) :
+    ParticleDumperPlugin(std::move(name), std::move(path)),
+    ranksPerAggregator_(ranksPerAggregator),
+    subfiling_(subfiling),
+    hints_(std::move(hints))
+{
+    if (ranksPerAggregator_ < 1)
+        die("Plugin '%s': the number of ranks per aggregator must be positive, got %d",
+            getCName(), ranksPerAggregator_);
+}
+
+AggregatedParticleDumperPlugin::AggregatedParticleDumperPlugin(Loader& loader, const ConfigObject& config) :
+    AggregatedParticleDumperPlugin(config["name"], config["path"],
+                                   config["ranksPerAggregator"], config["subfiling"],
+                                   loader.load<XDMF::IOHints>(config["hints"]))
+{}
+
+AggregatedParticleDumperPlugin::~AggregatedParticleDumperPlugin() = default;
+
+void AggregatedParticleDumperPlugin::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    ParticleDumperPlugin::setup(comm, interComm);
+    writer_ = std::make_unique<XDMF::AggregatedVertexWriter>(comm_, ranksPerAggregator_, subfiling_, hints_);
+
+    info("Plugin '%s' writes through %d aggregators, subfiling %s",
+         getCName(), writer_->getNumAggregators(), subfiling_ ? "on" : "off");
+}
+
+void AggregatedParticleDumperPlugin::deserialize()
+{
+    debug2("Plugin '%s' will dump right now", getCName());
+
+    MirState::TimeType time;
+    MirState::StepType timeStamp;
+    _recvAndUnpack(time, timeStamp);
+
+    const std::string fname = path_ + createStrZeroPadded(timeStamp, zeroPadding_);
+    writer_->write(fname, *positions_, channels_, time);
+}
+
+void AggregatedParticleDumperPlugin::saveSnapshotAndRegister(Saver& saver)
+{
+    saver.registerObject(this, _saveSnapshot(saver, "AggregatedParticleDumperPlugin"));
+}
+
+ConfigObject AggregatedParticleDumperPlugin::_saveSnapshot(Saver& saver, const std::string& typeName)
+{
+    ConfigObject config = ParticleDumperPlugin::_saveSnapshot(saver, typeName);
+    config.emplace("ranksPerAggregator", saver(ranksPerAggregator_));
+    config.emplace("subfiling",          saver(subfiling_));
+    config.emplace("hints",              saver(hints_));
+    return config;
+}
+
+
+
+TrajectoryParticleDumperPlugin::TrajectoryParticleDumperPlugin(std::string name, std::string path,
+                                                               int chunkSize, bool sortById) :
+    ParticleDumperPlugin(std::move(name), std::move(path)),
+    chunkSize_(chunkSize),
+    sortById_(sortById)
+{
+    if (chunkSize_ < 1)
+        die("Plugin '%s': the chunk size must be positive, got %d", getCName(), chunkSize_);
+}
+
+TrajectoryParticleDumperPlugin::TrajectoryParticleDumperPlugin(Loader&, const ConfigObject& config) :
+    TrajectoryParticleDumperPlugin(config["name"], config["path"], config["chunkSize"], config["sortById"])
+{
+    append_ = true;
+}
+
+TrajectoryParticleDumperPlugin::~TrajectoryParticleDumperPlugin() = default;
+
+void TrajectoryParticleDumperPlugin::handshake()
+{
+    ParticleDumperPlugin::handshake();
+
+    if (rank_ == 0)
+        writer_ = std::make_unique<trajectory::Writer>(path_ + ".traj", channels_, chunkSize_,
+                                                       "id", sortById_, append_);
+}
+
+void TrajectoryParticleDumperPlugin::_gather(const void *src, int nLocal, int elementSize, void *dst)
+{
+    if (rank_ == 0)
+    {
+        long long displacement = 0;
+        for (int i = 0; i < nranks_; ++i)
+        {
+            byteCounts_[i] = counts_[i] * elementSize;
+            byteDisplacements_[i] = static_cast<int>(displacement);
+            displacement += byteCounts_[i];
+        }
+
+        if (displacement > std::numeric_limits<int>::max())
+            die("Plugin '%s': too much data to gather (%lld bytes)", getCName(), displacement);
+    }
+
+    MPI_Check( MPI_Gatherv(src, nLocal * elementSize, MPI_BYTE,
+                           dst, byteCounts_.data(), byteDisplacements_.data(), MPI_BYTE,
+                           0, comm_) );
+}
+
+void TrajectoryParticleDumperPlugin::deserialize()
+{
+    debug2("Plugin '%s' will dump right now", getCName());
+
+    MirState::TimeType time;
+    MirState::StepType timeStamp;
+    _recvAndUnpack(time, timeStamp);
+
+    const int nLocal = static_cast<int>(positions_->size());
+    counts_           .resize(nranks_);
+    byteCounts_       .resize(nranks_);
+    byteDisplacements_.resize(nranks_);
+    MPI_Check( MPI_Gather(&nLocal, 1, MPI_INT, counts_.data(), 1, MPI_INT, 0, comm_) );
+
+    size_t nTotal = 0;
+    if (rank_ == 0)
+        for (auto c : counts_)
+            nTotal += static_cast<size_t>(c);
+
+    gatheredPositions_.resize(nTotal);
+    _gather(positions_->data(), nLocal, static_cast<int>(sizeof(real3)), gatheredPositions_.data());
+
+    gatheredChannels_ = channels_;
+    gatheredData_.resize(channels_.size());
+
+    for (size_t i = 0; i < channels_.size(); ++i)
+    {
+        const int elementSize = channels_[i].nComponents() * channels_[i].precision();
+        gatheredData_[i].resize(nTotal * static_cast<size_t>(elementSize));
+        _gather(channels_[i].data, nLocal, elementSize, gatheredData_[i].data());
+        gatheredChannels_[i].data = gatheredData_[i].data();
+    }
+
+    if (rank_ == 0)
+        writer_->write(time, timeStamp, gatheredPositions_, gatheredChannels_);
+}
+
+void TrajectoryParticleDumperPlugin::saveSnapshotAndRegister(Saver& saver)
+{
+    saver.registerObject(this, _saveSnapshot(saver, "TrajectoryParticleDumperPlugin"));
+}
+
+ConfigObject TrajectoryParticleDumperPlugin::_saveSnapshot(Saver& saver, const std::string& typeName)
+{
+    ConfigObject config = ParticleDumperPlugin::_saveSnapshot(saver, typeName);
+    config.emplace("chunkSize", saver(chunkSize_));
+    config.emplace("sortById",  saver(sortById_));
+    return config;
+}
+
 } // namespace mirheo
@@ -5,8 +5,11 @@
 #include <mirheo/core/datatypes.h>
 #include <mirheo/core/plugins.h>
 
+#include <mirheo/core/trajectory/writer.h>
+#include <mirheo/core/xdmf/aggregated_writer.h>
 #include <mirheo/core/xdmf/xdmf.h>
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -119,4 +122,101 @@ protected:
     std::vector<std::vector<char>> channelData_; ///< List of received channel data.
 };
 
+
+/** Postprocess side of ParticleSenderPlugin.
+    Same as ParticleDumperPlugin, but the data is written by a subset of the postprocess ranks,
+    optionally to one file per writing rank. See XDMF::AggregatedVertexWriter.
+*/
+class AggregatedParticleDumperPlugin : public ParticleDumperPlugin
+{
+public:
+    /** Create a AggregatedParticleDumperPlugin object.
+        \param [in] name The name of the plugin.
+        \param [in] path Particle data will be dumped to `pathXXXXX.[xmf,h5]`.
+        \param [in] ranksPerAggregator The number of postprocess ranks that send their data to one writing rank.
+        \param [in] subfiling If \c true, each writing rank writes its own `pathXXXXX_subYYYYY.[xmf,h5]` pair and
+                              `pathXXXXX.xmf` references all of them.
+        \param [in] hints MPI-IO hints of the hdf5 files; the default hints are used if empty.
+    */
+    AggregatedParticleDumperPlugin(std::string name, std::string path,
+                                   int ranksPerAggregator, bool subfiling, XDMF::IOHints hints);
+
+    /** Load a snapshot of the plugin.
+        \param [in] loader The \c Loader object. Provides load context and unserialization functions.
+        \param [in] config The parameters of the interaction.
+     */
+    AggregatedParticleDumperPlugin(Loader& loader, const ConfigObject& config);
+
+    ~AggregatedParticleDumperPlugin();
+
+    void setup(const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void deserialize() override;
+
+    /// Create a \c ConfigObject describing the plugin state and register it in the saver.
+    void saveSnapshotAndRegister(Saver& saver) override;
+
+protected:
+    /// Implementation of snapshot saving. Reusable by potential derived classes.
+    ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
+
+private:
+    int ranksPerAggregator_;
+    bool subfiling_;
+    XDMF::IOHints hints_;
+
+    std::unique_ptr<XDMF::AggregatedVertexWriter> writer_;
+};
+
+
+/** Postprocess side of ParticleSenderPlugin.
+    Append the particle data of every dump to a single trajectory file, see trajectory::Writer.
+    The data is gathered on the first postprocess rank, which is the only one to write.
+    The step of each frame is the index of the dump.
+*/
+class TrajectoryParticleDumperPlugin : public ParticleDumperPlugin
+{
+public:
+    /** Create a TrajectoryParticleDumperPlugin object.
+        \param [in] name The name of the plugin.
+        \param [in] path Particle data will be dumped to `path.traj`; an existing file is overwritten.
+        \param [in] chunkSize The maximum number of particles in each chunk of a frame.
+        \param [in] sortById If \c true, the particles of each frame are sorted by global id.
+    */
+    TrajectoryParticleDumperPlugin(std::string name, std::string path, int chunkSize, bool sortById);
+
+    /** Load a snapshot of the plugin.
+        The new frames are appended to the existing trajectory file.
+        \param [in] loader The \c Loader object. Provides load context and unserialization functions.
+        \param [in] config The parameters of the interaction.
+     */
+    TrajectoryParticleDumperPlugin(Loader& loader, const ConfigObject& config);
+
+    ~TrajectoryParticleDumperPlugin();
+
+    void handshake() override;
+    void deserialize() override;
+
+    /// Create a \c ConfigObject describing the plugin state and register it in the saver.
+    void saveSnapshotAndRegister(Saver& saver) override;
+
+protected:
+    /// Implementation of snapshot saving. Reusable by potential derived classes.
+    ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
+
+private:
+    void _gather(const void *src, int nLocal, int elementSize, void *dst);
+
+private:
+    int chunkSize_;
+    bool sortById_;
+    bool append_ {false};
+
+    std::unique_ptr<trajectory::Writer> writer_; ///< only on the first rank
+
+    std::vector<int> counts_, byteCounts_, byteDisplacements_; ///< work buffers for the gather operations
+    std::vector<real3> gatheredPositions_;
+    std::vector<std::vector<char>> gatheredData_;
+    std::vector<XDMF::Channel> gatheredChannels_;
+};
+
 } // namespace mirheo
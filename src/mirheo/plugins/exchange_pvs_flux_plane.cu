@@ -62,10 +62,11 @@ __global__ void moveParticles(DomainInfo domain, PVviewWithOldParticles view1, P
         view1.readVelocity(p, pid);
         view2.writeParticle(dst, p);
 
-        p.mark();
-        view1.writeParticle(pid, p);
-
         extra1.particles.copyTo(extra2.particles, pid, dst);
+
+        // the old position delta must not be encoded against the marked position
+        p.mark();
+        view1.PVview::writeParticle(pid, p);
     }
 }
 
@@ -103,8 +104,13 @@ void ExchangePVSFluxPlanePlugin::setup(Simulation* simulation, const MPI_Comm& c
     pv1_ = simulation->getPVbyNameOrDie(pv1Name_);
     pv2_ = simulation->getPVbyNameOrDie(pv2Name_);
 
-    pv1_->requireDataPerParticle<real4> (channel_names::oldPositions, DataManager::PersistenceMode::Active, DataManager::ShiftMode::Active);
-    pv2_->requireDataPerParticle<real4> (channel_names::oldPositions, DataManager::PersistenceMode::Active, DataManager::ShiftMode::Active);
+    // the old positions are copied as any other channel
+    if (pv1_->getOldPositionsStorage() != pv2_->getOldPositionsStorage())
+        die("Plugin '%s': pvs '%s' and '%s' must store their old positions in the same way",
+            getCName(), pv1_->getCName(), pv2_->getCName());
+
+    pv1_->requireOldPositions(DataManager::PersistenceMode::Active, DataManager::ShiftMode::Active);
+    pv2_->requireOldPositions(DataManager::PersistenceMode::Active, DataManager::ShiftMode::Active);
 }
 
 void ExchangePVSFluxPlanePlugin::beforeCellLists(cudaStream_t stream)
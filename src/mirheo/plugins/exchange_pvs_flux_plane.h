@@ -32,6 +32,7 @@ public:
 
     void setup(Simulation* simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
     void beforeCellLists(cudaStream_t stream) override;
+    bool actsBeforeCellLists(const ParticleVector *pv) const override { return pv == pv1_ || pv == pv2_; }
 
     bool needPostproc() override { return false; }
 
@@ -1,6 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "factory.h"
 
+#include "adaptive_time_step.h"
 #include "add_force.h"
 #include "add_torque.h"
 #include "anchor_particle.h"
@@ -17,12 +18,14 @@
 #include "dump_particles_with_mesh.h"
 #include "dump_xyz.h"
 #include "exchange_pvs_flux_plane.h"
+#include "field_extraction.h"
 #include "force_saver.h"
 #include "impose_profile.h"
 #include "impose_velocity.h"
 #include "magnetic_orientation.h"
 #include "membrane_extra_force.h"
 #include "msd.h"
+#include "multi_tau_correlator.h"
 #include "particle_channel_averager.h"
 #include "particle_channel_saver.h"
 #include "particle_checker.h"
@@ -53,6 +56,17 @@ static std::vector<std::string> extractPVNames(const std::vector<ParticleVector*
     return pvNames;
 }
 
+PairPlugin createAdaptiveTimeStepPlugin(bool computeTask, const MirState *state, std::string name,
+                                        const std::vector<ParticleVector*>& pvs, int checkEvery,
+                                        real dtMin, real dtMax, real maxDisplacement, real hysteresis)
+{
+    auto simPl = computeTask ?
+        std::make_shared<AdaptiveTimeStepPlugin> (state, name, extractPVNames(pvs), checkEvery,
+                                                  dtMin, dtMax, maxDisplacement, hysteresis) :
+        nullptr;
+    return { simPl, nullptr };
+}
+
 PairPlugin createAddForcePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, real3 force)
 {
     auto simPl = computeTask ? std::make_shared<AddForcePlugin> (state, name, pv->getName(), force) : nullptr;
@@ -104,7 +118,7 @@ PairPlugin createBerendsenThermostatPlugin(
 }
 
 PairPlugin createDensityControlPlugin(bool computeTask, const MirState *state, std::string name, std::string fname, std::vector<ParticleVector*> pvs,
-                                      real targetDensity, std::function<real(real3)> region, real3 resolution,
+                                      real targetDensity, PositionFunction<real> region, real3 resolution,
                                       real levelLo, real levelHi, real levelSpace, real Kp, real Ki, real Kd,
                                       int tuneEvery, int dumpEvery, int sampleEvery)
 {
@@ -122,7 +136,7 @@ PairPlugin createDensityControlPlugin(bool computeTask, const MirState *state, s
 }
 
 PairPlugin createDensityOutletPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
-                                     real numberDensity, std::function<real(real3)> region, real3 resolution)
+                                     real numberDensity, PositionFunction<real> region, real3 resolution)
 {
     auto simPl = computeTask ?
         std::make_shared<DensityOutletPlugin> (
@@ -142,7 +156,7 @@ PairPlugin createPlaneOutletPlugin(bool computeTask, const MirState *state, std:
 }
 
 PairPlugin createRateOutletPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
-                                  real rate, std::function<real(real3)> region, real3 resolution)
+                                  real rate, PositionFunction<real> region, real3 resolution)
 {
     auto simPl = computeTask ?
         std::make_shared<RateOutletPlugin> (state, name, extractPVNames(pvs), rate, region, resolution)
@@ -196,6 +210,27 @@ PairPlugin createDumpParticlesPlugin(bool computeTask, const MirState *state, st
     return { simPl, postPl };
 }
 
+PairPlugin createDumpParticlesAggregatedPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, int dumpEvery,
+                                               const std::vector<std::string>& channelNames, std::string path,
+                                               int ranksPerAggregator, bool subfiling, std::map<std::string, std::string> hints)
+{
+    auto simPl  = computeTask ? std::make_shared<ParticleSenderPlugin> (state, name, pv->getName(), dumpEvery, channelNames) : nullptr;
+    auto postPl = computeTask ? nullptr :
+        std::make_shared<AggregatedParticleDumperPlugin> (name, path, ranksPerAggregator, subfiling, std::move(hints));
+
+    return { simPl, postPl };
+}
+
+PairPlugin createDumpParticlesTrajectoryPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, int dumpEvery,
+                                               const std::vector<std::string>& channelNames, std::string path,
+                                               int chunkSize, bool sortById)
+{
+    auto simPl  = computeTask ? std::make_shared<ParticleSenderPlugin> (state, name, pv->getName(), dumpEvery, channelNames) : nullptr;
+    auto postPl = computeTask ? nullptr : std::make_shared<TrajectoryParticleDumperPlugin> (name, path, chunkSize, sortById);
+
+    return { simPl, postPl };
+}
+
 PairPlugin createDumpParticlesWithMeshPlugin(bool computeTask, const MirState *state, std::string name, ObjectVector *ov, int dumpEvery,
                                              const std::vector<std::string>& channelNames, std::string path)
 {
@@ -229,6 +264,42 @@ PairPlugin createExchangePVSFluxPlanePlugin(bool computeTask, const MirState *st
     return { simPl, nullptr };
 }
 
+PairPlugin createFieldExtractionPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
+                                       int sampleEvery, int dumpEvery, real3 binSize, std::vector<std::string> channelNames,
+                                       std::vector<std::pair<std::string, real>> slices, std::vector<real3> probes,
+                                       std::vector<std::pair<std::string, real>> isosurfaces, std::string path)
+{
+    std::shared_ptr<FieldExtractionPlugin> simPl;
+
+    if (computeTask)
+    {
+        std::vector<FieldExtractionPlugin::Slice> slicesDesc;
+        for (const auto& slice : slices)
+        {
+            int axis = -1;
+            if      (slice.first == "x") axis = 0;
+            else if (slice.first == "y") axis = 1;
+            else if (slice.first == "z") axis = 2;
+            else die("Plugin '%s': unknown slice axis '%s', expected 'x', 'y' or 'z'", name.c_str(), slice.first.c_str());
+
+            slicesDesc.push_back({axis, slice.second});
+        }
+
+        std::vector<FieldExtractionPlugin::Isosurface> isosurfacesDesc;
+        for (const auto& iso : isosurfaces)
+            isosurfacesDesc.push_back({iso.first, iso.second});
+
+        simPl = std::make_shared<FieldExtractionPlugin> (state, name, extractPVNames(pvs), channelNames,
+                                                         sampleEvery, dumpEvery, binSize,
+                                                         std::move(slicesDesc), std::move(probes),
+                                                         std::move(isosurfacesDesc));
+    }
+
+    auto postPl = computeTask ? nullptr : std::make_shared<FieldExtractionDumper> (name, path);
+
+    return { simPl, postPl };
+}
+
 PairPlugin createForceSaverPlugin(bool computeTask,  const MirState *state, std::string name, ParticleVector *pv)
 {
     auto simPl = computeTask ? std::make_shared<ForceSaverPlugin> (state, name, pv->getName()) : nullptr;
@@ -283,6 +354,26 @@ PairPlugin createMsdPlugin(bool computeTask, const MirState *state, std::string
     return { simPl, postPl };
 }
 
+PairPlugin createMultiTauCorrelatorPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
+                                          std::string channelName, std::string correlation, MirState::TimeType startTime,
+                                          int sampleEvery, int dumpEvery, int numLevels, int blockSize, std::string path)
+{
+    using multi_tau_correlator_plugin::CorrelationKind;
+    CorrelationKind kind;
+
+    if      (correlation == "squared_difference") kind = CorrelationKind::SquaredDifference;
+    else if (correlation == "dot")                kind = CorrelationKind::DotProduct;
+    else
+        die("Plugin '%s': unknown correlation '%s'; expected 'squared_difference' or 'dot'",
+            name.c_str(), correlation.c_str());
+
+    auto simPl  = computeTask ? std::make_shared<MultiTauCorrelatorPlugin> (state, name, pv->getName(), channelName, kind,
+                                                                            startTime, sampleEvery, dumpEvery, numLevels, blockSize)
+        : nullptr;
+    auto postPl = computeTask ? nullptr : std::make_shared<MultiTauCorrelatorDumper> (name, path);
+    return { simPl, postPl };
+}
+
 PairPlugin createParticleChannelAveragerPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
                                                std::string channelName, std::string averageName, real updateEvery)
 {
@@ -393,7 +484,7 @@ PairPlugin createVacfPlugin(bool computeTask, const MirState *state, std::string
 }
 
 PairPlugin createVirialPressurePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
-                                      std::function<real(real3)> region, real3 h, int dumpEvery, std::string path)
+                                      PositionFunction<real> region, real3 h, int dumpEvery, std::string path)
 {
     auto simPl  = computeTask ? std::make_shared<VirialPressurePlugin> (state, name, pv->getName(), region, h, dumpEvery)
         : nullptr;
@@ -402,8 +493,8 @@ PairPlugin createVirialPressurePlugin(bool computeTask, const MirState *state, s
 }
 
 PairPlugin createVelocityInletPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
-                                     std::function< real(real3)> implicitSurface,
-                                     std::function<real3(real3)> velocityField,
+                                     PositionFunction<real> implicitSurface,
+                                     PositionFunction<real3> velocityField,
                                      real3 resolution, real numberDensity, real kBT)
 {
     auto simPl  = computeTask ?
@@ -467,7 +558,10 @@ PluginFactoryContainer::OptionalPluginPair loadPlugins(
     // List all supported plugins.
     MIR_LOAD_PLUGIN_PAIR(MeshPlugin, MeshDumper);
     MIR_LOAD_PLUGIN_PAIR(ParticleSenderPlugin, ParticleDumperPlugin);
+    MIR_LOAD_PLUGIN_PAIR(ParticleSenderPlugin, AggregatedParticleDumperPlugin);
+    MIR_LOAD_PLUGIN_PAIR(ParticleSenderPlugin, TrajectoryParticleDumperPlugin);
     MIR_LOAD_PLUGIN_PAIR(SimulationStats, PostprocessStats);
+    MIR_LOAD_SIM_PLUGIN(AdaptiveTimeStepPlugin);
     MIR_LOAD_SIM_PLUGIN(BerendsenThermostatPlugin);
     MIR_LOAD_SIM_PLUGIN(ForceSaverPlugin);
     MIR_LOAD_SIM_PLUGIN(MembraneExtraForcePlugin);
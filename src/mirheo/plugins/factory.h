@@ -7,11 +7,14 @@
 #include <mirheo/core/pvs/rigid_object_vector.h>
 #include <mirheo/core/pvs/rod_vector.h>
 #include <mirheo/core/snapshot.h>
+#include <mirheo/core/utils/position_function.h>
 #include <mirheo/core/walls/interface.h>
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace mirheo
@@ -23,6 +26,10 @@ using PairPlugin = std::pair<std::shared_ptr<SimulationPlugin>,
                              std::shared_ptr<PostprocessPlugin>>;
 
 
+PairPlugin createAdaptiveTimeStepPlugin(bool computeTask, const MirState *state, std::string name,
+                                        const std::vector<ParticleVector*>& pvs, int checkEvery,
+                                        real dtMin, real dtMax, real maxDisplacement, real hysteresis);
+
 PairPlugin createAddForcePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, real3 force);
 
 PairPlugin createAddTorquePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, real3 torque);
@@ -36,18 +43,18 @@ PairPlugin createBerendsenThermostatPlugin(bool computeTask, const MirState *sta
                                            const std::vector<ParticleVector *> &pv, real tau, real T, real kBT, bool increaseIfLower);
 
 PairPlugin createDensityControlPlugin(bool computeTask, const MirState *state, std::string name, std::string fname, std::vector<ParticleVector*> pvs,
-                                      real targetDensity, std::function<real(real3)> region, real3 resolution,
+                                      real targetDensity, PositionFunction<real> region, real3 resolution,
                                       real levelLo, real levelHi, real levelSpace, real Kp, real Ki, real Kd,
                                       int tuneEvery, int dumpEvery, int sampleEvery);
 
 PairPlugin createDensityOutletPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
-                                     real numberDensity, std::function<real(real3)> region, real3 resolution);
+                                     real numberDensity, PositionFunction<real> region, real3 resolution);
 
 PairPlugin createPlaneOutletPlugin(bool computeTask, const MirState *state, std::string name,
                                    std::vector<ParticleVector*> pvs, real4 plane);
 
 PairPlugin createRateOutletPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
-                                  real rate, std::function<real(real3)> region, real3 resolution);
+                                  real rate, PositionFunction<real> region, real3 resolution);
 
 PairPlugin createDumpAveragePlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
                                    int sampleEvery, int dumpEvery, real3 binSize, std::vector<std::string> channelNames, std::string path);
@@ -62,6 +69,14 @@ PairPlugin createDumpMeshPlugin(bool computeTask, const MirState *state, std::st
 PairPlugin createDumpParticlesPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, int dumpEvery,
                                      const std::vector<std::string>& channelNames, std::string path);
 
+PairPlugin createDumpParticlesAggregatedPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, int dumpEvery,
+                                               const std::vector<std::string>& channelNames, std::string path,
+                                               int ranksPerAggregator, bool subfiling, std::map<std::string, std::string> hints);
+
+PairPlugin createDumpParticlesTrajectoryPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, int dumpEvery,
+                                               const std::vector<std::string>& channelNames, std::string path,
+                                               int chunkSize, bool sortById);
+
 PairPlugin createDumpParticlesWithMeshPlugin(bool computeTask, const MirState *state, std::string name, ObjectVector *ov, int dumpEvery,
                                              const std::vector<std::string>& channelNames, std::string path);
 
@@ -71,6 +86,11 @@ PairPlugin createDumpObjStats(bool computeTask, const MirState *state, std::stri
 
 PairPlugin createExchangePVSFluxPlanePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv1, ParticleVector *pv2, real4 plane);
 
+PairPlugin createFieldExtractionPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
+                                       int sampleEvery, int dumpEvery, real3 binSize, std::vector<std::string> channelNames,
+                                       std::vector<std::pair<std::string, real>> slices, std::vector<real3> probes,
+                                       std::vector<std::pair<std::string, real>> isosurfaces, std::string path);
+
 PairPlugin createForceSaverPlugin(bool computeTask,  const MirState *state, std::string name, ParticleVector *pv);
 
 PairPlugin createImposeProfilePlugin(bool computeTask,  const MirState *state, std::string name, ParticleVector* pv,
@@ -88,6 +108,10 @@ PairPlugin createMembraneExtraForcePlugin(bool computeTask, const MirState *stat
 PairPlugin createMsdPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
                            MirState::TimeType startTime, MirState::TimeType endTime, int dumpEvery, std::string path);
 
+PairPlugin createMultiTauCorrelatorPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
+                                          std::string channelName, std::string correlation, MirState::TimeType startTime,
+                                          int sampleEvery, int dumpEvery, int numLevels, int blockSize, std::string path);
+
 PairPlugin createParticleChannelAveragerPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
                                                std::string channelName, std::string averageName, real updateEvery);
 
@@ -125,11 +149,11 @@ PairPlugin createVacfPlugin(bool computeTask, const MirState *state, std::string
                             MirState::TimeType startTime, MirState::TimeType endTime, int dumpEvery, std::string path);
 
 PairPlugin createVirialPressurePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
-                                      std::function<real(real3)> region, real3 h, int dumpEvery, std::string path);
+                                      PositionFunction<real> region, real3 h, int dumpEvery, std::string path);
 
 PairPlugin createVelocityInletPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
-                                     std::function< real(real3)> implicitSurface,
-                                     std::function<real3(real3)> velocityField,
+                                     PositionFunction<real> implicitSurface,
+                                     PositionFunction<real3> velocityField,
                                      real3 resolution, real numberDensity, real kBT);
 
 PairPlugin createWallRepulsionPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector* pv, Wall* wall, real C, real h, real maxForce);
@@ -0,0 +1,346 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "field_extraction.h"
+#include "dump_mesh.h"
+#include "utils/field_extraction.h"
+#include "utils/simple_serializer.h"
+#include "utils/time_stamp.h"
+
+#include <mirheo/core/simulation.h>
+#include <mirheo/core/utils/path.h>
+
+#include <algorithm>
+
+namespace mirheo
+{
+
+static inline real getAxis(real3 v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+static inline int getAxis(int3 v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+FieldExtractionPlugin::FieldExtractionPlugin(const MirState *state, std::string name,
+                                             std::vector<std::string> pvNames, std::vector<std::string> channelNames,
+                                             int sampleEvery, int dumpEvery, real3 binSize,
+                                             std::vector<Slice> slices, std::vector<real3> probes,
+                                             std::vector<Isosurface> isosurfaces) :
+    Average3D(state, name, std::move(pvNames), std::move(channelNames), sampleEvery, dumpEvery, binSize),
+    slices_(std::move(slices)),
+    probes_(std::move(probes)),
+    isosurfaces_(std::move(isosurfaces))
+{
+    for (const auto& slice : slices_)
+        if (slice.axis < 0 || slice.axis > 2)
+            die("Plugin '%s': invalid slice axis %d, expected 0, 1 or 2", getCName(), slice.axis);
+
+    if (slices_.empty() && probes_.empty() && isosurfaces_.empty())
+        die("Plugin '%s' has nothing to extract: give at least one slice, probe or isosurface", getCName());
+}
+
+void FieldExtractionPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    Average3D::setup(simulation, comm, interComm);
+
+    const auto& names = channelsInfo_.names;
+    isosurfaceFieldIds_.clear();
+
+    for (const auto& iso : isosurfaces_)
+    {
+        if (iso.channelName == numberDensityChannelName_)
+        {
+            isosurfaceFieldIds_.push_back(0);
+            continue;
+        }
+
+        auto it = std::find(names.begin(), names.end(), iso.channelName);
+
+        if (it == names.end())
+            die("Plugin '%s': the channel '%s' of an isosurface must be '%s' or one of the averaged channels",
+                getCName(), iso.channelName.c_str(), numberDensityChannelName_.c_str());
+
+        const int channelId = static_cast<int>(it - names.begin());
+
+        if (channelsInfo_.types[channelId] != ChannelType::Scalar)
+            die("Plugin '%s': the channel '%s' of an isosurface must be a scalar",
+                getCName(), iso.channelName.c_str());
+
+        isosurfaceFieldIds_.push_back(channelId + 1);
+    }
+
+    const real3 L = getState()->domain.globalSize;
+
+    for (const auto& slice : slices_)
+        if (slice.position < 0 || slice.position >= getAxis(L, slice.axis))
+            die("Plugin '%s': the slice at position %g along axis %d is outside of the domain",
+                getCName(), slice.position, slice.axis);
+
+    for (const auto& r : probes_)
+        if (r.x < 0 || r.y < 0 || r.z < 0 || r.x >= L.x || r.y >= L.y || r.z >= L.z)
+            die("Plugin '%s': the probe (%g %g %g) is outside of the domain", getCName(), r.x, r.y, r.z);
+
+    info("Plugin '%s' extracts %zu slices, %zu probes and %zu isosurfaces",
+         getCName(), slices_.size(), probes_.size(), isosurfaces_.size());
+}
+
+void FieldExtractionPlugin::serializeAndSend(cudaStream_t stream)
+{
+    if (!isTimeEvery(getState(), dumpEvery_)) return;
+    if (nSamples_ == 0) return;
+
+    scaleSampled(stream);
+
+    const MirState::StepType timeStamp = getTimeStamp(getState(), dumpEvery_) - 1;  // -1 to start from 0
+
+    const field_extraction::Grid grid {resolution_, binSize_, getState()->domain.globalStart};
+
+    std::vector<field_extraction::Field> fields {{accumulatedNumberDensity_.hostPtr(), 1}};
+    for (int i = 0; i < channelsInfo_.n; ++i)
+        fields.push_back({accumulatedAverage_[i].hostPtr(), getNcomponents(channelsInfo_.types[i])});
+
+    const int nComponents = field_extraction::totalComponents(fields);
+
+    // The probes of the other subdomains are set to zero so that the postprocess side can sum them up.
+    probeValues_.assign(probes_.size() * nComponents, 0.0);
+
+    for (size_t i = 0; i < probes_.size(); ++i)
+        if (field_extraction::contains(grid, probes_[i]))
+            field_extraction::interpolateAll(grid, fields, probes_[i], probeValues_.data() + i * nComponents);
+
+    sliceValues_.resize(slices_.size());
+
+    for (size_t i = 0; i < slices_.size(); ++i)
+        field_extraction::extractSlice(grid, fields, slices_[i].axis, slices_[i].position, sliceValues_[i]);
+
+    isosurfaceVertices_.resize(isosurfaces_.size());
+    isosurfaceFaces_   .resize(isosurfaces_.size());
+
+    for (size_t i = 0; i < isosurfaces_.size(); ++i)
+        field_extraction::extractIsosurface(grid, fields[isosurfaceFieldIds_[i]], 0, isosurfaces_[i].isovalue,
+                                            isosurfaceVertices_[i], isosurfaceFaces_[i]);
+
+    debug2("Plugin '%s' is now packing the data", getCName());
+    _waitPrevSend();
+    SimpleSerializer::serialize(sendBuffer_, getState()->currentTime, timeStamp,
+                                probeValues_, sliceValues_, isosurfaceVertices_, isosurfaceFaces_);
+    _send(sendBuffer_);
+}
+
+void FieldExtractionPlugin::handshake()
+{
+    std::vector<int> sizes;
+    for (auto t : channelsInfo_.types)
+        sizes.push_back(getNcomponents(t));
+
+    std::vector<int> sliceAxes;
+    std::vector<real> slicePositions;
+    for (const auto& slice : slices_)
+    {
+        sliceAxes     .push_back(slice.axis);
+        slicePositions.push_back(slice.position);
+    }
+
+    std::vector<std::string> isosurfaceNames;
+    for (const auto& iso : isosurfaces_)
+        isosurfaceNames.push_back(iso.channelName);
+
+    SimpleSerializer::serialize(sendBuffer_, nranks3D_, rank3D_, resolution_, binSize_,
+                                sizes, channelsInfo_.names, numberDensityChannelName_,
+                                sliceAxes, slicePositions, probes_, isosurfaceNames);
+    _send(sendBuffer_);
+}
+
+//=================================================================================
+
+FieldExtractionDumper::FieldExtractionDumper(std::string name, std::string path) :
+    PostprocessPlugin(name),
+    path_(makePath(path))
+{}
+
+void FieldExtractionDumper::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    PostprocessPlugin::setup(comm, interComm);
+    activated_ = createFoldersCollective(comm, path_);
+}
+
+void FieldExtractionDumper::handshake()
+{
+    auto req = waitData();
+    MPI_Check( MPI_Wait(&req, MPI_STATUS_IGNORE) );
+    recv();
+
+    std::vector<int> sizes;
+    std::vector<std::string> names;
+    std::string numberDensityChannelName;
+    SimpleSerializer::deserialize(data_, nranks3D_, rank3D_, resolution_, h_,
+                                  sizes, names, numberDensityChannelName,
+                                  sliceAxes_, slicePositions_, probes_, isosurfaceNames_);
+
+    componentNames_ = {numberDensityChannelName};
+
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        if (sizes[i] == 1)
+            componentNames_.push_back(names[i]);
+        else
+            for (int c = 0; c < sizes[i]; ++c)
+                componentNames_.push_back(names[i] + "_" + std::to_string(c));
+    }
+
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm_, &rank) );
+
+    if (activated_ && rank == 0 && !probes_.empty() && fprobes_.get() == nullptr)
+    {
+        const std::string fname = joinPaths(path_, "probes.csv");
+        auto status = fprobes_.open(fname, "w");
+        if (status != FileWrapper::Status::Success)
+            die("Could not open file '%s'", fname.c_str());
+
+        fprintf(fprobes_.get(), "time,probe,x,y,z");
+        for (const auto& name : componentNames_)
+            fprintf(fprobes_.get(), ",%s", name.c_str());
+        fprintf(fprobes_.get(), "\n");
+    }
+}
+
+void FieldExtractionDumper::deserialize()
+{
+    MirState::TimeType t;
+    MirState::StepType timeStamp;
+    SimpleSerializer::deserialize(data_, t, timeStamp, probeValues_, sliceValues_, isosurfaceVertices_, isosurfaceFaces_);
+
+    if (!activated_) return;
+
+    debug2("Plugin '%s' will dump right now: simulation time %f, time stamp %lld",
+           getCName(), t, timeStamp);
+
+    if (!probes_.empty())
+        _dumpProbes(t, probeValues_);
+
+    for (size_t i = 0; i < sliceValues_.size(); ++i)
+        _dumpSlice(static_cast<int>(i), timeStamp, sliceValues_[i]);
+
+    for (size_t i = 0; i < isosurfaceVertices_.size(); ++i)
+    {
+        const std::string fname = path_ + isosurfaceNames_[i] + "_" + std::to_string(i) + "_"
+            + createStrZeroPadded(timeStamp, zeroPadding_) + ".ply";
+
+        const int nvertices  = static_cast<int>(isosurfaceVertices_[i].size());
+        const int ntriangles = static_cast<int>(isosurfaceFaces_   [i].size());
+
+        writePLY(comm_, fname, nvertices, nvertices, ntriangles, ntriangles, 1,
+                 isosurfaceFaces_[i], isosurfaceVertices_[i]);
+    }
+}
+
+void FieldExtractionDumper::_dumpProbes(MirState::TimeType t, std::vector<double>& localValues)
+{
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm_, &rank) );
+
+    const int n = static_cast<int>(localValues.size());
+
+    // each probe is non zero on one rank only
+    if (rank == 0)
+        MPI_Check( MPI_Reduce(MPI_IN_PLACE, localValues.data(), n, MPI_DOUBLE, MPI_SUM, 0, comm_) );
+    else
+        MPI_Check( MPI_Reduce(localValues.data(), nullptr, n, MPI_DOUBLE, MPI_SUM, 0, comm_) );
+
+    if (rank != 0) return;
+
+    const size_t nComponents = componentNames_.size();
+
+    for (size_t i = 0; i < probes_.size(); ++i)
+    {
+        const real3 r = probes_[i];
+        fprintf(fprobes_.get(), "%g,%zu,%g,%g,%g", t, i, r.x, r.y, r.z);
+
+        for (size_t c = 0; c < nComponents; ++c)
+            fprintf(fprobes_.get(), ",%.6e", localValues[i * nComponents + c]);
+
+        fprintf(fprobes_.get(), "\n");
+    }
+}
+
+void FieldExtractionDumper::_dumpSlice(int sliceId, MirState::StepType timeStamp, const std::vector<double>& localValues)
+{
+    const int axis = sliceAxes_[sliceId];
+    const int2 axes = field_extraction::sliceAxes(axis);
+
+    const int na = getAxis(resolution_, axes.x);
+    const int nb = getAxis(resolution_, axes.y);
+    const int NA = na * getAxis(nranks3D_, axes.x);
+    const int NB = nb * getAxis(nranks3D_, axes.y);
+    const size_t nComponents = componentNames_.size();
+
+    // place the local block in the global slice; zero if the slice does not cross the subdomain
+    std::vector<double> values(static_cast<size_t>(NA) * NB * nComponents, 0.0);
+
+    if (!localValues.empty())
+    {
+        const int offsetA = na * getAxis(rank3D_, axes.x);
+        const int offsetB = nb * getAxis(rank3D_, axes.y);
+
+        for (int ib = 0; ib < nb; ++ib)
+            for (int ia = 0; ia < na; ++ia)
+            {
+                const size_t src = static_cast<size_t>(ib) * na + ia;
+                const size_t dst = static_cast<size_t>(ib + offsetB) * NA + (ia + offsetA);
+
+                std::copy(localValues.begin() + src * nComponents,
+                          localValues.begin() + (src + 1) * nComponents,
+                          values.begin() + dst * nComponents);
+            }
+    }
+
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm_, &rank) );
+
+    const int n = static_cast<int>(values.size());
+
+    if (rank == 0)
+        MPI_Check( MPI_Reduce(MPI_IN_PLACE, values.data(), n, MPI_DOUBLE, MPI_SUM, 0, comm_) );
+    else
+        MPI_Check( MPI_Reduce(values.data(), nullptr, n, MPI_DOUBLE, MPI_SUM, 0, comm_) );
+
+    if (rank != 0) return;
+
+    const std::string fname = path_ + "slice" + std::to_string(sliceId) + "_"
+        + createStrZeroPadded(timeStamp, zeroPadding_) + ".csv";
+
+    FileWrapper f;
+    if (f.open(fname, "w") != FileWrapper::Status::Success)
+        die("Could not open file '%s'", fname.c_str());
+
+    fprintf(f.get(), "x,y,z");
+    for (const auto& name : componentNames_)
+        fprintf(f.get(), ",%s", name.c_str());
+    fprintf(f.get(), "\n");
+
+    real pos[3];
+    pos[axis] = slicePositions_[sliceId];
+
+    for (int ib = 0; ib < NB; ++ib)
+    {
+        pos[axes.y] = (static_cast<real>(ib) + 0.5_r) * getAxis(h_, axes.y);
+
+        for (int ia = 0; ia < NA; ++ia)
+        {
+            pos[axes.x] = (static_cast<real>(ia) + 0.5_r) * getAxis(h_, axes.x);
+
+            fprintf(f.get(), "%g,%g,%g", pos[0], pos[1], pos[2]);
+
+            const size_t pointId = static_cast<size_t>(ib) * NA + ia;
+            for (size_t c = 0; c < nComponents; ++c)
+                fprintf(f.get(), ",%.6e", values[pointId * nComponents + c]);
+
+            fprintf(f.get(), "\n");
+        }
+    }
+}
+
+} // namespace mirheo
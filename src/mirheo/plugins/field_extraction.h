@@ -0,0 +1,127 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "average_flow.h"
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/plugins.h>
+#include <mirheo/core/utils/file_wrapper.h>
+
+#include <string>
+#include <vector>
+
+namespace mirheo
+{
+
+/** Extract slices, probes and isosurfaces of grid-averaged particle quantities in situ.
+
+    The quantities are sampled and averaged in time exactly as in Average3D.
+    Instead of the full grids, only the following reduced data is sent to the postprocess side:
+    - the values on planes normal to one of the axes (slices);
+    - the values at given positions (probes);
+    - the isosurfaces of scalar quantities, computed with marching cubes.
+
+    The values are interpolated trilinearly between the bin centers, see field_extraction::interpolate().
+    The isosurfaces are computed independently on each subdomain.
+
+    This plugin should be used with FieldExtractionDumper on the postprocessing side.
+
+    Cannot be used with multiple invocations of `Mirheo.run`.
+ */
+class FieldExtractionPlugin : public Average3D
+{
+public:
+    /// A plane normal to one of the axes.
+    struct Slice
+    {
+        int axis;      ///< normal of the plane (0: x, 1: y, 2: z)
+        real position; ///< position of the plane along the axis, in global coordinates
+    };
+
+    /// A surface on which a scalar quantity has a given value.
+    struct Isosurface
+    {
+        std::string channelName; ///< name of the scalar channel, or the number density
+        real isovalue;           ///< value of the quantity on the surface
+    };
+
+    /** Create a FieldExtractionPlugin object.
+        \param [in] state The global state of the simulation.
+        \param [in] name The name of the plugin.
+        \param [in] pvNames The list of names of the ParticleVector that will be used when averaging.
+        \param [in] channelNames The list of particle data channels to average. Will die if the channel does not exist.
+        \param [in] sampleEvery Compute spatial averages every this number of time steps.
+        \param [in] dumpEvery Compute time averages and send the extracted data every this number of time steps.
+        \param [in] binSize Size of one spatial bin along the three axes.
+        \param [in] slices The planes on which to extract all the quantities.
+        \param [in] probes The positions, in global coordinates, at which to extract all the quantities.
+        \param [in] isosurfaces The isosurfaces to extract.
+     */
+    FieldExtractionPlugin(const MirState *state, std::string name,
+                          std::vector<std::string> pvNames, std::vector<std::string> channelNames,
+                          int sampleEvery, int dumpEvery, real3 binSize,
+                          std::vector<Slice> slices, std::vector<real3> probes,
+                          std::vector<Isosurface> isosurfaces);
+
+    void setup(Simulation* simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+    void serializeAndSend(cudaStream_t stream) override;
+
+private:
+    std::vector<Slice> slices_;
+    std::vector<real3> probes_;
+    std::vector<Isosurface> isosurfaces_;
+    std::vector<int> isosurfaceFieldIds_; ///< index of the field of each isosurface; 0 is the number density
+
+    std::vector<double> probeValues_;
+    std::vector<std::vector<double>> sliceValues_;
+    std::vector<std::vector<real3>> isosurfaceVertices_;
+    std::vector<std::vector<int3>> isosurfaceFaces_;
+};
+
+
+/** Postprocess side of FieldExtractionPlugin.
+    Writes the probes to a csv file, the slices to one csv file per dump and the isosurfaces to ply files.
+ */
+class FieldExtractionDumper : public PostprocessPlugin
+{
+public:
+    /** Create a FieldExtractionDumper object.
+        \param [in] name The name of the plugin.
+        \param [in] path The folder that will contain the files: `probes.csv`, `slice<i>_XXXXX.csv` and
+                         `<channel>_<i>_XXXXX.ply`, where `XXXXX` is the time stamp.
+     */
+    FieldExtractionDumper(std::string name, std::string path);
+
+    void setup(const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+    void deserialize() override;
+
+private:
+    void _dumpProbes(MirState::TimeType t, std::vector<double>& localValues);
+    void _dumpSlice(int sliceId, MirState::StepType timeStamp, const std::vector<double>& localValues);
+
+private:
+    std::string path_;
+    bool activated_ {true};
+    static constexpr int zeroPadding_ = 5;
+
+    int3 nranks3D_, rank3D_;
+    int3 resolution_;
+    real3 h_;
+    std::vector<std::string> componentNames_;
+
+    std::vector<int> sliceAxes_;
+    std::vector<real> slicePositions_;
+    std::vector<real3> probes_;
+    std::vector<std::string> isosurfaceNames_;
+
+    std::vector<double> probeValues_;
+    std::vector<std::vector<double>> sliceValues_;
+    std::vector<std::vector<real3>> isosurfaceVertices_;
+    std::vector<std::vector<int3>> isosurfaceFaces_;
+
+    FileWrapper fprobes_;
+};
+
+} // namespace mirheo
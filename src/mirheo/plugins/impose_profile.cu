@@ -89,6 +89,10 @@ void ImposeProfilePlugin::setup(Simulation* simulation, const MPI_Comm& comm, co
     if (cl_ == nullptr)
         die("Cell-list is required for PV '%s' by plugin '%s'", pvName_.c_str(), getCName());
 
+    // the particles of a cell are contiguous only through the particle ids with in-place object cell-lists
+    if (dynamic_cast<ObjectPrimaryCellList*>(cl_) != nullptr)
+        die("Plugin '%s' can not be used with the in-place cell-lists of OV '%s'", getCName(), pvName_.c_str());
+
     debug("Setting up pluging '%s' to impose uniform profile with velocity [%f %f %f]"
           " and temperature %f in a box [%.2f %.2f %.2f] - [%.2f %.2f %.2f] for PV '%s'",
           getCName(), targetVel_.x, targetVel_.y, targetVel_.z, kBT_,
@@ -36,6 +36,7 @@ public:
     bool needPostproc() override { return false; }
 
     void afterIntegration(cudaStream_t stream) override;
+    bool actsBeforeCellLists(const ParticleVector *pv) const override { return pv == pv_; }
 
 private:
     std::string pvName_;
@@ -0,0 +1,381 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "multi_tau_correlator.h"
+#include "utils/simple_serializer.h"
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/simulation.h>
+#include <mirheo/core/utils/common.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/file_wrapper.h>
+#include <mirheo/core/utils/kernel_launch.h>
+#include <mirheo/core/utils/mpi_types.h>
+#include <mirheo/core/utils/path.h>
+
+namespace mirheo
+{
+
+using multi_tau_correlator_plugin::CorrelationKind;
+using multi_tau_correlator_plugin::ReductionType;
+
+namespace multi_tau_correlator_kernels
+{
+
+/// per particle history, stored in channels
+struct HistoryStorage
+{
+    __D__ real3& value(int level, int j)
+    {
+        return valid ? values[level * blockSize + j][pid] : dummy;
+    }
+
+    __D__ real3& accumulator(int level)
+    {
+        return valid ? accumulators[level][pid] : dummy;
+    }
+
+    real3 **values;
+    real3 **accumulators;
+    int pid;
+    int blockSize;
+    bool valid;
+    real3 dummy;
+};
+
+__global__ void initDisplacements(int n, const real4 *positions, real4 *prevPositions, real3 *displacements)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+
+    prevPositions[i] = positions[i];
+    displacements[i] = make_real3(0.0_r);
+}
+
+/// replace the positions by the unwrapped displacements
+__global__ void updateDisplacements(int n, const real4 *positions, real4 *prevPositions, real3 *displacements)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+
+    const real4 r0 = prevPositions[i];
+    const real4 r1 = positions[i];
+
+    displacements[i] += make_real3(r1 - r0);
+    prevPositions[i] = r1;
+}
+
+template <CorrelationKind Kind, typename T>
+__global__ void correlate(int n, const T *signal, multi_tau::Layout layout, int nUpdated,
+                          const multi_tau::LevelState *states, real3 **values, real3 **accumulators,
+                          ReductionType *sums)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    const bool valid = i < n;
+
+    // all threads take part in the warp reductions
+    const real3 x = valid ? make_real3(signal[i]) : make_real3(0.0_r);
+
+    HistoryStorage storage {values, accumulators, i, layout.blockSize, valid, make_real3(0.0_r)};
+
+    auto correlation = [](real3 a, real3 b) -> ReductionType
+    {
+        if (Kind == CorrelationKind::SquaredDifference)
+        {
+            const real3 d = a - b;
+            return dot(d, d);
+        }
+        return dot(a, b);
+    };
+
+    auto output = [&](int level, int j, ReductionType v)
+    {
+        v = warpReduce(v, [](ReductionType a, ReductionType b) { return a+b; });
+
+        if (laneId() == 0)
+            atomicAdd(sums + level * layout.blockSize + j, v);
+    };
+
+    multi_tau::multiTauUpdate(x, layout, nUpdated, states, storage, correlation, output);
+}
+
+} // namespace multi_tau_correlator_kernels
+
+MultiTauCorrelatorPlugin::MultiTauCorrelatorPlugin(const MirState *state, std::string name, std::string pvName,
+                                                   std::string channelName, CorrelationKind kind,
+                                                   MirState::TimeType startTime, int sampleEvery, int dumpEvery,
+                                                   int numLevels, int blockSize) :
+    SimulationPlugin(state, name),
+    pvName_(pvName),
+    channelName_(channelName),
+    kind_(kind),
+    startTime_(startTime),
+    sampleEvery_(sampleEvery),
+    dumpEvery_(dumpEvery),
+    schedule_(multi_tau::Layout{numLevels, blockSize, 2})
+{
+    if (numLevels < 1)
+        die("Plugin '%s': expected at least one level, got %d", getCName(), numLevels);
+
+    if (blockSize < 2 || blockSize % 2 != 0)
+        die("Plugin '%s': the block size must be a positive multiple of 2, got %d", getCName(), blockSize);
+
+    if (sampleEvery <= 0 || dumpEvery <= 0)
+        die("Plugin '%s': sampleEvery and dumpEvery must be positive", getCName());
+
+    if (dumpEvery % sampleEvery != 0)
+        die("Plugin '%s': dumpEvery (%d) must be a multiple of sampleEvery (%d)", getCName(), dumpEvery, sampleEvery);
+
+    const int nvalues = numLevels * blockSize;
+    states_      .resize_anew(numLevels);
+    values_      .resize_anew(nvalues);
+    accumulators_.resize_anew(numLevels);
+    localSums_   .resize_anew(nvalues);
+    localCounts_.assign(nvalues, 0.0);
+}
+
+MultiTauCorrelatorPlugin::~MultiTauCorrelatorPlugin() = default;
+
+void MultiTauCorrelatorPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    SimulationPlugin::setup(simulation, comm, interComm);
+
+    pv_ = simulation->getPVbyNameOrDie(pvName_);
+
+    if (channelName_ == channel_names::positions)
+    {
+        previousPositionChannelName_  = getName() + "_xprev";
+        totalDisplacementChannelName_ = getName() + "_disp";
+
+        pv_->requireDataPerParticle<real4>(previousPositionChannelName_, DataManager::PersistenceMode::Active, DataManager::ShiftMode::Active);
+        pv_->requireDataPerParticle<real3>(totalDisplacementChannelName_, DataManager::PersistenceMode::Active);
+    }
+
+    const auto& layout = schedule_.layout();
+
+    for (int level = 0; level < layout.numLevels; ++level)
+    {
+        for (int j = 0; j < layout.blockSize; ++j)
+        {
+            valueChannelNames_.push_back(getName() + "_value_" + std::to_string(level) + "_" + std::to_string(j));
+            pv_->requireDataPerParticle<real3>(valueChannelNames_.back(), DataManager::PersistenceMode::Active);
+        }
+
+        accumulatorChannelNames_.push_back(getName() + "_acc_" + std::to_string(level));
+        pv_->requireDataPerParticle<real3>(accumulatorChannelNames_.back(), DataManager::PersistenceMode::Active);
+    }
+
+    info("Plugin %s initialized for the channel '%s' of the particle vector '%s' with %d levels of %d values",
+         getCName(), channelName_.c_str(), pvName_.c_str(), layout.numLevels, layout.blockSize);
+}
+
+void MultiTauCorrelatorPlugin::handshake()
+{
+    SimpleSerializer::serialize(sendBuffer_, pvName_, channelName_);
+    _send(sendBuffer_);
+}
+
+void MultiTauCorrelatorPlugin::_updateStoragePointers(cudaStream_t stream)
+{
+    auto& manager = pv_->local()->dataPerParticle;
+
+    for (size_t i = 0; i < valueChannelNames_.size(); ++i)
+        values_[i] = manager.getData<real3>(valueChannelNames_[i])->devPtr();
+
+    for (size_t i = 0; i < accumulatorChannelNames_.size(); ++i)
+        accumulators_[i] = manager.getData<real3>(accumulatorChannelNames_[i])->devPtr();
+
+    values_      .uploadToDevice(stream);
+    accumulators_.uploadToDevice(stream);
+}
+
+template <CorrelationKind Kind, typename T>
+static void launchCorrelate(int n, const T *signal, const multi_tau::Layout& layout, int nUpdated,
+                            const multi_tau::LevelState *states, real3 **values, real3 **accumulators,
+                            ReductionType *sums, cudaStream_t stream)
+{
+    constexpr int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(
+        multi_tau_correlator_kernels::correlate<Kind COMMA T>,
+        getNblocks(n, nthreads), nthreads, 0, stream,
+        n, signal, layout, nUpdated, states, values, accumulators, sums );
+}
+
+template <typename T>
+static void launchCorrelate(CorrelationKind kind, int n, const T *signal, const multi_tau::Layout& layout, int nUpdated,
+                            const multi_tau::LevelState *states, real3 **values, real3 **accumulators,
+                            ReductionType *sums, cudaStream_t stream)
+{
+    if (kind == CorrelationKind::SquaredDifference)
+        launchCorrelate<CorrelationKind::SquaredDifference>(n, signal, layout, nUpdated, states, values, accumulators, sums, stream);
+    else
+        launchCorrelate<CorrelationKind::DotProduct>       (n, signal, layout, nUpdated, states, values, accumulators, sums, stream);
+}
+
+void MultiTauCorrelatorPlugin::afterIntegration(cudaStream_t stream)
+{
+    const auto currentTime = getState()->currentTime;
+    const auto currentStep = getState()->currentStep;
+
+    if (currentTime < startTime_)
+        return;
+
+    auto lpv = pv_->local();
+    const int n = lpv->size();
+    constexpr int nthreads = 128;
+    const int nblocks = getNblocks(n, nthreads);
+
+    const bool unwrapPositions = !totalDisplacementChannelName_.empty();
+    auto& manager = lpv->dataPerParticle;
+
+    if (startStep_ < 0)
+    {
+        if (unwrapPositions)
+        {
+            SAFE_KERNEL_LAUNCH(
+                multi_tau_correlator_kernels::initDisplacements,
+                nblocks, nthreads, 0, stream,
+                n, lpv->positions().devPtr(),
+                manager.getData<real4>(previousPositionChannelName_)->devPtr(),
+                manager.getData<real3>(totalDisplacementChannelName_)->devPtr() );
+        }
+
+        for (const auto& name : accumulatorChannelNames_)
+            manager.getData<real3>(name)->clearDevice(stream);
+
+        localSums_.clear(stream);
+        startStep_ = currentStep;
+    }
+
+    if ((currentStep - startStep_) % sampleEvery_ != 0)
+        return;
+
+    const int nUpdated = schedule_.push();
+    const auto& layout = schedule_.layout();
+    const auto& states = schedule_.states();
+
+    std::copy(states.begin(), states.end(), states_.begin());
+    states_.uploadToDevice(stream);
+    _updateStoragePointers(stream);
+
+    if (unwrapPositions)
+    {
+        auto disp = manager.getData<real3>(totalDisplacementChannelName_);
+
+        SAFE_KERNEL_LAUNCH(
+            multi_tau_correlator_kernels::updateDisplacements,
+            nblocks, nthreads, 0, stream,
+            n, lpv->positions().devPtr(),
+            manager.getData<real4>(previousPositionChannelName_)->devPtr(),
+            disp->devPtr() );
+
+        launchCorrelate(kind_, n, disp->devPtr(), layout, nUpdated, states_.devPtr(),
+                        values_.devPtr(), accumulators_.devPtr(), localSums_.devPtr(), stream);
+    }
+    else
+    {
+        const auto& desc = manager.getChannelDescOrDie(channelName_);
+
+        if (mpark::holds_alternative<PinnedBuffer<real4>*>(desc.varDataPtr))
+            launchCorrelate(kind_, n, mpark::get<PinnedBuffer<real4>*>(desc.varDataPtr)->devPtr(), layout, nUpdated, states_.devPtr(),
+                            values_.devPtr(), accumulators_.devPtr(), localSums_.devPtr(), stream);
+        else if (mpark::holds_alternative<PinnedBuffer<real3>*>(desc.varDataPtr))
+            launchCorrelate(kind_, n, mpark::get<PinnedBuffer<real3>*>(desc.varDataPtr)->devPtr(), layout, nUpdated, states_.devPtr(),
+                            values_.devPtr(), accumulators_.devPtr(), localSums_.devPtr(), stream);
+        else
+            die("Plugin '%s': channel '%s' must contain real3 or real4", getCName(), channelName_.c_str());
+    }
+
+    for (int level = 0; level < nUpdated; ++level)
+        for (int j = layout.firstLagIndex(level); j < states[level].filled; ++j)
+            localCounts_[level * layout.blockSize + j] += n;
+
+    if ((currentStep - startStep_) % dumpEvery_ == 0)
+    {
+        localSums_.downloadFromDevice(stream, ContainersSynch::Synch);
+        savedTime_ = currentTime;
+        needToSend_ = true;
+    }
+}
+
+void MultiTauCorrelatorPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
+{
+    if (!needToSend_)
+        return;
+
+    debug2("Plugin %s is sending now data", getCName());
+
+    const auto& layout = schedule_.layout();
+    std::vector<MirState::TimeType> lagTimes;
+    std::vector<ReductionType> sums(localSums_.begin(), localSums_.end());
+
+    const MirState::TimeType sampleTime = static_cast<MirState::TimeType>(sampleEvery_) * getState()->getDt();
+
+    for (int level = 0; level < layout.numLevels; ++level)
+        for (int j = 0; j < layout.blockSize; ++j)
+            lagTimes.push_back(static_cast<MirState::TimeType>(layout.lag(level, j)) * sampleTime);
+
+    _waitPrevSend();
+    SimpleSerializer::serialize(sendBuffer_, savedTime_, lagTimes, sums, localCounts_);
+    _send(sendBuffer_);
+
+    needToSend_ = false;
+}
+
+//=================================================================================
+
+MultiTauCorrelatorDumper::MultiTauCorrelatorDumper(std::string name, std::string path) :
+    PostprocessPlugin(name),
+    path_(makePath(path))
+{}
+
+void MultiTauCorrelatorDumper::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    PostprocessPlugin::setup(comm, interComm);
+    activated_ = createFoldersCollective(comm, path_);
+}
+
+void MultiTauCorrelatorDumper::handshake()
+{
+    auto req = waitData();
+    MPI_Check( MPI_Wait(&req, MPI_STATUS_IGNORE) );
+    recv();
+
+    std::string pvName, channelName;
+    SimpleSerializer::deserialize(data_, pvName, channelName);
+
+    fileName_ = joinPaths(path_, setExtensionOrDie(pvName + "_" + channelName, "csv"));
+}
+
+void MultiTauCorrelatorDumper::deserialize()
+{
+    MirState::TimeType curTime;
+    std::vector<MirState::TimeType> lagTimes;
+    std::vector<ReductionType> localSums;
+    std::vector<double> localCounts;
+
+    SimpleSerializer::deserialize(data_, curTime, lagTimes, localSums, localCounts);
+
+    std::vector<ReductionType> totalSums(localSums.size());
+    std::vector<double> totalCounts(localCounts.size());
+
+    const auto dataType = getMPIFloatType<ReductionType>();
+    MPI_Check( MPI_Reduce(localSums  .data(), totalSums  .data(), static_cast<int>(localSums  .size()), dataType,   MPI_SUM, 0, comm_) );
+    MPI_Check( MPI_Reduce(localCounts.data(), totalCounts.data(), static_cast<int>(localCounts.size()), MPI_DOUBLE, MPI_SUM, 0, comm_) );
+
+    if (!activated_) return;
+
+    // the whole function is rewritten as all lags are updated
+    FileWrapper fdump;
+    if (fdump.open(fileName_, "w") != FileWrapper::Status::Success)
+        die("Could not open file '%s'", fileName_.c_str());
+
+    fprintf(fdump.get(), "# time %g\n", curTime);
+    fprintf(fdump.get(), "lag,correlation\n");
+
+    for (size_t i = 0; i < totalSums.size(); ++i)
+        if (totalCounts[i] > 0)
+            fprintf(fdump.get(), "%g,%.6e\n", lagTimes[i], totalSums[i] / totalCounts[i]);
+}
+
+} // namespace mirheo
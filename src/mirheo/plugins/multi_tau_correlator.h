@@ -0,0 +1,125 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "utils/multi_tau.h"
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/plugins.h>
+
+namespace mirheo
+{
+
+class ParticleVector;
+
+namespace multi_tau_correlator_plugin
+{
+using ReductionType = double;
+
+/// The quantity computed from two values of the signal.
+enum class CorrelationKind
+{
+    SquaredDifference, ///< |x(t+tau) - x(t)|^2, e.g. the MSD when the signal is the positions
+    DotProduct         ///< x(t+tau) . x(t), e.g. the VACF when the signal is the velocities
+};
+} // namespace multi_tau_correlator_plugin
+
+
+/** Compute time correlation functions of a per-particle vector channel of a ParticleVector with a multiple-tau correlator.
+
+    All samples are used as time origins and the lags span several orders of magnitude with
+    numLevels * (blockSize + 1) stored values per particle (see multi_tau).
+    The history of each particle is stored in persistent channels, so that it follows the particles
+    across ranks.
+
+    When the channel is the positions, the signal is the unwrapped displacement of the particles since startTime
+    (the positions are not continuous across periodic boundaries).
+
+    The correlations are averaged over the particles and the time origins.
+    The number of particles is assumed to be approximately constant.
+ */
+class MultiTauCorrelatorPlugin : public SimulationPlugin
+{
+public:
+    /** Create a MultiTauCorrelatorPlugin object.
+        \param [in] state The global state of the simulation.
+        \param [in] name The name of the plugin.
+        \param [in] pvName The name of the ParticleVector.
+        \param [in] channelName The name of the channel to correlate; must contain real3 or real4 (first three components are used).
+        \param [in] kind The correlation function.
+        \param [in] startTime The sampling starts at this time.
+        \param [in] sampleEvery The signal is sampled every this number of steps.
+        \param [in] dumpEvery The correlations are sent to the postprocess side every this number of steps.
+        \param [in] numLevels Number of blocks of the correlator.
+        \param [in] blockSize Number of values per block. Must be a multiple of 2.
+    */
+    MultiTauCorrelatorPlugin(const MirState *state, std::string name, std::string pvName, std::string channelName,
+                             multi_tau_correlator_plugin::CorrelationKind kind, MirState::TimeType startTime,
+                             int sampleEvery, int dumpEvery, int numLevels, int blockSize);
+
+    ~MultiTauCorrelatorPlugin();
+
+    void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
+
+    void afterIntegration(cudaStream_t stream) override;
+    void serializeAndSend(cudaStream_t stream) override;
+    void handshake() override;
+
+    bool needPostproc() override { return true; }
+
+private:
+    /// update the channel pointers of the history (they change when the particles are reordered)
+    void _updateStoragePointers(cudaStream_t stream);
+
+private:
+    std::string pvName_;
+    std::string channelName_;
+    ParticleVector *pv_ {nullptr};
+
+    multi_tau_correlator_plugin::CorrelationKind kind_;
+    MirState::TimeType startTime_;
+    int sampleEvery_;
+    int dumpEvery_;
+    bool needToSend_{false};
+    MirState::StepType startStep_{-1};
+
+    multi_tau::MultiTauSchedule schedule_;
+    PinnedBuffer<multi_tau::LevelState> states_;
+    PinnedBuffer<real3*> values_;       ///< device pointers to the history channels
+    PinnedBuffer<real3*> accumulators_; ///< device pointers to the accumulator channels
+
+    PinnedBuffer<multi_tau_correlator_plugin::ReductionType> localSums_; ///< sum of the correlations over particles and time origins
+    std::vector<double> localCounts_; ///< number of contributions to localSums_
+
+    MirState::TimeType savedTime_{0};
+    std::vector<char> sendBuffer_;
+
+    std::string previousPositionChannelName_;  ///< previous positions of the particles, when the signal is the positions
+    std::string totalDisplacementChannelName_; ///< unwrapped displacements of the particles, when the signal is the positions
+    std::vector<std::string> valueChannelNames_;
+    std::vector<std::string> accumulatorChannelNames_;
+};
+
+
+/** Postprocess side of MultiTauCorrelatorPlugin.
+    Rewrites the correlation function in a csv file at every dump.
+*/
+class MultiTauCorrelatorDumper : public PostprocessPlugin
+{
+public:
+    /** Create a MultiTauCorrelatorDumper object.
+        \param [in] name The name of the plugin.
+        \param [in] path The folder that will contain the csv file.
+    */
+    MultiTauCorrelatorDumper(std::string name, std::string path);
+
+    void deserialize() override;
+    void setup(const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+
+private:
+    std::string path_;
+    std::string fileName_;
+    bool activated_ = true;
+};
+
+} // namespace mirheo
@@ -9,6 +9,7 @@
 #include <mirheo/core/utils/cuda_rng.h>
 #include <mirheo/core/utils/kernel_launch.h>
 
+#include <algorithm>
 #include <memory>
 
 namespace mirheo
@@ -64,6 +65,11 @@ void OutletPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI
         pvs_.push_back( simulation->getPVbyNameOrDie(pvName) );
 }
 
+bool OutletPlugin::actsBeforeCellLists(const ParticleVector *pv) const
+{
+    return std::find(pvs_.begin(), pvs_.end(), pv) != pvs_.end();
+}
+
 
 PlaneOutletPlugin::PlaneOutletPlugin(const MirState *state, std::string name, std::vector<std::string> pvNames, real4 plane) :
     OutletPlugin(state, std::move(name), std::move(pvNames)),
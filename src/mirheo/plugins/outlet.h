@@ -3,6 +3,7 @@
 
 #include <mirheo/core/containers.h>
 #include <mirheo/core/plugins.h>
+#include <mirheo/core/utils/position_function.h>
 
 #include <functional>
 #include <memory>
@@ -32,6 +33,7 @@ public:
     ~OutletPlugin();
 
     void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    bool actsBeforeCellLists(const ParticleVector *pv) const override;
 
     bool needPostproc() override { return false; }
 
@@ -77,7 +79,7 @@ class RegionOutletPlugin : public OutletPlugin
 {
 public:
     /// A scalar field to represent inside (negative) / outside (positive) region
-    using RegionFunc = std::function<real(real3)>;
+    using RegionFunc = PositionFunction<real>;
 
     /** Create a RegionOutletPlugin.
         \param [in] state The global state of the simulation.
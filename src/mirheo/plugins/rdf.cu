@@ -110,6 +110,10 @@ void RdfPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Co
 {
     SimulationPlugin::setup(simulation, comm, interComm);
     pv_ = simulation->getPVbyNameOrDie(pvName_);
+
+    if (dynamic_cast<ObjectPrimaryCellList*>(simulation->gelCellList(pv_)) != nullptr)
+        die("Plugin '%s' can not be used with the in-place cell-lists of OV '%s'", getCName(), pvName_.c_str());
+
     cl_ = std::make_unique<CellList>(pv_, maxDist_, getState()->domain.localSize);
 }
 
@@ -0,0 +1,169 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "field_extraction.h"
+
+#include <mirheo/core/domain.h>
+#include <mirheo/core/marching_cubes.h>
+
+#include <cmath>
+
+namespace mirheo
+{
+
+namespace field_extraction
+{
+
+static inline real get(real3 v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+static inline int get(int3 v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+static inline void set(real3& v, int axis, real value)
+{
+    if      (axis == 0) v.x = value;
+    else if (axis == 1) v.y = value;
+    else                v.z = value;
+}
+
+namespace
+{
+/// The two cells and the weight of the second one used to interpolate along one axis.
+struct Stencil1D
+{
+    int i0, i1;
+    double w;
+};
+} // anonymous namespace
+
+/// \p u is the position in units of cells, relative to the center of the first cell
+static Stencil1D computeStencil(real u, int n)
+{
+    if (u <= 0)
+        return {0, 0, 0.0};
+
+    if (u >= static_cast<real>(n - 1))
+        return {n - 1, n - 1, 0.0};
+
+    const int i0 = static_cast<int>(std::floor(u));
+    return {i0, i0 + 1, static_cast<double>(u - static_cast<real>(i0))};
+}
+
+bool contains(const Grid& grid, real3 r)
+{
+    const real3 u = (r - grid.start) / grid.h;
+
+    return
+        u.x >= 0 && u.x < static_cast<real>(grid.resolution.x) &&
+        u.y >= 0 && u.y < static_cast<real>(grid.resolution.y) &&
+        u.z >= 0 && u.z < static_cast<real>(grid.resolution.z);
+}
+
+double interpolate(const Grid& grid, const Field& field, int component, real3 r)
+{
+    const real3 u = (r - grid.start) / grid.h - 0.5_r;
+    const int3 n = grid.resolution;
+
+    const Stencil1D sx = computeStencil(u.x, n.x);
+    const Stencil1D sy = computeStencil(u.y, n.y);
+    const Stencil1D sz = computeStencil(u.z, n.z);
+
+    auto value = [&](int ix, int iy, int iz)
+    {
+        const size_t cid = (static_cast<size_t>(iz) * n.y + iy) * n.x + ix;
+        return field.values[field.nComponents * cid + component];
+    };
+
+    auto lerp = [](double a, double b, double w) {return (1.0 - w) * a + w * b;};
+
+    const double v00 = lerp(value(sx.i0, sy.i0, sz.i0), value(sx.i1, sy.i0, sz.i0), sx.w);
+    const double v10 = lerp(value(sx.i0, sy.i1, sz.i0), value(sx.i1, sy.i1, sz.i0), sx.w);
+    const double v01 = lerp(value(sx.i0, sy.i0, sz.i1), value(sx.i1, sy.i0, sz.i1), sx.w);
+    const double v11 = lerp(value(sx.i0, sy.i1, sz.i1), value(sx.i1, sy.i1, sz.i1), sx.w);
+
+    return lerp(lerp(v00, v10, sy.w),
+                lerp(v01, v11, sy.w), sz.w);
+}
+
+void interpolateAll(const Grid& grid, const std::vector<Field>& fields, real3 r, double *dst)
+{
+    for (const auto& field : fields)
+        for (int c = 0; c < field.nComponents; ++c)
+            *(dst++) = interpolate(grid, field, c, r);
+}
+
+int totalComponents(const std::vector<Field>& fields)
+{
+    int n = 0;
+    for (const auto& field : fields)
+        n += field.nComponents;
+    return n;
+}
+
+int2 sliceAxes(int axis)
+{
+    return {axis == 0 ? 1 : 0,
+            axis == 2 ? 1 : 2};
+}
+
+bool extractSlice(const Grid& grid, const std::vector<Field>& fields, int axis, real position, std::vector<double>& slice)
+{
+    slice.clear();
+
+    const real u = (position - get(grid.start, axis)) / get(grid.h, axis);
+    if (u < 0 || u >= static_cast<real>(get(grid.resolution, axis)))
+        return false;
+
+    const int2 axes = sliceAxes(axis);
+    const int na = get(grid.resolution, axes.x);
+    const int nb = get(grid.resolution, axes.y);
+    const int nComponents = totalComponents(fields);
+
+    slice.resize(static_cast<size_t>(na) * nb * nComponents);
+
+    real3 r;
+    set(r, axis, position);
+
+    for (int ib = 0; ib < nb; ++ib)
+    {
+        set(r, axes.y, get(grid.start, axes.y) + (static_cast<real>(ib) + 0.5_r) * get(grid.h, axes.y));
+
+        for (int ia = 0; ia < na; ++ia)
+        {
+            set(r, axes.x, get(grid.start, axes.x) + (static_cast<real>(ia) + 0.5_r) * get(grid.h, axes.x));
+
+            const size_t pointId = static_cast<size_t>(ib) * na + ia;
+            interpolateAll(grid, fields, r, slice.data() + pointId * nComponents);
+        }
+    }
+    return true;
+}
+
+void extractIsosurface(const Grid& grid, const Field& field, int component, real isovalue,
+                       std::vector<real3>& vertices, std::vector<int3>& faces)
+{
+    const real3 size = grid.h * make_real3(grid.resolution);
+    const DomainInfo domain {size, grid.start, size};
+
+    auto surface = [&](const real3 *positions, int n, real *values)
+    {
+        for (int i = 0; i < n; ++i)
+            values[i] = static_cast<real>(interpolate(grid, field, component, positions[i])) - isovalue;
+    };
+
+    // slightly smaller than the cells so that the rounding does not remove one layer of cells
+    const real3 resolution = grid.h * (1.0_r - 1e-4_r);
+
+    marching_cubes::computeMesh(domain, resolution, marching_cubes::ImplicitSurfaceBatchFunction(surface),
+                                vertices, faces);
+
+    for (auto& v : vertices)
+        v = domain.local2global(v);
+}
+
+} // namespace field_extraction
+
+} // namespace mirheo
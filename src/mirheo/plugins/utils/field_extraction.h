@@ -0,0 +1,83 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+
+#include <vector>
+
+namespace mirheo
+{
+
+/** \brief Host utilities to extract reduced geometry (slices, probes, isosurfaces) from fields sampled on a uniform grid.
+
+    The fields are cell-centered on the grid, with the layout of Average3D: the value of component c of cell (ix, iy, iz)
+    is at index nComponents * ((iz * ny + iy) * nx + ix) + c.
+    Values between cell centers are interpolated trilinearly; outside of the centers, they are taken from the closest cell.
+ */
+namespace field_extraction
+{
+
+/// A uniform grid of cells.
+struct Grid
+{
+    int3 resolution; ///< number of cells along each direction
+    real3 h;         ///< size of one cell
+    real3 start;     ///< position of the lower corner of the grid
+};
+
+/// A field stored on a Grid.
+struct Field
+{
+    const double *values; ///< values of the field, see the layout above
+    int nComponents;      ///< number of components per cell
+};
+
+/// \return \c true if \p r is inside the grid; the upper faces are excluded so that each position belongs to one grid only.
+bool contains(const Grid& grid, real3 r);
+
+/// \return the interpolated value of the given component of \p field at position \p r
+double interpolate(const Grid& grid, const Field& field, int component, real3 r);
+
+/** \brief Interpolate all the components of several fields at a given position.
+    \param [in] grid The grid of the fields
+    \param [in] fields The fields to interpolate
+    \param [in] r The position
+    \param [out] dst The interpolated values, the components of the first field first; must hold the sum of the number of components
+ */
+void interpolateAll(const Grid& grid, const std::vector<Field>& fields, real3 r, double *dst);
+
+/// \return The sum of the number of components of \p fields
+int totalComponents(const std::vector<Field>& fields);
+
+/// \return The axes of the plane normal to \p axis, in the order used by extractSlice()
+int2 sliceAxes(int axis);
+
+/** \brief Interpolate fields on the centers of the cells projected on a plane normal to one of the axes.
+    \param [in] grid The grid of the fields
+    \param [in] fields The fields to interpolate
+    \param [in] axis The normal of the plane (0: x, 1: y, 2: z)
+    \param [in] position The position of the plane along \p axis
+    \param [out] slice The interpolated values of all the components (see interpolateAll()) of each point of the plane;
+                       the first axis returned by sliceAxes() is the fastest
+    \return \c false if the plane does not cross the grid; \p slice is then empty
+ */
+bool extractSlice(const Grid& grid, const std::vector<Field>& fields, int axis, real position, std::vector<double>& slice);
+
+/** \brief Compute the isosurface of one component of a field with marching cubes.
+    \param [in] grid The grid of the field
+    \param [in] field The field
+    \param [in] component The component of \p field
+    \param [in] isovalue The value of the field on the surface
+    \param [out] vertices The vertices of the surface, in the coordinates of the grid
+    \param [out] faces The triangles of the surface, as indices in \p vertices
+
+    The marching cubes grid is made of the corners of the cells.
+    As the field is taken from the closest cell near the faces of the grid, the surfaces of adjacent grids
+    might not match exactly on their common faces.
+ */
+void extractIsosurface(const Grid& grid, const Field& field, int component, real isovalue,
+                       std::vector<real3>& vertices, std::vector<int3>& faces);
+
+} // namespace field_extraction
+
+} // namespace mirheo
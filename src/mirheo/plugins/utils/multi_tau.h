@@ -0,0 +1,166 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+
+#include <vector>
+
+namespace mirheo
+{
+
+/** \brief Multiple-tau correlator, see Ramirez et al., J. Chem. Phys. 133, 154103 (2010).
+
+    The signal is stored in numLevels blocks of blockSize values.
+    Block 0 contains the last samples; block l > 0 contains averages of averaging^l consecutive samples,
+    obtained by averaging the values pushed to block l-1.
+    Correlations between the newest value of block l and its j-th predecessor correspond to a lag of
+    j * averaging^l samples.
+    Lags smaller than blockSize / averaging are computed only on block 0 (finer resolution).
+
+    This covers lags up to blockSize * averaging^(numLevels-1) samples with
+    numLevels * (blockSize + 1) stored values per signal.
+
+    All signals (e.g. all particles) are sampled at the same time: the position of the newest value in
+    each block, the number of stored values and the number of correlation contributions are the same
+    for all signals and are tracked once by MultiTauSchedule.
+    The per-signal part is multiTauUpdate().
+ */
+namespace multi_tau
+{
+
+/// Dimensions of the correlator.
+struct Layout
+{
+    int numLevels; ///< number of blocks
+    int blockSize; ///< number of values per block
+    int averaging; ///< number of values of block l averaged into one value of block l+1
+
+    /// \return the first lag index computed in block \p level
+    __HD__ inline int firstLagIndex(int level) const
+    {
+        return level == 0 ? 0 : blockSize / averaging;
+    }
+
+    /// \return the lag (in number of samples) of the correlation \p j of block \p level
+    __HD__ inline long lag(int level, int j) const
+    {
+        long l = j;
+        for (int i = 0; i < level; ++i)
+            l *= averaging;
+        return l;
+    }
+};
+
+/// Per-block state, common to all signals, of the current sample.
+struct LevelState
+{
+    int head;   ///< position of the newest value in the block
+    int filled; ///< number of valid values in the block
+};
+
+/** \brief Update the correlator of one signal with a new sample.
+    \tparam T The type of the signal; must support +, - and division by an integer
+    \tparam Storage Provides T& value(level, j) (the block values) and T& accumulator(level)
+    \tparam Correlation Callable T x T -> scalar; called with (newest, older)
+    \tparam Output Callable (level, j, scalar), receives the contributions to the correlations
+    \param [in] x The new sample
+    \param [in] layout The correlator dimensions
+    \param [in] nUpdated The number of blocks that receive a value at this sample (see MultiTauSchedule::push())
+    \param [in] states The state of each block, after MultiTauSchedule::push()
+    \param [in,out] storage The per-signal values
+    \param [in] correlation The correlation function
+    \param [in] output The contributions consumer
+
+    The loops depend only on the arguments that are common to all signals; this allows
+    to perform reductions across signals inside \p output.
+ */
+template <class T, class Storage, class Correlation, class Output>
+__HD__ inline void multiTauUpdate(T x, const Layout& layout, int nUpdated, const LevelState *states,
+                                  Storage& storage, Correlation correlation, Output output)
+{
+    for (int level = 0; level < nUpdated; ++level)
+    {
+        const LevelState s = states[level];
+        storage.value(level, s.head) = x;
+
+        for (int j = layout.firstLagIndex(level); j < s.filled; ++j)
+        {
+            const int k = (s.head - j + layout.blockSize) % layout.blockSize;
+            output(level, j, correlation(x, storage.value(level, k)));
+        }
+
+        if (level + 1 >= layout.numLevels)
+            break;
+
+        T& acc = storage.accumulator(level);
+        if (level + 1 < nUpdated)
+        {
+            // this block is complete: its average goes to the next block
+            x = (acc + x) / layout.averaging;
+            acc = T{};
+        }
+        else
+        {
+            acc = acc + x;
+        }
+    }
+}
+
+/** \brief Tracks the state common to all signals.
+ */
+class MultiTauSchedule
+{
+public:
+    /** \param [in] layout The correlator dimensions.
+        Requires blockSize to be a multiple of averaging.
+     */
+    MultiTauSchedule(Layout layout) :
+        layout_(layout),
+        states_(layout.numLevels, LevelState{layout.blockSize - 1, 0}),
+        accumulated_(layout.numLevels, 0),
+        counts_(layout.numLevels * layout.blockSize, 0)
+    {}
+
+    /** \brief Register a new sample.
+        \return The number of blocks that receive a new value.
+     */
+    int push()
+    {
+        int nUpdated = 0;
+        for (int level = 0; level < layout_.numLevels; ++level)
+        {
+            auto& s = states_[level];
+            s.head = (s.head + 1) % layout_.blockSize;
+            if (s.filled < layout_.blockSize)
+                ++s.filled;
+
+            for (int j = layout_.firstLagIndex(level); j < s.filled; ++j)
+                ++counts_[level * layout_.blockSize + j];
+
+            nUpdated = level + 1;
+
+            if (++accumulated_[level] < layout_.averaging)
+                break;
+            accumulated_[level] = 0;
+        }
+        return nUpdated;
+    }
+
+    const Layout& layout() const {return layout_;} ///< \return the dimensions of the correlator
+
+    /// \return the state of each block (numLevels entries)
+    const std::vector<LevelState>& states() const {return states_;}
+
+    /// \return the number of contributions to correlation \p j of block \p level, per signal
+    long count(int level, int j) const {return counts_[level * layout_.blockSize + j];}
+
+private:
+    Layout layout_;
+    std::vector<LevelState> states_;
+    std::vector<int> accumulated_;
+    std::vector<long> counts_;
+};
+
+} // namespace multi_tau
+
+} // namespace mirheo
@@ -3,8 +3,12 @@
 
 #include "../average_flow.h"
 
-#include <mirheo/core/utils/cuda_common.h>
 #include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/views/pv.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+#include <algorithm>
 
 namespace mirheo
 {
@@ -66,24 +70,111 @@ struct ChannelsInfo
 namespace sampling_helpers_kernels
 {
 
-__device__ inline void sampleChannels(int pid, int cid, ChannelsInfo channelsInfo)
+/// maximum number of reals per particle in a channel (Tensor6)
+constexpr int maxNcomponents = 6;
+
+/// \return the number of reals per bin in the average of a channel of the given type
+__HD__ inline int getNcomponents(Average3D::ChannelType type)
+{
+    if (type == Average3D::ChannelType::Scalar)  return 1;
+    if (type == Average3D::ChannelType::Tensor6) return 6;
+    return 3;
+}
+
+/// \return the number of reals per particle in the data of a channel of the given type
+__HD__ inline int getDataStride(Average3D::ChannelType type)
+{
+    if (type == Average3D::ChannelType::Vector_real4) return 4;
+    return getNcomponents(type);
+}
+
+/// \return the component \p c of the channel \p i of the particle \p pid
+__device__ inline real readComponent(const ChannelsInfo& channelsInfo, int i, int pid, int c)
+{
+    return channelsInfo.data[i][getDataStride(channelsInfo.types[i]) * pid + c];
+}
+
+/** \brief Add the channels of one particle to the bin \p cid
+    \param [in] pid The particle index
+    \param [in] cid The bin index
+    \param [in] channelsInfo The channels to sample
+    \param [in] getAverage Callable int -> real*; the bins of the channel with the given index
+ */
+template <class GetAverage>
+__device__ inline void sampleChannels(int pid, int cid, const ChannelsInfo& channelsInfo, GetAverage getAverage)
+{
+    for (int i = 0; i < channelsInfo.n; ++i)
+    {
+        const int nc = getNcomponents(channelsInfo.types[i]);
+        real *average = getAverage(i) + nc * cid;
+
+        for (int c = 0; c < nc; ++c)
+            atomicAdd(average + c, readComponent(channelsInfo, i, pid, c));
+    }
+}
+
+/// Add the channels of one particle to the global bin \p cid
+__device__ inline void sampleChannels(int pid, int cid, const ChannelsInfo& channelsInfo)
+{
+    sampleChannels(pid, cid, channelsInfo, [&](int i) {return channelsInfo.average[i];});
+}
+
+/** \brief Bin the particles with per-block bins in shared memory.
+    \tparam BinIndex Callable real3 -> int, the bin of a position
+    \param [in] view The particles to sample
+    \param [in] binIndex The bin index functor
+    \param [in] nbins The number of bins
+    \param [out] avgDensity The number of particles per bin
+    \param [out] channelsInfo The channels to sample
+
+    Each block accumulates a grid-stride range of particles into private bins and
+    adds them to the global bins once, instead of one global atomic per particle and component.
+    The dynamic shared memory must hold nbins * (1 + total number of components) reals.
+ */
+template <class BinIndex>
+__global__ void samplePrivatized(PVview view, BinIndex binIndex, int nbins, real *avgDensity, ChannelsInfo channelsInfo)
 {
+    extern __shared__ real bins[];
+
+    int nreals = nbins;
     for (int i = 0; i < channelsInfo.n; ++i)
+        nreals += nbins * getNcomponents(channelsInfo.types[i]);
+
+    for (int k = threadIdx.x; k < nreals; k += blockDim.x)
+        bins[k] = 0.0_r;
+
+    __syncthreads();
+
+    auto getAverage = [&](int i)
     {
-        if (channelsInfo.types[i] == Average3D::ChannelType::Scalar)
-            atomicAdd(channelsInfo.average[i] + cid, channelsInfo.data[i][pid]);
+        real *average = bins + nbins;
+        for (int j = 0; j < i; ++j)
+            average += nbins * getNcomponents(channelsInfo.types[j]);
+        return average;
+    };
 
-        if (channelsInfo.types[i] == Average3D::ChannelType::Vector_real3)
-            atomicAdd(((real3*)channelsInfo.average[i]) + cid, ((real3*)channelsInfo.data[i])[pid]);
+    for (int pid = threadIdx.x + blockIdx.x * blockDim.x; pid < view.size; pid += blockDim.x * gridDim.x)
+    {
+        const int cid = binIndex(make_real3(view.readPosition(pid)));
+
+        atomicAdd(bins + cid, 1.0_r);
+        sampleChannels(pid, cid, channelsInfo, getAverage);
+    }
 
-        if (channelsInfo.types[i] == Average3D::ChannelType::Vector_real4)
-            atomicAdd(((real3*)channelsInfo.average[i]) + cid, make_real3( ((real4*)channelsInfo.data[i])[pid] ));
+    __syncthreads();
+
+    for (int k = threadIdx.x; k < nbins; k += blockDim.x)
+        if (bins[k] != 0.0_r)
+            atomicAdd(avgDensity + k, bins[k]);
+
+    for (int i = 0; i < channelsInfo.n; ++i)
+    {
+        const real *average = getAverage(i);
+        const int n = nbins * getNcomponents(channelsInfo.types[i]);
 
-        if (channelsInfo.types[i] == Average3D::ChannelType::Tensor6)
-        {
-            atomicAdd(((real3*)channelsInfo.average[i]) + 2*cid + 0, ((real3*)channelsInfo.data[i])[2*pid + 0] );
-            atomicAdd(((real3*)channelsInfo.average[i]) + 2*cid + 1, ((real3*)channelsInfo.data[i])[2*pid + 1] );
-        }
+        for (int k = threadIdx.x; k < n; k += blockDim.x)
+            if (average[k] != 0.0_r)
+                atomicAdd(channelsInfo.average[i] + k, average[k]);
     }
 }
 
@@ -129,4 +220,39 @@ __global__ static void accumulate(int n, int fieldComponents, const real *src, d
 
 } // namespace sampling_helpers_kernels
 
+/// Bins are privatised in shared memory only if they fit in this size
+constexpr size_t maxPrivatizedBinsBytes = 48 * 1024;
+
+/// \return the size in bytes of the private bins of sampling_helpers_kernels::samplePrivatized()
+inline size_t getPrivatizedBinsBytes(int nbins, const Average3D::HostChannelsInfo& info)
+{
+    size_t nreals = nbins;
+    for (int i = 0; i < info.n; ++i)
+        nreals += nbins * sampling_helpers_kernels::getNcomponents(info.types[i]);
+    return nreals * sizeof(real);
+}
+
+/** \brief Launch sampling_helpers_kernels::samplePrivatized() if the bins fit in shared memory.
+    \return \c false if the bins are too large; nothing is launched in that case.
+ */
+template <class BinIndex>
+inline bool trySamplePrivatized(PVview view, BinIndex binIndex, int nbins, real *avgDensity,
+                                const Average3D::HostChannelsInfo& hostInfo, ChannelsInfo channelsInfo, cudaStream_t stream)
+{
+    const size_t sharedBytes = getPrivatizedBinsBytes(nbins, hostInfo);
+    if (sharedBytes > maxPrivatizedBinsBytes)
+        return false;
+
+    // each block processes at least as many particles as there are bins, to amortise the flush
+    const int nthreads = 128;
+    const int nblocks = std::min(getNblocks(view.size, nthreads), std::max(1, view.size / nbins));
+
+    SAFE_KERNEL_LAUNCH
+        (sampling_helpers_kernels::samplePrivatized<BinIndex>,
+         nblocks, nthreads, sharedBytes, stream,
+         view, binIndex, nbins, avgDensity, channelsInfo);
+
+    return true;
+}
+
 } // namespace mirheo
@@ -0,0 +1,64 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mirheo
+{
+
+/** \brief Choice of the time step from bounds on the velocity and acceleration of the particles.
+
+    The largest time step for which no particle travels further than \f$ d \f$ is the positive root of
+    \f$ v \Delta t + a \Delta t^2 / 2 = d \f$, where \f$ v \f$ and \f$ a \f$ are the largest velocity and
+    acceleration norms.
+    It is reached with a hysteresis: the time step decreases immediately, but only increases by steps of
+    \f$ 1 + h \f$, when the limit exceeds \f$ (1 + h)^2 \f$ times the current time step.
+ */
+namespace time_step_controller
+{
+
+/// Parameters of the controller.
+struct Parameters
+{
+    real dtMin;           ///< smallest allowed time step
+    real dtMax;           ///< largest allowed time step
+    real maxDisplacement; ///< largest distance travelled by a particle in one time step
+    real hysteresis;      ///< relative margin before increasing the time step
+};
+
+/** \return The largest time step for which the particles travel at most \p maxDisplacement;
+    infinite if the particles are at rest.
+ */
+inline real displacementLimit(real maxVelocity, real maxAcceleration, real maxDisplacement)
+{
+    // 2d / (v + sqrt(v^2 + 2ad)) avoids the cancellation of (sqrt(v^2 + 2ad) - v) / a
+    const real denominator = maxVelocity + std::sqrt(maxVelocity * maxVelocity + 2 * maxAcceleration * maxDisplacement);
+    return 2 * maxDisplacement / denominator;
+}
+
+/** \return The time step to use after \p dt, given the current largest velocity and acceleration norms.
+    Non finite bounds (e.g. from diverging particles) give the smallest time step.
+ */
+inline real nextTimeStep(const Parameters& p, real dt, real maxVelocity, real maxAcceleration)
+{
+    if (!std::isfinite(maxVelocity) || !std::isfinite(maxAcceleration))
+        return p.dtMin;
+
+    const real limit = displacementLimit(maxVelocity, maxAcceleration, p.maxDisplacement);
+    const real growth = 1 + p.hysteresis;
+
+    real next = dt;
+
+    if (limit < dt)
+        next = limit;
+    else if (limit > growth * growth * dt)
+        next = growth * dt;
+
+    return std::min(std::max(next, p.dtMin), p.dtMax);
+}
+
+} // namespace time_step_controller
+} // namespace mirheo
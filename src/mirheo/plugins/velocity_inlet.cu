@@ -150,30 +150,42 @@ void VelocityInletPlugin::setup(Simulation *simulation, const MPI_Comm& comm, co
 
     pv_ = simulation->getPVbyNameOrDie(pvName_);
 
-    std::vector<marching_cubes::Triangle> triangles;
-    marching_cubes::computeTriangles(getState()->domain, resolution_, implicitSurface_, triangles);
+    auto surface = [this](const real3 *positions, int n, real *values)
+    {
+        implicitSurface_(positions, n, values);
+    };
+
+    std::vector<real3> vertices;
+    std::vector<int3> faces;
+    marching_cubes::computeMesh(getState()->domain, resolution_, surface, vertices, faces);
 
-    const int nTriangles = triangles.size();
+    const int nTriangles = static_cast<int>(faces.size());
 
     surfaceTriangles_.resize_anew(nTriangles * 3);
     surfaceVelocity_ .resize_anew(nTriangles * 3);
 
+    // evaluate the velocity once per vertex of the mesh
+    std::vector<real3> globalVertices(vertices.size());
+    std::vector<real3> vertexVelocities(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); ++i)
+        globalVertices[i] = getState()->domain.local2global(vertices[i]);
+
+    velocityField_(globalVertices.data(), static_cast<int>(vertices.size()), vertexVelocities.data());
+
     {
         size_t i = 0;
-        for (const auto& t : triangles)
+        for (const auto& f : faces)
         {
-            surfaceTriangles_[i++] = t.a;
-            surfaceTriangles_[i++] = t.b;
-            surfaceTriangles_[i++] = t.c;
+            for (int vid : {f.x, f.y, f.z})
+            {
+                surfaceTriangles_[i] = vertices[vid];
+                surfaceVelocity_ [i] = vertexVelocities[vid];
+                ++i;
+            }
         }
     }
 
-    for (size_t i = 0; i < surfaceTriangles_.size(); ++i)
-    {
-        const real3 r = getState()->domain.local2global(surfaceTriangles_[i]);
-        surfaceVelocity_[i] = velocityField_(r);
-    }
-
     surfaceTriangles_.uploadToDevice(defaultStream);
     surfaceVelocity_ .uploadToDevice(defaultStream);
 
@@ -3,6 +3,7 @@
 
 #include <mirheo/core/containers.h>
 #include <mirheo/core/plugins.h>
+#include <mirheo/core/utils/position_function.h>
 
 #include <functional>
 #include <random>
@@ -20,10 +21,10 @@ class VelocityInletPlugin : public SimulationPlugin
 public:
 
     /// Representation of a surface from a scalar field.
-    using ImplicitSurfaceFunc = std::function<real(real3)>;
+    using ImplicitSurfaceFunc = PositionFunction<real>;
 
     /// Velocity field used to describe the inflow.
-    using VelocityFieldFunc = std::function<real3(real3)>;
+    using VelocityFieldFunc = PositionFunction<real3>;
 
     /** Create a VelocityInletPlugin object.
         \param [in] state The global state of the simulation.
@@ -43,6 +44,7 @@ public:
 
     void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
     void beforeCellLists(cudaStream_t stream) override;
+    bool actsBeforeCellLists(const ParticleVector *pv) const override { return pv == pv_; }
 
     bool needPostproc() override { return false; }
 
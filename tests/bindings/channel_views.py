@@ -0,0 +1,52 @@
+#!/usr/bin/env python
+
+import numpy as np
+import mirheo as mir
+
+def main():
+    ranks  = (1, 1, 1)
+    domain = [16, 16, 16]
+
+    dt   = 1e-3
+    mass = 1.0
+
+    u = mir.Mirheo(ranks, domain, debug_level=3, log_filename='log', no_splash=True)
+
+    pv = mir.ParticleVectors.ParticleVector("pv", mass)
+
+    n = 5
+    pos = [[1 + i, 2, 3] for i in range(n)]
+    vel = [[0, 0, 0] for i in range(n)]
+    u.registerParticleVector(pv, mir.InitialConditions.FromArray(pos, vel))
+
+    u.run(1, dt=dt)
+
+    if u.isComputeTask():
+        positions = pv.getParticleChannel("positions")
+        positions.download()
+        r = np.asarray(positions)
+
+        # the view holds local coordinates; the 4th lane (particle id) is not exposed
+        err = np.max(np.abs(r + np.array(domain) / 2 - np.array(pv.getCoordinates())))
+        print("positions shape =", r.shape)
+        print("max position error =", err)
+
+        velocities = pv.getParticleChannel("velocities")
+        velocities.download()
+        v = np.asarray(velocities)
+        v[:,0] = 1
+        v[:,1] = 2
+        v[:,2] = 3
+        velocities.upload()
+
+        print("velocities =", np.unique(np.array(pv.getVelocities()), axis=0).tolist())
+
+    del u
+
+if __name__ == '__main__':
+    main()
+
+# TEST: bindings.channel_views
+# cd bindings
+# rm -rf channel_views.out.txt
+# mir.run --runargs "-n 2" ./channel_views.py > channel_views.out.txt
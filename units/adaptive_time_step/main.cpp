@@ -0,0 +1,91 @@
+#include <mirheo/plugins/utils/time_step_controller.h>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+using namespace mirheo;
+
+static time_step_controller::Parameters makeParameters()
+{
+    time_step_controller::Parameters p;
+    p.dtMin = 1e-4_r;
+    p.dtMax = 1e-1_r;
+    p.maxDisplacement = 0.1_r;
+    p.hysteresis = 0.2_r;
+    return p;
+}
+
+TEST (ADAPTIVE_TIME_STEP, limit_is_root_of_displacement)
+{
+    const real d = 0.1_r;
+
+    for (real v : {0.0_r, 0.5_r, 3.0_r, 100.0_r})
+    {
+        for (real a : {0.0_r, 1.0_r, 50.0_r, 1e4_r})
+        {
+            if (v == 0 && a == 0)
+                continue;
+
+            const real dt = time_step_controller::displacementLimit(v, a, d);
+            ASSERT_NEAR(v * dt + 0.5_r * a * dt * dt, d, 1e-5_r * d);
+        }
+    }
+}
+
+TEST (ADAPTIVE_TIME_STEP, particles_at_rest_have_no_limit)
+{
+    const real dt = time_step_controller::displacementLimit(0.0_r, 0.0_r, 0.1_r);
+    ASSERT_TRUE(std::isinf(dt));
+
+    const auto p = makeParameters();
+    ASSERT_EQ(time_step_controller::nextTimeStep(p, p.dtMax, 0.0_r, 0.0_r), p.dtMax);
+}
+
+TEST (ADAPTIVE_TIME_STEP, decreases_immediately)
+{
+    const auto p = makeParameters();
+    const real v = 10.0_r;
+    const real limit = time_step_controller::displacementLimit(v, 0.0_r, p.maxDisplacement);
+
+    ASSERT_NEAR(time_step_controller::nextTimeStep(p, 0.05_r, v, 0.0_r), limit, 1e-6_r);
+}
+
+TEST (ADAPTIVE_TIME_STEP, increases_with_hysteresis)
+{
+    const auto p = makeParameters();
+    const real dt = 0.01_r;
+    const real growth = 1 + p.hysteresis;
+
+    // v such that the limit is slightly above dt: keep the current time step
+    const real vSlow = p.maxDisplacement / (1.1_r * dt);
+    ASSERT_EQ(time_step_controller::nextTimeStep(p, dt, vSlow, 0.0_r), dt);
+
+    // limit above (1+h)^2 dt: grow by a factor 1+h only
+    const real vFast = p.maxDisplacement / (2.0_r * dt);
+    ASSERT_NEAR(time_step_controller::nextTimeStep(p, dt, vFast, 0.0_r), growth * dt, 1e-7_r);
+}
+
+TEST (ADAPTIVE_TIME_STEP, clamped_to_bounds)
+{
+    const auto p = makeParameters();
+
+    ASSERT_EQ(time_step_controller::nextTimeStep(p, p.dtMin, 1e6_r, 0.0_r), p.dtMin);
+    ASSERT_EQ(time_step_controller::nextTimeStep(p, 0.09_r, 0.0_r, 0.0_r), p.dtMax);
+}
+
+TEST (ADAPTIVE_TIME_STEP, non_finite_bounds_give_smallest_time_step)
+{
+    const auto p = makeParameters();
+    const real inf = std::numeric_limits<real>::infinity();
+    const real nan = std::numeric_limits<real>::quiet_NaN();
+
+    ASSERT_EQ(time_step_controller::nextTimeStep(p, 0.01_r, inf, 0.0_r), p.dtMin);
+    ASSERT_EQ(time_step_controller::nextTimeStep(p, 0.01_r, 1.0_r, nan), p.dtMin);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
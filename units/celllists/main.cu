@@ -6,11 +6,15 @@
 #include <cuda.h>
 #include <cassert>
 #include <algorithm>
+#include <random>
 
+#include <mirheo/core/pvs/object_vector.h>
 #include <mirheo/core/pvs/particle_vector.h>
 #include <mirheo/core/celllist.h>
 #include <mirheo/core/logger.h>
 #include <mirheo/core/initial_conditions/uniform.h>
+#include <mirheo/core/integrators/forcing_terms/none.h>
+#include <mirheo/core/integrators/vv.h>
 
 #include <gtest/gtest.h>
 
@@ -151,6 +155,312 @@ TEST (CELLLISTS, DensityVaries)
     test_domain(domain, rc, 8.0, ncalls);
 }
 
+static std::vector<std::vector<int64_t>> idsPerCell(ParticleVector& pv, CellList& cl)
+{
+    auto& positions  = pv.local()->positions();
+    auto& velocities = pv.local()->velocities();
+    positions .downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    velocities.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    HostBuffer<int> starts(cl.totcells+1);
+    starts.copy(cl.cellStarts, defaultStream);
+    CUDA_Check( cudaStreamSynchronize(defaultStream) );
+
+    std::vector<std::vector<int64_t>> ids(cl.totcells);
+    for (int cid = 0; cid < cl.totcells; ++cid)
+    {
+        for (int pid = starts[cid]; pid < starts[cid+1]; ++pid)
+            ids[cid].push_back(Particle(positions[pid], velocities[pid]).getId());
+        std::sort(ids[cid].begin(), ids[cid].end());
+    }
+    return ids;
+}
+
+static void displaceParticles(ParticleVector& pv, real3 length, int step)
+{
+    auto& positions = pv.local()->positions();
+    positions.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    for (auto& r : positions)
+    {
+        // same displacement for the same particle, whatever its position in the array
+        std::mt19937 gen(static_cast<unsigned>(Real3_int(r).i * 97 + step));
+        std::uniform_real_distribution<real> u(-0.1_r, 0.1_r);
+
+        r.x = std::min(0.499_r * length.x, std::max(-0.499_r * length.x, r.x + u(gen)));
+        r.y = std::min(0.499_r * length.y, std::max(-0.499_r * length.y, r.y + u(gen)));
+        r.z = std::min(0.499_r * length.z, std::max(-0.499_r * length.z, r.z + u(gen)));
+    }
+    positions.uploadToDevice(defaultStream);
+    pv.cellListStamp++;
+}
+
+void test_incremental(real3 length, real rc, real density, int nsteps)
+{
+    DomainInfo domain{length, {0,0,0}, length};
+    real dt = 0; // dummy dt
+    MirState state(domain, dt, UnitConversion{});
+
+    ParticleVector pvFull(&state, "full", 1.0f);
+    ParticleVector pvIncr(&state, "incr", 1.0f);
+    PrimaryCellList clFull(&pvFull, rc, length);
+    PrimaryCellList clIncr(&pvIncr, rc, length);
+    clIncr.setIncrementalBuild(true);
+
+    UniformIC ic(density);
+    ic.exec(MPI_COMM_WORLD, &pvFull, 0);
+
+    const int np = pvFull.local()->size();
+    pvIncr.local()->resize_anew(np);
+    std::copy(pvFull.local()->positions ().begin(), pvFull.local()->positions ().end(), pvIncr.local()->positions ().begin());
+    std::copy(pvFull.local()->velocities().begin(), pvFull.local()->velocities().end(), pvIncr.local()->velocities().begin());
+    pvIncr.local()->positions ().uploadToDevice(defaultStream);
+    pvIncr.local()->velocities().uploadToDevice(defaultStream);
+
+    for (int step = 0; step < nsteps; ++step)
+    {
+        clFull.build(defaultStream);
+        clIncr.build(defaultStream);
+
+        ASSERT_EQ(pvFull.local()->size(), pvIncr.local()->size());
+        ASSERT_EQ(idsPerCell(pvFull, clFull), idsPerCell(pvIncr, clIncr));
+
+        displaceParticles(pvFull, length, step);
+        displaceParticles(pvIncr, length, step);
+    }
+}
+
+TEST (CELLLISTS, IncrementalMatchesFull)
+{
+    const int nsteps = 10;
+    test_incremental(make_real3(16, 16, 16), 1.0, 8.0, nsteps);
+    test_incremental(make_real3(32, 16, 8),  1.2, 4.0, nsteps);
+}
+
+static void setRandomForces(ParticleVector& pv, int step)
+{
+    auto& forces = pv.local()->forces();
+    std::mt19937 gen(42 + step);
+    std::uniform_real_distribution<real> u(-2000.0_r, 2000.0_r);
+
+    for (auto& f : forces)
+        f.f = make_real3(u(gen), u(gen), u(gen));
+    forces.uploadToDevice(defaultStream);
+}
+
+// emulates the redistribution: marks the particles that left the subdomain and appends new ones
+static void redistribute(ParticleVector& pv, const CellList& cl, real3 length, int step)
+{
+    auto lpv = pv.local();
+    lpv->positions ().downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    lpv->velocities().downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    std::vector<real4> pos(lpv->positions ().begin(), lpv->positions ().end());
+    std::vector<real4> vel(lpv->velocities().begin(), lpv->velocities().end());
+
+    for (auto& r : pos)
+    {
+        if (cl.getCellId<CellListsProjection::NoClamp>(make_real3(r)) < 0)
+        {
+            Real3_int ri(r);
+            ri.mark();
+            r = ri.toReal4();
+        }
+    }
+
+    const int nArrived = 50;
+    std::mt19937 gen(step);
+    std::uniform_real_distribution<real> u(-0.5_r, 0.5_r);
+
+    for (int i = 0; i < nArrived; ++i)
+    {
+        Particle p;
+        p.r = make_real3(u(gen) * length.x, u(gen) * length.y, u(gen) * length.z);
+        p.u = make_real3(0.0_r);
+        p.setId(1000000 + step * nArrived + i);
+        pos.push_back(p.r2Real4());
+        vel.push_back(p.u2Real4());
+    }
+
+    lpv->resize(static_cast<int>(pos.size()), defaultStream);
+    std::copy(pos.begin(), pos.end(), lpv->positions ().begin());
+    std::copy(vel.begin(), vel.end(), lpv->velocities().begin());
+    lpv->positions ().uploadToDevice(defaultStream);
+    lpv->velocities().uploadToDevice(defaultStream);
+}
+
+static bool allForcesZero(ParticleVector& pv)
+{
+    auto& forces = pv.local()->forces();
+    forces.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    for (const auto& f : forces)
+        if (f.f.x != 0 || f.f.y != 0 || f.f.z != 0 || f.i != 0)
+            return false;
+    return true;
+}
+
+void test_fused_integration(real3 length, real rc, real density, int nsteps)
+{
+    DomainInfo domain{length, {0,0,0}, length};
+    real dt = 0.01;
+    MirState state(domain, dt, UnitConversion{});
+
+    ParticleVector pvSep  (&state, "separate", 1.0f);
+    ParticleVector pvFused(&state, "fused",    1.0f);
+    PrimaryCellList clSep  (&pvSep,   rc, length);
+    PrimaryCellList clFused(&pvFused, rc, length);
+
+    IntegratorVV<ForcingTermNone> integrator(&state, "vv", ForcingTermNone{});
+
+    UniformIC ic(density);
+    ic.exec(MPI_COMM_WORLD, &pvSep, 0);
+
+    const int np = pvSep.local()->size();
+    pvFused.local()->resize_anew(np);
+    std::copy(pvSep.local()->positions ().begin(), pvSep.local()->positions ().end(), pvFused.local()->positions ().begin());
+    std::copy(pvSep.local()->velocities().begin(), pvSep.local()->velocities().end(), pvFused.local()->velocities().begin());
+    pvFused.local()->positions ().uploadToDevice(defaultStream);
+    pvFused.local()->velocities().uploadToDevice(defaultStream);
+
+    clSep  .build(defaultStream);
+    clFused.build(defaultStream);
+
+    for (int step = 0; step < nsteps; ++step)
+    {
+        // same particles in the same order in both
+        ASSERT_EQ(pvSep.local()->size(), pvFused.local()->size());
+        setRandomForces(pvSep,   step);
+        setRandomForces(pvFused, step);
+
+        integrator.execute(&pvSep, defaultStream);
+        integrator.executeAndBin(&pvFused, &clFused, defaultStream);
+
+        redistribute(pvSep,   clSep,   length, step);
+        redistribute(pvFused, clFused, length, step);
+
+        clSep  .build(defaultStream);
+        clFused.build(defaultStream);
+        pvSep.local()->forces().clear(defaultStream);
+
+        ASSERT_TRUE(clFused.hasClearedForces());
+        ASSERT_TRUE(allForcesZero(pvFused));
+        ASSERT_EQ(pvSep.local()->size(), pvFused.local()->size());
+        ASSERT_EQ(idsPerCell(pvSep, clSep), idsPerCell(pvFused, clFused));
+
+        HostBuffer<int> sizesSep(clSep.totcells + 1), sizesFused(clFused.totcells + 1);
+        sizesSep  .copy(clSep  .cellSizes, defaultStream);
+        sizesFused.copy(clFused.cellSizes, defaultStream);
+        CUDA_Check( cudaStreamSynchronize(defaultStream) );
+        ASSERT_TRUE(std::equal(sizesSep.begin(), sizesSep.end(), sizesFused.begin()));
+
+        // make the order within the cells identical for the next step
+        std::copy(pvFused.local()->positions ().begin(), pvFused.local()->positions ().end(), pvSep.local()->positions ().begin());
+        std::copy(pvFused.local()->velocities().begin(), pvFused.local()->velocities().end(), pvSep.local()->velocities().begin());
+        pvSep.local()->positions ().uploadToDevice(defaultStream);
+        pvSep.local()->velocities().uploadToDevice(defaultStream);
+    }
+}
+
+TEST (CELLLISTS, FusedIntegrationMatchesSeparate)
+{
+    const int nsteps = 5;
+    test_fused_integration(make_real3(16, 16, 16), 1.0, 8.0, nsteps);
+    test_fused_integration(make_real3(32, 16, 8),  1.2, 4.0, nsteps);
+}
+
+void test_object_primary(real3 length, real rc, int objSize, int nObjects)
+{
+    DomainInfo domain{length, {0,0,0}, length};
+    real dt = 0; // dummy dt
+    MirState state(domain, dt, UnitConversion{});
+
+    ObjectVector ov(&state, "ov", 1.0f, objSize, nObjects);
+    ObjectPrimaryCellList cl(&ov, rc, length);
+
+    auto lov = ov.local();
+    auto& positions  = lov->positions();
+    auto& velocities = lov->velocities();
+    auto& globalIds  = *lov->dataPerObject.getData<int64_t>(channel_names::globalIds);
+
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<real> ucenter(-0.45_r, 0.45_r);
+    std::uniform_real_distribution<real> uoffset(-0.4_r, 0.4_r);
+
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        const real3 center = make_real3(ucenter(gen) * length.x, ucenter(gen) * length.y, ucenter(gen) * length.z);
+        globalIds[objId] = objId;
+
+        for (int i = 0; i < objSize; ++i)
+        {
+            Particle p;
+            p.r = center + make_real3(uoffset(gen), uoffset(gen), uoffset(gen));
+            p.u = make_real3(0.0_r);
+            p.setId(objId * objSize + i);
+            positions [objId * objSize + i] = p.r2Real4();
+            velocities[objId * objSize + i] = p.u2Real4();
+        }
+    }
+    positions .uploadToDevice(defaultStream);
+    velocities.uploadToDevice(defaultStream);
+    globalIds .uploadToDevice(defaultStream);
+
+    cl.sortObjects(defaultStream);
+    cl.build(defaultStream);
+
+    positions .downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    velocities.downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    globalIds .downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    // the particles follow their object and stay contiguous; the objects are sorted by cell
+    int prevCid = -1;
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        real3 com = make_real3(0.0_r);
+        for (int i = 0; i < objSize; ++i)
+        {
+            const Particle p(positions[objId * objSize + i], velocities[objId * objSize + i]);
+            ASSERT_EQ(p.getId(), globalIds[objId] * objSize + i);
+            com += p.r;
+        }
+        com *= 1.0_r / objSize;
+
+        const int cid = cl.getCellId(com);
+        ASSERT_LE(prevCid, cid);
+        prevCid = cid;
+    }
+
+    // the cell ranges contain the indices of all the particles of the cell
+    const int np = lov->size();
+    HostBuffer<int> starts(cl.totcells+1), particleIds(np);
+    starts     .copy(cl.cellStarts,   defaultStream);
+    particleIds.copy(cl.particleIds_, defaultStream);
+    CUDA_Check( cudaStreamSynchronize(defaultStream) );
+
+    ASSERT_EQ(starts[cl.totcells], np);
+
+    std::vector<int> counts(np, 0);
+    for (int cid = 0; cid < cl.totcells; ++cid)
+    {
+        for (int k = starts[cid]; k < starts[cid+1]; ++k)
+        {
+            const int pid = particleIds[k];
+            ASSERT_EQ(cid, cl.getCellId(make_real3(positions[pid])));
+            counts[pid]++;
+        }
+    }
+
+    for (auto c : counts)
+        ASSERT_EQ(c, 1);
+}
+
+TEST (CELLLISTS, ObjectPrimarySortsObjectsInPlace)
+{
+    test_object_primary(make_real3(16, 16, 16), 1.0, 8,  500);
+    test_object_primary(make_real3(32, 16, 8),  1.2, 27, 200);
+}
+
 int main(int argc, char **argv)
 {
     MPI_Init(&argc, &argv);
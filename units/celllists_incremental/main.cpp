@@ -0,0 +1,269 @@
+#include <mirheo/core/celllist_incremental.h>
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+// host version of the particles data as seen by the cell-lists: only the cell index matters
+struct Particle
+{
+    int id;
+    int cid; ///< -1 if leaving the subdomain
+};
+
+struct Layout
+{
+    std::vector<Particle> particles;
+    std::vector<int> cellStarts;
+};
+
+static std::vector<int> exclusiveScan(const std::vector<int>& v)
+{
+    std::vector<int> res(v.size() + 1, 0);
+    std::partial_sum(v.begin(), v.end(), res.begin() + 1);
+    return res;
+}
+
+// reference: rebuild from scratch with a stable sort
+static Layout fullBuild(const std::vector<Particle>& particles, int totcells)
+{
+    Layout l;
+    for (auto p : particles)
+        if (p.cid >= 0)
+            l.particles.push_back(p);
+
+    std::stable_sort(l.particles.begin(), l.particles.end(),
+                     [](Particle a, Particle b) {return a.cid < b.cid;});
+
+    std::vector<int> sizes(totcells, 0);
+    for (auto p : l.particles)
+        ++sizes[p.cid];
+    l.cellStarts = exclusiveScan(sizes);
+    return l;
+}
+
+// same steps as PrimaryCellList::_reorderPositionsAndCreateMapIncremental, executed serially
+static Layout incrementalBuild(const std::vector<Particle>& particles, const std::vector<int>& prevCellStarts, int totcells)
+{
+    const int n = static_cast<int>(particles.size());
+
+    std::vector<int> stayFlags(n);
+    std::vector<int> moverIds;
+    for (int pid = 0; pid < n; ++pid)
+    {
+        const int cid = particles[pid].cid;
+        const bool stay = incremental_cell_list::isStayer(pid, cid, prevCellStarts.data(), totcells);
+        stayFlags[pid] = stay;
+        if (!stay && cid >= 0)
+            moverIds.push_back(pid);
+    }
+    const auto stayScan = exclusiveScan(stayFlags);
+
+    std::stable_sort(moverIds.begin(), moverIds.end(),
+                     [&](int a, int b) {return particles[a].cid < particles[b].cid;});
+
+    const int nMovers = static_cast<int>(moverIds.size());
+    std::vector<int> sortedMoverCells(nMovers);
+    for (int k = 0; k < nMovers; ++k)
+        sortedMoverCells[k] = particles[moverIds[k]].cid;
+
+    std::vector<int> sizes(totcells);
+    for (int cid = 0; cid < totcells; ++cid)
+        sizes[cid] = incremental_cell_list::numStayers(cid, prevCellStarts.data(), stayScan.data(), n)
+            + incremental_cell_list::numMovers(cid, sortedMoverCells.data(), nMovers);
+
+    Layout l;
+    l.cellStarts = exclusiveScan(sizes);
+    l.particles.assign(l.cellStarts[totcells], Particle{-1, -1});
+
+    auto place = [&](int dst, int pid)
+    {
+        ASSERT_GE(dst, 0);
+        ASSERT_LT(dst, static_cast<int>(l.particles.size()));
+        ASSERT_EQ(l.particles[dst].id, -1); // no two particles at the same place
+        l.particles[dst] = particles[pid];
+    };
+
+    for (int pid = 0; pid < n; ++pid)
+        if (stayFlags[pid])
+            place(incremental_cell_list::stayerDestination(pid, particles[pid].cid, l.cellStarts.data(),
+                                                           prevCellStarts.data(), stayScan.data()), pid);
+
+    for (int k = 0; k < nMovers; ++k)
+    {
+        const int pid = moverIds[k];
+        const int cid = particles[pid].cid;
+        const int nstayers = incremental_cell_list::numStayers(cid, prevCellStarts.data(), stayScan.data(), n);
+        place(incremental_cell_list::moverDestination(k, cid, l.cellStarts.data(), nstayers,
+                                                      sortedMoverCells.data(), nMovers), pid);
+    }
+
+    return l;
+}
+
+static std::vector<int> sortedIdsInCell(const Layout& l, int cid)
+{
+    std::vector<int> ids;
+    for (int i = l.cellStarts[cid]; i < l.cellStarts[cid+1]; ++i)
+    {
+        EXPECT_EQ(l.particles[i].cid, cid);
+        ids.push_back(l.particles[i].id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+static void checkSameCells(const Layout& a, const Layout& b, int totcells)
+{
+    ASSERT_EQ(a.cellStarts, b.cellStarts);
+    for (int cid = 0; cid < totcells; ++cid)
+        ASSERT_EQ(sortedIdsInCell(a, cid), sortedIdsInCell(b, cid));
+}
+
+// move a fraction of the particles to another cell, remove some and add new ones
+static std::vector<Particle> perturb(const std::vector<Particle>& particles, int totcells,
+                                     double moveFraction, double leaveFraction, int nNew,
+                                     int& nextId, std::mt19937& gen)
+{
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::uniform_int_distribution<int> cell(0, totcells - 1);
+    std::uniform_int_distribution<int> step(-1, 1);
+
+    auto res = particles;
+    for (auto& p : res)
+    {
+        const double r = u(gen);
+        if (r < leaveFraction)
+            p.cid = -1;
+        else if (r < leaveFraction + moveFraction)
+            p.cid = std::min(totcells - 1, std::max(0, p.cid + step(gen)));
+    }
+
+    for (int i = 0; i < nNew; ++i)
+        res.push_back({nextId++, cell(gen)});
+
+    return res;
+}
+
+static std::vector<Particle> randomParticles(int n, int totcells, int& nextId, std::mt19937& gen)
+{
+    std::uniform_int_distribution<int> cell(0, totcells - 1);
+    std::vector<Particle> particles;
+    for (int i = 0; i < n; ++i)
+        particles.push_back({nextId++, cell(gen)});
+    return particles;
+}
+
+TEST (INCREMENTAL_CELLLISTS, first_build_matches_full_build)
+{
+    const int totcells = 100;
+    std::mt19937 gen(1234);
+    int nextId = 0;
+    const auto particles = randomParticles(2000, totcells, nextId, gen);
+
+    const std::vector<int> emptyStarts(totcells + 1, 0);
+    const auto ref = fullBuild(particles, totcells);
+    const auto inc = incrementalBuild(particles, emptyStarts, totcells);
+
+    checkSameCells(ref, inc, totcells);
+
+    // without previous build, every particle is a mover: same order as the stable sort
+    for (size_t i = 0; i < ref.particles.size(); ++i)
+        ASSERT_EQ(ref.particles[i].id, inc.particles[i].id);
+}
+
+TEST (INCREMENTAL_CELLLISTS, successive_builds_match_full_build)
+{
+    const int totcells = 64;
+    std::mt19937 gen(4321);
+    int nextId = 0;
+
+    auto layout = fullBuild(randomParticles(3000, totcells, nextId, gen), totcells);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        const auto particles = perturb(layout.particles, totcells, 0.05, 0.01, 30, nextId, gen);
+
+        const auto ref = fullBuild(particles, totcells);
+        const auto inc = incrementalBuild(particles, layout.cellStarts, totcells);
+
+        checkSameCells(ref, inc, totcells);
+        layout = inc;
+    }
+}
+
+TEST (INCREMENTAL_CELLLISTS, stayers_keep_their_order_and_come_first)
+{
+    const int totcells = 16;
+    std::mt19937 gen(5678);
+    int nextId = 0;
+
+    const auto prev = fullBuild(randomParticles(500, totcells, nextId, gen), totcells);
+    const auto particles = perturb(prev.particles, totcells, 0.2, 0.05, 20, nextId, gen);
+    const auto inc = incrementalBuild(particles, prev.cellStarts, totcells);
+
+    const int n = static_cast<int>(particles.size());
+    std::vector<int> rank(nextId, -1);
+    for (int pid = 0; pid < n; ++pid)
+        rank[particles[pid].id] = pid;
+
+    for (int cid = 0; cid < totcells; ++cid)
+    {
+        bool inMovers = false;
+        int lastRank = -1;
+        for (int i = inc.cellStarts[cid]; i < inc.cellStarts[cid+1]; ++i)
+        {
+            const int pid = rank[inc.particles[i].id];
+            const bool stay = incremental_cell_list::isStayer(pid, cid, prev.cellStarts.data(), totcells);
+
+            if (!stay && !inMovers)
+            {
+                inMovers = true;
+                lastRank = -1;
+            }
+            ASSERT_FALSE(stay && inMovers);
+            ASSERT_GT(pid, lastRank); // both groups sorted by previous index
+            lastRank = pid;
+        }
+    }
+}
+
+TEST (INCREMENTAL_CELLLISTS, arbitrary_previous_layout_is_still_correct)
+{
+    // the particles may have been reordered by something else than the cell-lists
+    const int totcells = 32;
+    std::mt19937 gen(8765);
+    int nextId = 0;
+
+    const auto prev = fullBuild(randomParticles(1000, totcells, nextId, gen), totcells);
+    auto particles = perturb(prev.particles, totcells, 0.1, 0.02, 10, nextId, gen);
+    std::shuffle(particles.begin(), particles.end(), gen);
+    particles.resize(particles.size() - 100);
+
+    const auto ref = fullBuild(particles, totcells);
+    const auto inc = incrementalBuild(particles, prev.cellStarts, totcells);
+
+    checkSameCells(ref, inc, totcells);
+}
+
+TEST (INCREMENTAL_CELLLISTS, slot_lookup_with_empty_cells)
+{
+    const std::vector<int> starts = {0, 0, 3, 3, 3, 5, 5};
+    const int totcells = static_cast<int>(starts.size()) - 1;
+
+    ASSERT_EQ(incremental_cell_list::previousCellOfSlot(0, starts.data(), totcells), 1);
+    ASSERT_EQ(incremental_cell_list::previousCellOfSlot(2, starts.data(), totcells), 1);
+    ASSERT_EQ(incremental_cell_list::previousCellOfSlot(3, starts.data(), totcells), 4);
+    ASSERT_EQ(incremental_cell_list::previousCellOfSlot(4, starts.data(), totcells), 4);
+    ASSERT_EQ(incremental_cell_list::previousCellOfSlot(5, starts.data(), totcells), -1);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
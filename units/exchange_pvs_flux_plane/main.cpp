@@ -0,0 +1,160 @@
+#include <mirheo/core/logger.h>
+#include <mirheo/core/mirheo_state.h>
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/simulation.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/half_precision.h>
+#include <mirheo/plugins/exchange_pvs_flux_plane.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace mirheo;
+
+// relative error of a round to nearest conversion to half precision
+constexpr real halfEpsilon = 1.0_r / 2048.0_r;
+
+static void setOldPositions(ParticleVector *pv, const std::vector<real3>& oldPositions)
+{
+    auto lpv = pv->local();
+    const auto& pos = lpv->positions();
+
+    if (pv->getOldPositionsStorage() == OldPositionsStorage::Full)
+    {
+        auto& old = *lpv->dataPerParticle.getData<real4>(channel_names::oldPositions);
+        for (size_t i = 0; i < oldPositions.size(); ++i)
+            old[i] = make_real4(oldPositions[i], 0.0_r);
+        old.uploadToDevice(defaultStream);
+    }
+    else
+    {
+        auto& deltas = *lpv->dataPerParticle.getData<int64_t>(channel_names::oldPositionDeltas);
+        for (size_t i = 0; i < oldPositions.size(); ++i)
+            deltas[i] = half_precision::packHalf3(oldPositions[i] - make_real3(pos[i]));
+        deltas.uploadToDevice(defaultStream);
+    }
+}
+
+static std::vector<real3> getOldPositions(ParticleVector *pv)
+{
+    auto lpv = pv->local();
+    const auto& pos = lpv->positions();
+    std::vector<real3> oldPositions(lpv->size());
+
+    if (pv->getOldPositionsStorage() == OldPositionsStorage::Full)
+    {
+        auto& old = *lpv->dataPerParticle.getData<real4>(channel_names::oldPositions);
+        old.downloadFromDevice(defaultStream);
+        for (size_t i = 0; i < oldPositions.size(); ++i)
+            oldPositions[i] = make_real3(old[i]);
+    }
+    else
+    {
+        auto& deltas = *lpv->dataPerParticle.getData<int64_t>(channel_names::oldPositionDeltas);
+        deltas.downloadFromDevice(defaultStream);
+        for (size_t i = 0; i < oldPositions.size(); ++i)
+            oldPositions[i] = make_real3(pos[i]) + half_precision::unpackHalf3(deltas[i]);
+    }
+    return oldPositions;
+}
+
+static void checkExchangeKeepsOldPositions(OldPositionsStorage storage)
+{
+    MPI_Comm cart;
+    const int dims[] = {1, 1, 1};
+    const int periods[] = {1, 1, 1};
+    MPI_Check( MPI_Cart_create(MPI_COMM_WORLD, 3, dims, periods, 0, &cart) );
+
+    const real L = 8.0_r;
+    DomainInfo domain{{L, L, L}, {0.0_r, 0.0_r, 0.0_r}, {L, L, L}};
+    MirState state(domain, 0.01_r, UnitConversion{});
+
+    {
+        Simulation sim(cart, MPI_COMM_NULL, &state, CheckpointInfo{});
+        auto pv1 = std::make_shared<ParticleVector>(&state, "pv1", 1.0_r);
+        auto pv2 = std::make_shared<ParticleVector>(&state, "pv2", 1.0_r);
+        sim.registerParticleVector(pv1, nullptr);
+        sim.registerParticleVector(pv2, nullptr);
+        sim.setOldPositionsStorage("pv1", storage);
+        sim.setOldPositionsStorage("pv2", storage);
+
+        // x = 0 in local coordinates
+        ExchangePVSFluxPlanePlugin plugin(&state, "exchange", "pv1", "pv2", {1.0_r, 0.0_r, 0.0_r, -0.5_r * L});
+        plugin.setTag(0);
+        plugin.setup(&sim, cart, MPI_COMM_NULL);
+
+        // the first particle crosses the plane, the second one does not
+        const std::vector<real3> positions    {{ 0.07_r, 1.0_r, -2.0_r}, {-0.1_r, 0.5_r, 0.25_r}};
+        const std::vector<real3> oldPositions {{-0.05_r, 1.1_r, -1.9_r}, {-0.2_r, 0.4_r, 0.30_r}};
+        const real3 velocity {1.0_r, 2.0_r, 3.0_r};
+
+        auto lpv1 = pv1->local();
+        lpv1->resize_anew(static_cast<int>(positions.size()));
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            Particle p;
+            p.r = positions[i];
+            p.u = velocity;
+            p.setId(static_cast<int64_t>(i));
+            lpv1->positions ()[i] = p.r2Real4();
+            lpv1->velocities()[i] = p.u2Real4();
+        }
+        lpv1->positions ().uploadToDevice(defaultStream);
+        lpv1->velocities().uploadToDevice(defaultStream);
+        setOldPositions(pv1.get(), oldPositions);
+
+        plugin.beforeCellLists(defaultStream);
+
+        auto lpv2 = pv2->local();
+        ASSERT_EQ(lpv2->size(), 1);
+
+        lpv1->positions().downloadFromDevice(defaultStream);
+        lpv2->positions().downloadFromDevice(defaultStream);
+        const auto old1 = getOldPositions(pv1.get());
+        const auto old2 = getOldPositions(pv2.get());
+
+        // the moved particle keeps its old position
+        const real3 r2 = make_real3(lpv2->positions()[0]);
+        const real tol = halfEpsilon * length(oldPositions[0] - positions[0]) + 1e-6_r;
+        ASSERT_EQ(r2.x, positions[0].x);
+        ASSERT_EQ(r2.y, positions[0].y);
+        ASSERT_EQ(r2.z, positions[0].z);
+        ASSERT_NEAR(old2[0].x, oldPositions[0].x, tol);
+        ASSERT_NEAR(old2[0].y, oldPositions[0].y, tol);
+        ASSERT_NEAR(old2[0].z, oldPositions[0].z, tol);
+
+        // the source is marked, the other particle is untouched
+        ASSERT_TRUE(Particle(lpv1->positions()[0], lpv1->velocities()[0]).isMarked());
+        ASSERT_FALSE(Particle(lpv1->positions()[1], lpv1->velocities()[1]).isMarked());
+        ASSERT_NEAR(old1[1].x, oldPositions[1].x, tol);
+        ASSERT_NEAR(old1[1].y, oldPositions[1].y, tol);
+        ASSERT_NEAR(old1[1].z, oldPositions[1].z, tol);
+    }
+
+    MPI_Check( MPI_Comm_free(&cart) );
+}
+
+TEST (EXCHANGE_PVS_FLUX_PLANE, moved_particle_keeps_full_old_position)
+{
+    checkExchangeKeepsOldPositions(OldPositionsStorage::Full);
+}
+
+TEST (EXCHANGE_PVS_FLUX_PLANE, moved_particle_keeps_half_delta_old_position)
+{
+    checkExchangeKeepsOldPositions(OldPositionsStorage::HalfDelta);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "exchange_pvs_flux_plane.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
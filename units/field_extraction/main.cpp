@@ -0,0 +1,175 @@
+#include <mirheo/core/utils/helper_math.h>
+#include <mirheo/plugins/utils/field_extraction.h>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using namespace mirheo;
+using namespace field_extraction;
+
+static Grid makeGrid()
+{
+    Grid grid;
+    grid.resolution = {8, 6, 5};
+    grid.h = {0.5_r, 1.0_r, 2.0_r};
+    grid.start = {4.0_r, 6.0_r, 10.0_r};
+    return grid;
+}
+
+static real3 cellCenter(const Grid& grid, int ix, int iy, int iz)
+{
+    return grid.start + grid.h * make_real3(static_cast<real>(ix) + 0.5_r,
+                                            static_cast<real>(iy) + 0.5_r,
+                                            static_cast<real>(iz) + 0.5_r);
+}
+
+// two components per cell, the first one linear and the second one constant
+template <class Function>
+static std::vector<double> sampleOnCenters(const Grid& grid, Function f)
+{
+    const int3 n = grid.resolution;
+    std::vector<double> values;
+
+    for (int iz = 0; iz < n.z; ++iz)
+        for (int iy = 0; iy < n.y; ++iy)
+            for (int ix = 0; ix < n.x; ++ix)
+            {
+                values.push_back(f(cellCenter(grid, ix, iy, iz)));
+                values.push_back(42.0);
+            }
+    return values;
+}
+
+static double linear(real3 r)
+{
+    return 1.0 + 2.0 * r.x - 3.0 * r.y + 0.5 * r.z;
+}
+
+TEST (FIELD_EXTRACTION, interpolation_is_exact_for_linear_fields)
+{
+    const Grid grid = makeGrid();
+    const auto values = sampleOnCenters(grid, linear);
+    const Field field {values.data(), 2};
+
+    const real3 lo = cellCenter(grid, 0, 0, 0);
+    const real3 hi = cellCenter(grid, grid.resolution.x-1, grid.resolution.y-1, grid.resolution.z-1);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const real t = static_cast<real>(i) / 99.0_r;
+        const real3 r = lo + t * (hi - lo) * make_real3(1.0_r, 1.0_r - t, t);
+
+        ASSERT_NEAR(interpolate(grid, field, 0, r), linear(r), 1e-4);
+        ASSERT_NEAR(interpolate(grid, field, 1, r), 42.0, 1e-10);
+    }
+}
+
+TEST (FIELD_EXTRACTION, interpolation_is_clamped_outside_of_the_centers)
+{
+    const Grid grid = makeGrid();
+    const auto values = sampleOnCenters(grid, linear);
+    const Field field {values.data(), 2};
+
+    const real3 corner = grid.start;
+    ASSERT_NEAR(interpolate(grid, field, 0, corner), linear(cellCenter(grid, 0, 0, 0)), 1e-4);
+
+    ASSERT_TRUE (contains(grid, corner));
+    ASSERT_FALSE(contains(grid, grid.start + grid.h * make_real3(grid.resolution)));
+}
+
+TEST (FIELD_EXTRACTION, slice_has_the_values_of_the_plane)
+{
+    const Grid grid = makeGrid();
+    const auto values = sampleOnCenters(grid, linear);
+
+    std::vector<double> scalars;
+    for (size_t i = 0; i < values.size(); i += 2)
+        scalars.push_back(values[i]);
+
+    const std::vector<Field> fields {{values.data(), 2}, {scalars.data(), 1}};
+    const int nComponents = totalComponents(fields);
+
+    ASSERT_EQ(nComponents, 3);
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const real3 middle = grid.start + 0.37_r * grid.h * make_real3(grid.resolution);
+        const real position = axis == 0 ? middle.x : (axis == 1 ? middle.y : middle.z);
+
+        std::vector<double> slice;
+        ASSERT_TRUE(extractSlice(grid, fields, axis, position, slice));
+
+        const int2 axes = sliceAxes(axis);
+        const int3 n = grid.resolution;
+        const int na = axes.x == 0 ? n.x : (axes.x == 1 ? n.y : n.z);
+        const int nb = axes.y == 0 ? n.x : (axes.y == 1 ? n.y : n.z);
+
+        ASSERT_EQ(slice.size(), static_cast<size_t>(na * nb * nComponents));
+
+        for (int ib = 0; ib < nb; ++ib)
+            for (int ia = 0; ia < na; ++ia)
+            {
+                int idx[3];
+                idx[axes.x] = ia;
+                idx[axes.y] = ib;
+                idx[axis] = 0;
+
+                real3 r = cellCenter(grid, idx[0], idx[1], idx[2]);
+                if      (axis == 0) r.x = position;
+                else if (axis == 1) r.y = position;
+                else                r.z = position;
+
+                const double *point = slice.data() + (ib * na + ia) * nComponents;
+                ASSERT_NEAR(point[0], linear(r), 1e-4);
+                ASSERT_NEAR(point[1], 42.0,      1e-10);
+                ASSERT_NEAR(point[2], linear(r), 1e-4);
+            }
+
+        ASSERT_FALSE(extractSlice(grid, fields, axis, -1.0_r, slice));
+        ASSERT_TRUE(slice.empty());
+    }
+}
+
+TEST (FIELD_EXTRACTION, isosurface_of_a_sphere)
+{
+    Grid grid;
+    grid.resolution = {32, 32, 32};
+    grid.h = {0.25_r, 0.25_r, 0.25_r};
+    grid.start = {8.0_r, 0.0_r, -4.0_r};
+
+    const real3 center = grid.start + 0.5_r * grid.h * make_real3(grid.resolution);
+    const real R = 2.5_r;
+
+    auto distance = [&](real3 r)
+    {
+        r -= center;
+        return static_cast<double>(std::sqrt(dot(r, r)));
+    };
+
+    const auto values = sampleOnCenters(grid, distance);
+    const Field field {values.data(), 2};
+
+    std::vector<real3> vertices;
+    std::vector<int3> faces;
+    extractIsosurface(grid, field, 0, R, vertices, faces);
+
+    ASSERT_GT(vertices.size(), 0u);
+    ASSERT_GT(faces.size(), 0u);
+
+    for (auto v : vertices)
+        ASSERT_NEAR(distance(v), R, 0.5 * grid.h.x);
+
+    for (auto f : faces)
+    {
+        ASSERT_LT(f.x, static_cast<int>(vertices.size()));
+        ASSERT_LT(f.y, static_cast<int>(vertices.size()));
+        ASSERT_LT(f.z, static_cast<int>(vertices.size()));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
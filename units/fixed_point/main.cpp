@@ -0,0 +1,119 @@
+#include <mirheo/core/utils/fixed_point.h>
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+TEST (FIXED_POINT, conversion_of_representable_values_is_exact)
+{
+    const std::vector<double> values = {0.0, 1.0, -1.0, 0.5, -0.25, 1024.0, -123456.75,
+                                        fixed_point::invScale, -3 * fixed_point::invScale};
+
+    for (auto x : values)
+        ASSERT_EQ(fixed_point::toReal(fixed_point::fromReal(x)), x);
+}
+
+TEST (FIXED_POINT, conversion_error_is_bounded_by_resolution)
+{
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<double> distr(-1e4, 1e4);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const double x = distr(gen);
+        const double err = std::abs(fixed_point::toReal(fixed_point::fromReal(x)) - x);
+        ASSERT_LE(err, 0.5 * fixed_point::invScale);
+    }
+}
+
+TEST (FIXED_POINT, conversion_is_symmetric)
+{
+    std::mt19937 gen(4243);
+    std::uniform_real_distribution<double> distr(-100.0, 100.0);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const double x = distr(gen);
+        ASSERT_EQ(fixed_point::fromReal(-x), -fixed_point::fromReal(x));
+    }
+}
+
+TEST (FIXED_POINT, sum_does_not_depend_on_order)
+{
+    std::mt19937 gen(4244);
+    std::uniform_real_distribution<float> distr(-50.0f, 50.0f);
+
+    const int n = 1000;
+    std::vector<float> terms(n);
+    for (auto& t : terms)
+        t = distr(gen);
+
+    auto fixedSum = [](const std::vector<float>& v)
+    {
+        int64_t s = 0;
+        for (auto x : v)
+            s += fixed_point::fromReal(x);
+        return s;
+    };
+
+    auto floatSum = [](const std::vector<float>& v)
+    {
+        float s = 0;
+        for (auto x : v)
+            s += x;
+        return s;
+    };
+
+    const int64_t refFixed = fixedSum(terms);
+    const float   refFloat = floatSum(terms);
+    bool floatDiffers = false;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        std::shuffle(terms.begin(), terms.end(), gen);
+        ASSERT_EQ(fixedSum(terms), refFixed);
+        floatDiffers |= (floatSum(terms) != refFloat);
+    }
+
+    // not a requirement, only shows that the test is meaningful
+    if (!floatDiffers)
+        printf("floating point sums happened to be order independent for this sample\n");
+
+    ASSERT_NEAR(fixed_point::toReal(refFixed), refFloat, 1e-2);
+}
+
+TEST (FIXED_POINT, opposite_contributions_cancel_exactly)
+{
+    // typical of pairwise forces: each pair adds f to one particle and -f to the other
+    std::mt19937 gen(4245);
+    std::uniform_real_distribution<float> distr(-10.0f, 10.0f);
+
+    int64_t total = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const float f = distr(gen);
+        total += fixed_point::fromReal( f);
+        total += fixed_point::fromReal(-f);
+    }
+    ASSERT_EQ(total, 0);
+}
+
+TEST (FIXED_POINT, vector_conversion)
+{
+    const real3 f = fixed_point::toReal3(fixed_point::fromReal(1.5),
+                                         fixed_point::fromReal(-2.0),
+                                         fixed_point::fromReal(0.25));
+    ASSERT_EQ(f.x,  1.5_r);
+    ASSERT_EQ(f.y, -2.0_r);
+    ASSERT_EQ(f.z, 0.25_r);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
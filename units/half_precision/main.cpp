@@ -0,0 +1,93 @@
+#include <mirheo/core/utils/half_precision.h>
+#include <mirheo/core/utils/helper_math.h>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+// relative error of a round to nearest conversion to half precision
+constexpr double halfEpsilon = 1.0 / 2048.0;
+
+TEST (HALF_PRECISION, conversion_of_representable_values_is_exact)
+{
+    const std::vector<float> values = {0.0f, 1.0f, -1.0f, 0.5f, -0.25f, 1024.0f, 65504.0f, -0.000244140625f};
+
+    for (auto x : values)
+        ASSERT_EQ(half_precision::halfToFloat(half_precision::floatToHalf(x)), x);
+}
+
+TEST (HALF_PRECISION, conversion_relative_error_is_bounded)
+{
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<float> mantissa(1.0f, 2.0f);
+    std::uniform_int_distribution<int> exponent(-14, 14); // normal half precision range
+    std::bernoulli_distribution negative(0.5);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        const float x = (negative(gen) ? -1.0f : 1.0f) * std::ldexp(mantissa(gen), exponent(gen));
+        const float y = half_precision::halfToFloat(half_precision::floatToHalf(x));
+        ASSERT_LE(std::abs(static_cast<double>(y) - x), halfEpsilon * std::abs(x)) << "x = " << x;
+    }
+}
+
+TEST (HALF_PRECISION, subnormal_conversion_absolute_error_is_bounded)
+{
+    std::mt19937 gen(4245);
+    std::uniform_real_distribution<float> distr(-std::ldexp(1.0f, -14), std::ldexp(1.0f, -14));
+    const double absEpsilon = std::ldexp(1.0, -25); // half of the smallest subnormal
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const float x = distr(gen);
+        const float y = half_precision::halfToFloat(half_precision::floatToHalf(x));
+        ASSERT_LE(std::abs(static_cast<double>(y) - x), absEpsilon) << "x = " << x;
+    }
+}
+
+TEST (HALF_PRECISION, packed_vector_roundtrip)
+{
+    std::mt19937 gen(4243);
+    std::uniform_real_distribution<real> distr(-4.0_r, 4.0_r);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const real3 v {distr(gen), distr(gen), distr(gen)};
+        const real3 w = half_precision::unpackHalf3(half_precision::packHalf3(v));
+
+        ASSERT_LE(std::abs(w.x - v.x), halfEpsilon * std::abs(v.x));
+        ASSERT_LE(std::abs(w.y - v.y), halfEpsilon * std::abs(v.y));
+        ASSERT_LE(std::abs(w.z - v.z), halfEpsilon * std::abs(v.z));
+    }
+}
+
+TEST (HALF_PRECISION, old_position_from_delta_error_is_bounded_by_displacement)
+{
+    std::mt19937 gen(4244);
+    std::uniform_real_distribution<real> pos(-32.0_r, 32.0_r);
+    std::uniform_real_distribution<real> disp(-0.1_r, 0.1_r);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const real3 rNew {pos(gen), pos(gen), pos(gen)};
+        const real3 rOld = rNew + real3{disp(gen), disp(gen), disp(gen)};
+
+        // same reconstruction as PVviewWithOldParticles::readOldPosition()
+        const real3 delta = rOld - rNew;
+        const real3 rec = rNew + half_precision::unpackHalf3(half_precision::packHalf3(delta));
+
+        // allow for the rounding of the sum itself
+        const real tol = static_cast<real>(halfEpsilon) * length(delta) + 4 * std::numeric_limits<real>::epsilon() * 32.0_r;
+        ASSERT_LE(length(rec - rOld), tol);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
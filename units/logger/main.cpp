@@ -0,0 +1,146 @@
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/log_record_buffer.h>
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mirheo;
+
+static bool pushValue(LogRecordBuffer& buffer, int value)
+{
+    return buffer.tryPush([value](LogRecord& r)
+    {
+        r.line = value;
+        r.length = 0;
+    });
+}
+
+TEST (LOG_RECORD_BUFFER, fifo_order )
+{
+    LogRecordBuffer buffer(16);
+
+    for (int i = 0; i < 10; ++i)
+        ASSERT_TRUE(pushValue(buffer, i));
+
+    std::vector<int> values;
+    const int n = buffer.popAll([&](const LogRecord& r) {values.push_back(r.line);});
+
+    ASSERT_EQ(n, 10);
+    for (int i = 0; i < n; ++i)
+        ASSERT_EQ(values[i], i);
+
+    ASSERT_EQ(buffer.size(), 0);
+}
+
+TEST (LOG_RECORD_BUFFER, full_then_reuse )
+{
+    const int capacity = 8;
+    LogRecordBuffer buffer(capacity);
+
+    for (int i = 0; i < capacity; ++i)
+        ASSERT_TRUE(pushValue(buffer, i));
+
+    ASSERT_FALSE(pushValue(buffer, capacity));
+    ASSERT_EQ(buffer.size(), capacity);
+
+    // wrap around several times
+    int expected = 0;
+    for (int round = 0; round < 5; ++round)
+    {
+        buffer.popAll([&](const LogRecord& r) {ASSERT_EQ(r.line, expected++);});
+
+        for (int i = 0; i < capacity; ++i)
+            ASSERT_TRUE(pushValue(buffer, expected + i));
+    }
+}
+
+TEST (LOG_RECORD_BUFFER, multiple_producers )
+{
+    const int nthreads = 4;
+    const int nPerThread = 10000;
+    LogRecordBuffer buffer(64);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < nthreads; ++t)
+    {
+        producers.emplace_back([&buffer, t]()
+        {
+            for (int i = 0; i < nPerThread; ++i)
+                while (!pushValue(buffer, t * nPerThread + i))
+                    std::this_thread::yield();
+        });
+    }
+
+    // messages of the same thread must come out in order
+    std::vector<int> lastSeen(nthreads, -1);
+    int total = 0;
+
+    while (total < nthreads * nPerThread)
+    {
+        total += buffer.popAll([&](const LogRecord& r)
+        {
+            const int t = r.line / nPerThread;
+            const int i = r.line % nPerThread;
+            ASSERT_EQ(i, lastSeen[t] + 1);
+            lastSeen[t] = i;
+        });
+    }
+
+    for (auto& p : producers)
+        p.join();
+
+    for (auto i : lastSeen)
+        ASSERT_EQ(i, nPerThread - 1);
+}
+
+TEST (LOGGER, async_keeps_all_messages_in_order )
+{
+    logger.init(MPI_COMM_WORLD, "logger_async.log", 3);
+    logger.setAsync(true, 16);
+
+    const int n = 1000;
+    for (int i = 0; i < n; ++i)
+        logger.log("INFO", __FILE__, __LINE__, "message %d", i);
+
+    // longer than a record; must still appear in order and complete
+    const std::string longMessage(2 * LogRecord::maxMessageLength, 'x');
+    logger.log("INFO", __FILE__, __LINE__, "%s", longMessage.c_str());
+
+    logger.setAsync(false);
+
+    std::ifstream f("logger_async_00000.log");
+    std::string line;
+    int expected = 0;
+    bool foundLong = false;
+
+    while (std::getline(f, line))
+    {
+        const auto pos = line.find("message ");
+        if (pos != std::string::npos)
+        {
+            ASSERT_EQ(std::stoi(line.substr(pos + strlen("message "))), expected);
+            ++expected;
+        }
+        if (line.find(longMessage) != std::string::npos)
+        {
+            ASSERT_EQ(expected, n);
+            foundLong = true;
+        }
+    }
+
+    ASSERT_EQ(expected, n);
+    ASSERT_TRUE(foundLong);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return ret;
+}
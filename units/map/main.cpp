@@ -1,8 +1,12 @@
 #include <mirheo/core/logger.h>
 #include <mirheo/core/exchangers/utils/map.h>
+#include <mirheo/core/pvs/utils/gid_map.h>
 
 #include <cstdio>
 #include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+#include <vector>
 
 using namespace mirheo;
 
@@ -45,6 +49,108 @@ TEST (MAP, ThreadDispatch)
     }
 }
 
+// host reference of the hash table: same probing as on the device, sequential inserts
+struct HostGidMap
+{
+    HostGidMap(int capacity) :
+        keys(capacity, static_cast<int64_t>(GidMapView::EmptyKey)),
+        values(capacity)
+    {}
+
+    GidMapView view() {return {static_cast<int>(keys.size()), keys.data(), values.data()};}
+
+    std::vector<int64_t> keys;
+    std::vector<int> values;
+};
+
+TEST (MAP, GidMap_capacity_is_power_of_two_with_load_below_half)
+{
+    for (int n : {0, 1, 2, 3, 100, 1000, 1024, 1025, 123456})
+    {
+        const int capacity = GidMap::capacityFor(n);
+        ASSERT_EQ(capacity & (capacity - 1), 0);
+        ASSERT_GE(capacity, 2 * n);
+        ASSERT_LT(capacity, 4 * n + 2);
+    }
+}
+
+TEST (MAP, GidMap_matches_unordered_map)
+{
+    std::mt19937 gen(4242);
+    // sparse ids, as in a large system with few local particles
+    std::uniform_int_distribution<int64_t> distr(0, (int64_t(1) << 40));
+
+    const int n = 10000;
+    HostGidMap map(GidMap::capacityFor(n));
+    std::unordered_map<int64_t, int> reference;
+
+    while (static_cast<int>(reference.size()) < n)
+    {
+        const int64_t gid = distr(gen);
+        if (reference.count(gid))
+            continue;
+
+        const int localId = static_cast<int>(reference.size());
+        reference[gid] = localId;
+        ASSERT_TRUE(map.view().insert(gid, localId));
+    }
+
+    for (const auto& entry : reference)
+        ASSERT_EQ(map.view().find(entry.first), entry.second);
+
+    const int notFound = GidMapView::NotFound;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const int64_t gid = distr(gen);
+        if (reference.count(gid) == 0)
+        {
+            ASSERT_EQ(map.view().find(gid), notFound);
+        }
+    }
+}
+
+TEST (MAP, GidMap_dense_ids_and_updates)
+{
+    const int n = 4096;
+    HostGidMap map(GidMap::capacityFor(n));
+
+    // consecutive ids collide often after masking a poor hash; the mixing hash must handle them
+    for (int i = 0; i < n; ++i)
+        ASSERT_TRUE(map.view().insert(i, -1));
+
+    for (int i = 0; i < n; ++i)
+        ASSERT_TRUE(map.view().insert(i, n - i));
+
+    for (int i = 0; i < n; ++i)
+        ASSERT_EQ(map.view().find(i), n - i);
+
+    int nUsed = 0;
+    for (auto k : map.keys)
+        nUsed += (k != GidMapView::EmptyKey);
+    ASSERT_EQ(nUsed, n);
+}
+
+TEST (MAP, GidMap_full_table_rejects_new_keys)
+{
+    HostGidMap map(8);
+    for (int i = 0; i < 8; ++i)
+        ASSERT_TRUE(map.view().insert(100 + i, i));
+
+    ASSERT_FALSE(map.view().insert(42, 0));
+    ASSERT_TRUE (map.view().insert(103, 7));
+
+    const int notFound = GidMapView::NotFound;
+    ASSERT_EQ(map.view().find(42), notFound);
+    ASSERT_EQ(map.view().find(103), 7);
+}
+
+TEST (MAP, GidMap_empty_view)
+{
+    const GidMapView view;
+    const int notFound = GidMapView::NotFound;
+    ASSERT_EQ(view.find(0), notFound);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -1,8 +1,13 @@
 #include <mirheo/core/logger.h>
 #include <mirheo/core/marching_cubes.h>
 
+#include "reference.h"
+
 #include <cstdio>
 #include <cmath>
+#include <map>
+#include <set>
+#include <utility>
 #include <gtest/gtest.h>
 
 using namespace mirheo;
@@ -78,6 +83,155 @@ TEST (MARCHING_CUBES, Sphere)
     ASSERT_LE(maxVal, 0.01);
 }
 
+static DomainInfo makeDomain(real L)
+{
+    DomainInfo domain;
+    domain.globalStart = make_real3(0, 0, 0);
+    domain.localSize   = make_real3(L, L, L);
+    domain.globalSize  = domain.localSize;
+    return domain;
+}
+
+// Euler characteristic of a closed mesh; fails if one edge is not shared by exactly two faces
+static int eulerCharacteristic(const std::vector<real3>& vertices, const std::vector<int3>& faces)
+{
+    std::map<std::pair<int,int>, int> edges;
+    auto addEdge = [&](int a, int b)
+    {
+        ++edges[{std::min(a, b), std::max(a, b)}];
+    };
+
+    for (auto f : faces)
+    {
+        addEdge(f.x, f.y);
+        addEdge(f.y, f.z);
+        addEdge(f.z, f.x);
+    }
+
+    for (const auto& e : edges)
+        EXPECT_EQ(e.second, 2) << "edge " << e.first.first << " " << e.first.second;
+
+    return static_cast<int>(vertices.size()) - static_cast<int>(edges.size()) + static_cast<int>(faces.size());
+}
+
+TEST (MARCHING_CUBES, WeldedSphereIsClosed)
+{
+    const real R = 1.0;
+    const DomainInfo domain = makeDomain(2.5 * R);
+    const real3 center = 0.5 * domain.globalSize;
+
+    auto sphereSurface = [&] (const real3 *r, int n, real *values)
+    {
+        for (int i = 0; i < n; ++i)
+            values[i] = length(r[i] - center) - R;
+    };
+
+    std::vector<real3> vertices;
+    std::vector<int3> faces;
+    marching_cubes::computeMesh(domain, {0.1_r, 0.1_r, 0.1_r}, sphereSurface, vertices, faces);
+
+    ASSERT_GT(faces.size(), 0u);
+    ASSERT_EQ(eulerCharacteristic(vertices, faces), 2);
+
+    // each vertex is shared by several triangles
+    ASSERT_LT(vertices.size(), faces.size());
+}
+
+TEST (MARCHING_CUBES, WeldedTorusIsClosed)
+{
+    const real R = 1.0, r = 0.4;
+    const DomainInfo domain = makeDomain(3.0);
+    const real3 center = 0.5 * domain.globalSize;
+
+    auto torusSurface = [&] (real3 x)
+    {
+        x -= center;
+        const real q = math::sqrt(x.x * x.x + x.y * x.y) - R;
+        return math::sqrt(q * q + x.z * x.z) - r;
+    };
+
+    std::vector<real3> vertices;
+    std::vector<int3> faces;
+    marching_cubes::computeMesh(domain, {0.1_r, 0.1_r, 0.1_r}, torusSurface, vertices, faces);
+
+    ASSERT_EQ(eulerCharacteristic(vertices, faces), 0);
+}
+
+TEST (MARCHING_CUBES, ResultDoesNotDependOnThreads)
+{
+    const real R = 1.0;
+    const DomainInfo domain = makeDomain(2.5 * R);
+    const real3 center = 0.5 * domain.globalSize;
+
+    auto sphereSurface = [&] (real3 x)
+    {
+        return length(x - center) - R;
+    };
+
+    const real3 resolution {0.07_r, 0.08_r, 0.09_r};
+
+    std::vector<real3> vertices1, vertices4;
+    std::vector<int3> faces1, faces4;
+    marching_cubes::computeMesh(domain, resolution, sphereSurface, vertices1, faces1, 1);
+    marching_cubes::computeMesh(domain, resolution, sphereSurface, vertices4, faces4, 4);
+
+    ASSERT_EQ(vertices1.size(), vertices4.size());
+    ASSERT_EQ(faces1.size(), faces4.size());
+
+    for (size_t i = 0; i < vertices1.size(); ++i)
+    {
+        ASSERT_EQ(vertices1[i].x, vertices4[i].x);
+        ASSERT_EQ(vertices1[i].y, vertices4[i].y);
+        ASSERT_EQ(vertices1[i].z, vertices4[i].z);
+    }
+
+    for (size_t i = 0; i < faces1.size(); ++i)
+    {
+        ASSERT_EQ(faces1[i].x, faces4[i].x);
+        ASSERT_EQ(faces1[i].y, faces4[i].y);
+        ASSERT_EQ(faces1[i].z, faces4[i].z);
+    }
+}
+
+TEST (MARCHING_CUBES, TrianglesMatchReferenceImplementation)
+{
+    const real R = 0.83;
+    const DomainInfo domain = makeDomain(2.0);
+    const real3 center {0.97_r, 1.02_r, 1.05_r};
+
+    auto ellipsoidSurface = [&] (real3 x)
+    {
+        x -= center;
+        return math::sqrt(x.x * x.x + 1.5_r * x.y * x.y + 0.7_r * x.z * x.z) - R;
+    };
+
+    const real3 resolution {0.2_r, 0.25_r, 0.22_r};
+
+    std::vector<marching_cubes::Triangle> triangles, reference;
+    marching_cubes::computeTriangles(domain, resolution, ellipsoidSurface, triangles);
+    reference_marching_cubes::computeTriangles(domain, resolution, ellipsoidSurface, reference);
+
+    ASSERT_GT(reference.size(), 0u);
+    ASSERT_EQ(triangles.size(), reference.size());
+
+    // the corners are computed differently, which may change the last bits of the vertices
+    const real tol = 1e-5_r;
+
+    auto expectNear = [tol](real3 a, real3 b)
+    {
+        EXPECT_NEAR(a.x, b.x, tol);
+        EXPECT_NEAR(a.y, b.y, tol);
+        EXPECT_NEAR(a.z, b.z, tol);
+    };
+
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        expectNear(triangles[i].a, reference[i].a);
+        expectNear(triangles[i].b, reference[i].b);
+        expectNear(triangles[i].c, reference[i].c);
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -2,9 +2,15 @@
 #include <mirheo/core/mesh/mesh.h>
 #include <mirheo/core/mesh/membrane.h>
 #include <mirheo/core/mesh/edge_colors.h>
+#include <mirheo/core/mesh/off.h>
+#include <mirheo/core/mesh/ply.h>
+#include <mirheo/core/utils/helper_math.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cmath>
+#include <cstring>
 #include <set>
 #include <string>
 #include <gtest/gtest.h>
@@ -127,8 +133,159 @@ TEST (MESH, edgeSets)
     ASSERT_EQ(numUsedEdges, numEdges);
 }
 
+static void assertSameMesh(const std::tuple<std::vector<real3>, std::vector<int3>>& a,
+                           const std::tuple<std::vector<real3>, std::vector<int3>>& b,
+                           real tolerance)
+{
+    const auto& va = std::get<0>(a);
+    const auto& vb = std::get<0>(b);
+    const auto& fa = std::get<1>(a);
+    const auto& fb = std::get<1>(b);
+
+    ASSERT_EQ(va.size(), vb.size());
+    ASSERT_EQ(fa.size(), fb.size());
+
+    for (size_t i = 0; i < va.size(); ++i)
+    {
+        ASSERT_NEAR(va[i].x, vb[i].x, tolerance);
+        ASSERT_NEAR(va[i].y, vb[i].y, tolerance);
+        ASSERT_NEAR(va[i].z, vb[i].z, tolerance);
+    }
+
+    for (size_t i = 0; i < fa.size(); ++i)
+    {
+        ASSERT_EQ(fa[i].x, fb[i].x);
+        ASSERT_EQ(fa[i].y, fb[i].y);
+        ASSERT_EQ(fa[i].z, fb[i].z);
+    }
+}
+
+template <typename T>
+static void writeBinary(FILE *f, T val, bool bigEndian)
+{
+    char bytes[sizeof(T)];
+    memcpy(bytes, &val, sizeof(T));
+
+    const uint16_t one = 1;
+    const bool hostBigEndian = *reinterpret_cast<const char*>(&one) == 0;
+
+    if (bigEndian != hostBigEndian)
+        std::reverse(bytes, bytes + sizeof(T));
+    fwrite(bytes, sizeof(T), 1, f);
+}
+
+static void writeBinaryOff(const std::vector<real3>& vertices, const std::vector<int3>& faces, const std::string& fileName)
+{
+    FILE *f = fopen(fileName.c_str(), "wb");
+    fprintf(f, "OFF BINARY\n");
+    writeBinary<int32_t>(f, static_cast<int32_t>(vertices.size()), true);
+    writeBinary<int32_t>(f, static_cast<int32_t>(faces.size()), true);
+    writeBinary<int32_t>(f, 0, true);
+
+    for (auto v : vertices)
+    {
+        writeBinary<float>(f, static_cast<float>(v.x), true);
+        writeBinary<float>(f, static_cast<float>(v.y), true);
+        writeBinary<float>(f, static_cast<float>(v.z), true);
+    }
+    for (auto t : faces)
+    {
+        writeBinary<int32_t>(f, 3, true);
+        writeBinary<int32_t>(f, t.x, true);
+        writeBinary<int32_t>(f, t.y, true);
+        writeBinary<int32_t>(f, t.z, true);
+        writeBinary<int32_t>(f, 0, true); // no colors
+    }
+    fclose(f);
+}
+
+// also contains extra properties and elements that must be skipped
+static void writePly(const std::vector<real3>& vertices, const std::vector<int3>& faces,
+                     const std::string& fileName, const std::string& format)
+{
+    FILE *f = fopen(fileName.c_str(), "wb");
+    fprintf(f, "ply\nformat %s 1.0\ncomment test mesh\n", format.c_str());
+    fprintf(f, "element vertex %zu\nproperty float x\nproperty float y\nproperty float z\nproperty uchar red\n", vertices.size());
+    fprintf(f, "element face %zu\nproperty list uchar int vertex_indices\nproperty list uchar float texcoord\n", faces.size());
+    fprintf(f, "element material 1\nproperty double shininess\nend_header\n");
 
+    if (format == "ascii")
+    {
+        for (auto v : vertices)
+            fprintf(f, "%.9g %.9g %.9g 255\n", v.x, v.y, v.z);
+        for (auto t : faces)
+            fprintf(f, "3 %d %d %d 2 0.5 0.25\n", t.x, t.y, t.z);
+        fprintf(f, "1.5\n");
+    }
+    else
+    {
+        const bool bigEndian = format == "binary_big_endian";
+        for (auto v : vertices)
+        {
+            writeBinary<float>(f, static_cast<float>(v.x), bigEndian);
+            writeBinary<float>(f, static_cast<float>(v.y), bigEndian);
+            writeBinary<float>(f, static_cast<float>(v.z), bigEndian);
+            writeBinary<uint8_t>(f, 255, bigEndian);
+        }
+        for (auto t : faces)
+        {
+            writeBinary<uint8_t>(f, 3, bigEndian);
+            writeBinary<int32_t>(f, t.x, bigEndian);
+            writeBinary<int32_t>(f, t.y, bigEndian);
+            writeBinary<int32_t>(f, t.z, bigEndian);
+            writeBinary<uint8_t>(f, 2, bigEndian);
+            writeBinary<float>(f, 0.5f, bigEndian);
+            writeBinary<float>(f, 0.25f, bigEndian);
+        }
+        writeBinary<double>(f, 1.5, bigEndian);
+    }
+    fclose(f);
+}
+
+TEST (MESH, readBinaryOff)
+{
+    const auto ref = readOff(rbc_off);
+    writeBinaryOff(std::get<0>(ref), std::get<1>(ref), "rbc_binary.off");
+    assertSameMesh(ref, readMeshFile("rbc_binary.off"), 1e-6_r);
+}
 
+TEST (MESH, readPly)
+{
+    const auto ref = readOff(rbc_off);
+
+    for (std::string format : {"ascii", "binary_little_endian", "binary_big_endian"})
+    {
+        const std::string fileName = "rbc_" + format + ".ply";
+        writePly(std::get<0>(ref), std::get<1>(ref), fileName, format);
+        assertSameMesh(ref, readMeshFile(fileName), 1e-6_r);
+    }
+}
+
+TEST (MESH, sharedTopology)
+{
+    MembraneMesh a(rbc_off);
+    MembraneMesh b(rbc_off);
+
+    // same connectivity: a single copy of the faces and adjacency lists
+    ASSERT_EQ(&a.getTopology(), &b.getTopology());
+    ASSERT_EQ(a.getFaces().devPtr(), b.getFaces().devPtr());
+
+    // same stress-free state: a single copy of the stress-free quantities
+    const MembraneMeshView va(&a), vb(&b);
+    ASSERT_EQ(va.adjacent, vb.adjacent);
+    ASSERT_EQ(va.initialLengths, vb.initialLengths);
+
+    // different stress-free state: same topology, different quantities
+    auto mesh = readOff(rbc_off);
+    auto stressFree = std::get<0>(mesh);
+    for (auto& v : stressFree)
+        v = 1.1_r * v;
+
+    MembraneMesh c(std::get<0>(mesh), stressFree, std::get<1>(mesh));
+    const MembraneMeshView vc(&c);
+    ASSERT_EQ(&a.getTopology(), &c.getTopology());
+    ASSERT_NE(va.initialLengths, vc.initialLengths);
+}
 
 int main(int argc, char **argv)
 {
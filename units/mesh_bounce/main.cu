@@ -0,0 +1,209 @@
+#define private   public
+#define protected public
+
+#include <mirheo/core/bouncers/drivers/mesh.h>
+#include <mirheo/core/bouncers/from_mesh.h>
+#include <mirheo/core/celllist.h>
+#include <mirheo/core/initial_conditions/uniform.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/marching_cubes.h>
+#include <mirheo/core/mesh/membrane.h>
+#include <mirheo/core/pvs/membrane_vector.h>
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/views/ov.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+static bool lessPair(int2 a, int2 b)
+{
+    // same order as the device tables, sorted as 64 bits keys
+    return (a.y < b.y) || (a.y == b.y && a.x < b.x);
+}
+
+static bool equalPair(int2 a, int2 b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+// Host version of the triangle-centric search: one triangle at a time, scan all particles
+// in the cells overlapped by the swept triangle.
+static std::vector<int2> referenceCandidates(const CellListInfo& cinfo, const HostBuffer<int>& cellStarts,
+                                             const PinnedBuffer<real4>& positions, const PinnedBuffer<real4>& oldPositions,
+                                             const PinnedBuffer<real4>& vertices, const PinnedBuffer<real4>& oldVertices,
+                                             const std::vector<int3>& triangles, int nvertices, int nObjects)
+{
+    using namespace mesh_bounce_kernels;
+    std::vector<int2> candidates;
+    const int ntriangles = static_cast<int>(triangles.size());
+
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        for (int trid = 0; trid < ntriangles; ++trid)
+        {
+            const int globTrid = objId * ntriangles + trid;
+            const Triangle tr    = readTriangle(vertices.hostPtr(),    nvertices*objId, triangles[trid]);
+            const Triangle trOld = readTriangle(oldVertices.hostPtr(), nvertices*objId, triangles[trid]);
+
+            const CellRange range = getSweptCellRange(tr, trOld, cinfo);
+
+            for (int iz = range.lo.z; iz <= range.hi.z; ++iz)
+                for (int iy = range.lo.y; iy <= range.hi.y; ++iy)
+                {
+                    const int pstart = cellStarts[cinfo.encode(range.lo.x, iy, iz)];
+                    const int pend   = cellStarts[cinfo.encode(range.hi.x, iy, iz) + 1];
+
+                    for (int pid = pstart; pid < pend; ++pid)
+                        if (segmentTriangleQuickCheck(tr, trOld, make_real3(positions[pid]), make_real3(oldPositions[pid])))
+                            candidates.push_back({pid, globTrid});
+                }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), lessPair);
+    return candidates;
+}
+
+static std::vector<int2> deviceCandidates(BounceFromMesh& bouncer, ParticleVector *pv, MembraneVector *mv, CellList *cl)
+{
+    const int maxCollisions = static_cast<int>(bouncer.coarseCollisionsPerTri_ * static_cast<real>(mv->mesh->getNtriangles() * mv->local()->getNumObjects()));
+    bouncer.coarseTable_.collisionTable.resize_anew(maxCollisions);
+    bouncer.coarseTable_.sortedTable   .resize_anew(maxCollisions);
+
+    OVviewWithNewOldVertices view(mv, mv->local(), defaultStream);
+
+    bouncer._findCoarseCollisions(pv, cl, view, defaultStream);
+    const int n = bouncer.coarseTable_.nCollisions[0];
+    EXPECT_LE(n, maxCollisions);
+
+    bouncer._sortCollisions(bouncer.coarseTable_, n, defaultStream);
+    bouncer.coarseTable_.nCollisions.downloadFromDevice(defaultStream);
+
+    std::vector<int2> candidates(bouncer.coarseTable_.nCollisions[0]);
+    CUDA_Check( cudaMemcpyAsync(candidates.data(), bouncer.coarseTable_.collisionTable.devPtr(),
+                                candidates.size() * sizeof(int2), cudaMemcpyDeviceToHost, defaultStream) );
+    CUDA_Check( cudaStreamSynchronize(defaultStream) );
+    return candidates;
+}
+
+static void displace(PinnedBuffer<real4>& dst, const PinnedBuffer<real4>& src, real amplitude, std::mt19937& gen)
+{
+    std::uniform_real_distribution<real> u(-amplitude, amplitude);
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        dst[i] = src[i];
+        dst[i].x += u(gen);
+        dst[i].y += u(gen);
+        dst[i].z += u(gen);
+    }
+}
+
+TEST (MESH_BOUNCE, CandidatesMatchTriangleCentricSearch)
+{
+    const real3 domainSize {16.0_r, 16.0_r, 16.0_r};
+    const real rc = 1.0_r;
+    const real density = 8.0_r;
+    const int nObjects = 4;
+    const real radius = 2.5_r;
+
+    DomainInfo domain{domainSize, {0,0,0}, domainSize};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    // membrane: a sphere from marching cubes
+    std::vector<real3> meshVertices;
+    std::vector<int3> meshFaces;
+    {
+        const real3 meshSize {8.0_r, 8.0_r, 8.0_r};
+        DomainInfo meshDomain{meshSize, {0,0,0}, meshSize};
+        marching_cubes::computeMesh(meshDomain, {0.5_r, 0.5_r, 0.5_r},
+                                    [&](real3 r) { return length(r - 0.5_r * meshSize) - radius; },
+                                    meshVertices, meshFaces);
+    }
+    auto mesh = std::make_shared<MembraneMesh>(meshVertices, meshFaces);
+    const int nv = mesh->getNvertices();
+
+    MembraneVector mv(&state, "mv", 1.0_r, mesh, nObjects);
+
+    ParticleVector pv(&state, "pv", 1.0_r);
+    UniformIC ic(density);
+    ic.exec(MPI_COMM_WORLD, &pv, defaultStream);
+
+    BounceFromMesh bouncer(&state, "bouncer", BounceBack{});
+    bouncer.setup(&mv);
+    bouncer.setPrerequisites(&pv);
+
+    PrimaryCellList cl(&pv, rc, domainSize);
+    cl.build(defaultStream);
+
+    std::mt19937 gen(4242);
+
+    // particles: move them a little from their previous positions
+    auto& positions    = pv.local()->positions();
+    auto& oldPositions = *pv.local()->dataPerParticle.getData<real4>(channel_names::oldPositions);
+    positions.downloadFromDevice(defaultStream);
+    displace(oldPositions, positions, 0.1_r, gen);
+    oldPositions.uploadToDevice(defaultStream);
+
+    // membranes: spheres placed in the domain, vertices moving a little between steps
+    auto& vertices    = mv.local()->positions();
+    auto& oldVertices = *mv.local()->dataPerParticle.getData<real4>(channel_names::oldPositions);
+    {
+        std::uniform_real_distribution<real> u(-0.5_r * domainSize.x + radius + 0.5_r, 0.5_r * domainSize.x - radius - 0.5_r);
+        for (int objId = 0; objId < nObjects; ++objId)
+        {
+            const real3 center {u(gen), u(gen), u(gen)};
+            for (int i = 0; i < nv; ++i)
+            {
+                const real3 r = meshVertices[i] + center;
+                vertices[objId * nv + i] = make_real4(r.x, r.y, r.z, 0.0_r);
+            }
+        }
+        displace(oldVertices, vertices, 0.05_r, gen);
+        vertices   .uploadToDevice(defaultStream);
+        oldVertices.uploadToDevice(defaultStream);
+    }
+
+    HostBuffer<int> cellStarts(cl.totcells + 1);
+    cellStarts.copy(cl.cellStarts, defaultStream);
+    CUDA_Check( cudaStreamSynchronize(defaultStream) );
+
+    const auto reference = referenceCandidates(cl.cellInfo(), cellStarts, positions, oldPositions,
+                                               vertices, oldVertices, meshFaces, nv, nObjects);
+    const auto candidates = deviceCandidates(bouncer, &pv, &mv, &cl);
+
+    ASSERT_GT(reference.size(), 0u);
+
+    // the tables are sorted and free of duplicates
+    ASSERT_TRUE(std::is_sorted(candidates.begin(), candidates.end(), lessPair));
+    ASSERT_TRUE(std::adjacent_find(candidates.begin(), candidates.end(), equalPair) == candidates.end());
+
+    // the device and host quick checks may disagree on borderline pairs (fused multiply-add)
+    std::vector<int2> mismatches;
+    std::set_symmetric_difference(reference.begin(), reference.end(),
+                                  candidates.begin(), candidates.end(),
+                                  std::back_inserter(mismatches), lessPair);
+    ASSERT_LE(mismatches.size(), reference.size() / 1000 + 1);
+
+    // the result does not depend on the order of the atomic operations
+    const auto candidates2 = deviceCandidates(bouncer, &pv, &mv, &cl);
+    ASSERT_EQ(candidates.size(), candidates2.size());
+    ASSERT_TRUE(std::equal(candidates.begin(), candidates.end(), candidates2.begin(), equalPair));
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "mesh_bounce.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -0,0 +1,151 @@
+#include <mirheo/plugins/utils/multi_tau.h>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+// storage of a single scalar signal
+struct Storage
+{
+    Storage(const multi_tau::Layout& layout) :
+        blockSize(layout.blockSize),
+        values(layout.numLevels * layout.blockSize, 0.0),
+        accumulators(layout.numLevels, 0.0)
+    {}
+
+    double& value(int level, int j) {return values[level * blockSize + j];}
+    double& accumulator(int level) {return accumulators[level];}
+
+    int blockSize;
+    std::vector<double> values;
+    std::vector<double> accumulators;
+};
+
+// runs the correlator on the signal and returns the average correlations
+template <class Correlation>
+static std::vector<double> correlate(const std::vector<double>& signal, multi_tau::Layout layout,
+                                     Correlation correlation, multi_tau::MultiTauSchedule& schedule)
+{
+    Storage storage(layout);
+    std::vector<double> sums(layout.numLevels * layout.blockSize, 0.0);
+
+    auto output = [&](int level, int j, double v) {sums[level * layout.blockSize + j] += v;};
+
+    for (auto x : signal)
+    {
+        const int nUpdated = schedule.push();
+        multi_tau::multiTauUpdate(x, layout, nUpdated, schedule.states().data(), storage, correlation, output);
+    }
+
+    for (int level = 0; level < layout.numLevels; ++level)
+        for (int j = 0; j < layout.blockSize; ++j)
+        {
+            const long count = schedule.count(level, j);
+            auto& s = sums[level * layout.blockSize + j];
+            s = count > 0 ? s / static_cast<double>(count) : 0.0;
+        }
+
+    return sums;
+}
+
+static double squaredDifference(double a, double b) {return (a-b) * (a-b);}
+static double product(double a, double b) {return a * b;}
+
+TEST (MULTI_TAU, first_level_matches_brute_force)
+{
+    const multi_tau::Layout layout {4, 8, 2};
+    multi_tau::MultiTauSchedule schedule(layout);
+
+    std::mt19937 gen(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+
+    std::vector<double> signal {0.0};
+    for (int i = 0; i < 1000; ++i)
+        signal.push_back(signal.back() + step(gen));
+
+    const auto msd = correlate(signal, layout, squaredDifference, schedule);
+    const int n = static_cast<int>(signal.size());
+
+    for (int j = 0; j < layout.blockSize; ++j)
+    {
+        double sum = 0;
+        for (int t = j; t < n; ++t)
+            sum += squaredDifference(signal[t], signal[t-j]);
+
+        ASSERT_EQ(schedule.count(0, j), n - j);
+        ASSERT_NEAR(msd[j], sum / (n - j), 1e-9 * (1 + std::abs(sum)));
+    }
+}
+
+TEST (MULTI_TAU, ballistic_msd_is_exact_at_all_levels)
+{
+    const multi_tau::Layout layout {6, 16, 2};
+    multi_tau::MultiTauSchedule schedule(layout);
+
+    const double v = 0.3;
+    std::vector<double> signal;
+    for (int i = 0; i < 5000; ++i)
+        signal.push_back(v * i);
+
+    const auto msd = correlate(signal, layout, squaredDifference, schedule);
+
+    for (int level = 0; level < layout.numLevels; ++level)
+        for (int j = layout.firstLagIndex(level); j < layout.blockSize; ++j)
+        {
+            ASSERT_GT(schedule.count(level, j), 0);
+            const double tau = static_cast<double>(layout.lag(level, j));
+            ASSERT_NEAR(msd[level * layout.blockSize + j], v * v * tau * tau, 1e-9 * (1 + tau * tau));
+        }
+}
+
+TEST (MULTI_TAU, constant_signal_has_constant_autocorrelation)
+{
+    const multi_tau::Layout layout {5, 4, 2};
+    multi_tau::MultiTauSchedule schedule(layout);
+
+    const double c = 1.5;
+    const std::vector<double> signal(300, c);
+
+    const auto acf = correlate(signal, layout, product, schedule);
+
+    for (int level = 0; level < layout.numLevels; ++level)
+        for (int j = layout.firstLagIndex(level); j < layout.blockSize; ++j)
+            ASSERT_NEAR(acf[level * layout.blockSize + j], c * c, 1e-12);
+}
+
+TEST (MULTI_TAU, schedule_updates_levels_at_the_right_rate)
+{
+    const multi_tau::Layout layout {4, 4, 2};
+    multi_tau::MultiTauSchedule schedule(layout);
+
+    for (int i = 1; i <= 64; ++i)
+    {
+        int expected = 1;
+        for (int k = i; k % 2 == 0 && expected < layout.numLevels; k /= 2)
+            ++expected;
+
+        ASSERT_EQ(schedule.push(), expected);
+    }
+
+    // level l received 64 / 2^l values
+    for (int level = 0; level < layout.numLevels; ++level)
+    {
+        const long nvalues = 64 >> level;
+        for (int j = layout.firstLagIndex(level); j < layout.blockSize; ++j)
+            ASSERT_EQ(schedule.count(level, j), nvalues - j);
+    }
+
+    ASSERT_EQ(layout.lag(0, 3), 3);
+    ASSERT_EQ(layout.lag(3, 2), 16);
+    ASSERT_EQ(layout.firstLagIndex(0), 0);
+    ASSERT_EQ(layout.firstLagIndex(2), 2);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,193 @@
+#include <mirheo/core/integrators/factory.h>
+#include <mirheo/core/integrators/sub_step.h>
+#include <mirheo/core/interactions/membrane/base_membrane.h>
+#include <mirheo/core/interactions/membrane/factory.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/managers/interactions.h>
+#include <mirheo/core/managers/multi_time_stepping.h>
+#include <mirheo/core/mesh/membrane.h>
+#include <mirheo/core/pvs/membrane_vector.h>
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+static const std::string rbc_off = "../../data/rbc_mesh.off";
+
+static std::shared_ptr<BaseMembraneInteraction> createFastForces(const MirState *state)
+{
+    CommonMembraneParameters common;
+    common.ka = 5000.0_r;
+    common.kv = 5000.0_r;
+    common.gammaC = 0.0_r;
+    common.kBT = 0.0_r;
+    common.totArea0 = 135.0_r;
+    common.totVolume0 = 94.0_r;
+
+    KantorBendingParameters bending;
+    bending.kb = 40.0_r;
+    bending.theta = 0.0_r;
+
+    WLCParameters shear;
+    shear.x0 = 0.457_r;
+    shear.ks = 20.0_r;
+    shear.mpow = 2.0_r;
+    shear.kd = 250.0_r;
+    shear.totArea0 = common.totArea0;
+
+    return createInteractionMembrane(state, "fast", common, bending, shear,
+                                     false, 1.0_r, 0.0_r, FilterKeepAll{});
+}
+
+static void initialize(MembraneVector *mv, const MembraneMesh *mesh, int nObjects)
+{
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<real> noise(-0.05_r, 0.05_r);
+    std::normal_distribution<real> vel(0.0_r, 0.1_r);
+
+    const auto& vertices = mesh->getVertices();
+    const int nv = mesh->getNvertices();
+
+    auto& pos = mv->local()->positions();
+    auto& vels = mv->local()->velocities();
+
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        for (int i = 0; i < nv; ++i)
+        {
+            const int pid = objId * nv + i;
+            pos[pid] = vertices[i];
+            pos[pid].x += 10.0_r * objId + noise(gen);
+            pos[pid].y += noise(gen);
+            pos[pid].z += noise(gen);
+            vels[pid] = make_real4(vel(gen), vel(gen), vel(gen), 0.0_r);
+        }
+    }
+    pos .uploadToDevice(defaultStream);
+    vels.uploadToDevice(defaultStream);
+}
+
+static void setSlowForces(MembraneVector *mv, int step)
+{
+    std::mt19937 gen(step);
+    std::uniform_real_distribution<real> distr(-1.0_r, 1.0_r);
+
+    auto& forces = mv->local()->forces();
+    for (auto& f : forces)
+        f.f = make_real3(distr(gen), distr(gen), distr(gen));
+
+    forces.uploadToDevice(defaultStream);
+}
+
+template <class Advance>
+static void run(MembraneVector *mv, MirState *state, int nsteps, Advance advance)
+{
+    for (int i = 0; i < nsteps; ++i)
+    {
+        state->currentStep = i;
+        state->currentTime = i * state->getDt();
+
+        setSlowForces(mv, i);
+        advance();
+    }
+
+    mv->local()->positions ().downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    mv->local()->velocities().downloadFromDevice(defaultStream, ContainersSynch::Synch);
+}
+
+static void compare(MembraneVector *mvRef, MembraneVector *mv)
+{
+    const auto& posRef = mvRef->local()->positions();
+    const auto& pos    = mv   ->local()->positions();
+    const auto& velRef = mvRef->local()->velocities();
+    const auto& vel    = mv   ->local()->velocities();
+
+    // same operations; only the order of the atomic force additions may differ
+    const real tol = 1e-4_r;
+
+    for (size_t i = 0; i < posRef.size(); ++i)
+    {
+        ASSERT_NEAR(posRef[i].x, pos[i].x, tol);
+        ASSERT_NEAR(posRef[i].y, pos[i].y, tol);
+        ASSERT_NEAR(posRef[i].z, pos[i].z, tol);
+
+        ASSERT_NEAR(velRef[i].x, vel[i].x, tol);
+        ASSERT_NEAR(velRef[i].y, vel[i].y, tol);
+        ASSERT_NEAR(velRef[i].z, vel[i].z, tol);
+    }
+}
+
+// substepsPerLevel: sub steps of each level; the membrane forces have the deepest level
+static void checkAgainstSubStepIntegrator(const std::vector<int>& substepsPerLevel)
+{
+    const real dt = 0.01_r;
+    const int nObjects = 3;
+    const int nsteps = 5;
+
+    int substeps = 1;
+    for (auto n : substepsPerLevel)
+        substeps *= n;
+
+    DomainInfo domain{{32.0_r, 32.0_r, 32.0_r}, {0,0,0}, {32.0_r, 32.0_r, 32.0_r}};
+    MirState stateRef(domain, dt, UnitConversion{});
+    MirState state   (domain, dt, UnitConversion{});
+
+    auto mesh = std::make_shared<MembraneMesh>(rbc_off);
+
+    MembraneVector mvRef(&stateRef, "ref", 1.0_r, mesh, nObjects);
+    MembraneVector mv   (&state,    "mts", 1.0_r, mesh, nObjects);
+    initialize(&mvRef, mesh.get(), nObjects);
+    initialize(&mv,    mesh.get(), nObjects);
+
+    // reference: frozen slow forces with one level of sub steps
+    auto fastRef = createFastForces(&stateRef);
+    auto integratorRef = integrator_factory::createSubStep(&stateRef, "ref", substeps, {fastRef.get()});
+    integratorRef->setPrerequisites(&mvRef);
+
+    run(&mvRef, &stateRef, nsteps, [&]() {integratorRef->execute(&mvRef, defaultStream);});
+
+    // multiple time stepping, membrane forces at the deepest level
+    const int level = static_cast<int>(substepsPerLevel.size());
+    auto fast = createFastForces(&state);
+    auto integrator = integrator_factory::createVV(&state, "vv");
+    integrator->setPrerequisites(&mv);
+    fast->setPrerequisites(&mv, &mv, nullptr, nullptr);
+
+    InteractionManager manager;
+    manager.add(fast.get(), &mv, &mv, nullptr, nullptr, level);
+
+    MultiTimeStepping mts(&state, substepsPerLevel, &manager);
+    mts.addInteraction(fast.get(), level, &mv, &mv);
+    mts.addIntegrator(integrator.get(), &mv);
+
+    ASSERT_TRUE(mts.manages(&mv));
+
+    run(&mv, &state, nsteps, [&]() {mts.execute(defaultStream);});
+
+    compare(&mvRef, &mv);
+}
+
+TEST (MULTI_TIME_STEPPING, one_level_matches_sub_step_integrator)
+{
+    checkAgainstSubStepIntegrator({10});
+}
+
+TEST (MULTI_TIME_STEPPING, nested_levels_match_sub_step_integrator)
+{
+    checkAgainstSubStepIntegrator({2, 5});
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "multi_time_stepping.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -5,6 +5,7 @@
 #include <mirheo/core/containers.h>
 #include <mirheo/core/exchangers/api.h>
 #include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/packers/compressed_particles.h>
 #include <mirheo/core/pvs/particle_vector.h>
 #include <mirheo/core/pvs/rigid_ashape_object_vector.h>
 #include <mirheo/core/utils/cuda_common.h>
@@ -14,6 +15,7 @@
 #include <cmath>
 #include <cstdio>
 #include <gtest/gtest.h>
+#include <limits>
 #include <random>
 #include <vector>
 
@@ -63,7 +65,7 @@ struct Comp // for sorting particles
 
 static void checkHalo(const PinnedBuffer<real4>& lpos,
                       const PinnedBuffer<real4>& hpos,
-                      real3 L, real rc)
+                      real3 L, real rc, real tolerance = 1e-6_r)
 {
     std::vector<real4> hposSorted(hpos.begin(), hpos.end());
     std::sort(hposSorted.begin(), hposSorted.end(), Comp());
@@ -115,7 +117,7 @@ static void checkHalo(const PinnedBuffer<real4>& lpos,
                 ++lb;
             };
 
-            ASSERT_LE(err, 1e-6f);
+            ASSERT_LE(err, tolerance);
         }
     }
 }
@@ -164,6 +166,109 @@ TEST (PACKERS_EXCHANGE, particles)
     checkRef(hpos, hvel, domain.localSize);
 }
 
+TEST (PACKERS_EXCHANGE, particles_compressed)
+{
+    real dt = 0.0_r;
+    real rc = 1.0_r;
+    real L  = 48.0_r;
+    real density = 8.0_r;
+    DomainInfo domain;
+    domain.globalSize  = {L, L, L};
+    domain.globalStart = {0.0_r, 0.0_r, 0.0_r};
+    domain.localSize   = {L, L, L};
+    MirState state(domain, dt, UnitConversion{});
+    auto pv = initializeRandomPV(MPI_COMM_WORLD, &state, density);
+    auto lpv = pv->local();
+    auto hpv = pv->halo();
+
+    auto& lpos = lpv->positions();
+
+    auto cl = std::make_unique<PrimaryCellList>(pv.get(), rc, domain.localSize);
+    cl->build(defaultStream);
+
+    auto exch = std::make_unique<ParticleHaloExchanger>();
+    exch->attach(pv.get(), cl.get(), {}, true);
+
+    auto engine = std::make_unique<SingleNodeExchangeEngine>(std::move(exch));
+
+    engine->init(defaultStream);
+    engine->finalize(defaultStream);
+
+    lpos.downloadFromDevice(defaultStream);
+
+    auto& hpos = hpv->positions();
+    hpos.downloadFromDevice(defaultStream);
+
+    // positions are quantized inside the cells
+    const real tolerance = cl->h.x / 65536.0_r;
+    checkHalo(lpos, hpos, domain.localSize, rc, tolerance);
+}
+
+TEST (PACKERS_EXCHANGE, compressed_position_roundtrip_error_is_bounded)
+{
+    const real3 L {48.0_r, 24.0_r, 12.0_r};
+    const int3 ncells {40, 24, 10};
+    const halo_compression::PositionCodec codec(ncells, L);
+
+    const real3 h = L / make_real3(ncells);
+    // quantization error plus rounding error of the floating point operations
+    const real3 tolerance = h / 131072.0_r + 8 * std::numeric_limits<real>::epsilon() * (0.5_r * L + h);
+
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<real> ux(-0.5_r * L.x - h.x, 0.5_r * L.x + h.x);
+    std::uniform_real_distribution<real> uy(-0.5_r * L.y - h.y, 0.5_r * L.y + h.y);
+    std::uniform_real_distribution<real> uz(-0.5_r * L.z - h.z, 0.5_r * L.z + h.z);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        const real3 r {ux(gen), uy(gen), uz(gen)};
+
+        halo_compression::QuantizedPosition q;
+        const int cid = codec.encode(r, q);
+        const real3 rd = codec.decode(cid, q);
+
+        ASSERT_LE(math::abs(rd.x - r.x), tolerance.x);
+        ASSERT_LE(math::abs(rd.y - r.y), tolerance.y);
+        ASSERT_LE(math::abs(rd.z - r.z), tolerance.z);
+    }
+}
+
+TEST (PACKERS_EXCHANGE, compressed_velocity_roundtrip_error_is_bounded)
+{
+    using half_precision::floatToHalf;
+    using half_precision::halfToFloat;
+
+    // exactly representable values
+    for (float x : {0.0f, 1.0f, -2.0f, 0.5f, 1024.0f, -65504.0f, 6.103515625e-05f, 5.9604644775390625e-08f})
+        ASSERT_EQ(halfToFloat(floatToHalf(x)), x);
+
+    ASSERT_TRUE(std::isinf(halfToFloat(floatToHalf( 1e6f))));
+    ASSERT_TRUE(std::isinf(halfToFloat(floatToHalf(-1e6f))));
+    ASSERT_TRUE(std::isnan(halfToFloat(floatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+    ASSERT_EQ(halfToFloat(floatToHalf(1e-9f)), 0.0f);
+
+    std::mt19937 gen(4243);
+    std::uniform_real_distribution<float> logMagnitude(-14.0f, 15.0f);
+    std::bernoulli_distribution negative(0.5);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        const float x = (negative(gen) ? -1.0f : 1.0f) * std::pow(2.0f, logMagnitude(gen));
+        const float xd = halfToFloat(floatToHalf(x));
+
+        // normal range: relative error of half the unit in the last place
+        ASSERT_LE(std::abs(xd - x), std::abs(x) / 2048.0f);
+    }
+
+    // subnormal range: absolute error of half the smallest subnormal
+    std::uniform_real_distribution<float> small(-6.1e-5f, 6.1e-5f);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const float x = small(gen);
+        ASSERT_LE(std::abs(halfToFloat(floatToHalf(x)) - x), 0.5f * 5.9604644775390625e-08f);
+    }
+}
+
 /*
  * tests for object exchange:
  * apply a field to the object particles in 2 manners:
@@ -472,6 +577,246 @@ TEST (PACKERS_EXCHANGE, objects_extra_exchange)
     }
 }
 
+/*
+ * tests for partial object exchange:
+ * only the particles within rc of the boundaries are sent, without the object structure
+ */
+
+// number of halo images of a particle in each direction: -1, 0 or 1
+static int3 getHaloDirection(real3 r, real3 L, real rc)
+{
+    int3 d {0, 0, 0};
+    if (r.x < -0.5_r * L.x + rc) d.x = -1;
+    if (r.y < -0.5_r * L.y + rc) d.y = -1;
+    if (r.z < -0.5_r * L.z + rc) d.z = -1;
+
+    if (r.x >  0.5_r * L.x - rc) d.x = 1;
+    if (r.y >  0.5_r * L.y - rc) d.y = 1;
+    if (r.z >  0.5_r * L.z - rc) d.z = 1;
+    return d;
+}
+
+// sum of the field applied to all the halo images of each particle
+static std::vector<Force> getFieldOfHaloImages(const PinnedBuffer<real4>& pos, real3 L, real rc, int *numImages)
+{
+    std::vector<Force> forces(pos.size());
+    *numImages = 0;
+
+    for (size_t i = 0; i < pos.size(); ++i)
+    {
+        const auto r0 = make_real3(pos[i]);
+        const int3 d = getHaloDirection(r0, L, rc);
+        forces[i].f = make_real3(0.0_r);
+
+        for (int ix = math::min(d.x, 0); ix <= math::max(d.x, 0); ++ix)
+        for (int iy = math::min(d.y, 0); iy <= math::max(d.y, 0); ++iy)
+        for (int iz = math::min(d.z, 0); iz <= math::max(d.z, 0); ++iz)
+        {
+            if (ix == 0 && iy == 0 && iz == 0) continue;
+
+            const real3 r {r0.x - ix * L.x,
+                           r0.y - iy * L.y,
+                           r0.z - iz * L.z};
+
+            forces[i] += getField(r);
+            ++(*numImages);
+        }
+    }
+    return forces;
+}
+
+TEST (PACKERS_EXCHANGE, objects_partial_exchange)
+{
+    real dt = 0.0_r;
+    real rc = 1.0_r;
+    real L  = 48.0_r;
+    int nObjs = 1024;
+    int objSize = 555;
+
+    DomainInfo domain;
+    domain.globalSize  = {L, L, L};
+    domain.globalStart = {0.0_r, 0.0_r, 0.0_r};
+    domain.localSize   = {L, L, L};
+    MirState state(domain, dt, UnitConversion{});
+    auto rev = initializeRandomREV(MPI_COMM_WORLD, &state, nObjs, objSize);
+    auto lrev = rev->local();
+    auto hrev = rev->halo();
+
+    auto& lpos = lrev->positions();
+    auto& lforces = lrev->forces();
+
+    auto& hpos = hrev->positions();
+    auto& hforces = hrev->forces();
+
+    lpos.downloadFromDevice(defaultStream);
+
+    int numImages = 0;
+    getFieldOfHaloImages(lpos, domain.localSize, rc, &numImages);
+
+    std::vector<std::string> extraExchangeChannels = {channel_names::forces};
+
+    auto exchanger = std::make_unique<ObjectHaloExchanger>();
+
+    exchanger->attach(rev.get(), rc, extraExchangeChannels, false);
+
+    auto engineExchange = std::make_unique<SingleNodeExchangeEngine>(std::move(exchanger));
+
+    clearForces(lforces);
+    applyFieldUnbounded(lpos, lforces);
+    lforces.uploadToDevice(defaultStream);
+
+    engineExchange->init(defaultStream);
+    engineExchange->finalize(defaultStream);
+
+    hpos   .downloadFromDevice(defaultStream);
+    hforces.downloadFromDevice(defaultStream);
+
+    ASSERT_EQ(hrev->size(), numImages);
+    ASSERT_EQ(hrev->getNumObjects(), 0);
+
+    // all halo particles are within rc outside of the subdomain
+    for (size_t i = 0; i < hpos.size(); ++i)
+    {
+        const auto r = make_real3(hpos[i]);
+        ASSERT_FALSE(isInside(r, domain.localSize));
+        ASSERT_TRUE(isInside(r, domain.localSize + 2 * rc));
+    }
+
+    checkForces(hpos, hforces, domain.localSize);
+}
+
+TEST (PACKERS_EXCHANGE, objects_partial_reverse_exchange)
+{
+    real dt = 0.0_r;
+    real rc = 1.0_r;
+    real L  = 48.0_r;
+    int nObjs = 1024;
+    int objSize = 555;
+
+    DomainInfo domain;
+    domain.globalSize  = {L, L, L};
+    domain.globalStart = {0.0_r, 0.0_r, 0.0_r};
+    domain.localSize   = {L, L, L};
+    MirState state(domain, dt, UnitConversion{});
+    auto rev = initializeRandomREV(MPI_COMM_WORLD, &state, nObjs, objSize);
+    auto lrev = rev->local();
+    auto hrev = rev->halo();
+
+    auto& lpos = lrev->positions();
+    auto& lforces = lrev->forces();
+
+    auto& hpos = hrev->positions();
+    auto& hforces = hrev->forces();
+
+    lpos.downloadFromDevice(defaultStream);
+
+    clearForces(lforces);
+    lforces.uploadToDevice(defaultStream);
+
+    int numImages = 0;
+    const auto refForces = getFieldOfHaloImages(lpos, domain.localSize, rc, &numImages);
+
+    std::vector<std::string>   extraExchangeChannels = {};
+    std::vector<std::string> reverseExchangeChannels = {channel_names::forces};
+
+    auto exchanger        = std::make_unique<ObjectHaloExchanger>();
+    auto reverseExchanger = std::make_unique<ObjectReverseExchanger>(exchanger.get());
+
+    exchanger       ->attach(rev.get(), rc, extraExchangeChannels, false);
+    reverseExchanger->attach(rev.get(),   reverseExchangeChannels);
+
+    auto engineExchange        = std::make_unique<SingleNodeExchangeEngine>(std::move(exchanger));
+    auto engineReverseExchange = std::make_unique<SingleNodeExchangeEngine>(std::move(reverseExchanger));
+
+    engineExchange->init(defaultStream);
+    engineExchange->finalize(defaultStream);
+
+    hpos   .downloadFromDevice(defaultStream);
+    hforces.downloadFromDevice(defaultStream);
+    clearForces(hforces);
+    applyFieldUnbounded(hpos, hforces);
+    hforces.uploadToDevice(defaultStream);
+
+    engineReverseExchange->init(defaultStream);
+    engineReverseExchange->finalize(defaultStream);
+
+    lforces.downloadFromDevice(defaultStream);
+
+    compareForces(lforces, refForces);
+}
+
+TEST (PACKERS_EXCHANGE, objects_partial_extra_exchange)
+{
+    real dt = 0.0_r;
+    real rc = 1.0_r;
+    real L  = 48.0_r;
+    int nObjs = 1024;
+    int objSize = 555;
+
+    DomainInfo domain;
+    domain.globalSize  = {L, L, L};
+    domain.globalStart = {0.0_r, 0.0_r, 0.0_r};
+    domain.localSize   = {L, L, L};
+    MirState state(domain, dt, UnitConversion{});
+    auto rev = initializeRandomREV(MPI_COMM_WORLD, &state, nObjs, objSize);
+    auto lrev = rev->local();
+    auto hrev = rev->halo();
+
+    const std::string extraChannelName = "single_real_field";
+
+    rev->requireDataPerParticle<real>(extraChannelName,
+                                       DataManager::PersistenceMode::None,
+                                       DataManager::ShiftMode::None);
+
+    auto& lpos = lrev->positions();
+    auto& lforces = lrev->forces();
+    auto& lfield = *lrev->dataPerParticle.getData<real>(extraChannelName);
+
+    auto& hforces = hrev->forces();
+    auto& hfield = *hrev->dataPerParticle.getData<real>(extraChannelName);
+
+    auto fieldTransform = [](Force f){return length(f.f);};
+
+    std::vector<std::string> exchangeChannels = {channel_names::forces};
+    std::vector<std::string> extraExchangeChannels = {extraChannelName};
+
+    lpos.downloadFromDevice(defaultStream);
+    clearForces(lforces);
+    applyFieldUnbounded(lpos, lforces);
+    std::transform(lforces.begin(), lforces.end(), lfield.begin(), fieldTransform);
+
+    lforces.uploadToDevice(defaultStream);
+    lfield.uploadToDevice(defaultStream);
+
+    auto exchanger      = std::make_unique<ObjectHaloExchanger>();
+    auto extraExchanger = std::make_unique<ObjectExtraExchanger>(exchanger.get());
+
+    exchanger     ->attach(rev.get(), rc, exchangeChannels, false);
+    extraExchanger->attach(rev.get(), extraExchangeChannels);
+
+    auto engineExchange      = std::make_unique<SingleNodeExchangeEngine>(std::move(exchanger));
+    auto engineExtraExchange = std::make_unique<SingleNodeExchangeEngine>(std::move(extraExchanger));
+
+    engineExchange->init(defaultStream);
+    engineExchange->finalize(defaultStream);
+
+    hforces.downloadFromDevice(defaultStream);
+
+    engineExtraExchange->init(defaultStream);
+    engineExtraExchange->finalize(defaultStream);
+
+    hfield.downloadFromDevice(defaultStream);
+
+    ASSERT_GT(hforces.size(), 0u);
+
+    for (size_t i = 0; i < hforces.size(); ++i)
+    {
+        auto ref = fieldTransform(hforces[i]);
+        auto val = hfield[i];
+        ASSERT_EQ(ref, val) << "wrong value for index " << i;
+    }
+}
+
 
 int main(int argc, char **argv)
 {
@@ -0,0 +1,197 @@
+#include <mirheo/core/logger.h>
+#include <mirheo/core/marching_cubes.h>
+#include <mirheo/core/utils/position_function.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+static std::vector<real3> randomPositions(int n, long seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<real> udistr(-2.0_r, 2.0_r);
+
+    std::vector<real3> positions(n);
+    for (auto& r : positions)
+        r = {udistr(gen), udistr(gen), udistr(gen)};
+    return positions;
+}
+
+static real sphere(real3 r)
+{
+    return length(r) - 1.0_r;
+}
+
+static real3 shear(real3 r)
+{
+    return {r.y, -0.5_r * r.x, r.x * r.z};
+}
+
+// batch version of a point function, that counts the number of calls
+template <typename T, typename F>
+static typename PositionFunction<T>::BatchFunction makeBatch(F func, int& ncalls)
+{
+    return [func, &ncalls](const real3 *positions, int n, T *values)
+    {
+        ++ncalls;
+        for (int i = 0; i < n; ++i)
+            values[i] = func(positions[i]);
+    };
+}
+
+TEST (POSITION_FUNCTION, pointwise_function_evaluated_on_batch)
+{
+    const PositionFunction<real> f(sphere);
+    ASSERT_FALSE(f.isBatched());
+
+    const auto positions = randomPositions(1000, 42);
+    const int n = static_cast<int>(positions.size());
+
+    std::vector<real> values(n);
+    f(positions.data(), n, values.data());
+
+    for (int i = 0; i < n; ++i)
+        ASSERT_EQ(values[i], sphere(positions[i]));
+}
+
+TEST (POSITION_FUNCTION, batch_function_evaluated_pointwise)
+{
+    int ncalls = 0;
+    const PositionFunction<real> f(makeBatch<real>(sphere, ncalls));
+    ASSERT_TRUE(f.isBatched());
+
+    const auto positions = randomPositions(1000, 43);
+    const int n = static_cast<int>(positions.size());
+
+    std::vector<real> values(n);
+    f(positions.data(), n, values.data());
+    ASSERT_EQ(ncalls, 1);
+
+    for (int i = 0; i < n; ++i)
+        ASSERT_EQ(values[i], f(positions[i]));
+
+    ASSERT_EQ(ncalls, 1 + n);
+}
+
+TEST (POSITION_FUNCTION, vector_field_batch_matches_pointwise)
+{
+    int ncalls = 0;
+    const PositionFunction<real3> pointwise(shear);
+    const PositionFunction<real3> batched(makeBatch<real3>(shear, ncalls));
+
+    const auto positions = randomPositions(500, 44);
+    const int n = static_cast<int>(positions.size());
+
+    std::vector<real3> fromPoints(n), fromBatch(n);
+    pointwise(positions.data(), n, fromPoints.data());
+    batched  (positions.data(), n, fromBatch .data());
+    ASSERT_EQ(ncalls, 1);
+
+    for (int i = 0; i < n; ++i)
+    {
+        const real3 expected = shear(positions[i]);
+        ASSERT_EQ(fromPoints[i].x, expected.x);
+        ASSERT_EQ(fromPoints[i].y, expected.y);
+        ASSERT_EQ(fromPoints[i].z, expected.z);
+        ASSERT_EQ(fromBatch[i].x, expected.x);
+        ASSERT_EQ(fromBatch[i].y, expected.y);
+        ASSERT_EQ(fromBatch[i].z, expected.z);
+    }
+}
+
+TEST (POSITION_FUNCTION, filter_batch_matches_pointwise)
+{
+    auto inside = [](real3 r) {return sphere(r) < 0.0_r;};
+
+    int ncalls = 0;
+    const PositionFunction<bool> batched(makeBatch<bool>(inside, ncalls));
+
+    const auto positions = randomPositions(1000, 45);
+    const int n = static_cast<int>(positions.size());
+
+    std::unique_ptr<bool[]> keep(new bool[n]);
+    batched(positions.data(), n, keep.get());
+
+    int nkept = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        ASSERT_EQ(keep[i], inside(positions[i]));
+        nkept += keep[i];
+    }
+
+    // the filter must keep some of the positions and reject others for the test to be meaningful
+    ASSERT_GT(nkept, 0);
+    ASSERT_LT(nkept, n);
+}
+
+TEST (POSITION_FUNCTION, marching_cubes_batch_matches_pointwise)
+{
+    DomainInfo domain;
+    domain.globalStart = make_real3(-1.5_r, -1.5_r, -1.5_r);
+    domain.localSize   = make_real3(3.0_r, 3.0_r, 3.0_r);
+    domain.globalSize  = domain.localSize;
+
+    const real3 resolution {0.1_r, 0.1_r, 0.1_r};
+
+    int ncalls = 0;
+    const PositionFunction<real> batched(makeBatch<real>(sphere, ncalls));
+
+    // evaluated the same way as in the velocity inlet plugin
+    auto surface = [&batched](const real3 *positions, int n, real *values)
+    {
+        batched(positions, n, values);
+    };
+
+    std::vector<real3> verticesBatch, verticesPoints;
+    std::vector<int3> facesBatch, facesPoints;
+    marching_cubes::computeMesh(domain, resolution, surface, verticesBatch, facesBatch);
+    marching_cubes::computeMesh(domain, resolution, sphere,  verticesPoints, facesPoints);
+
+    // one call per x plane of grid points
+    ASSERT_EQ(ncalls, static_cast<int>(domain.localSize.x / resolution.x) + 1);
+
+    ASSERT_GT(facesBatch.size(), 0u);
+    ASSERT_EQ(verticesBatch.size(), verticesPoints.size());
+    ASSERT_EQ(facesBatch.size(), facesPoints.size());
+
+    for (size_t i = 0; i < verticesBatch.size(); ++i)
+    {
+        ASSERT_EQ(verticesBatch[i].x, verticesPoints[i].x);
+        ASSERT_EQ(verticesBatch[i].y, verticesPoints[i].y);
+        ASSERT_EQ(verticesBatch[i].z, verticesPoints[i].z);
+    }
+
+    for (size_t i = 0; i < facesBatch.size(); ++i)
+    {
+        ASSERT_EQ(facesBatch[i].x, facesPoints[i].x);
+        ASSERT_EQ(facesBatch[i].y, facesPoints[i].y);
+        ASSERT_EQ(facesBatch[i].z, facesPoints[i].z);
+    }
+}
+
+TEST (POSITION_FUNCTION, empty_function_dies)
+{
+    const PositionFunction<real> f;
+    ASSERT_FALSE(static_cast<bool>(f));
+
+    real3 r {0.0_r, 0.0_r, 0.0_r};
+    real value;
+    ASSERT_ANY_THROW(f(r));
+    ASSERT_ANY_THROW(f(&r, 1, &value));
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "position_function.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
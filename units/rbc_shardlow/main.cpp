@@ -0,0 +1,275 @@
+#include <mirheo/core/integrators/factory.h>
+#include <mirheo/core/integrators/rbc_shardlow.h>
+#include <mirheo/core/interactions/membrane/base_membrane.h>
+#include <mirheo/core/interactions/membrane/factory.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/mesh/edge_colors.h>
+#include <mirheo/core/mesh/membrane.h>
+#include <mirheo/core/mesh/topology.h>
+#include <mirheo/core/pvs/membrane_vector.h>
+#include <mirheo/core/utils/cuda_rng.h>
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+static const std::string rbc_off = "../../data/rbc_mesh.off";
+
+// all the stiffnesses are multiplied by stiffness; 0 gives no fast forces
+static std::shared_ptr<BaseMembraneInteraction> createFastForces(const MirState *state, real stiffness = 1.0_r)
+{
+    CommonMembraneParameters common;
+    common.ka = 5000.0_r * stiffness;
+    common.kv = 5000.0_r * stiffness;
+    common.gammaC = 0.0_r;
+    common.kBT = 0.0_r;
+    common.totArea0 = 135.0_r;
+    common.totVolume0 = 94.0_r;
+
+    KantorBendingParameters bending;
+    bending.kb = 40.0_r * stiffness;
+    bending.theta = 0.0_r;
+
+    WLCParameters shear;
+    shear.x0 = 0.457_r;
+    shear.ks = 20.0_r * stiffness;
+    shear.mpow = 2.0_r;
+    shear.kd = 250.0_r * stiffness;
+    shear.totArea0 = common.totArea0;
+
+    return createInteractionMembrane(state, "fast", common, bending, shear,
+                                     false, 1.0_r, 0.0_r, FilterKeepAll{});
+}
+
+static void initialize(MembraneVector *mv, const MembraneMesh *mesh, int nObjects)
+{
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<real> noise(-0.05_r, 0.05_r);
+    std::normal_distribution<real> vel(0.0_r, 0.1_r);
+
+    const auto& vertices = mesh->getVertices();
+    const int nv = mesh->getNvertices();
+
+    auto& pos = mv->local()->positions();
+    auto& vels = mv->local()->velocities();
+
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        for (int i = 0; i < nv; ++i)
+        {
+            const int pid = objId * nv + i;
+            pos[pid] = vertices[i];
+            pos[pid].x += 10.0_r * objId + noise(gen);
+            pos[pid].y += noise(gen);
+            pos[pid].z += noise(gen);
+            vels[pid] = make_real4(vel(gen), vel(gen), vel(gen), 0.0_r);
+        }
+    }
+    pos .uploadToDevice(defaultStream);
+    vels.uploadToDevice(defaultStream);
+}
+
+static void setSlowForces(MembraneVector *mv, int step)
+{
+    std::mt19937 gen(step);
+    std::uniform_real_distribution<real> distr(-1.0_r, 1.0_r);
+
+    auto& forces = mv->local()->forces();
+    for (auto& f : forces)
+        f.f = make_real3(distr(gen), distr(gen), distr(gen));
+
+    forces.uploadToDevice(defaultStream);
+}
+
+static void run(MembraneVector *mv, IntegratorSubStepShardlowSweep *integrator, MirState *state, int nsteps)
+{
+    integrator->setPrerequisites(mv);
+
+    for (int i = 0; i < nsteps; ++i)
+    {
+        state->currentStep = i;
+        state->currentTime = i * state->getDt();
+
+        setSlowForces(mv, i);
+        integrator->execute(mv, defaultStream);
+    }
+
+    mv->local()->positions ().downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    mv->local()->velocities().downloadFromDevice(defaultStream, ContainersSynch::Synch);
+}
+
+// host version of the Shardlow update of one edge, see rbc_shardlow_kernels::sweepEdge()
+static void sweepEdgeReference(real3 ri, real3 rj, real3& vi, real3& vj, int i, int j,
+                               real dt, real gamma, real sigma, real invMass, real seed)
+{
+    const real3 eij = normalize(rj - ri);
+
+    const real inv2m = 0.5_r * invMass;
+    const real dtgamma = dt * gamma;
+    const real sqrtdtsigma = math::sqrt(dt) * sigma;
+    const real xiij = 3.4641016151_r * (Saru::uniform01(seed, i, j) - 0.5_r);
+
+    // explicit step
+    {
+        const real3 dv = (dtgamma * inv2m * dot(eij, vj - vi) - sqrtdtsigma * inv2m * xiij) * eij;
+        vi += dv;
+        vj -= dv;
+    }
+
+    // implicit step
+    {
+        const real frac = inv2m * dtgamma / (1.0_r + dtgamma);
+        const real3 dv = (frac * (dot(eij, vj - vi) + sqrtdtsigma * xiij) - inv2m * sqrtdtsigma * xiij) * eij;
+        vi += dv;
+        vj -= dv;
+    }
+}
+
+// one time step with one sub step and one sweep, without forces: a single viscous sweep followed by the drift
+static void referenceStep(const MembraneMesh *mesh, int nObjects, real dt, real gammaC, real kBT,
+                          std::vector<real3>& pos, std::vector<real3>& vel)
+{
+    const auto& edgeSets = mesh->getTopology().getDistinctEdgeSets();
+    const int nv = mesh->getNvertices();
+    const real sigma = math::sqrt(2 * gammaC * kBT);
+    const real invMass = 1.0_r;
+
+    // same random numbers as the integrator
+    std::mt19937 gen;
+    std::uniform_real_distribution<real> u(0.0_r, 1.0_r);
+
+    for (int color = 0; color < edgeSets.numColors(); ++color)
+    {
+        const real seed = u(gen);
+
+        for (int objId = 0; objId < nObjects; ++objId)
+        {
+            for (const int2 edge : edgeSets.edgeSet(color))
+            {
+                const int i = objId * nv + edge.x;
+                const int j = objId * nv + edge.y;
+                sweepEdgeReference(pos[i], pos[j], vel[i], vel[j], i, j, dt, gammaC, sigma, invMass, seed);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < pos.size(); ++i)
+        pos[i] += dt * vel[i];
+}
+
+TEST (RBC_SHARDLOW, one_sweep_matches_host_reference)
+{
+    const real dt = 0.01_r;
+    const int nObjects = 2;
+    const real gammaC = 20.0_r;
+    const real kBT = 0.01_r;
+
+    DomainInfo domain{{32.0_r, 32.0_r, 32.0_r}, {0,0,0}, {32.0_r, 32.0_r, 32.0_r}};
+    auto mesh = std::make_shared<MembraneMesh>(rbc_off);
+
+    for (bool fused : {false, true})
+    {
+        MirState state(domain, dt, UnitConversion{});
+        MembraneVector mv(&state, "mv", 1.0_r, mesh, nObjects);
+        initialize(&mv, mesh.get(), nObjects);
+
+        std::vector<real3> posRef, velRef;
+        for (const auto& r : mv.local()->positions ()) posRef.push_back(make_real3(r));
+        for (const auto& v : mv.local()->velocities()) velRef.push_back(make_real3(v));
+
+        referenceStep(mesh.get(), nObjects, dt, gammaC, kBT, posRef, velRef);
+
+        auto noFastForces = createFastForces(&state, 0.0_r);
+        auto integrator = integrator_factory::createSubstepShardlowSweep(&state, "shardlow", 1, noFastForces.get(),
+                                                                         gammaC, kBT, 1, fused);
+        integrator->setPrerequisites(&mv);
+
+        mv.local()->forces().clear(defaultStream);
+        integrator->execute(&mv, defaultStream);
+
+        mv.local()->positions ().downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+        mv.local()->velocities().downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+        const auto& pos = mv.local()->positions();
+        const auto& vel = mv.local()->velocities();
+        const real tol = 1e-5_r;
+
+        for (size_t i = 0; i < posRef.size(); ++i)
+        {
+            ASSERT_NEAR(pos[i].x, posRef[i].x, tol) << "fused = " << fused;
+            ASSERT_NEAR(pos[i].y, posRef[i].y, tol) << "fused = " << fused;
+            ASSERT_NEAR(pos[i].z, posRef[i].z, tol) << "fused = " << fused;
+
+            ASSERT_NEAR(vel[i].x, velRef[i].x, tol) << "fused = " << fused;
+            ASSERT_NEAR(vel[i].y, velRef[i].y, tol) << "fused = " << fused;
+            ASSERT_NEAR(vel[i].z, velRef[i].z, tol) << "fused = " << fused;
+        }
+    }
+}
+
+TEST (RBC_SHARDLOW, fused_substeps_match_multi_kernel_path)
+{
+    const real dt = 0.01_r;
+    const int nObjects = 3;
+    const int substeps = 10;
+    const int nsweeps = 3;
+    const real gammaC = 20.0_r;
+    const real kBT = 0.01_r;
+    const int nsteps = 5;
+
+    DomainInfo domain{{32.0_r, 32.0_r, 32.0_r}, {0,0,0}, {32.0_r, 32.0_r, 32.0_r}};
+    MirState stateRef(domain, dt, UnitConversion{});
+    MirState stateFused(domain, dt, UnitConversion{});
+
+    auto mesh = std::make_shared<MembraneMesh>(rbc_off);
+
+    MembraneVector mvRef  (&stateRef,   "ref",   1.0_r, mesh, nObjects);
+    MembraneVector mvFused(&stateFused, "fused", 1.0_r, mesh, nObjects);
+    initialize(&mvRef,   mesh.get(), nObjects);
+    initialize(&mvFused, mesh.get(), nObjects);
+
+    auto fastRef   = createFastForces(&stateRef);
+    auto fastFused = createFastForces(&stateFused);
+
+    auto integratorRef   = integrator_factory::createSubstepShardlowSweep(&stateRef,   "ref",   substeps, fastRef.get(),
+                                                                          gammaC, kBT, nsweeps, false);
+    auto integratorFused = integrator_factory::createSubstepShardlowSweep(&stateFused, "fused", substeps, fastFused.get(),
+                                                                          gammaC, kBT, nsweeps, true);
+
+    run(&mvRef,   integratorRef  .get(), &stateRef,   nsteps);
+    run(&mvFused, integratorFused.get(), &stateFused, nsteps);
+
+    const auto& posRef   = mvRef  .local()->positions();
+    const auto& posFused = mvFused.local()->positions();
+    const auto& velRef   = mvRef  .local()->velocities();
+    const auto& velFused = mvFused.local()->velocities();
+
+    // same operations and random numbers; only the contraction of multiply-adds may differ
+    const real tol = 1e-4_r;
+
+    for (size_t i = 0; i < posRef.size(); ++i)
+    {
+        ASSERT_NEAR(posRef[i].x, posFused[i].x, tol);
+        ASSERT_NEAR(posRef[i].y, posFused[i].y, tol);
+        ASSERT_NEAR(posRef[i].z, posFused[i].z, tol);
+
+        ASSERT_NEAR(velRef[i].x, velFused[i].x, tol);
+        ASSERT_NEAR(velRef[i].y, velFused[i].y, tol);
+        ASSERT_NEAR(velRef[i].z, velFused[i].z, tol);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "rbc_shardlow.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -0,0 +1,223 @@
+#include <mirheo/core/containers.h>
+#include <mirheo/core/interactions/rod/kernels/transfer_matrix.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+static std::vector<real> randomEnergies(int n, int nstates, int seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<real> distr(0.0_r, 1.0_r);
+
+    std::vector<real> energies(n * nstates);
+    for (auto& e : energies)
+        e = distr(gen);
+    return energies;
+}
+
+static std::vector<real> randomUniforms(int n, std::mt19937& gen)
+{
+    std::uniform_real_distribution<real> distr(0.0_r, 1.0_r);
+    std::vector<real> u(n);
+    for (auto& x : u)
+        x = distr(gen);
+    return u;
+}
+
+static double totalEnergy(const std::vector<real>& energies, int nstates, real J, const std::vector<int>& states)
+{
+    double E = 0;
+    for (size_t b = 0; b < states.size(); ++b)
+    {
+        E += energies[b * nstates + states[b]];
+        if (b > 0)
+            E += J * std::abs(states[b] - states[b-1]);
+    }
+    return E;
+}
+
+// call f for all the nstates^n configurations
+template <class Func>
+static void forAllStates(int n, int nstates, Func f)
+{
+    std::vector<int> states(n, 0);
+    while (true)
+    {
+        f(states);
+
+        int b = 0;
+        while (b < n && ++states[b] == nstates)
+            states[b++] = 0;
+        if (b == n)
+            break;
+    }
+}
+
+TEST (ROD_STATES, reference_ground_state_is_minimum)
+{
+    constexpr int N = 3;
+    const int n = 6;
+    const std::vector<real> Js = {0.0_r, 0.1_r, 0.5_r, 2.0_r};
+
+    for (auto J : Js)
+    {
+        const auto energies = randomEnergies(n, N, 42);
+        const std::vector<real> uniforms(n, 0.5_r);
+
+        double Emin = 1e9;
+        forAllStates(n, N, [&](const std::vector<int>& states)
+        {
+            Emin = std::min(Emin, totalEnergy(energies, N, J, states));
+        });
+
+        const auto states = transfer_matrix::sampleStatesReference<N>(energies, J, 0.0_r, uniforms);
+        ASSERT_NEAR(Emin, totalEnergy(energies, N, J, states), 1e-5);
+    }
+}
+
+TEST (ROD_STATES, reference_samples_boltzmann_marginals)
+{
+    constexpr int N = 2;
+    const int n = 6;
+    const real J = 0.5_r;
+    const real kBT = 0.7_r;
+    const int nsamples = 40000;
+
+    const auto energies = randomEnergies(n, N, 1234);
+
+    std::vector<double> exact(n, 0.0);
+    double Z = 0.0;
+    forAllStates(n, N, [&](const std::vector<int>& states)
+    {
+        const double w = std::exp(-totalEnergy(energies, N, J, states) / kBT);
+        Z += w;
+        for (int b = 0; b < n; ++b)
+            exact[b] += w * states[b];
+    });
+
+    std::mt19937 gen(5678);
+    std::vector<double> measured(n, 0.0);
+    for (int i = 0; i < nsamples; ++i)
+    {
+        const auto states = transfer_matrix::sampleStatesReference<N>(energies, J, kBT, randomUniforms(n, gen));
+        for (int b = 0; b < n; ++b)
+            measured[b] += states[b];
+    }
+
+    // a few standard deviations of the estimate of a probability
+    const double tol = 0.015;
+    for (int b = 0; b < n; ++b)
+        ASSERT_NEAR(exact[b] / Z, measured[b] / nsamples, tol);
+}
+
+template <int N>
+__global__ void sampleStates(int n, const real *energies, const real *uniforms, real J, real kBT, int *states)
+{
+    extern __shared__ char shMem[];
+
+    auto energiesFunc = [&](int b, real *e)
+    {
+        for (int s = 0; s < N; ++s)
+            e[s] = energies[b * N + s];
+    };
+
+    auto uniformsFunc = [&](int b)
+    {
+        return uniforms[b];
+    };
+
+    transfer_matrix::sampleStatesBlock<N>(n, energiesFunc, uniformsFunc, J, kBT, states, shMem);
+}
+
+template <int N>
+static std::vector<int> sampleStatesGPU(const std::vector<real>& energies, real J, real kBT,
+                                        const std::vector<real>& uniforms, int nthreads)
+{
+    const int n = static_cast<int>(uniforms.size());
+    PinnedBuffer<real> dEnergies(energies.size()), dUniforms(n);
+    PinnedBuffer<int> dStates(n);
+
+    std::copy(energies.begin(), energies.end(), dEnergies.begin());
+    std::copy(uniforms.begin(), uniforms.end(), dUniforms.begin());
+    dEnergies.uploadToDevice(defaultStream);
+    dUniforms.uploadToDevice(defaultStream);
+
+    SAFE_KERNEL_LAUNCH(
+        sampleStates<N>,
+        1, nthreads, transfer_matrix::sampleStatesSharedMemory<N>(n, nthreads), defaultStream,
+        n, dEnergies.devPtr(), dUniforms.devPtr(), J, kBT, dStates.devPtr() );
+
+    dStates.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+    return {dStates.begin(), dStates.end()};
+}
+
+template <int N>
+static void checkGroundStateGPU(int n, real J, int nthreads)
+{
+    const auto energies = randomEnergies(n, N, 42 + n);
+    const std::vector<real> uniforms(n, 0.5_r);
+
+    const auto ref = transfer_matrix::sampleStatesReference<N>(energies, J, 0.0_r, uniforms);
+    const auto gpu = sampleStatesGPU<N>(energies, J, 0.0_r, uniforms, nthreads);
+
+    const double Eref = totalEnergy(energies, N, J, ref);
+    const double Egpu = totalEnergy(energies, N, J, gpu);
+
+    ASSERT_NEAR(Eref, Egpu, 1e-5 * n);
+}
+
+template <int N>
+static void checkSamplesGPU(int n, real J, real kBT, int nthreads)
+{
+    std::mt19937 gen(n);
+    const auto energies = randomEnergies(n, N, 42 + n);
+    const auto uniforms = randomUniforms(n, gen);
+
+    const auto ref = transfer_matrix::sampleStatesReference<N>(energies, J, kBT, uniforms);
+    const auto gpu = sampleStatesGPU<N>(energies, J, kBT, uniforms, nthreads);
+
+    // same random numbers: the samples only differ when a uniform falls within roundoff of a cumulative probability
+    int ndiff = 0;
+    for (int b = 0; b < n; ++b)
+        ndiff += (ref[b] != gpu[b]);
+
+    ASSERT_LE(ndiff, n / 50);
+}
+
+TEST (ROD_STATES, gpu_ground_state_matches_reference)
+{
+    for (int n : {1, 7, 31, 32, 100, 1000})
+    {
+        checkGroundStateGPU<2> (n, 0.3_r, 32);
+        checkGroundStateGPU<11>(n, 0.1_r, 32);
+        checkGroundStateGPU<11>(n, 0.1_r, 1);
+    }
+}
+
+TEST (ROD_STATES, gpu_samples_match_reference)
+{
+    for (int n : {1, 7, 31, 32, 100, 1000})
+    {
+        checkSamplesGPU<2> (n, 0.3_r, 0.2_r, 32);
+        checkSamplesGPU<11>(n, 0.1_r, 0.2_r, 32);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "rod_states.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
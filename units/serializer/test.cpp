@@ -1,6 +1,7 @@
 #include <mirheo/core/containers.h>
 #include <mirheo/core/datatypes.h>
 #include <mirheo/core/logger.h>
+#include <mirheo/core/utils/config.h>
 #include <mirheo/plugins/utils/simple_serializer.h>
 
 #include <vector>
@@ -78,6 +79,31 @@ TEST(Serializer, Mixed)
         ASSERT_EQ(s5[i], d5[i]) << "mismatch on 5[" + std::to_string(i) + "]";
 }
 
+TEST(Serializer, BinaryConfigIsSmallerThanJSON)
+{
+    // A config similar to a snapshot with many membranes: large float tables and many small objects.
+    ConfigArray objects;
+    for (int i = 0; i < 200; ++i)
+    {
+        ConfigArray vertices;
+        for (int j = 0; j < 64; ++j)
+            vertices.push_back(ConfigArray{0.1 * j, 0.2 * i, 0.3 * (i + j)});
+
+        objects.push_back(ConfigObject{
+            {"name", "object" + std::to_string(i)},
+            {"id", static_cast<long long>(i)},
+            {"vertices", std::move(vertices)}});
+    }
+    const ConfigValue config = ConfigObject{{"objects", std::move(objects)}};
+
+    const std::string json = config.toJSONString();
+    const std::string binary = configToBinary(config);
+    const ConfigValue fromBinary = configFromBinary(binary);
+
+    ASSERT_EQ(fromBinary.toJSONString(), json);
+    ASSERT_LT(binary.size(), json.size());
+}
+
 int main(int argc, char **argv)
 {
     MPI_Init(&argc, &argv);
@@ -0,0 +1,79 @@
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/shared_memory.h>
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <string>
+#include <unistd.h>
+
+using namespace mirheo;
+
+static std::string segmentName(const std::string& suffix)
+{
+    return "/mirheo_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+TEST (SHARED_MEMORY, capacity_is_larger_than_the_message)
+{
+    for (size_t size : {size_t(0), size_t(1), size_t(4095), size_t(4096), size_t(1) << 20})
+        ASSERT_GT(SharedMemorySegment::computeCapacity(size), size);
+}
+
+TEST (SHARED_MEMORY, capacity_does_not_overflow_int)
+{
+    // messages close to INT_MAX bytes need segments that do not fit in an int
+    const size_t size = static_cast<size_t>(INT_MAX);
+    const size_t capacity = SharedMemorySegment::computeCapacity(size);
+
+    ASSERT_GT(capacity, size);
+    ASSERT_GT(capacity, static_cast<size_t>(INT_MAX));
+}
+
+TEST (SHARED_MEMORY, data_is_shared_up_to_the_last_byte)
+{
+    const size_t capacity = SharedMemorySegment::computeCapacity(10000);
+    const std::string name = segmentName("boundary");
+
+    auto writer = SharedMemorySegment::create(name, capacity);
+    ASSERT_EQ(writer.size(), capacity);
+
+    writer.data()[0] = 'a';
+    writer.data()[capacity-1] = 'z';
+
+    auto reader = SharedMemorySegment::open(name, capacity, true);
+    ASSERT_EQ(reader.size(), capacity);
+    ASSERT_EQ(reader.data()[0], 'a');
+    ASSERT_EQ(reader.data()[capacity-1], 'z');
+
+    // the reader sees the updates of the writer
+    writer.data()[capacity-1] = 'y';
+    ASSERT_EQ(reader.data()[capacity-1], 'y');
+}
+
+TEST (SHARED_MEMORY, larger_segment_replaces_the_old_one)
+{
+    auto small = SharedMemorySegment::create(segmentName("small"), SharedMemorySegment::computeCapacity(100));
+    const size_t required = small.size() + 1;
+
+    auto large = SharedMemorySegment::create(segmentName("large"), SharedMemorySegment::computeCapacity(required));
+    ASSERT_GE(large.size(), required);
+
+    large.data()[required-1] = 'x';
+    small = std::move(large);
+
+    ASSERT_GE(small.size(), required);
+    ASSERT_EQ(small.data()[required-1], 'x');
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "shared_memory.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
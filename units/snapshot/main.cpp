@@ -7,6 +7,9 @@
 #include <mirheo/core/utils/config.h>
 #include <mirheo/core/utils/type_traits.h>
 
+#include <fstream>
+#include <limits>
+
 using namespace mirheo;
 
 static std::string removeWhitespace(std::string str) {
@@ -206,6 +209,100 @@ TEST(Snapshot, DumpUndumpInteractions)
     }
 }
 
+/// Check that the types (Int or Float) and the values are exactly the same.
+static void assertSameConfig(const ConfigValue& a, const ConfigValue& b)
+{
+    if (auto i = a.get_if<ConfigValue::Int>()) {
+        ASSERT_NE(b.get_if<ConfigValue::Int>(), nullptr);
+        ASSERT_EQ(*i, b.get<ConfigValue::Int>());
+    } else if (auto f = a.get_if<ConfigValue::Float>()) {
+        ASSERT_NE(b.get_if<ConfigValue::Float>(), nullptr);
+        ASSERT_EQ(*f, b.get<ConfigValue::Float>());
+    } else if (auto s = a.get_if<ConfigValue::String>()) {
+        ASSERT_EQ(*s, b.getString());
+    } else if (auto arr = a.get_if<ConfigValue::Array>()) {
+        const auto& other = b.getArray();
+        ASSERT_EQ(arr->size(), other.size());
+        for (size_t k = 0; k < arr->size(); ++k)
+            assertSameConfig((*arr)[k], other[k]);
+    } else {
+        const auto& obj = a.getObject();
+        const auto& other = b.getObject();
+        ASSERT_EQ(obj.size(), other.size());
+        auto it = other.begin();
+        for (const auto& kv : obj) {
+            ASSERT_EQ(kv.first, it->first);  // Order is preserved.
+            assertSameConfig(kv.second, it->second);
+            ++it;
+        }
+    }
+}
+
+TEST(Snapshot, BinaryRoundTrip)
+{
+    ConfigArray vertices;
+    for (int i = 0; i < 100; ++i)
+        vertices.push_back(ConfigArray{0.1 * i, -2.5 * i, 1e-300 * i});
+
+    ConfigArray ints;
+    for (long long i = -50; i < 50; ++i)
+        ints.push_back(i * 1234567LL);
+
+    const ConfigValue config = ConfigObject{
+        {"int", 10LL},
+        {"negative", -1LL},
+        {"extremes", ConfigArray{std::numeric_limits<long long>::min(),
+                                 std::numeric_limits<long long>::max(), 0LL}},
+        {"float", 12.125},
+        {"integerFloat", 1230.0},  // Would be parsed back as a float from JSON as well.
+        {"string", std::string("with \"quotes\", \n and a \0 byte", 30)},
+        {"empty", ConfigArray{}},
+        {"emptyObject", ConfigObject{}},
+        {"mixed", ConfigArray{1LL, 2.5, "three", 4LL, 5.0}},
+        {"vertices", std::move(vertices)},
+        {"ints", std::move(ints)},
+        {"ragged", ConfigArray{ConfigArray{1.0, 2.0}, ConfigArray{3.0}, ConfigArray{4.0, 5.0}, ConfigArray{}}},
+        {"nested", ConfigObject{{"b", ConfigArray{ConfigObject{{"x", 1LL}}}}, {"a", "<Mesh with name=mesh>"}}},
+    };
+
+    const std::string binary = configToBinary(config);
+    assertSameConfig(config, configFromBinary(binary));
+
+    // Same tree as through JSON.
+    ASSERT_STREQ(configFromBinary(binary).toJSONString().c_str(), config.toJSONString().c_str());
+}
+
+TEST(Snapshot, BinaryIsCompactForLargeArrays)
+{
+    ConfigArray vertices;
+    for (int i = 0; i < 10000; ++i)
+        vertices.push_back(ConfigArray{0.1 * i, 0.2 * i, 0.3 * i});
+    const ConfigValue config = ConfigObject{{"vertices", std::move(vertices)}};
+
+    const std::string binary = configToBinary(config);
+    // Raw doubles plus a small header.
+    ASSERT_LT(binary.size(), 10000 * 3 * sizeof(double) + 64);
+    ASSERT_LT(binary.size(), config.toJSONString().size());
+}
+
+TEST(Snapshot, BinarySnapshotConfigFile)
+{
+    const ConfigValue config = ConfigObject{{"a", 10LL}, {"b", ConfigArray{1.5, 2.5, 3.5, 4.5}}};
+
+    writeSnapshotConfig("./", ConfigFormat::Binary, config);
+    assertSameConfig(config, readSnapshotConfig("./", ConfigFormat::Binary));
+
+    writeSnapshotConfig("./", ConfigFormat::JSON, config);
+    ASSERT_STREQ(readSnapshotConfig("./", ConfigFormat::JSON).toJSONString().c_str(),
+                 config.toJSONString().c_str());
+
+    // The stale binary config is removed, so that the JSON one is loaded.
+    ASSERT_EQ(std::ifstream(getConfigFileName(ConfigFormat::Binary)).good(), false);
+    LoaderContext context{std::string("./")};
+    ASSERT_EQ(context.getConfigFormat(), ConfigFormat::JSON);
+    ASSERT_EQ(context.getConfig().at("a").getInt(), 10);
+}
+
 TEST(Snapshot, HumanReadableToString)
 {
     ASSERT_STREQ(ConfigValue{10LL}.toString().c_str(), "10");
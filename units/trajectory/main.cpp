@@ -0,0 +1,247 @@
+#include <mirheo/core/logger.h>
+#include <mirheo/core/trajectory/reader.h>
+#include <mirheo/core/trajectory/writer.h>
+#include <mirheo/core/xdmf/type_map.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace mirheo;
+
+static const std::string fname = "trajectory_test.traj";
+
+// particles with shuffled ids; the velocity of a particle is a function of its id and of the frame
+struct Frame
+{
+    Frame(int n, int frameId)
+    {
+        for (int i = 0; i < n; ++i)
+            ids.push_back(100 + 3 * i);
+
+        std::mt19937 gen(42 + frameId);
+        std::shuffle(ids.begin(), ids.end(), gen);
+
+        for (auto id : ids)
+        {
+            const real x = static_cast<real>(id);
+            positions.push_back({x, 2.0_r * x, static_cast<real>(frameId)});
+            velocities.push_back({-x, static_cast<real>(frameId), 0.5_r});
+        }
+
+        channels.push_back(XDMF::Channel{"velocity", velocities.data(), XDMF::Channel::DataForm::Vector,
+                                         XDMF::getNumberType<real>(), DataTypeWrapper<real>(),
+                                         XDMF::Channel::NeedShift::False});
+        channels.push_back(XDMF::Channel{"id", ids.data(), XDMF::Channel::DataForm::Scalar,
+                                         XDMF::Channel::NumberType::Int64, DataTypeWrapper<int64_t>(),
+                                         XDMF::Channel::NeedShift::False});
+    }
+
+    std::vector<real3> positions, velocities;
+    std::vector<int64_t> ids;
+    std::vector<XDMF::Channel> channels;
+};
+
+static void checkParticles(const XDMF::VertexChannelsData& data, int frameId)
+{
+    ASSERT_EQ(data.descriptions.size(), 2u);
+    ASSERT_EQ(data.descriptions[0].name, "velocity");
+    ASSERT_EQ(data.descriptions[1].name, "id");
+
+    const real3   *vel = reinterpret_cast<const real3*>  (data.data[0].data());
+    const int64_t *ids = reinterpret_cast<const int64_t*>(data.data[1].data());
+
+    for (size_t i = 0; i < data.positions.size(); ++i)
+    {
+        const real x = static_cast<real>(ids[i]);
+        ASSERT_EQ(data.positions[i].x, x);
+        ASSERT_EQ(data.positions[i].y, 2.0_r * x);
+        ASSERT_EQ(data.positions[i].z, static_cast<real>(frameId));
+        ASSERT_EQ(vel[i].x, -x);
+        ASSERT_EQ(vel[i].y, static_cast<real>(frameId));
+    }
+}
+
+static const int64_t* getIds(const XDMF::VertexChannelsData& data)
+{
+    return reinterpret_cast<const int64_t*>(data.data[1].data());
+}
+
+static void writeFrames(int nFrames, int n, int chunkSize, bool sortById, bool append, int firstFrame = 0)
+{
+    const Frame desc(0, 0);
+    trajectory::Writer writer(fname, desc.channels, chunkSize, "id", sortById, append);
+
+    for (int f = firstFrame; f < firstFrame + nFrames; ++f)
+    {
+        const Frame frame(n, f);
+        writer.write(0.1 * f, 10 * f, frame.positions, frame.channels);
+    }
+}
+
+TEST (TRAJECTORY, frames_are_read_back_with_their_times)
+{
+    const int nFrames = 5;
+    const int n = 1000;
+    writeFrames(nFrames, n, 128, false, false);
+
+    trajectory::Reader reader(fname);
+    ASSERT_EQ(reader.getNumFrames(), nFrames);
+    ASSERT_EQ(reader.getIdChannelName(), "id");
+
+    // random access, in reverse order
+    for (int f = nFrames - 1; f >= 0; --f)
+    {
+        ASSERT_EQ(reader.getTime(f), 0.1 * f);
+        ASSERT_EQ(reader.getStep(f), 10 * f);
+
+        const auto data = reader.readFrame(f);
+        ASSERT_EQ(data.positions.size(), static_cast<size_t>(n));
+        checkParticles(data, f);
+
+        // not sorted: the particles keep the order in which they were written
+        const Frame expected(n, f);
+        for (int i = 0; i < n; ++i)
+            ASSERT_EQ(getIds(data)[i], expected.ids[i]);
+    }
+
+    ASSERT_EQ(reader.findFrame(0.25), 2);
+    ASSERT_EQ(reader.findFrame(-1.0), -1);
+}
+
+TEST (TRAJECTORY, sorted_frames_give_id_ranges)
+{
+    const int n = 1000;
+    writeFrames(3, n, 64, true, false);
+
+    trajectory::Reader reader(fname);
+
+    const auto all = reader.readFrame(1);
+    ASSERT_EQ(all.positions.size(), static_cast<size_t>(n));
+    ASSERT_TRUE(std::is_sorted(getIds(all), getIds(all) + n));
+    checkParticles(all, 1);
+
+    const int64_t idMin = 1000, idMax = 1500;
+    const auto part = reader.readFrame(1, idMin, idMax);
+
+    const size_t expectedSize = std::count_if(getIds(all), getIds(all) + n, [&](int64_t id)
+    {
+        return id >= idMin && id <= idMax;
+    });
+
+    ASSERT_EQ(part.positions.size(), expectedSize);
+    checkParticles(part, 1);
+
+    for (size_t i = 0; i < part.positions.size(); ++i)
+    {
+        ASSERT_GE(getIds(part)[i], idMin);
+        ASSERT_LE(getIds(part)[i], idMax);
+    }
+
+    ASSERT_EQ(reader.readFrame(1, -10, -1).positions.size(), 0u);
+}
+
+TEST (TRAJECTORY, append_keeps_existing_frames)
+{
+    writeFrames(2, 100, 32, true, false);
+    writeFrames(3, 100, 32, true, true, 2);
+
+    trajectory::Reader reader(fname);
+    ASSERT_EQ(reader.getNumFrames(), 5);
+
+    for (int f = 0; f < 5; ++f)
+    {
+        ASSERT_EQ(reader.getStep(f), 10 * f);
+        checkParticles(reader.readFrame(f), f);
+    }
+}
+
+TEST (TRAJECTORY, frames_are_found_without_footer)
+{
+    writeFrames(4, 200, 50, false, false);
+
+    // simulate an interrupted write: the footer and part of the last frame are lost
+    {
+        FileWrapper f(fname, "rb");
+        fseek(f.get(), 0, SEEK_END);
+        const long size = ftell(f.get());
+        ASSERT_EQ(truncate(fname.c_str(), size - 1000), 0);
+    }
+
+    trajectory::Reader reader(fname);
+    ASSERT_EQ(reader.getNumFrames(), 3);
+    for (int f = 0; f < 3; ++f)
+        checkParticles(reader.readFrame(f), f);
+
+    // appending drops the incomplete frame
+    writeFrames(1, 200, 50, false, true, 3);
+
+    trajectory::Reader reader2(fname);
+    ASSERT_EQ(reader2.getNumFrames(), 4);
+    checkParticles(reader2.readFrame(3), 3);
+
+    // interrupt the write of the next frame by limiting the size of the files a few bytes after the end of the frames;
+    // the frames are large enough for the limit not to affect the log file
+    const int nFrames = 4;
+    const int n = 10000;
+    writeFrames(nFrames, n, 128, false, false);
+
+    uint64_t framesEnd, fileSize;
+    {
+        FileWrapper f;
+        ASSERT_EQ(f.open(fname, "rb"), FileWrapper::Status::Success);
+        trajectory::readHeader(f, fname);
+        trajectory::readIndex(f, fname, framesEnd);
+        fseek(f.get(), 0, SEEK_END);
+        fileSize = static_cast<uint64_t>(ftell(f.get()));
+    }
+    // the trailer of the previous footer is beyond the limit
+    ASSERT_LT(framesEnd + 16, fileSize);
+
+    rlimit unlimited, limited;
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &unlimited), 0);
+    limited = unlimited;
+    limited.rlim_cur = framesEnd + 16;
+
+    signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limited), 0);
+    try
+    {
+        writeFrames(1, n, 128, false, true, nFrames);
+    }
+    catch (const std::runtime_error&)
+    {
+        // die() closes the log file
+        logger.init(MPI_COMM_WORLD, "trajectory.log", 9);
+    }
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &unlimited), 0);
+    signal(SIGXFSZ, SIG_DFL);
+
+    // the previous footer must not be used to find the frames
+    trajectory::Reader reader3(fname);
+    ASSERT_EQ(reader3.getNumFrames(), nFrames);
+    for (int f = 0; f < nFrames; ++f)
+    {
+        ASSERT_EQ(reader3.getStep(f), 10 * f);
+        checkParticles(reader3.readFrame(f), f);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "trajectory.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -0,0 +1,157 @@
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/path.h>
+#include <mirheo/core/xdmf/aggregated_writer.h>
+#include <mirheo/core/xdmf/type_map.h>
+#include <mirheo/core/xdmf/xdmf.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace mirheo;
+
+static int getRank(MPI_Comm comm)
+{
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
+    return rank;
+}
+
+static int getSize(MPI_Comm comm)
+{
+    int size;
+    MPI_Check( MPI_Comm_size(comm, &size) );
+    return size;
+}
+
+// a different number of particles per rank; the id encodes the rank and the index
+struct LocalData
+{
+    LocalData(int rank)
+    {
+        const int n = 10 + 3 * rank;
+        for (int i = 0; i < n; ++i)
+        {
+            positions.push_back({static_cast<real>(rank), static_cast<real>(i), 0.0_r});
+            ids.push_back(1000 * rank + i);
+        }
+
+        channels.push_back(XDMF::Channel{"id", ids.data(), XDMF::Channel::DataForm::Scalar,
+                                         XDMF::Channel::NumberType::Int64, DataTypeWrapper<int64_t>(),
+                                         XDMF::Channel::NeedShift::False});
+    }
+
+    std::vector<real3> positions;
+    std::vector<int64_t> ids;
+    std::vector<XDMF::Channel> channels;
+};
+
+static long long sumOfAllIds(MPI_Comm comm)
+{
+    long long sum = 0;
+    for (int r = 0; r < getSize(comm); ++r)
+        for (auto id : LocalData(r).ids)
+            sum += id;
+    return sum;
+}
+
+// number of particles and sum of the ids of the data read from the given file
+static void readBack(const std::string& fname, MPI_Comm comm, long long& n, long long& idSum)
+{
+    const auto data = XDMF::readVertexData(fname, comm, 1);
+
+    n = static_cast<long long>(data.positions.size());
+    idSum = 0;
+
+    ASSERT_EQ(data.descriptions.size(), 1u);
+    ASSERT_EQ(data.descriptions[0].name, "id");
+
+    const int64_t *ids = reinterpret_cast<const int64_t*>(data.data[0].data());
+    for (long long i = 0; i < n; ++i)
+    {
+        idSum += ids[i];
+        ASSERT_EQ(static_cast<real>(ids[i] / 1000), data.positions[i].x);
+        ASSERT_EQ(static_cast<real>(ids[i] % 1000), data.positions[i].y);
+    }
+}
+
+TEST (XDMF, aggregated_shared_file_has_all_particles)
+{
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    LocalData local(getRank(comm));
+
+    XDMF::AggregatedVertexWriter writer(comm, 2, false, {{"romio_cb_write", "enable"}});
+    ASSERT_EQ(writer.isAggregator(), getRank(comm) % 2 == 0);
+    ASSERT_EQ(writer.getNumAggregators(), (getSize(comm) + 1) / 2);
+
+    writer.write("aggregated_shared", local.positions, local.channels, 0.5);
+
+    long long n, idSum;
+    readBack("aggregated_shared.xmf", comm, n, idSum);
+
+    MPI_Check( MPI_Allreduce(MPI_IN_PLACE, &n,     1, MPI_LONG_LONG, MPI_SUM, comm) );
+    MPI_Check( MPI_Allreduce(MPI_IN_PLACE, &idSum, 1, MPI_LONG_LONG, MPI_SUM, comm) );
+
+    long long nExpected = 0;
+    for (int r = 0; r < getSize(comm); ++r)
+        nExpected += static_cast<long long>(LocalData(r).ids.size());
+
+    ASSERT_EQ(n, nExpected);
+    ASSERT_EQ(idSum, sumOfAllIds(comm));
+}
+
+TEST (XDMF, subfiles_have_all_particles_and_are_referenced)
+{
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    LocalData local(getRank(comm));
+
+    XDMF::AggregatedVertexWriter writer(comm, 1, true, {});
+    writer.write("aggregated_sub", local.positions, local.channels, 0.5);
+
+    MPI_Check( MPI_Barrier(comm) );
+
+    if (getRank(comm) != 0)
+        return;
+
+    std::ifstream master("aggregated_sub.xmf");
+    std::stringstream content;
+    content << master.rdbuf();
+
+    long long nTotal = 0, idSumTotal = 0;
+
+    for (int r = 0; r < writer.getNumAggregators(); ++r)
+    {
+        const std::string piece = "aggregated_sub_sub" + createStrZeroPadded(r);
+        ASSERT_NE(content.str().find(piece + ".xmf"), std::string::npos);
+
+        long long n, idSum;
+        readBack(piece + ".xmf", MPI_COMM_SELF, n, idSum);
+
+        ASSERT_EQ(n, static_cast<long long>(LocalData(r).ids.size()));
+        nTotal += n;
+        idSumTotal += idSum;
+    }
+
+    long long nExpected = 0;
+    for (int r = 0; r < getSize(comm); ++r)
+        nExpected += static_cast<long long>(LocalData(r).ids.size());
+
+    ASSERT_EQ(nTotal, nExpected);
+    ASSERT_EQ(idSumTotal, sumOfAllIds(comm));
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "xdmf.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}